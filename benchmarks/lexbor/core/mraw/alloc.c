@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "benchmark.h"
+
+#include <lexbor/core/mraw.h>
+#include <lexbor/core/bst.h>
+
+
+#define SLOTS     4096
+#define STEPS     (SLOTS * 16)
+
+
+typedef struct {
+    size_t max_size;
+    size_t sizes[STEPS];
+    size_t slots[STEPS];
+}
+pattern_t;
+
+
+/*
+ * Free the block in a random slot and allocate a new one of a random size,
+ * like a document under mutation does with nodes, attributes and strings.
+ */
+static void
+pattern_init(pattern_t *pattern, size_t max_size)
+{
+    size_t i;
+    uint32_t seed = 0x2545F491;
+
+    pattern->max_size = max_size;
+
+    for (i = 0; i < STEPS; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        pattern->sizes[i] = 1 + (seed % max_size);
+        pattern->slots[i] = (seed >> 16) % SLOTS;
+    }
+}
+
+BENCHMARK_BEGIN(freelists, context)
+    size_t i;
+    void *slots[SLOTS];
+    lexbor_mraw_t *mraw;
+    lxb_status_t status;
+    pattern_t *pattern = context;
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096 * 16);
+    test_eq(status, LXB_STATUS_OK);
+
+BENCHMARK_CODE
+    memset(slots, 0, sizeof(slots));
+
+    for (i = 0; i < STEPS; i++) {
+        if (slots[pattern->slots[i]] != NULL) {
+            lexbor_mraw_free(mraw, slots[pattern->slots[i]]);
+        }
+
+        slots[pattern->slots[i]] = lexbor_mraw_alloc(mraw, pattern->sizes[i]);
+        test_ne(slots[pattern->slots[i]], NULL);
+
+        /* Touch the block as a user would. */
+        memset(slots[pattern->slots[i]], 0, sizeof(void *));
+    }
+
+    lexbor_mraw_clean(mraw);
+BENCHMARK_CODE_END
+
+    lexbor_mraw_destroy(mraw, true);
+BENCHMARK_END
+
+/*
+ * The previous lexbor_mraw cache: freed blocks in a BST keyed by size.
+ */
+BENCHMARK_BEGIN(bst, context)
+    size_t i, size, found;
+    void *slots[SLOTS];
+    size_t sizes[SLOTS];
+    lexbor_mem_t *mem;
+    lexbor_bst_t *cache;
+    lxb_status_t status;
+    pattern_t *pattern = context;
+
+    mem = lexbor_mem_create();
+    status = lexbor_mem_init(mem, 4096 * 16);
+    test_eq(status, LXB_STATUS_OK);
+
+    cache = lexbor_bst_create();
+    status = lexbor_bst_init(cache, 512);
+    test_eq(status, LXB_STATUS_OK);
+
+BENCHMARK_CODE
+    memset(slots, 0, sizeof(slots));
+
+    for (i = 0; i < STEPS; i++) {
+        if (slots[pattern->slots[i]] != NULL) {
+            lexbor_bst_insert(cache, lexbor_bst_root_ref(cache),
+                              sizes[pattern->slots[i]],
+                              slots[pattern->slots[i]]);
+        }
+
+        size = lexbor_mem_align(pattern->sizes[i]);
+        found = size;
+
+        slots[pattern->slots[i]] = NULL;
+
+        if (cache->tree_length != 0) {
+            slots[pattern->slots[i]] = lexbor_bst_remove_close(cache,
+                                                   lexbor_bst_root_ref(cache),
+                                                   size, &found);
+        }
+
+        if (slots[pattern->slots[i]] == NULL) {
+            found = size;
+            slots[pattern->slots[i]] = lexbor_mem_alloc(mem, size);
+            test_ne(slots[pattern->slots[i]], NULL);
+        }
+
+        sizes[pattern->slots[i]] = found;
+
+        memset(slots[pattern->slots[i]], 0, sizeof(void *));
+    }
+
+    lexbor_bst_clean(cache);
+    lexbor_mem_clean(mem);
+BENCHMARK_CODE_END
+
+    lexbor_bst_destroy(cache, true);
+    lexbor_mem_destroy(mem, true);
+BENCHMARK_END
+
+int
+main(int argc, const char * argv[])
+{
+    size_t i;
+    char caption[64];
+    pattern_t *pattern;
+
+    static const size_t max_sizes[] = {64, 256, 4096};
+
+    BENCHMARK_INIT;
+
+    pattern = lexbor_malloc(sizeof(pattern_t));
+    test_ne(pattern, NULL);
+
+    for (i = 0; i < sizeof(max_sizes) / sizeof(size_t); i++) {
+        pattern_init(pattern, max_sizes[i]);
+
+        snprintf(caption, sizeof(caption), "freelists, up to %zu bytes",
+                 max_sizes[i]);
+        BENCHMARK_ADD(freelists, caption, 100, pattern);
+
+        snprintf(caption, sizeof(caption), "bst, up to %zu bytes",
+                 max_sizes[i]);
+        BENCHMARK_ADD(bst, caption, 100, pattern);
+    }
+
+    lexbor_free(pattern);
+
+    return EXIT_SUCCESS;
+}
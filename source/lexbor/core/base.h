@@ -71,7 +71,8 @@ typedef enum {
     LXB_STATUS_NEXT,
     LXB_STATUS_STOP,
     LXB_STATUS_WARNING,
-    LXB_STATUS_SKIPPED
+    LXB_STATUS_SKIPPED,
+    LXB_STATUS_ERROR_MEMORY_LIMIT
 }
 lexbor_status_t;
 
@@ -31,5 +31,6 @@
 #include "lexbor/core/dtoa.h"
 #include "lexbor/core/strtod.h"
 #include "lexbor/core/serialize.h"
+#include "lexbor/core/simd.h"
 
 #endif /* LEXBOR_CORE_H */
@@ -21,6 +21,15 @@ lexbor_dobject_create(void)
 lxb_status_t
 lexbor_dobject_init(lexbor_dobject_t *dobject,
                     size_t chunk_size, size_t struct_size)
+{
+    return lexbor_dobject_init_allocator(dobject, chunk_size, struct_size,
+                                         NULL);
+}
+
+lxb_status_t
+lexbor_dobject_init_allocator(lexbor_dobject_t *dobject,
+                              size_t chunk_size, size_t struct_size,
+                              const lexbor_allocator_t *allocator)
 {
     lxb_status_t status;
 
@@ -37,10 +46,11 @@ lexbor_dobject_init(lexbor_dobject_t *dobject,
     dobject->struct_size = struct_size;
 
     /* Init memory */
-    dobject->mem = lexbor_mem_create();
+    dobject->mem = lexbor_allocator_calloc(allocator, 1, sizeof(lexbor_mem_t));
 
-    status = lexbor_mem_init(dobject->mem,
-                           lexbor_mem_align(chunk_size * dobject->struct_size));
+    status = lexbor_mem_init_allocator(dobject->mem,
+                           lexbor_mem_align(chunk_size * dobject->struct_size),
+                           allocator);
     if (status) {
         return status;
     }
@@ -71,13 +81,34 @@ lexbor_dobject_clean(lexbor_dobject_t *dobject)
     }
 }
 
+size_t
+lexbor_dobject_rewind(lexbor_dobject_t *dobject, size_t retain)
+{
+    size_t retained;
+
+    if (dobject == NULL) {
+        return 0;
+    }
+
+    dobject->allocated = 0UL;
+
+    retained = lexbor_mem_rewind(dobject->mem, retain);
+    lexbor_array_clean(dobject->cache);
+
+    return retained;
+}
+
 lexbor_dobject_t *
 lexbor_dobject_destroy(lexbor_dobject_t *dobject, bool destroy_self)
 {
     if (dobject == NULL)
         return NULL;
 
-    dobject->mem = lexbor_mem_destroy(dobject->mem, true);
+    if (dobject->mem != NULL) {
+        (void) lexbor_mem_destroy(dobject->mem, false);
+        dobject->mem = lexbor_allocator_free(dobject->mem->allocator,
+                                             dobject->mem);
+    }
     dobject->cache = lexbor_array_destroy(dobject->cache, true);
 
     if (destroy_self == true) {
@@ -185,3 +216,9 @@ lexbor_dobject_cache_length_noi(lexbor_dobject_t *dobject)
 {
     return lexbor_dobject_cache_length(dobject);
 }
+
+lexbor_mem_stat_t *
+lexbor_dobject_stat_noi(lexbor_dobject_t *dobject)
+{
+    return lexbor_dobject_stat(dobject);
+}
@@ -33,9 +33,25 @@ LXB_API lxb_status_t
 lexbor_dobject_init(lexbor_dobject_t *dobject,
                     size_t chunk_size, size_t struct_size);
 
+/*
+ * Chunks are taken from the allocator; NULL is the same as
+ * lexbor_dobject_init().
+ */
+LXB_API lxb_status_t
+lexbor_dobject_init_allocator(lexbor_dobject_t *dobject,
+                              size_t chunk_size, size_t struct_size,
+                              const lexbor_allocator_t *allocator);
+
 LXB_API void
 lexbor_dobject_clean(lexbor_dobject_t *dobject);
 
+/*
+ * Like lexbor_dobject_clean(), but keeps up to retain bytes of chunks
+ * for reuse. See lexbor_mem_rewind().
+ */
+LXB_API size_t
+lexbor_dobject_rewind(lexbor_dobject_t *dobject, size_t retain);
+
 LXB_API lexbor_dobject_t *
 lexbor_dobject_destroy(lexbor_dobject_t *dobject, bool destroy_self);
 
@@ -69,6 +85,12 @@ lexbor_dobject_cache_length(lexbor_dobject_t *dobject)
     return lexbor_array_length(dobject->cache);
 }
 
+lxb_inline lexbor_mem_stat_t *
+lexbor_dobject_stat(lexbor_dobject_t *dobject)
+{
+    return &dobject->mem->stat;
+}
+
 /*
  * No inline functions for ABI.
  */
@@ -78,6 +100,9 @@ lexbor_dobject_allocated_noi(lexbor_dobject_t *dobject);
 LXB_API size_t
 lexbor_dobject_cache_length_noi(lexbor_dobject_t *dobject);
 
+LXB_API lexbor_mem_stat_t *
+lexbor_dobject_stat_noi(lexbor_dobject_t *dobject);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
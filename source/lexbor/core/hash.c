@@ -70,28 +70,192 @@ LXB_API const lexbor_hash_search_t
 *lexbor_hash_search_upper = &lexbor_hash_search_upper_var;
 
 
-lxb_inline lexbor_hash_entry_t **
-lexbor_hash_table_create(lexbor_hash_t *hash)
+lxb_inline lexbor_hash_slot_t *
+lexbor_hash_table_create(lexbor_hash_t *hash, size_t table_size)
 {
-    return lexbor_calloc(hash->table_size, sizeof(lexbor_hash_entry_t *));
+    lexbor_hash_slot_t *table;
+
+    if (!lexbor_mem_stat_reserve(&hash->stat,
+                                 table_size * sizeof(lexbor_hash_slot_t)))
+    {
+        return NULL;
+    }
+
+    table = lexbor_allocator_calloc(hash->allocator,
+                                    table_size, sizeof(lexbor_hash_slot_t));
+    if (table != NULL) {
+        lexbor_mem_stat_add(&hash->stat,
+                            table_size * sizeof(lexbor_hash_slot_t));
+    }
+
+    return table;
 }
 
 lxb_inline void
 lexbor_hash_table_clean(lexbor_hash_t *hash)
 {
-    memset(hash->table, 0, sizeof(lexbor_hash_t *) * hash->table_size);
+    memset(hash->table, 0, sizeof(lexbor_hash_slot_t) * hash->table_size);
+
+    hash->count = 0;
 }
 
-lxb_inline lexbor_hash_entry_t **
+lxb_inline lexbor_hash_slot_t *
 lexbor_hash_table_destroy(lexbor_hash_t *hash)
 {
     if (hash->table != NULL) {
-        return lexbor_free(hash->table);
+        lexbor_mem_stat_sub(&hash->stat,
+                            hash->table_size * sizeof(lexbor_hash_slot_t));
+
+        return lexbor_allocator_free(hash->allocator, hash->table);
     }
 
     return NULL;
 }
 
+/*
+ * Makes the table of the initial size again. If it cannot be made, the
+ * table keeps its size.
+ */
+static void
+lexbor_hash_table_shrink(lexbor_hash_t *hash)
+{
+    lexbor_hash_slot_t *table;
+
+    if (hash->table_size > hash->table_init) {
+        table = lexbor_hash_table_create(hash, hash->table_init);
+
+        if (table != NULL) {
+            (void) lexbor_hash_table_destroy(hash);
+
+            hash->table = table;
+            hash->table_size = hash->table_init;
+        }
+    }
+
+    lexbor_hash_table_clean(hash);
+}
+
+lxb_inline size_t
+lexbor_hash_table_distance(const lexbor_hash_t *hash,
+                           const lexbor_hash_slot_t *slot, size_t idx)
+{
+    return (idx - slot->hash_id) & (hash->table_size - 1);
+}
+
+/*
+ * The entry must not be in the table and there must be a free slot.
+ */
+static void
+lexbor_hash_table_put(lexbor_hash_t *hash, lexbor_hash_entry_t *entry,
+                      uint32_t hash_id)
+{
+    size_t idx, dist, mask;
+    lexbor_hash_slot_t *slot, item, tmp;
+
+    mask = hash->table_size - 1;
+    idx = hash_id & mask;
+    dist = 0;
+
+    item.entry = entry;
+    item.hash_id = hash_id;
+
+    for (;;) {
+        slot = &hash->table[idx];
+
+        if (slot->entry == NULL) {
+            *slot = item;
+            break;
+        }
+
+        /* Robin Hood: take the place of an entry that is closer to home. */
+        if (lexbor_hash_table_distance(hash, slot, idx) < dist) {
+            tmp = *slot;
+            *slot = item;
+            item = tmp;
+
+            dist = lexbor_hash_table_distance(hash, &item, idx);
+        }
+
+        idx = (idx + 1) & mask;
+        dist++;
+    }
+
+    hash->count++;
+}
+
+static lxb_status_t
+lexbor_hash_table_rebuild(lexbor_hash_t *hash, size_t table_size)
+{
+    size_t i, old_size;
+    lexbor_hash_slot_t *old_table;
+
+    old_table = hash->table;
+    old_size = hash->table_size;
+
+    hash->table = lexbor_hash_table_create(hash, table_size);
+    if (hash->table == NULL) {
+        hash->table = old_table;
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    hash->table_size = table_size;
+    hash->count = 0;
+
+    for (i = 0; i < old_size; i++) {
+        if (old_table[i].entry != NULL) {
+            lexbor_hash_table_put(hash, old_table[i].entry,
+                                  old_table[i].hash_id);
+        }
+    }
+
+    lexbor_mem_stat_sub(&hash->stat, old_size * sizeof(lexbor_hash_slot_t));
+    lexbor_allocator_free(hash->allocator, old_table);
+
+    return LXB_STATUS_OK;
+}
+
+lxb_inline lxb_status_t
+lexbor_hash_table_reserve(lexbor_hash_t *hash)
+{
+    if ((hash->count + 1) * LEXBOR_HASH_LOAD_DEN
+        > hash->table_size * LEXBOR_HASH_LOAD_NUM)
+    {
+        return lexbor_hash_table_rebuild(hash, hash->table_size * 2);
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static size_t
+lexbor_hash_table_find(lexbor_hash_t *hash, uint32_t hash_id,
+                       const lxb_char_t *key, size_t length,
+                       const lexbor_hash_cmp_f cmp_func)
+{
+    size_t idx, dist, mask;
+    lexbor_hash_slot_t *slot;
+
+    mask = hash->table_size - 1;
+    idx = hash_id & mask;
+
+    for (dist = 0; ; dist++) {
+        slot = &hash->table[idx];
+
+        if (slot->entry == NULL
+            || lexbor_hash_table_distance(hash, slot, idx) < dist)
+        {
+            return hash->table_size;
+        }
+
+        if (slot->hash_id == hash_id && slot->entry->length == length
+            && cmp_func(lexbor_hash_entry_str(slot->entry), key, length))
+        {
+            return idx;
+        }
+
+        idx = (idx + 1) & mask;
+    }
+}
+
 lxb_inline lexbor_hash_entry_t *
 _lexbor_hash_entry_create(lexbor_hash_t *hash, const lexbor_hash_copy_f copy_func,
                           const lxb_char_t *key, size_t length)
@@ -119,6 +283,14 @@ lexbor_hash_create(void)
 
 lxb_status_t
 lexbor_hash_init(lexbor_hash_t *hash, size_t table_size, size_t struct_size)
+{
+    return lexbor_hash_init_allocator(hash, table_size, struct_size, NULL);
+}
+
+lxb_status_t
+lexbor_hash_init_allocator(lexbor_hash_t *hash, size_t table_size,
+                           size_t struct_size,
+                           const lexbor_allocator_t *allocator)
 {
     lxb_status_t status;
     size_t chunk_size;
@@ -133,21 +305,41 @@ lexbor_hash_init(lexbor_hash_t *hash, size_t table_size, size_t struct_size)
 
     chunk_size = table_size / 2;
 
-    hash->table_size = table_size;
+    /* Power of two. */
+    hash->table_size = LEXBOR_HASH_TABLE_MIN_SIZE;
 
-    hash->entries = lexbor_dobject_create();
-    status = lexbor_dobject_init(hash->entries, chunk_size, struct_size);
+    while (hash->table_size < table_size) {
+        hash->table_size *= 2;
+    }
+
+    hash->table_init = hash->table_size;
+
+    hash->count = 0;
+    hash->allocator = allocator;
+
+    lexbor_mem_stat_init(&hash->stat);
+
+    hash->entries = lexbor_allocator_calloc(allocator, 1,
+                                            sizeof(lexbor_dobject_t));
+    status = lexbor_dobject_init_allocator(hash->entries, chunk_size,
+                                           struct_size, allocator);
     if (status != LXB_STATUS_OK) {
         return status;
     }
 
-    hash->mraw = lexbor_mraw_create();
-    status = lexbor_mraw_init(hash->mraw, chunk_size * 12);
+    lexbor_mem_stat_parent_set(lexbor_dobject_stat(hash->entries),
+                               &hash->stat);
+
+    hash->mraw = lexbor_allocator_calloc(allocator, 1, sizeof(lexbor_mraw_t));
+    status = lexbor_mraw_init_allocator(hash->mraw, chunk_size * 12,
+                                        allocator);
     if (status != LXB_STATUS_OK) {
         return status;
     }
 
-    hash->table = lexbor_hash_table_create(hash);
+    lexbor_mem_stat_parent_set(lexbor_mraw_stat(hash->mraw), &hash->stat);
+
+    hash->table = lexbor_hash_table_create(hash, hash->table_size);
     if (hash->table == NULL) {
         return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
     }
@@ -162,7 +354,30 @@ lexbor_hash_clean(lexbor_hash_t *hash)
 {
     lexbor_dobject_clean(hash->entries);
     lexbor_mraw_clean(hash->mraw);
-    lexbor_hash_table_clean(hash);
+    lexbor_hash_table_shrink(hash);
+}
+
+size_t
+lexbor_hash_rewind(lexbor_hash_t *hash, size_t retain)
+{
+    size_t size, retained;
+
+    retained = lexbor_dobject_rewind(hash->entries, retain);
+    retained += lexbor_mraw_rewind(hash->mraw, (retained < retain)
+                                               ? retain - retained : 0);
+
+    size = hash->table_size * sizeof(lexbor_hash_slot_t);
+
+    if (retained > retain || size > retain - retained) {
+        lexbor_hash_table_shrink(hash);
+
+        size = hash->table_size * sizeof(lexbor_hash_slot_t);
+    }
+    else {
+        lexbor_hash_table_clean(hash);
+    }
+
+    return retained + size;
 }
 
 lexbor_hash_t *
@@ -172,8 +387,15 @@ lexbor_hash_destroy(lexbor_hash_t *hash, bool destroy_obj)
         return NULL;
     }
 
-    hash->entries = lexbor_dobject_destroy(hash->entries, true);
-    hash->mraw = lexbor_mraw_destroy(hash->mraw, true);
+    if (hash->entries != NULL) {
+        (void) lexbor_dobject_destroy(hash->entries, false);
+        hash->entries = lexbor_allocator_free(hash->allocator, hash->entries);
+    }
+
+    if (hash->mraw != NULL) {
+        (void) lexbor_mraw_destroy(hash->mraw, false);
+        hash->mraw = lexbor_allocator_free(hash->allocator, hash->mraw);
+    }
     hash->table = lexbor_hash_table_destroy(hash);
 
     if (destroy_obj) {
@@ -187,40 +409,29 @@ void *
 lexbor_hash_insert(lexbor_hash_t *hash, const lexbor_hash_insert_t *insert,
                    const lxb_char_t *key, size_t length)
 {
-    lxb_char_t *str;
-    uint32_t hash_id, table_idx;
+    size_t idx;
+    uint32_t hash_id;
     lexbor_hash_entry_t *entry;
 
     hash_id = insert->hash(key, length);
-    table_idx = hash_id % hash->table_size;
-
-    entry = hash->table[table_idx];
-
-    if (entry == NULL) {
-        entry = _lexbor_hash_entry_create(hash, insert->copy, key, length);
-        hash->table[table_idx] = entry;
 
-        return entry;
+    idx = lexbor_hash_table_find(hash, hash_id, key, length, insert->cmp);
+    if (idx != hash->table_size) {
+        return hash->table[idx].entry;
     }
 
-    do {
-        str = lexbor_hash_entry_str(entry);
-
-        if (entry->length == length && insert->cmp(str, key, length)) {
-            return entry;
-        }
-
-        if (entry->next == NULL) {
-            break;
-        }
+    if (lexbor_hash_table_reserve(hash) != LXB_STATUS_OK) {
+        return NULL;
+    }
 
-        entry = entry->next;
+    entry = _lexbor_hash_entry_create(hash, insert->copy, key, length);
+    if (entry == NULL) {
+        return NULL;
     }
-    while (1);
 
-    entry->next = _lexbor_hash_entry_create(hash, insert->copy, key, length);
+    lexbor_hash_table_put(hash, entry, hash_id);
 
-    return entry->next;
+    return entry;
 }
 
 void *
@@ -228,37 +439,21 @@ lexbor_hash_insert_by_entry(lexbor_hash_t *hash, lexbor_hash_entry_t *entry,
                             const lexbor_hash_search_t *search,
                             const lxb_char_t *key, size_t length)
 {
-    lxb_char_t *str;
-    uint32_t hash_id, table_idx;
-    lexbor_hash_entry_t *item;
+    size_t idx;
+    uint32_t hash_id;
 
     hash_id = search->hash(key, length);
-    table_idx = hash_id % hash->table_size;
-
-    item = hash->table[table_idx];
-
-    if (item == NULL) {
-        hash->table[table_idx] = entry;
 
-        return entry;
+    idx = lexbor_hash_table_find(hash, hash_id, key, length, search->cmp);
+    if (idx != hash->table_size) {
+        return hash->table[idx].entry;
     }
 
-    do {
-        str = lexbor_hash_entry_str(item);
-
-        if (item->length == length && search->cmp(str, key, length)) {
-            return item;
-        }
-
-        if (item->next == NULL) {
-            break;
-        }
-
-        item = item->next;
+    if (lexbor_hash_table_reserve(hash) != LXB_STATUS_OK) {
+        return NULL;
     }
-    while (1);
 
-    item->next = entry;
+    lexbor_hash_table_put(hash, entry, hash_id);
 
     return entry;
 }
@@ -284,37 +479,39 @@ lexbor_hash_remove_by_hash_id(lexbor_hash_t *hash, uint32_t hash_id,
                               const lxb_char_t *key, size_t length,
                               const lexbor_hash_cmp_f cmp_func)
 {
-    uint32_t table_idx;
-    lxb_char_t *str;
-    lexbor_hash_entry_t *entry, *prev;
+    size_t idx, next, mask;
+    lexbor_hash_entry_t *entry;
 
-    table_idx = hash_id % hash->table_size;
-    entry = hash->table[table_idx];
-    prev = NULL;
+    idx = lexbor_hash_table_find(hash, hash_id, key, length, cmp_func);
+    if (idx == hash->table_size) {
+        return;
+    }
 
-    while (entry != NULL) {
-        str = lexbor_hash_entry_str(entry);
+    entry = hash->table[idx].entry;
+    mask = hash->table_size - 1;
 
-        if (entry->length == length && cmp_func(str, key, length)) {
-            if (prev == NULL) {
-                hash->table[table_idx] = entry->next;
-            }
-            else {
-                prev->next = entry->next;
-            }
+    /* Backward shift: no tombstones are left behind. */
+    for (;;) {
+        next = (idx + 1) & mask;
 
-            if (length > LEXBOR_HASH_SHORT_SIZE) {
-                lexbor_mraw_free(hash->mraw, entry->u.long_str);
-            }
+        if (hash->table[next].entry == NULL
+            || lexbor_hash_table_distance(hash, &hash->table[next], next) == 0)
+        {
+            break;
+        }
 
-            lexbor_dobject_free(hash->entries, entry);
+        hash->table[idx] = hash->table[next];
+        idx = next;
+    }
 
-            return;
-        }
+    hash->table[idx].entry = NULL;
+    hash->count--;
 
-        prev = entry;
-        entry = entry->next;
+    if (length > LEXBOR_HASH_SHORT_SIZE) {
+        lexbor_mraw_free(hash->mraw, entry->u.long_str);
     }
+
+    lexbor_dobject_free(hash->entries, entry);
 }
 
 void *
@@ -322,22 +519,14 @@ lexbor_hash_search_by_hash_id(lexbor_hash_t *hash, uint32_t hash_id,
                               const lxb_char_t *key, size_t length,
                               const lexbor_hash_cmp_f cmp_func)
 {
-    lxb_char_t *str;
-    lexbor_hash_entry_t *entry;
-
-    entry = hash->table[ hash_id % hash->table_size ];
-
-    while (entry != NULL) {
-        str = lexbor_hash_entry_str(entry);
+    size_t idx;
 
-        if (entry->length == length && cmp_func(str, key, length)) {
-            return entry;
-        }
-
-        entry = entry->next;
+    idx = lexbor_hash_table_find(hash, hash_id, key, length, cmp_func);
+    if (idx == hash->table_size) {
+        return NULL;
     }
 
-    return NULL;
+    return hash->table[idx].entry;
 }
 
 uint32_t
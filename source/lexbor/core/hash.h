@@ -18,6 +18,12 @@ extern "C" {
 #define LEXBOR_HASH_SHORT_SIZE     16
 #define LEXBOR_HASH_TABLE_MIN_SIZE 32
 
+/*
+ * The table grows twice when it is more than LOAD_NUM/LOAD_DEN full.
+ */
+#define LEXBOR_HASH_LOAD_NUM       3
+#define LEXBOR_HASH_LOAD_DEN       4
+
 
 typedef struct lexbor_hash_search lexbor_hash_search_t;
 typedef struct lexbor_hash_insert lexbor_hash_insert_t;
@@ -33,9 +39,10 @@ LXB_EXTERN const lexbor_hash_search_t *lexbor_hash_search_upper;
 #endif
 
 /*
- * FIXME:
- * It is necessary to add the rebuild of a hash table
- * and optimize collisions.
+ * Open addressing with linear probing, Robin Hood insertion and
+ * backward-shift deletion. The table size is a power of two; the table is
+ * rebuilt when it gets too full. Entries are allocated separately and never
+ * move, so pointers to them stay valid after a rebuild.
  */
 
 typedef struct lexbor_hash lexbor_hash_t;
@@ -60,17 +67,31 @@ struct lexbor_hash_entry {
 
     size_t              length;
 
+    /* Not used by the table; kept for static entries initializers. */
     lexbor_hash_entry_t *next;
 };
 
+typedef struct {
+    lexbor_hash_entry_t *entry;
+    uint32_t            hash_id;
+}
+lexbor_hash_slot_t;
+
 struct lexbor_hash {
-    lexbor_dobject_t    *entries;
-    lexbor_mraw_t       *mraw;
+    lexbor_dobject_t         *entries;
+    lexbor_mraw_t            *mraw;
+
+    lexbor_hash_slot_t       *table;
+    size_t                   table_size;
+    size_t                   table_init; /* Size after lexbor_hash_init(). */
+    size_t                   count;
+
+    size_t                   struct_size;
 
-    lexbor_hash_entry_t **table;
-    size_t              table_size;
+    /* Entries, strings and the table. */
+    lexbor_mem_stat_t        stat;
 
-    size_t              struct_size;
+    const lexbor_allocator_t *allocator;
 };
 
 struct lexbor_hash_insert {
@@ -91,9 +112,29 @@ lexbor_hash_create(void);
 LXB_API lxb_status_t
 lexbor_hash_init(lexbor_hash_t *hash, size_t table_size, size_t struct_size);
 
+/*
+ * The table and the memory pools use the allocator; NULL is the same as
+ * lexbor_hash_init().
+ */
+LXB_API lxb_status_t
+lexbor_hash_init_allocator(lexbor_hash_t *hash, size_t table_size,
+                           size_t struct_size,
+                           const lexbor_allocator_t *allocator);
+
+/*
+ * The table goes back to its size after lexbor_hash_init().
+ */
 LXB_API void
 lexbor_hash_clean(lexbor_hash_t *hash);
 
+/*
+ * Like lexbor_hash_clean(), but keeps up to retain bytes of entries and
+ * strings chunks and of the table for reuse. The table keeps its size if
+ * it fits the rest of retain, the table of the initial size is always kept.
+ */
+LXB_API size_t
+lexbor_hash_rewind(lexbor_hash_t *hash, size_t retain);
+
 LXB_API lexbor_hash_t *
 lexbor_hash_destroy(lexbor_hash_t *hash, bool destroy_obj);
 
@@ -210,6 +251,21 @@ lexbor_hash_entries_count(lexbor_hash_t *hash)
     return lexbor_dobject_allocated(hash->entries);
 }
 
+/*
+ * Number of entries in the table.
+ */
+lxb_inline size_t
+lexbor_hash_count(const lexbor_hash_t *hash)
+{
+    return hash->count;
+}
+
+lxb_inline lexbor_mem_stat_t *
+lexbor_hash_stat(lexbor_hash_t *hash)
+{
+    return &hash->stat;
+}
+
 
 #ifdef __cplusplus
 } /* extern "C" */
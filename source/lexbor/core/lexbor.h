@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 #include "lexbor/core/def.h"
+#include "lexbor/core/types.h"
 
 typedef void *(*lexbor_memory_malloc_f)(size_t size);
 typedef void *(*lexbor_memory_realloc_f)(void *dst, size_t size);
@@ -34,6 +35,79 @@ LXB_API lxb_status_t
 lexbor_memory_setup(lexbor_memory_malloc_f new_malloc, lexbor_memory_realloc_f new_realloc,
                     lexbor_memory_calloc_f new_calloc, lexbor_memory_free_f new_free);
 
+/*
+ * Allocator for a single object tree (lexbor_mem_t, lexbor_mraw_t,
+ * lexbor_dobject_t, lexbor_hash_t and everything built on them).
+ *
+ * Only the memory of chunks goes through the allocator; the control
+ * structures themselves use lexbor_malloc() and friends. A NULL allocator
+ * means the global functions set by lexbor_memory_setup().
+ *
+ * The allocator must outlive every object it was given to.
+ */
+typedef void *(*lexbor_allocator_malloc_f)(size_t size, void *ctx);
+typedef void *(*lexbor_allocator_realloc_f)(void *dst, size_t size, void *ctx);
+typedef void *(*lexbor_allocator_calloc_f)(size_t num, size_t size, void *ctx);
+typedef void (*lexbor_allocator_free_f)(void *dst, void *ctx);
+
+typedef struct {
+    lexbor_allocator_malloc_f  malloc_f;
+    lexbor_allocator_realloc_f realloc_f;
+    lexbor_allocator_calloc_f  calloc_f;
+    lexbor_allocator_free_f    free_f;
+
+    void                       *ctx;
+}
+lexbor_allocator_t;
+
+
+/*
+ * Inline functions
+ */
+lxb_inline void *
+lexbor_allocator_malloc(const lexbor_allocator_t *allocator, size_t size)
+{
+    if (allocator == NULL) {
+        return lexbor_malloc(size);
+    }
+
+    return allocator->malloc_f(size, allocator->ctx);
+}
+
+lxb_inline void *
+lexbor_allocator_realloc(const lexbor_allocator_t *allocator,
+                         void *dst, size_t size)
+{
+    if (allocator == NULL) {
+        return lexbor_realloc(dst, size);
+    }
+
+    return allocator->realloc_f(dst, size, allocator->ctx);
+}
+
+lxb_inline void *
+lexbor_allocator_calloc(const lexbor_allocator_t *allocator,
+                        size_t num, size_t size)
+{
+    if (allocator == NULL) {
+        return lexbor_calloc(num, size);
+    }
+
+    return allocator->calloc_f(num, size, allocator->ctx);
+}
+
+lxb_inline void *
+lexbor_allocator_free(const lexbor_allocator_t *allocator, void *dst)
+{
+    if (allocator == NULL) {
+        return lexbor_free(dst);
+    }
+
+    allocator->free_f(dst, allocator->ctx);
+
+    return NULL;
+}
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -15,15 +15,26 @@ lexbor_mem_create(void)
 
 lxb_status_t
 lexbor_mem_init(lexbor_mem_t *mem, size_t min_chunk_size)
+{
+    return lexbor_mem_init_allocator(mem, min_chunk_size, NULL);
+}
+
+lxb_status_t
+lexbor_mem_init_allocator(lexbor_mem_t *mem, size_t min_chunk_size,
+                          const lexbor_allocator_t *allocator)
 {
     if (mem == NULL) {
         return LXB_STATUS_ERROR_OBJECT_IS_NULL;
     }
 
+    mem->allocator = allocator;
+
     if (min_chunk_size == 0) {
         return LXB_STATUS_ERROR_WRONG_ARGS;
     }
 
+    lexbor_mem_stat_init(&mem->stat);
+
     mem->chunk_min_size = lexbor_mem_align(min_chunk_size);
 
     /* Create first chunk */
@@ -47,13 +58,20 @@ lexbor_mem_clean(lexbor_mem_t *mem)
         return;
     }
 
+    /* Chunks after the current one are kept by lexbor_mem_rewind(). */
     chunk = mem->chunk;
 
+    while (chunk->next) {
+        chunk = chunk->next;
+    }
+
     while (chunk->prev) {
         prev = chunk->prev;
 
-        chunk->data = lexbor_free(chunk->data);
-        lexbor_free(chunk);
+        lexbor_mem_stat_sub(&mem->stat, chunk->size);
+
+        chunk->data = lexbor_allocator_free(mem->allocator, chunk->data);
+        lexbor_allocator_free(mem->allocator, chunk);
 
         chunk = prev;
     }
@@ -65,6 +83,46 @@ lexbor_mem_clean(lexbor_mem_t *mem)
     mem->chunk_length = 1;
 }
 
+size_t
+lexbor_mem_rewind(lexbor_mem_t *mem, size_t retain)
+{
+    size_t retained;
+    lexbor_mem_chunk_t *chunk, *next;
+
+    if (mem == NULL) {
+        return 0;
+    }
+
+    chunk = mem->chunk_first;
+    chunk->length = 0;
+
+    retained = chunk->size;
+
+    while (chunk->next != NULL && retained <= retain
+           && chunk->next->size <= retain - retained)
+    {
+        chunk = chunk->next;
+        chunk->length = 0;
+
+        retained += chunk->size;
+    }
+
+    next = chunk->next;
+    chunk->next = NULL;
+
+    while (next != NULL) {
+        chunk = next;
+        next = next->next;
+
+        lexbor_mem_chunk_destroy(mem, chunk, true);
+    }
+
+    mem->chunk = mem->chunk_first;
+    mem->chunk_length = 1;
+
+    return retained;
+}
+
 lexbor_mem_t *
 lexbor_mem_destroy(lexbor_mem_t *mem, bool destroy_self)
 {
@@ -78,6 +136,10 @@ lexbor_mem_destroy(lexbor_mem_t *mem, bool destroy_self)
     if (mem->chunk) {
         chunk = mem->chunk;
 
+        while (chunk->next) {
+            chunk = chunk->next;
+        }
+
         while (chunk) {
             prev = chunk->prev;
             lexbor_mem_chunk_destroy(mem, chunk, true);
@@ -113,7 +175,23 @@ lexbor_mem_chunk_init(lexbor_mem_t *mem,
     }
 
     chunk->length = 0;
-    chunk->data = lexbor_malloc(chunk->size * sizeof(uint8_t));
+
+    if (!lexbor_mem_stat_reserve(&mem->stat, chunk->size)) {
+        chunk->data = NULL;
+        chunk->size = 0;
+
+        return NULL;
+    }
+
+    chunk->data = lexbor_allocator_malloc(mem->allocator,
+                                          chunk->size * sizeof(uint8_t));
+    if (chunk->data == NULL) {
+        chunk->size = 0;
+
+        return NULL;
+    }
+
+    lexbor_mem_stat_add(&mem->stat, chunk->size);
 
     return chunk->data;
 }
@@ -121,19 +199,53 @@ lexbor_mem_chunk_init(lexbor_mem_t *mem,
 lexbor_mem_chunk_t *
 lexbor_mem_chunk_make(lexbor_mem_t *mem, size_t length)
 {
-    lexbor_mem_chunk_t *chunk = lexbor_calloc(1, sizeof(lexbor_mem_chunk_t));
+    lexbor_mem_chunk_t *chunk;
 
+    chunk = lexbor_allocator_calloc(mem->allocator,
+                                    1, sizeof(lexbor_mem_chunk_t));
     if (chunk == NULL) {
         return NULL;
     }
 
     if (lexbor_mem_chunk_init(mem, chunk, length) == NULL) {
-        return lexbor_free(chunk);
+        return lexbor_allocator_free(mem->allocator, chunk);
     }
 
     return chunk;
 }
 
+lexbor_mem_chunk_t *
+lexbor_mem_chunk_next(lexbor_mem_t *mem, size_t length)
+{
+    lexbor_mem_chunk_t *chunk, *next;
+
+    chunk = mem->chunk;
+    next = chunk->next;
+
+    if (next == NULL || next->size < length) {
+        next = lexbor_mem_chunk_make(mem, length);
+        if (next == NULL) {
+            return NULL;
+        }
+
+        next->next = chunk->next;
+
+        if (chunk->next != NULL) {
+            chunk->next->prev = next;
+        }
+
+        next->prev = chunk;
+        chunk->next = next;
+    }
+
+    next->length = 0;
+
+    mem->chunk = next;
+    mem->chunk_length++;
+
+    return next;
+}
+
 lexbor_mem_chunk_t *
 lexbor_mem_chunk_destroy(lexbor_mem_t *mem,
                          lexbor_mem_chunk_t *chunk, bool self_destroy)
@@ -143,11 +255,13 @@ lexbor_mem_chunk_destroy(lexbor_mem_t *mem,
     }
 
     if (chunk->data) {
-        chunk->data = lexbor_free(chunk->data);
+        lexbor_mem_stat_sub(&mem->stat, chunk->size);
+
+        chunk->data = lexbor_allocator_free(mem->allocator, chunk->data);
     }
 
     if (self_destroy) {
-        return lexbor_free(chunk);
+        return lexbor_allocator_free(mem->allocator, chunk);
     }
 
     return chunk;
@@ -167,15 +281,9 @@ lexbor_mem_alloc(lexbor_mem_t *mem, size_t length)
             return NULL;
         }
 
-        mem->chunk->next = lexbor_mem_chunk_make(mem, length);
-        if (mem->chunk->next == NULL) {
+        if (lexbor_mem_chunk_next(mem, length) == NULL) {
             return NULL;
         }
-
-        mem->chunk->next->prev = mem->chunk;
-        mem->chunk = mem->chunk->next;
-
-        mem->chunk_length++;
     }
 
     mem->chunk->length += length;
@@ -195,6 +303,16 @@ lexbor_mem_calloc(lexbor_mem_t *mem, size_t length)
     return data;
 }
 
+void
+lexbor_mem_stat_parent_set(lexbor_mem_stat_t *stat, lexbor_mem_stat_t *parent)
+{
+    lexbor_mem_stat_sub(stat->parent, stat->size);
+
+    stat->parent = parent;
+
+    lexbor_mem_stat_add(parent, stat->size);
+}
+
 /*
  * No inline functions for ABI.
  */
@@ -215,6 +333,61 @@ lexbor_mem_chunk_length_noi(lexbor_mem_t *mem)
 {
     return lexbor_mem_chunk_length(mem);
 }
+
+lexbor_mem_stat_t *
+lexbor_mem_stat_noi(lexbor_mem_t *mem)
+{
+    return lexbor_mem_stat(mem);
+}
+
+void
+lexbor_mem_stat_init_noi(lexbor_mem_stat_t *stat)
+{
+    lexbor_mem_stat_init(stat);
+}
+
+bool
+lexbor_mem_stat_reserve_noi(lexbor_mem_stat_t *stat, size_t size)
+{
+    return lexbor_mem_stat_reserve(stat, size);
+}
+
+void
+lexbor_mem_stat_add_noi(lexbor_mem_stat_t *stat, size_t size)
+{
+    lexbor_mem_stat_add(stat, size);
+}
+
+void
+lexbor_mem_stat_sub_noi(lexbor_mem_stat_t *stat, size_t size)
+{
+    lexbor_mem_stat_sub(stat, size);
+}
+
+void
+lexbor_mem_stat_peak_reset_noi(lexbor_mem_stat_t *stat)
+{
+    lexbor_mem_stat_peak_reset(stat);
+}
+
+void
+lexbor_mem_stat_limit_set_noi(lexbor_mem_stat_t *stat, size_t limit)
+{
+    lexbor_mem_stat_limit_set(stat, limit);
+}
+
+bool
+lexbor_mem_stat_exceeded_noi(const lexbor_mem_stat_t *stat)
+{
+    return lexbor_mem_stat_exceeded(stat);
+}
+
+lexbor_mem_usage_t
+lexbor_mem_stat_usage_noi(const lexbor_mem_stat_t *stat)
+{
+    return lexbor_mem_stat_usage(stat);
+}
+
 size_t
 lexbor_mem_align_noi(size_t size)
 {
@@ -18,6 +18,29 @@ extern "C" {
 
 typedef struct lexbor_mem_chunk lexbor_mem_chunk_t;
 typedef struct lexbor_mem lexbor_mem_t;
+typedef struct lexbor_mem_stat lexbor_mem_stat_t;
+
+typedef struct {
+    size_t size;
+    size_t peak;
+}
+lexbor_mem_usage_t;
+
+/*
+ * Bytes taken from the allocator. Changes go up through the parents, so
+ * the stat of an object owning several memory pools counts all of them.
+ *
+ * A non-zero limit makes allocations that would grow the size over it fail,
+ * the exceeded flag tells such a failure from a real out of memory.
+ */
+struct lexbor_mem_stat {
+    size_t            size;
+    size_t            peak;
+    size_t            limit;
+    bool              exceeded;
+
+    lexbor_mem_stat_t *parent;
+};
 
 struct lexbor_mem_chunk {
     uint8_t            *data;
@@ -29,11 +52,15 @@ struct lexbor_mem_chunk {
 };
 
 struct lexbor_mem {
-    lexbor_mem_chunk_t *chunk;
-    lexbor_mem_chunk_t *chunk_first;
+    lexbor_mem_chunk_t       *chunk;
+    lexbor_mem_chunk_t       *chunk_first;
+
+    size_t                   chunk_min_size;
+    size_t                   chunk_length;
+
+    lexbor_mem_stat_t        stat;
 
-    size_t             chunk_min_size;
-    size_t             chunk_length;
+    const lexbor_allocator_t *allocator;
 };
 
 
@@ -43,9 +70,25 @@ lexbor_mem_create(void);
 LXB_API lxb_status_t
 lexbor_mem_init(lexbor_mem_t *mem, size_t min_chunk_size);
 
+/*
+ * Chunks are taken from the allocator; NULL is the same as lexbor_mem_init().
+ */
+LXB_API lxb_status_t
+lexbor_mem_init_allocator(lexbor_mem_t *mem, size_t min_chunk_size,
+                          const lexbor_allocator_t *allocator);
+
 LXB_API void
 lexbor_mem_clean(lexbor_mem_t *mem);
 
+/*
+ * Like lexbor_mem_clean(), but keeps the chunks in order while their total
+ * size does not exceed the retain bytes; the first chunk is always kept.
+ * The kept chunks are reused by next allocations before new ones are made.
+ * Returns the number of retained bytes.
+ */
+LXB_API size_t
+lexbor_mem_rewind(lexbor_mem_t *mem, size_t retain);
+
 LXB_API lexbor_mem_t *
 lexbor_mem_destroy(lexbor_mem_t *mem, bool destroy_self);
 
@@ -63,6 +106,13 @@ lexbor_mem_chunk_init(lexbor_mem_t *mem,
 LXB_API lexbor_mem_chunk_t *
 lexbor_mem_chunk_make(lexbor_mem_t *mem, size_t length);
 
+/*
+ * Makes the next chunk current: a chunk kept by lexbor_mem_rewind() if it
+ * fits the length, or a new one.
+ */
+LXB_API lexbor_mem_chunk_t *
+lexbor_mem_chunk_next(lexbor_mem_t *mem, size_t length);
+
 LXB_API lexbor_mem_chunk_t *
 lexbor_mem_chunk_destroy(lexbor_mem_t *mem,
                          lexbor_mem_chunk_t *chunk, bool self_destroy);
@@ -77,6 +127,12 @@ lexbor_mem_alloc(lexbor_mem_t *mem, size_t length);
 LXB_API void *
 lexbor_mem_calloc(lexbor_mem_t *mem, size_t length);
 
+/*
+ * Moves the bytes counted by stat from the old parent to the new one.
+ */
+LXB_API void
+lexbor_mem_stat_parent_set(lexbor_mem_stat_t *stat, lexbor_mem_stat_t *parent);
+
 
 /*
  * Inline functions
@@ -99,6 +155,92 @@ lexbor_mem_chunk_length(lexbor_mem_t *mem)
     return mem->chunk_length;
 }
 
+lxb_inline lexbor_mem_stat_t *
+lexbor_mem_stat(lexbor_mem_t *mem)
+{
+    return &mem->stat;
+}
+
+lxb_inline void
+lexbor_mem_stat_init(lexbor_mem_stat_t *stat)
+{
+    memset(stat, 0, sizeof(lexbor_mem_stat_t));
+}
+
+/*
+ * Checks the limits up through the parents. On failure the stat with
+ * the limit is marked as exceeded.
+ */
+lxb_inline bool
+lexbor_mem_stat_reserve(lexbor_mem_stat_t *stat, size_t size)
+{
+    while (stat != NULL) {
+        if (stat->limit != 0
+            && (size > stat->limit || stat->size > stat->limit - size))
+        {
+            stat->exceeded = true;
+            return false;
+        }
+
+        stat = stat->parent;
+    }
+
+    return true;
+}
+
+lxb_inline void
+lexbor_mem_stat_add(lexbor_mem_stat_t *stat, size_t size)
+{
+    while (stat != NULL) {
+        stat->size += size;
+
+        if (stat->size > stat->peak) {
+            stat->peak = stat->size;
+        }
+
+        stat = stat->parent;
+    }
+}
+
+lxb_inline void
+lexbor_mem_stat_sub(lexbor_mem_stat_t *stat, size_t size)
+{
+    while (stat != NULL) {
+        stat->size -= size;
+        stat = stat->parent;
+    }
+}
+
+lxb_inline void
+lexbor_mem_stat_peak_reset(lexbor_mem_stat_t *stat)
+{
+    stat->peak = stat->size;
+}
+
+/*
+ * Zero for no limit. Clears the exceeded flag.
+ */
+lxb_inline void
+lexbor_mem_stat_limit_set(lexbor_mem_stat_t *stat, size_t limit)
+{
+    stat->limit = limit;
+    stat->exceeded = false;
+}
+
+lxb_inline bool
+lexbor_mem_stat_exceeded(const lexbor_mem_stat_t *stat)
+{
+    return stat->exceeded;
+}
+
+lxb_inline lexbor_mem_usage_t
+lexbor_mem_stat_usage(const lexbor_mem_stat_t *stat)
+{
+    lexbor_mem_usage_t usage = {.size = stat->size, .peak = stat->peak};
+
+    return usage;
+}
+
 lxb_inline size_t
 lexbor_mem_align(size_t size)
 {
@@ -127,6 +269,33 @@ lexbor_mem_current_size_noi(lexbor_mem_t *mem);
 LXB_API size_t
 lexbor_mem_chunk_length_noi(lexbor_mem_t *mem);
 
+LXB_API lexbor_mem_stat_t *
+lexbor_mem_stat_noi(lexbor_mem_t *mem);
+
+LXB_API void
+lexbor_mem_stat_init_noi(lexbor_mem_stat_t *stat);
+
+LXB_API bool
+lexbor_mem_stat_reserve_noi(lexbor_mem_stat_t *stat, size_t size);
+
+LXB_API void
+lexbor_mem_stat_add_noi(lexbor_mem_stat_t *stat, size_t size);
+
+LXB_API void
+lexbor_mem_stat_sub_noi(lexbor_mem_stat_t *stat, size_t size);
+
+LXB_API void
+lexbor_mem_stat_peak_reset_noi(lexbor_mem_stat_t *stat);
+
+LXB_API void
+lexbor_mem_stat_limit_set_noi(lexbor_mem_stat_t *stat, size_t limit);
+
+LXB_API bool
+lexbor_mem_stat_exceeded_noi(const lexbor_mem_stat_t *stat);
+
+LXB_API lexbor_mem_usage_t
+lexbor_mem_stat_usage_noi(const lexbor_mem_stat_t *stat);
+
 LXB_API size_t
 lexbor_mem_align_noi(size_t size);
 
@@ -18,6 +18,9 @@
     }                                                                          \
     while (0)
 
+#define LEXBOR_MRAW_CACHE_WALK 4
+
+
 #define lexbor_mraw_data_begin(data)                                           \
     &((uint8_t *) (data))[ lexbor_mraw_meta_size() ]
 
@@ -28,6 +31,222 @@ lexbor_mraw_realloc_tail(lexbor_mraw_t *mraw, void *data, void *begin,
                          bool *is_valid);
 
 
+lxb_inline unsigned
+lexbor_mraw_ctz64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_ctzll(value);
+#else
+    unsigned idx = 0;
+
+    while ((value & 1) == 0) {
+        value >>= 1;
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+lxb_inline unsigned
+lexbor_mraw_log2(size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) (sizeof(unsigned long long) * 8 - 1)
+           - (unsigned) __builtin_clzll((unsigned long long) value);
+#else
+    unsigned idx = 0;
+
+    while (value >>= 1) {
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+/*
+ * The size must be aligned and not 0.
+ */
+lxb_inline size_t
+lexbor_mraw_cache_index(size_t size)
+{
+    size_t idx;
+    unsigned log;
+
+    if (size <= LEXBOR_MRAW_CACHE_SMALL * LEXBOR_MEM_ALIGN_STEP) {
+        return (size / LEXBOR_MEM_ALIGN_STEP) - 1;
+    }
+
+    log = lexbor_mraw_log2(size);
+
+    idx = LEXBOR_MRAW_CACHE_SMALL
+          + ((log - lexbor_mraw_log2(LEXBOR_MRAW_CACHE_SMALL
+                                     * LEXBOR_MEM_ALIGN_STEP)) << 2)
+          + ((size >> (log - 2)) & 0x03);
+
+    return lexbor_min(idx, LEXBOR_MRAW_CACHE_SIZE - 1);
+}
+
+lxb_inline void *
+lexbor_mraw_cache_next_get(void *data)
+{
+    void *next;
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_UNPOISON_MEMORY_REGION(data, sizeof(void *));
+#endif
+
+    memcpy(&next, data, sizeof(void *));
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_POISON_MEMORY_REGION(data, sizeof(void *));
+#endif
+
+    return next;
+}
+
+lxb_inline void
+lexbor_mraw_cache_next_set(void *data, void *next)
+{
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_UNPOISON_MEMORY_REGION(data, sizeof(void *));
+#endif
+
+    memcpy(data, &next, sizeof(void *));
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_POISON_MEMORY_REGION(data, sizeof(void *));
+#endif
+}
+
+lxb_inline size_t
+lexbor_mraw_cache_size_get(void *data)
+{
+    size_t size;
+    uint8_t *meta = ((uint8_t *) data) - lexbor_mraw_meta_size();
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_UNPOISON_MEMORY_REGION(meta, sizeof(size_t));
+#endif
+
+    memcpy(&size, meta, sizeof(size_t));
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    ASAN_POISON_MEMORY_REGION(meta, sizeof(size_t));
+#endif
+
+    return size;
+}
+
+/*
+ * The block must be poisoned already (if ASan), its size is in the meta.
+ */
+static void
+lexbor_mraw_cache_push(lexbor_mraw_t *mraw, void *data, size_t size)
+{
+    size_t idx;
+
+    /* There is no room for the link. */
+    if (size < sizeof(void *)) {
+        return;
+    }
+
+    idx = lexbor_mraw_cache_index(size);
+
+    lexbor_mraw_cache_next_set(data, mraw->cache[idx]);
+
+    mraw->cache[idx] = data;
+    mraw->cache_map[idx / 64] |= (uint64_t) 1 << (idx % 64);
+    mraw->cache_length++;
+}
+
+lxb_inline void *
+lexbor_mraw_cache_take(lexbor_mraw_t *mraw, size_t idx)
+{
+    void *data = mraw->cache[idx];
+
+    mraw->cache[idx] = lexbor_mraw_cache_next_get(data);
+
+    if (mraw->cache[idx] == NULL) {
+        mraw->cache_map[idx / 64] &= ~((uint64_t) 1 << (idx % 64));
+    }
+
+    mraw->cache_length--;
+
+    return data;
+}
+
+/*
+ * Returns a block of at least the given size; the block is not split.
+ */
+static void *
+lexbor_mraw_cache_pop(lexbor_mraw_t *mraw, size_t size)
+{
+    void *prev, *data, *next;
+    size_t idx, word, steps;
+    uint64_t bits;
+
+    idx = lexbor_mraw_cache_index(size);
+
+    if (mraw->cache[idx] != NULL) {
+        /* Exact small class or a large class with a fitting head. */
+        if (idx < LEXBOR_MRAW_CACHE_SMALL
+            || lexbor_mraw_cache_size_get(mraw->cache[idx]) >= size)
+        {
+            return lexbor_mraw_cache_take(mraw, idx);
+        }
+
+        /* Sizes in a large class differ; look a few blocks further. */
+        prev = mraw->cache[idx];
+        data = lexbor_mraw_cache_next_get(prev);
+
+        for (steps = 0; data != NULL && steps < LEXBOR_MRAW_CACHE_WALK;
+             steps++)
+        {
+            next = lexbor_mraw_cache_next_get(data);
+
+            if (lexbor_mraw_cache_size_get(data) >= size) {
+                lexbor_mraw_cache_next_set(prev, next);
+                mraw->cache_length--;
+
+                return data;
+            }
+
+            prev = data;
+            data = next;
+        }
+    }
+
+    /* Any block in a higher class fits. */
+    idx++;
+
+    for (word = idx / 64; word < LEXBOR_MRAW_CACHE_SIZE / 64; word++) {
+        bits = mraw->cache_map[word];
+
+        if (word == idx / 64) {
+            bits &= ~(uint64_t) 0 << (idx % 64);
+        }
+
+        if (bits != 0) {
+            return lexbor_mraw_cache_take(mraw,
+                                          word * 64 + lexbor_mraw_ctz64(bits));
+        }
+    }
+
+    return NULL;
+}
+
+lxb_inline void
+lexbor_mraw_cache_clean(lexbor_mraw_t *mraw)
+{
+    memset(mraw->cache, 0, sizeof(mraw->cache));
+    memset(mraw->cache_map, 0, sizeof(mraw->cache_map));
+
+    mraw->cache_length = 0;
+}
+
+
 lexbor_mraw_t *
 lexbor_mraw_create(void)
 {
@@ -36,6 +255,13 @@ lexbor_mraw_create(void)
 
 lxb_status_t
 lexbor_mraw_init(lexbor_mraw_t *mraw, size_t chunk_size)
+{
+    return lexbor_mraw_init_allocator(mraw, chunk_size, NULL);
+}
+
+lxb_status_t
+lexbor_mraw_init_allocator(lexbor_mraw_t *mraw, size_t chunk_size,
+                           const lexbor_allocator_t *allocator)
 {
     lxb_status_t status;
 
@@ -48,9 +274,11 @@ lexbor_mraw_init(lexbor_mraw_t *mraw, size_t chunk_size)
     }
 
     /* Init memory */
-    mraw->mem = lexbor_mem_create();
+    mraw->mem = lexbor_allocator_calloc(allocator, 1, sizeof(lexbor_mem_t));
 
-    status = lexbor_mem_init(mraw->mem, chunk_size + lexbor_mraw_meta_size());
+    status = lexbor_mem_init_allocator(mraw->mem,
+                                       chunk_size + lexbor_mraw_meta_size(),
+                                       allocator);
     if (status) {
         return status;
     }
@@ -59,13 +287,7 @@ lexbor_mraw_init(lexbor_mraw_t *mraw, size_t chunk_size)
     ASAN_POISON_MEMORY_REGION(mraw->mem->chunk->data, mraw->mem->chunk->size);
 #endif
 
-    /* Cache */
-    mraw->cache = lexbor_bst_create();
-
-    status = lexbor_bst_init(mraw->cache, 512);
-    if (status) {
-        return status;
-    }
+    lexbor_mraw_cache_clean(mraw);
 
     mraw->ref_count = 0;
 
@@ -77,12 +299,39 @@ lexbor_mraw_clean(lexbor_mraw_t *mraw)
 {
     if (mraw != NULL) {
         lexbor_mem_clean(mraw->mem);
-        lexbor_bst_clean(mraw->cache);
+        lexbor_mraw_cache_clean(mraw);
 
         mraw->ref_count = 0;
     }
 }
 
+size_t
+lexbor_mraw_rewind(lexbor_mraw_t *mraw, size_t retain)
+{
+    size_t retained;
+
+    if (mraw == NULL) {
+        return 0;
+    }
+
+    retained = lexbor_mem_rewind(mraw->mem, retain);
+
+#if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
+    lexbor_mem_chunk_t *chunk = mraw->mem->chunk_first;
+
+    while (chunk != NULL) {
+        ASAN_POISON_MEMORY_REGION(chunk->data, chunk->size);
+        chunk = chunk->next;
+    }
+#endif
+
+    lexbor_mraw_cache_clean(mraw);
+
+    mraw->ref_count = 0;
+
+    return retained;
+}
+
 lexbor_mraw_t *
 lexbor_mraw_destroy(lexbor_mraw_t *mraw, bool destroy_self)
 {
@@ -90,8 +339,11 @@ lexbor_mraw_destroy(lexbor_mraw_t *mraw, bool destroy_self)
         return NULL;
     }
 
-    mraw->mem = lexbor_mem_destroy(mraw->mem, true);
-    mraw->cache = lexbor_bst_destroy(mraw->cache, true);
+    if (mraw->mem != NULL) {
+        (void) lexbor_mem_destroy(mraw->mem, false);
+        mraw->mem = lexbor_allocator_free(mraw->mem->allocator, mraw->mem);
+    }
+    lexbor_mraw_cache_clean(mraw);
 
     if (destroy_self) {
         return lexbor_free(mraw);
@@ -119,7 +371,10 @@ lexbor_mraw_mem_alloc(lexbor_mraw_t *mraw, size_t length)
 
         if (chunk->length == 0) {
             lexbor_mem_chunk_destroy(mem, chunk, false);
-            lexbor_mem_chunk_init(mem, chunk, length);
+
+            if (lexbor_mem_chunk_init(mem, chunk, length) == NULL) {
+                return NULL;
+            }
 
             chunk->length = length;
 
@@ -148,23 +403,17 @@ lexbor_mraw_mem_alloc(lexbor_mraw_t *mraw, size_t length)
                                       diff + lexbor_mraw_meta_size());
 #endif
 
-            lexbor_bst_insert(mraw->cache,
-                              lexbor_bst_root_ref(mraw->cache), diff,
-                              lexbor_mraw_data_begin(&chunk->data[chunk->length]));
+            lexbor_mraw_cache_push(mraw,
+                              lexbor_mraw_data_begin(&chunk->data[chunk->length]),
+                              diff);
 
             chunk->length = chunk->size;
         }
 
-        chunk->next = lexbor_mem_chunk_make(mem, length);
-        if (chunk->next == NULL) {
+        if (lexbor_mem_chunk_next(mem, length) == NULL) {
             return NULL;
         }
 
-        chunk->next->prev = chunk;
-        mem->chunk = chunk->next;
-
-        mem->chunk_length++;
-
 #if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
         ASAN_POISON_MEMORY_REGION(mem->chunk->data, mem->chunk->size);
 #endif
@@ -183,10 +432,8 @@ lexbor_mraw_alloc(lexbor_mraw_t *mraw, size_t size)
 
     size = lexbor_mem_align(size);
 
-    if (mraw->cache->tree_length != 0) {
-        data = lexbor_bst_remove_close(mraw->cache,
-                                       lexbor_bst_root_ref(mraw->cache),
-                                       size, NULL);
+    if (mraw->cache_length != 0 && size != 0) {
+        data = lexbor_mraw_cache_pop(mraw, size);
         if (data != NULL) {
 
 #if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
@@ -277,11 +524,20 @@ lexbor_mraw_realloc_tail(lexbor_mraw_t *mraw, void *data, void *begin,
         length = lexbor_mem_align(new_size + lexbor_mraw_meta_size()
                                   + mraw->mem->chunk_min_size);
 
-        tmp = lexbor_realloc(chunk->data, length);
+        if (!lexbor_mem_stat_reserve(&mraw->mem->stat,
+                                     length - chunk->size))
+        {
+            return NULL;
+        }
+
+        tmp = lexbor_allocator_realloc(mraw->mem->allocator,
+                                       chunk->data, length);
         if (tmp == NULL) {
             return NULL;
         }
 
+        lexbor_mem_stat_add(&mraw->mem->stat, length - chunk->size);
+
         chunk->data = tmp;
         chunk->size = length;
         chunk->length = new_size + lexbor_mraw_meta_size();
@@ -342,8 +598,7 @@ lexbor_mraw_realloc(lexbor_mraw_t *mraw, void *data, size_t new_size)
 #endif
             mraw->ref_count--;
 
-            lexbor_bst_insert(mraw->cache, lexbor_bst_root_ref(mraw->cache),
-                              size, data);
+            lexbor_mraw_cache_push(mraw, data, size);
             return NULL;
         }
 
@@ -360,8 +615,8 @@ lexbor_mraw_realloc(lexbor_mraw_t *mraw, void *data, size_t new_size)
 #if defined(LEXBOR_HAVE_ADDRESS_SANITIZER)
             ASAN_POISON_MEMORY_REGION(begin, new_size + lexbor_mraw_meta_size());
 #endif
-            lexbor_bst_insert(mraw->cache, lexbor_bst_root_ref(mraw->cache),
-                              new_size, lexbor_mraw_data_begin(begin));
+            lexbor_mraw_cache_push(mraw, lexbor_mraw_data_begin(begin),
+                                   new_size);
         }
 
         return data;
@@ -391,8 +646,7 @@ lexbor_mraw_free(lexbor_mraw_t *mraw, void *data)
     ASAN_POISON_MEMORY_REGION(real_data, size + lexbor_mraw_meta_size());
 #endif
 
-    lexbor_bst_insert(mraw->cache, lexbor_bst_root_ref(mraw->cache),
-                      size, data);
+    lexbor_mraw_cache_push(mraw, data, size);
 
     mraw->ref_count--;
 
@@ -419,3 +673,15 @@ lexbor_mraw_dup_noi(lexbor_mraw_t *mraw, const void *src, size_t size)
 {
     return lexbor_mraw_dup(mraw, src, size);
 }
+
+size_t
+lexbor_mraw_cache_length_noi(lexbor_mraw_t *mraw)
+{
+    return lexbor_mraw_cache_length(mraw);
+}
+
+lexbor_mem_stat_t *
+lexbor_mraw_stat_noi(lexbor_mraw_t *mraw)
+{
+    return lexbor_mraw_stat(mraw);
+}
@@ -15,7 +15,6 @@ extern "C" {
 
 #include "lexbor/core/base.h"
 #include "lexbor/core/mem.h"
-#include "lexbor/core/bst.h"
 
 
 #define lexbor_mraw_meta_size()                                                \
@@ -25,10 +24,28 @@ extern "C" {
     : sizeof(size_t))
 
 
+/*
+ * Freed blocks are kept in size-class freelists:
+ *
+ * 1. Exact classes for sizes up to LEXBOR_MRAW_CACHE_SMALL aligned steps
+ *    (512 bytes on 64-bit).
+ * 2. Four classes per power of two for larger sizes.
+ *
+ * The list link is stored in the freed block itself; bitmaps of non-empty
+ * classes make both alloc and free O(1).
+ */
+#define LEXBOR_MRAW_CACHE_SMALL 64
+#define LEXBOR_MRAW_CACHE_SIZE  (LEXBOR_MRAW_CACHE_SMALL + 128)
+
+
 typedef struct {
-    lexbor_mem_t *mem;
-    lexbor_bst_t *cache;
-    size_t       ref_count;
+    lexbor_mem_t             *mem;
+
+    void                     *cache[LEXBOR_MRAW_CACHE_SIZE];
+    uint64_t                 cache_map[LEXBOR_MRAW_CACHE_SIZE / 64];
+    size_t                   cache_length;
+
+    size_t                   ref_count;
 }
 lexbor_mraw_t;
 
@@ -39,9 +56,23 @@ lexbor_mraw_create(void);
 LXB_API lxb_status_t
 lexbor_mraw_init(lexbor_mraw_t *mraw, size_t chunk_size);
 
+/*
+ * Chunks are taken from the allocator; NULL is the same as lexbor_mraw_init().
+ */
+LXB_API lxb_status_t
+lexbor_mraw_init_allocator(lexbor_mraw_t *mraw, size_t chunk_size,
+                           const lexbor_allocator_t *allocator);
+
 LXB_API void
 lexbor_mraw_clean(lexbor_mraw_t *mraw);
 
+/*
+ * Like lexbor_mraw_clean(), but keeps up to retain bytes of chunks for reuse.
+ * See lexbor_mem_rewind().
+ */
+LXB_API size_t
+lexbor_mraw_rewind(lexbor_mraw_t *mraw, size_t retain);
+
 LXB_API lexbor_mraw_t *
 lexbor_mraw_destroy(lexbor_mraw_t *mraw, bool destroy_self);
 
@@ -93,6 +124,21 @@ lexbor_mraw_reference_count(lexbor_mraw_t *mraw)
     return mraw->ref_count;
 }
 
+/*
+ * Number of freed blocks waiting for reuse.
+ */
+lxb_inline size_t
+lexbor_mraw_cache_length(lexbor_mraw_t *mraw)
+{
+    return mraw->cache_length;
+}
+
+lxb_inline lexbor_mem_stat_t *
+lexbor_mraw_stat(lexbor_mraw_t *mraw)
+{
+    return &mraw->mem->stat;
+}
+
 
 /*
  * No inline functions for ABI.
@@ -106,6 +152,12 @@ lexbor_mraw_data_size_set_noi(void *data, size_t size);
 LXB_API void *
 lexbor_mraw_dup_noi(lexbor_mraw_t *mraw, const void *src, size_t size);
 
+LXB_API size_t
+lexbor_mraw_cache_length_noi(lexbor_mraw_t *mraw);
+
+LXB_API lexbor_mem_stat_t *
+lexbor_mraw_stat_noi(lexbor_mraw_t *mraw);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
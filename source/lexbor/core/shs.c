@@ -116,3 +116,50 @@ lexbor_shs_entry_get_upper_static(const lexbor_shs_entry_t *root,
 
     return NULL;
 }
+
+const lexbor_shs_entry_t *
+lexbor_shs_perfect_get_lower_static(const lexbor_shs_perfect_t *phs,
+                                    const lxb_char_t *key, size_t key_len)
+{
+    size_t i;
+    uint64_t sign;
+    uint32_t hash, idx;
+    const lexbor_shs_entry_t *entry;
+    const lxb_char_t *map = lexbor_str_res_map_lowercase;
+
+    if (key_len == 0 || key_len > phs->key_max) {
+        return NULL;
+    }
+
+    /*
+     * Only the first two, the middle and the last two characters and
+     * the length are hashed; the generator checks that this is unique
+     * for every key. The only full pass over the key is the comparison.
+     */
+    sign = (uint64_t) map[key[0]]
+           | (uint64_t) map[key[key_len > 1]] << 8
+           | (uint64_t) map[key[key_len >> 1]] << 16
+           | (uint64_t) map[key[key_len - 1 - (key_len > 1)]] << 24
+           | (uint64_t) map[key[key_len - 1]] << 32
+           | (uint64_t) key_len << 40;
+
+    hash = (uint32_t) ((sign * 0x9e3779b97f4a7c15) >> 32);
+
+    /* The bucket is taken from the high bits; displace_shift is 32 - log2. */
+    idx = (hash ^ phs->displace[hash >> phs->displace_shift]) * 0x85ebca6b;
+
+    /* Maps idx onto [0, table_size) without division. */
+    entry = &phs->entries[((uint64_t) idx * phs->table_size) >> 32];
+
+    if (entry->key_len != key_len) {
+        return NULL;
+    }
+
+    for (i = 0; i < key_len; i++) {
+        if ((lxb_char_t) entry->key[i] != map[key[i]]) {
+            return NULL;
+        }
+    }
+
+    return entry;
+}
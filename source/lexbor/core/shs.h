@@ -33,6 +33,21 @@ typedef struct {
 }
 lexbor_shs_hash_t;
 
+/*
+ * Minimal perfect hash over lowercase keys, generated by "PHS" from
+ * "utils/lexbor/lexbor/LXB.py". Every key maps to exactly one entry,
+ * so a lookup is a few character loads and one comparison.
+ */
+typedef struct {
+    const lexbor_shs_entry_t *entries;
+    const uint16_t           *displace;
+
+    size_t                   table_size;
+    unsigned                 displace_shift;
+    size_t                   key_max;
+}
+lexbor_shs_perfect_t;
+
 
 LXB_API const lexbor_shs_entry_t *
 lexbor_shs_entry_get_static(const lexbor_shs_entry_t *tree,
@@ -46,6 +61,13 @@ LXB_API const lexbor_shs_entry_t *
 lexbor_shs_entry_get_upper_static(const lexbor_shs_entry_t *root,
                                   const lxb_char_t *key, size_t key_len);
 
+/*
+ * Case-insensitive lookup. Returns NULL if the key is not in the table.
+ */
+LXB_API const lexbor_shs_entry_t *
+lexbor_shs_perfect_get_lower_static(const lexbor_shs_perfect_t *phs,
+                                    const lxb_char_t *key, size_t key_len);
+
 /*
  * Inline functions
  */
@@ -0,0 +1,775 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/core/simd.h"
+#include "lexbor/core/swar.h"
+
+
+#ifndef LEXBOR_DISABLE_SIMD
+    #if (defined(__x86_64__) || defined(__i386__))                             \
+        && (defined(__GNUC__) || defined(__clang__))
+        #define LEXBOR_SIMD_X86
+        #define LEXBOR_SIMD_TARGET(feature) __attribute__((target(feature)))
+
+        #include <cpuid.h>
+        #include <immintrin.h>
+
+    #elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+        #define LEXBOR_SIMD_X86
+        #define LEXBOR_SIMD_TARGET(feature)
+
+        #include <intrin.h>
+        #include <immintrin.h>
+
+    #elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+        #define LEXBOR_SIMD_NEON
+
+        #include <arm_neon.h>
+    #endif
+#endif
+
+
+typedef const lxb_char_t *
+(*lexbor_simd_seek3_f)(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3);
+
+typedef const lxb_char_t *
+(*lexbor_simd_seek4_f)(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4);
+
+typedef const lxb_char_t *
+(*lexbor_simd_seek_set_f)(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length);
+
+
+static const lxb_char_t *
+lexbor_simd_seek3_swar(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3);
+
+static const lxb_char_t *
+lexbor_simd_seek4_swar(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4);
+
+static const lxb_char_t *
+lexbor_simd_seek_set_swar(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length);
+
+
+/*
+ * The portable kernels until lexbor_simd_init() runs: when the library is
+ * loaded, where the compiler allows it, see lexbor_simd_load().
+ */
+static lexbor_simd_seek3_f lexbor_simd_seek3_fn = lexbor_simd_seek3_swar;
+static lexbor_simd_seek4_f lexbor_simd_seek4_fn = lexbor_simd_seek4_swar;
+static lexbor_simd_seek_set_f lexbor_simd_seek_set_fn = lexbor_simd_seek_set_swar;
+
+static int lexbor_simd_detected = -1;
+static unsigned int lexbor_simd_active_opt = LEXBOR_SIMD_NONE;
+
+
+/*
+ * Scalar tails.
+ */
+lxb_inline const lxb_char_t *
+lexbor_simd_seek3_tail(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    while (data < end) {
+        if (*data == c1 || *data == c2 || *data == c3) {
+            return data;
+        }
+
+        data++;
+    }
+
+    return end;
+}
+
+lxb_inline const lxb_char_t *
+lexbor_simd_seek4_tail(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4)
+{
+    while (data < end) {
+        if (*data == c1 || *data == c2 || *data == c3 || *data == c4) {
+            return data;
+        }
+
+        data++;
+    }
+
+    return end;
+}
+
+lxb_inline const lxb_char_t *
+lexbor_simd_seek_set_tail(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length)
+{
+    size_t i;
+
+    while (data < end) {
+        for (i = 0; i < length; i++) {
+            if (*data == set[i]) {
+                return data;
+            }
+        }
+
+        data++;
+    }
+
+    return end;
+}
+
+lxb_inline unsigned int
+lexbor_simd_ctz(unsigned int mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long idx;
+
+    _BitScanForward(&idx, mask);
+
+    return (unsigned int) idx;
+#else
+    unsigned int idx = 0;
+
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+
+/*
+ * SWAR, the portable fallback.
+ */
+static const lxb_char_t *
+lexbor_simd_seek3_swar(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    data = lexbor_swar_seek3(data, end, c1, c2, c3);
+
+    return lexbor_simd_seek3_tail(data, end, c1, c2, c3);
+}
+
+static const lxb_char_t *
+lexbor_simd_seek4_swar(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4)
+{
+    data = lexbor_swar_seek4(data, end, c1, c2, c3, c4);
+
+    return lexbor_simd_seek4_tail(data, end, c1, c2, c3, c4);
+}
+
+static const lxb_char_t *
+lexbor_simd_seek_set_swar(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length)
+{
+    size_t i, bytes, matches;
+
+    if (LEXBOR_SWAR_IS_LITTLE_ENDIAN) {
+        while (data + sizeof(size_t) <= end) {
+            memcpy(&bytes, data, sizeof(size_t));
+
+            matches = 0;
+
+            for (i = 0; i < length; i++) {
+                matches |= LEXBOR_SWAR_HAS_ZERO(bytes
+                                                ^ LEXBOR_SWAR_REPEAT(set[i]));
+            }
+
+            if (matches) {
+                data += ((((matches - 1) & LEXBOR_SWAR_ONES) * LEXBOR_SWAR_ONES)
+                         >> (sizeof(size_t) * 8 - 8)) - 1;
+                break;
+            }
+
+            data += sizeof(size_t);
+        }
+    }
+
+    return lexbor_simd_seek_set_tail(data, end, set, length);
+}
+
+
+#ifdef LEXBOR_SIMD_X86
+
+/*
+ * SSE2.
+ */
+LEXBOR_SIMD_TARGET("sse2")
+static const lxb_char_t *
+lexbor_simd_seek3_sse2(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    int mask;
+    __m128i v, n1, n2, n3;
+
+    n1 = _mm_set1_epi8((char) c1);
+    n2 = _mm_set1_epi8((char) c2);
+    n3 = _mm_set1_epi8((char) c3);
+
+    while (end - data >= 16) {
+        v = _mm_loadu_si128((const __m128i *) data);
+
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, n1),
+                                                           _mm_cmpeq_epi8(v, n2)),
+                                              _mm_cmpeq_epi8(v, n3)));
+        if (mask != 0) {
+            return data + lexbor_simd_ctz((unsigned int) mask);
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek3_tail(data, end, c1, c2, c3);
+}
+
+LEXBOR_SIMD_TARGET("sse2")
+static const lxb_char_t *
+lexbor_simd_seek4_sse2(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4)
+{
+    int mask;
+    __m128i v, n1, n2, n3, n4;
+
+    n1 = _mm_set1_epi8((char) c1);
+    n2 = _mm_set1_epi8((char) c2);
+    n3 = _mm_set1_epi8((char) c3);
+    n4 = _mm_set1_epi8((char) c4);
+
+    while (end - data >= 16) {
+        v = _mm_loadu_si128((const __m128i *) data);
+
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, n1),
+                                                           _mm_cmpeq_epi8(v, n2)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(v, n3),
+                                                           _mm_cmpeq_epi8(v, n4))));
+        if (mask != 0) {
+            return data + lexbor_simd_ctz((unsigned int) mask);
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek4_tail(data, end, c1, c2, c3, c4);
+}
+
+LEXBOR_SIMD_TARGET("sse2")
+static const lxb_char_t *
+lexbor_simd_seek_set_sse2(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length)
+{
+    int mask;
+    size_t i;
+    __m128i v, m, n[LEXBOR_SIMD_SET_MAX];
+
+    for (i = 0; i < length; i++) {
+        n[i] = _mm_set1_epi8((char) set[i]);
+    }
+
+    while (end - data >= 16) {
+        v = _mm_loadu_si128((const __m128i *) data);
+        m = _mm_cmpeq_epi8(v, n[0]);
+
+        for (i = 1; i < length; i++) {
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, n[i]));
+        }
+
+        mask = _mm_movemask_epi8(m);
+
+        if (mask != 0) {
+            return data + lexbor_simd_ctz((unsigned int) mask);
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek_set_tail(data, end, set, length);
+}
+
+/*
+ * SSE4.2.
+ *
+ * PCMPESTRI is not faster than SSE2 compares for three or four bytes,
+ * but it matches a whole set of up to 16 bytes in one instruction.
+ */
+LEXBOR_SIMD_TARGET("sse4.2")
+static const lxb_char_t *
+lexbor_simd_seek_set_sse42(const lxb_char_t *data, const lxb_char_t *end,
+                           const lxb_char_t *set, size_t length)
+{
+    int idx;
+    __m128i v, n;
+    lxb_char_t buf[16];
+
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, set, length);
+
+    n = _mm_loadu_si128((const __m128i *) buf);
+
+    while (end - data >= 16) {
+        v = _mm_loadu_si128((const __m128i *) data);
+
+        idx = _mm_cmpestri(n, (int) length, v, 16,
+                           _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY
+                           | _SIDD_LEAST_SIGNIFICANT);
+        if (idx != 16) {
+            return data + idx;
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek_set_tail(data, end, set, length);
+}
+
+/*
+ * AVX2.
+ */
+LEXBOR_SIMD_TARGET("avx2")
+static const lxb_char_t *
+lexbor_simd_seek3_avx2(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    unsigned int mask;
+    __m256i v, n1, n2, n3;
+
+    n1 = _mm256_set1_epi8((char) c1);
+    n2 = _mm256_set1_epi8((char) c2);
+    n3 = _mm256_set1_epi8((char) c3);
+
+    while (end - data >= 32) {
+        v = _mm256_loadu_si256((const __m256i *) data);
+
+        mask = (unsigned int) _mm256_movemask_epi8(
+                   _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, n1),
+                                                   _mm256_cmpeq_epi8(v, n2)),
+                                   _mm256_cmpeq_epi8(v, n3)));
+        if (mask != 0) {
+            return data + lexbor_simd_ctz(mask);
+        }
+
+        data += 32;
+    }
+
+    return lexbor_simd_seek3_sse2(data, end, c1, c2, c3);
+}
+
+LEXBOR_SIMD_TARGET("avx2")
+static const lxb_char_t *
+lexbor_simd_seek4_avx2(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4)
+{
+    unsigned int mask;
+    __m256i v, n1, n2, n3, n4;
+
+    n1 = _mm256_set1_epi8((char) c1);
+    n2 = _mm256_set1_epi8((char) c2);
+    n3 = _mm256_set1_epi8((char) c3);
+    n4 = _mm256_set1_epi8((char) c4);
+
+    while (end - data >= 32) {
+        v = _mm256_loadu_si256((const __m256i *) data);
+
+        mask = (unsigned int) _mm256_movemask_epi8(
+                   _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, n1),
+                                                   _mm256_cmpeq_epi8(v, n2)),
+                                   _mm256_or_si256(_mm256_cmpeq_epi8(v, n3),
+                                                   _mm256_cmpeq_epi8(v, n4))));
+        if (mask != 0) {
+            return data + lexbor_simd_ctz(mask);
+        }
+
+        data += 32;
+    }
+
+    return lexbor_simd_seek4_sse2(data, end, c1, c2, c3, c4);
+}
+
+LEXBOR_SIMD_TARGET("avx2")
+static const lxb_char_t *
+lexbor_simd_seek_set_avx2(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length)
+{
+    size_t i;
+    unsigned int mask;
+    __m256i v, m, n[LEXBOR_SIMD_SET_MAX];
+
+    for (i = 0; i < length; i++) {
+        n[i] = _mm256_set1_epi8((char) set[i]);
+    }
+
+    while (end - data >= 32) {
+        v = _mm256_loadu_si256((const __m256i *) data);
+        m = _mm256_cmpeq_epi8(v, n[0]);
+
+        for (i = 1; i < length; i++) {
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, n[i]));
+        }
+
+        mask = (unsigned int) _mm256_movemask_epi8(m);
+
+        if (mask != 0) {
+            return data + lexbor_simd_ctz(mask);
+        }
+
+        data += 32;
+    }
+
+    return lexbor_simd_seek_set_sse2(data, end, set, length);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+static unsigned int
+lexbor_simd_xgetbv(void)
+{
+    unsigned int eax, edx;
+
+    __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+
+    return eax;
+}
+#endif
+
+static unsigned int
+lexbor_simd_detect(void)
+{
+    unsigned int opt, max, xcr0;
+    unsigned int eax, ebx, ecx, edx;
+
+#if defined(__GNUC__) || defined(__clang__)
+    max = __get_cpuid_max(0, NULL);
+
+    if (max < 1) {
+        return LEXBOR_SIMD_NONE;
+    }
+
+    __cpuid(1, eax, ebx, ecx, edx);
+#else
+    int regs[4];
+
+    __cpuid(regs, 0);
+    max = (unsigned int) regs[0];
+
+    if (max < 1) {
+        return LEXBOR_SIMD_NONE;
+    }
+
+    __cpuid(regs, 1);
+
+    eax = (unsigned int) regs[0];
+    ebx = (unsigned int) regs[1];
+    ecx = (unsigned int) regs[2];
+    edx = (unsigned int) regs[3];
+#endif
+
+    opt = LEXBOR_SIMD_NONE;
+
+    if (edx & (1U << 26)) {
+        opt |= LEXBOR_SIMD_SSE2;
+    }
+
+    if (ecx & (1U << 20)) {
+        opt |= LEXBOR_SIMD_SSE42;
+    }
+
+    /* OSXSAVE and AVX, then the OS must save XMM and YMM state. */
+    if ((ecx & (1U << 27)) == 0 || (ecx & (1U << 28)) == 0 || max < 7) {
+        return opt;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    xcr0 = lexbor_simd_xgetbv();
+#else
+    xcr0 = (unsigned int) _xgetbv(0);
+#endif
+
+    if ((xcr0 & 0x06) != 0x06) {
+        return opt;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#else
+    __cpuidex(regs, 7, 0);
+    ebx = (unsigned int) regs[1];
+#endif
+
+    if (ebx & (1U << 5)) {
+        opt |= LEXBOR_SIMD_AVX2;
+    }
+
+    (void) eax;
+    (void) edx;
+
+    return opt;
+}
+
+#elif defined(LEXBOR_SIMD_NEON)
+
+/*
+ * NEON.
+ *
+ * There is no movemask, so narrow the 128-bit compare result to 64 bits
+ * with 4 bits per byte.
+ */
+lxb_inline unsigned int
+lexbor_simd_neon_index(uint8x16_t m)
+{
+    uint64_t bits;
+
+    bits = vget_lane_u64(vreinterpret_u64_u8(
+                         vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+    if (bits == 0) {
+        return 16;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctzll(bits) >> 2;
+#elif defined(_MSC_VER)
+    unsigned long idx;
+
+    _BitScanForward64(&idx, bits);
+
+    return (unsigned int) idx >> 2;
+#else
+    unsigned int idx = 0;
+
+    while ((bits & 0x0F) == 0) {
+        bits >>= 4;
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+static const lxb_char_t *
+lexbor_simd_seek3_neon(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    unsigned int idx;
+    uint8x16_t v, n1, n2, n3;
+
+    n1 = vdupq_n_u8(c1);
+    n2 = vdupq_n_u8(c2);
+    n3 = vdupq_n_u8(c3);
+
+    while (end - data >= 16) {
+        v = vld1q_u8(data);
+
+        idx = lexbor_simd_neon_index(vorrq_u8(vorrq_u8(vceqq_u8(v, n1),
+                                                       vceqq_u8(v, n2)),
+                                              vceqq_u8(v, n3)));
+        if (idx != 16) {
+            return data + idx;
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek3_tail(data, end, c1, c2, c3);
+}
+
+static const lxb_char_t *
+lexbor_simd_seek4_neon(const lxb_char_t *data, const lxb_char_t *end,
+                       lxb_char_t c1, lxb_char_t c2, lxb_char_t c3,
+                       lxb_char_t c4)
+{
+    unsigned int idx;
+    uint8x16_t v, n1, n2, n3, n4;
+
+    n1 = vdupq_n_u8(c1);
+    n2 = vdupq_n_u8(c2);
+    n3 = vdupq_n_u8(c3);
+    n4 = vdupq_n_u8(c4);
+
+    while (end - data >= 16) {
+        v = vld1q_u8(data);
+
+        idx = lexbor_simd_neon_index(vorrq_u8(vorrq_u8(vceqq_u8(v, n1),
+                                                       vceqq_u8(v, n2)),
+                                              vorrq_u8(vceqq_u8(v, n3),
+                                                       vceqq_u8(v, n4))));
+        if (idx != 16) {
+            return data + idx;
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek4_tail(data, end, c1, c2, c3, c4);
+}
+
+static const lxb_char_t *
+lexbor_simd_seek_set_neon(const lxb_char_t *data, const lxb_char_t *end,
+                          const lxb_char_t *set, size_t length)
+{
+    size_t i;
+    unsigned int idx;
+    uint8x16_t v, m, n[LEXBOR_SIMD_SET_MAX];
+
+    for (i = 0; i < length; i++) {
+        n[i] = vdupq_n_u8(set[i]);
+    }
+
+    while (end - data >= 16) {
+        v = vld1q_u8(data);
+        m = vceqq_u8(v, n[0]);
+
+        for (i = 1; i < length; i++) {
+            m = vorrq_u8(m, vceqq_u8(v, n[i]));
+        }
+
+        idx = lexbor_simd_neon_index(m);
+
+        if (idx != 16) {
+            return data + idx;
+        }
+
+        data += 16;
+    }
+
+    return lexbor_simd_seek_set_tail(data, end, set, length);
+}
+
+static unsigned int
+lexbor_simd_detect(void)
+{
+    /* NEON is mandatory on AArch64 and enabled by the compiler on ARMv7. */
+    return LEXBOR_SIMD_NEON;
+}
+
+#else
+
+static unsigned int
+lexbor_simd_detect(void)
+{
+    return LEXBOR_SIMD_NONE;
+}
+
+#endif
+
+
+void
+lexbor_simd_init(void)
+{
+    (void) lexbor_simd_use(LEXBOR_SIMD_ALL);
+}
+
+/*
+ * The kernels are chosen once, before any thread can use them: calls
+ * never switch them.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+
+__attribute__((constructor))
+static void
+lexbor_simd_load(void)
+{
+    lexbor_simd_init();
+}
+
+#elif defined(_MSC_VER)
+
+static void __cdecl
+lexbor_simd_load(void)
+{
+    lexbor_simd_init();
+}
+
+#pragma section(".CRT$XCU", read)
+__declspec(allocate(".CRT$XCU"))
+static void (__cdecl *lexbor_simd_load_ptr)(void) = lexbor_simd_load;
+
+#endif
+
+unsigned int
+lexbor_simd_supported(void)
+{
+    if (lexbor_simd_detected < 0) {
+        lexbor_simd_detected = (int) lexbor_simd_detect();
+    }
+
+    return (unsigned int) lexbor_simd_detected;
+}
+
+unsigned int
+lexbor_simd_use(unsigned int opt)
+{
+    opt &= lexbor_simd_supported();
+
+    lexbor_simd_seek3_fn = lexbor_simd_seek3_swar;
+    lexbor_simd_seek4_fn = lexbor_simd_seek4_swar;
+    lexbor_simd_seek_set_fn = lexbor_simd_seek_set_swar;
+
+#if defined(LEXBOR_SIMD_X86)
+    if (opt & LEXBOR_SIMD_SSE2) {
+        lexbor_simd_seek3_fn = lexbor_simd_seek3_sse2;
+        lexbor_simd_seek4_fn = lexbor_simd_seek4_sse2;
+        lexbor_simd_seek_set_fn = lexbor_simd_seek_set_sse2;
+    }
+
+    if (opt & LEXBOR_SIMD_SSE42) {
+        lexbor_simd_seek_set_fn = lexbor_simd_seek_set_sse42;
+    }
+
+    /* The AVX2 kernels finish their tails with SSE2. */
+    if ((opt & LEXBOR_SIMD_AVX2) && (opt & LEXBOR_SIMD_SSE2)) {
+        lexbor_simd_seek3_fn = lexbor_simd_seek3_avx2;
+        lexbor_simd_seek4_fn = lexbor_simd_seek4_avx2;
+        lexbor_simd_seek_set_fn = lexbor_simd_seek_set_avx2;
+    }
+
+#elif defined(LEXBOR_SIMD_NEON)
+    if (opt & LEXBOR_SIMD_NEON) {
+        lexbor_simd_seek3_fn = lexbor_simd_seek3_neon;
+        lexbor_simd_seek4_fn = lexbor_simd_seek4_neon;
+        lexbor_simd_seek_set_fn = lexbor_simd_seek_set_neon;
+    }
+#endif
+
+    lexbor_simd_active_opt = opt;
+
+    return opt;
+}
+
+unsigned int
+lexbor_simd_active(void)
+{
+    return lexbor_simd_active_opt;
+}
+
+const lxb_char_t *
+lexbor_simd_seek3(const lxb_char_t *data, const lxb_char_t *end,
+                  lxb_char_t c1, lxb_char_t c2, lxb_char_t c3)
+{
+    return lexbor_simd_seek3_fn(data, end, c1, c2, c3);
+}
+
+const lxb_char_t *
+lexbor_simd_seek4(const lxb_char_t *data, const lxb_char_t *end,
+                  lxb_char_t c1, lxb_char_t c2, lxb_char_t c3, lxb_char_t c4)
+{
+    return lexbor_simd_seek4_fn(data, end, c1, c2, c3, c4);
+}
+
+const lxb_char_t *
+lexbor_simd_seek_set(const lxb_char_t *data, const lxb_char_t *end,
+                     const lxb_char_t *set, size_t length)
+{
+    return lexbor_simd_seek_set_fn(data, end, set, length);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SIMD_H
+#define LEXBOR_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/core/base.h"
+
+
+/*
+ * Maximum number of bytes in a set for lexbor_simd_seek_set().
+ */
+#define LEXBOR_SIMD_SET_MAX 16
+
+
+typedef enum {
+    LEXBOR_SIMD_NONE  = 0x00,
+    LEXBOR_SIMD_SSE2  = 0x01,
+    LEXBOR_SIMD_SSE42 = 0x02,
+    LEXBOR_SIMD_AVX2  = 0x04,
+    LEXBOR_SIMD_NEON  = 0x08,
+    LEXBOR_SIMD_ALL   = 0xFF
+}
+lexbor_simd_opt_t;
+
+
+/*
+ * Detects CPU features and selects the widest available kernels.
+ *
+ * With GCC, Clang and MSVC it is called when the library is loaded; with
+ * other compilers the portable kernels are used until it is called.
+ *
+ * This function and lexbor_simd_use() change process-wide state: call them
+ * before other threads use the library.
+ */
+LXB_API void
+lexbor_simd_init(void);
+
+/*
+ * Returns a mask of lexbor_simd_opt_t supported by the current CPU and
+ * compiled into the library.
+ */
+LXB_API unsigned int
+lexbor_simd_supported(void);
+
+/*
+ * Restricts kernels to the given lexbor_simd_opt_t mask.
+ * LEXBOR_SIMD_NONE forces the portable SWAR code.
+ *
+ * Returns the mask actually in use, that is, opt & lexbor_simd_supported().
+ */
+LXB_API unsigned int
+lexbor_simd_use(unsigned int opt);
+
+/*
+ * Returns the mask of lexbor_simd_opt_t whose kernels are in use now.
+ * LEXBOR_SIMD_NONE means the portable SWAR code.
+ *
+ * The kernels are selected once, when the library is loaded (see
+ * lexbor_simd_init()), and change only on a later lexbor_simd_use() call.
+ */
+LXB_API unsigned int
+lexbor_simd_active(void);
+
+/*
+ * The functions below return a pointer to the first byte in [data, end)
+ * equal to one of the given bytes, or end if there is no such byte.
+ */
+LXB_API const lxb_char_t *
+lexbor_simd_seek3(const lxb_char_t *data, const lxb_char_t *end,
+                  lxb_char_t c1, lxb_char_t c2, lxb_char_t c3);
+
+LXB_API const lxb_char_t *
+lexbor_simd_seek4(const lxb_char_t *data, const lxb_char_t *end,
+                  lxb_char_t c1, lxb_char_t c2, lxb_char_t c3, lxb_char_t c4);
+
+/*
+ * The set must contain from 1 to LEXBOR_SIMD_SET_MAX bytes.
+ */
+LXB_API const lxb_char_t *
+lexbor_simd_seek_set(const lxb_char_t *data, const lxb_char_t *end,
+                     const lxb_char_t *set, size_t length);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SIMD_H */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_THREAD_H
+#define LEXBOR_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/core/base.h"
+
+
+typedef void
+(*lexbor_thread_f)(void *ctx);
+
+
+/*
+ * Runs the function in a new thread.
+ *
+ * Returns NULL if the thread could not be started, or if lexbor is built
+ * with LEXBOR_WITHOUT_THREADS; the caller is then expected to run
+ * the function by itself.
+ */
+LXB_API void *
+lexbor_thread_create(lexbor_thread_f func, void *ctx);
+
+/* Waits for the thread to finish and frees it. */
+LXB_API void
+lexbor_thread_join(void *thread);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_THREAD_H */
@@ -14,6 +14,7 @@ extern "C" {
 
 #include "lexbor/core/base.h"
 #include "lexbor/core/mraw.h"
+#include "lexbor/core/dobject.h"
 #include "lexbor/core/str.h"
 
 
@@ -28,14 +29,26 @@ extern "C" {
 
 
 typedef struct lxb_css_memory {
-    lexbor_dobject_t *objs;
-    lexbor_mraw_t    *mraw;
-    lexbor_mraw_t    *tree;
+    lexbor_dobject_t  *objs;
+    lexbor_mraw_t     *mraw;
+    lexbor_mraw_t     *tree;
 
-    size_t           ref_count;
+    size_t            ref_count;
+
+    /* All pools above. */
+    lexbor_mem_stat_t stat;
 }
 lxb_css_memory_t;
 
+typedef struct {
+    lexbor_mem_usage_t total;
+
+    lexbor_mem_usage_t objs;
+    lexbor_mem_usage_t mraw;
+    lexbor_mem_usage_t tree;
+}
+lxb_css_memory_usage_t;
+
 typedef uint32_t lxb_css_type_t;
 
 typedef struct lxb_css_parser lxb_css_parser_t;
@@ -128,6 +141,16 @@ lxb_css_memory_ref_dec(lxb_css_memory_t *memory);
 LXB_API lxb_css_memory_t *
 lxb_css_memory_ref_dec_destroy(lxb_css_memory_t *memory);
 
+/*
+ * Bytes held by the pools, in total and per pool. Pools not created yet
+ * are reported as zero.
+ */
+LXB_API void
+lxb_css_memory_usage(lxb_css_memory_t *memory, lxb_css_memory_usage_t *usage);
+
+LXB_API void
+lxb_css_memory_peak_reset(lxb_css_memory_t *memory);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -46,6 +46,9 @@ lxb_css_memory_init(lxb_css_memory_t *memory, size_t prepare_count)
         if (status != LXB_STATUS_OK) {
             goto failed;
         }
+
+        lexbor_mem_stat_parent_set(lexbor_dobject_stat(memory->objs),
+                                   &memory->stat);
     }
 
     if (memory->tree == NULL) {
@@ -56,6 +59,9 @@ lxb_css_memory_init(lxb_css_memory_t *memory, size_t prepare_count)
         if (status != LXB_STATUS_OK) {
             goto failed;
         }
+
+        lexbor_mem_stat_parent_set(lexbor_mraw_stat(memory->tree),
+                                   &memory->stat);
     }
 
     if (memory->mraw == NULL) {
@@ -64,6 +70,9 @@ lxb_css_memory_init(lxb_css_memory_t *memory, size_t prepare_count)
         if (status != LXB_STATUS_OK) {
             goto failed;
         }
+
+        lexbor_mem_stat_parent_set(lexbor_mraw_stat(memory->mraw),
+                                   &memory->stat);
     }
 
     memory->ref_count = 1;
@@ -119,6 +128,44 @@ lxb_css_memory_destroy(lxb_css_memory_t *memory, bool self_destroy)
     return memory;
 }
 
+void
+lxb_css_memory_usage(lxb_css_memory_t *memory, lxb_css_memory_usage_t *usage)
+{
+    memset(usage, 0, sizeof(lxb_css_memory_usage_t));
+
+    usage->total = lexbor_mem_stat_usage(&memory->stat);
+
+    if (memory->objs != NULL) {
+        usage->objs = lexbor_mem_stat_usage(lexbor_dobject_stat(memory->objs));
+    }
+
+    if (memory->mraw != NULL) {
+        usage->mraw = lexbor_mem_stat_usage(lexbor_mraw_stat(memory->mraw));
+    }
+
+    if (memory->tree != NULL) {
+        usage->tree = lexbor_mem_stat_usage(lexbor_mraw_stat(memory->tree));
+    }
+}
+
+void
+lxb_css_memory_peak_reset(lxb_css_memory_t *memory)
+{
+    lexbor_mem_stat_peak_reset(&memory->stat);
+
+    if (memory->objs != NULL) {
+        lexbor_mem_stat_peak_reset(lexbor_dobject_stat(memory->objs));
+    }
+
+    if (memory->mraw != NULL) {
+        lexbor_mem_stat_peak_reset(lexbor_mraw_stat(memory->mraw));
+    }
+
+    if (memory->tree != NULL) {
+        lexbor_mem_stat_peak_reset(lexbor_mraw_stat(memory->tree));
+    }
+}
+
 lxb_css_memory_t *
 lxb_css_memory_ref_inc(lxb_css_memory_t *memory)
 {
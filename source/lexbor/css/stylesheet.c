@@ -109,3 +109,10 @@ lxb_css_stylesheet_parse(lxb_css_stylesheet_t *sst, lxb_css_parser_t *parser,
 
     return LXB_STATUS_OK;
 }
+
+void
+lxb_css_stylesheet_memory_usage(lxb_css_stylesheet_t *sst,
+                                lxb_css_memory_usage_t *usage)
+{
+    lxb_css_memory_usage(sst->memory, usage);
+}
@@ -82,6 +82,19 @@ LXB_API lxb_status_t
 lxb_css_stylesheet_parse(lxb_css_stylesheet_t *sst, lxb_css_parser_t *parser,
                          const lxb_char_t *data, size_t length);
 
+/*
+ * Get the memory usage of the stylesheet.
+ *
+ * The usage is of the stylesheet's memory pool. Stylesheets created with
+ * the same lxb_css_memory_t share it and report the same numbers.
+ *
+ * @param[in] sst     Required. The stylesheet.
+ * @param[out] usage  Required. Total and per-pool bytes with peaks.
+ */
+LXB_API void
+lxb_css_stylesheet_memory_usage(lxb_css_stylesheet_t *sst,
+                                lxb_css_memory_usage_t *usage);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
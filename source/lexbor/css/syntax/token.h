@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 #include "lexbor/core/str.h"
+#include "lexbor/core/dobject.h"
 
 #include "lexbor/css/log.h"
 #include "lexbor/css/syntax/base.h"
@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 #include "lexbor/core/array_obj.h"
+#include "lexbor/core/dobject.h"
 
 #include "lexbor/css/syntax/base.h"
 #include "lexbor/css/syntax/token.h"
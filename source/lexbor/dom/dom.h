@@ -10,6 +10,7 @@
 #include "lexbor/dom/base.h"
 #include "lexbor/dom/interface.h"
 #include "lexbor/dom/collection.h"
+#include "lexbor/dom/index.h"
 #include "lexbor/dom/exception.h"
 #include "lexbor/dom/interfaces/shadow_root.h"
 #include "lexbor/dom/interfaces/attr.h"
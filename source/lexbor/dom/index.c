@@ -0,0 +1,710 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/dom/index.h"
+#include "lexbor/dom/interfaces/document.h"
+#include "lexbor/dom/interfaces/element.h"
+
+
+static bool
+lxb_dom_index_id_is(lxb_dom_element_t *element,
+                    const lxb_char_t *id, size_t length);
+
+static bool
+lxb_dom_index_precedes(const lxb_dom_node_t *first,
+                       const lxb_dom_node_t *second);
+
+
+lxb_dom_index_t *
+lxb_dom_index_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_dom_index_t));
+}
+
+lxb_status_t
+lxb_dom_index_init(lxb_dom_index_t *index, lxb_dom_document_t *document,
+                   lxb_dom_index_opt_t opt)
+{
+    lxb_status_t status;
+
+    if (index == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    index->opt = opt;
+    index->document = document;
+    index->stale = true;
+
+    index->ids = lexbor_allocator_calloc(document->allocator, 1,
+                                         sizeof(lexbor_hash_t));
+    status = lexbor_hash_init_allocator(index->ids, 128,
+                                        sizeof(lxb_dom_index_id_t),
+                                        document->allocator);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lexbor_mem_stat_parent_set(lexbor_hash_stat(index->ids),
+                               &document->memory);
+
+    index->links = lexbor_allocator_calloc(document->allocator, 1,
+                                           sizeof(lexbor_dobject_t));
+    status = lexbor_dobject_init_allocator(index->links, 256,
+                                           sizeof(lxb_dom_index_link_t),
+                                           document->allocator);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lexbor_mem_stat_parent_set(lexbor_dobject_stat(index->links),
+                               &document->memory);
+
+    if ((opt & (LXB_DOM_INDEX_OPT_TAG|LXB_DOM_INDEX_OPT_CLASS)) == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    index->items = lexbor_allocator_calloc(document->allocator, 1,
+                                           sizeof(lexbor_dobject_t));
+    status = lexbor_dobject_init_allocator(index->items, 1024,
+                                           sizeof(lxb_dom_index_item_t),
+                                           document->allocator);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lexbor_mem_stat_parent_set(lexbor_dobject_stat(index->items),
+                               &document->memory);
+
+    if (opt & LXB_DOM_INDEX_OPT_TAG) {
+        index->tags = lexbor_allocator_calloc(document->allocator, 1,
+                                              sizeof(lexbor_hash_t));
+        status = lexbor_hash_init_allocator(index->tags, 128,
+                                            sizeof(lxb_dom_index_list_t),
+                                            document->allocator);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        lexbor_mem_stat_parent_set(lexbor_hash_stat(index->tags),
+                                   &document->memory);
+    }
+
+    if (opt & LXB_DOM_INDEX_OPT_CLASS) {
+        index->classes = lexbor_allocator_calloc(document->allocator, 1,
+                                                 sizeof(lexbor_hash_t));
+        status = lexbor_hash_init_allocator(index->classes, 128,
+                                            sizeof(lxb_dom_index_list_t),
+                                            document->allocator);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        lexbor_mem_stat_parent_set(lexbor_hash_stat(index->classes),
+                                   &document->memory);
+    }
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_dom_index_clean(lxb_dom_index_t *index)
+{
+    lexbor_hash_clean(index->ids);
+    lexbor_dobject_clean(index->links);
+
+    if (index->items != NULL) {
+        lexbor_dobject_clean(index->items);
+    }
+
+    if (index->tags != NULL) {
+        lexbor_hash_clean(index->tags);
+    }
+
+    if (index->classes != NULL) {
+        lexbor_hash_clean(index->classes);
+    }
+
+    index->stale = true;
+    index->nodes = 0;
+    index->walked = 0;
+}
+
+/* The pools are made with the allocator of the document. */
+static lexbor_hash_t *
+lxb_dom_index_hash_destroy(lxb_dom_index_t *index, lexbor_hash_t *hash)
+{
+    if (hash == NULL) {
+        return NULL;
+    }
+
+    (void) lexbor_hash_destroy(hash, false);
+
+    return lexbor_allocator_free(index->document->allocator, hash);
+}
+
+static lexbor_dobject_t *
+lxb_dom_index_dobject_destroy(lxb_dom_index_t *index,
+                              lexbor_dobject_t *dobject)
+{
+    if (dobject == NULL) {
+        return NULL;
+    }
+
+    (void) lexbor_dobject_destroy(dobject, false);
+
+    return lexbor_allocator_free(index->document->allocator, dobject);
+}
+
+lxb_dom_index_t *
+lxb_dom_index_destroy(lxb_dom_index_t *index, bool self_destroy)
+{
+    if (index == NULL) {
+        return NULL;
+    }
+
+    index->ids = lxb_dom_index_hash_destroy(index, index->ids);
+    index->links = lxb_dom_index_dobject_destroy(index, index->links);
+
+    index->tags = lxb_dom_index_hash_destroy(index, index->tags);
+    index->classes = lxb_dom_index_hash_destroy(index, index->classes);
+    index->items = lxb_dom_index_dobject_destroy(index, index->items);
+
+    if (self_destroy) {
+        return lexbor_free(index);
+    }
+
+    return index;
+}
+
+static lxb_status_t
+lxb_dom_index_element_add(lxb_dom_index_t *index, lxb_dom_element_t *element)
+{
+    size_t length;
+    const lxb_char_t *id;
+
+    if ((index->opt & LXB_DOM_INDEX_OPT_ID) == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    id = lxb_dom_element_id(element, &length);
+    if (id == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    return lxb_dom_index_id_add(index, element, id, length);
+}
+
+lxb_status_t
+lxb_dom_index_build(lxb_dom_index_t *index, lxb_dom_node_t *root)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *node = root;
+
+    while (node != NULL) {
+        if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            status = lxb_dom_index_element_add(index,
+                                               lxb_dom_interface_element(node));
+            if (status != LXB_STATUS_OK) {
+                return status;
+            }
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_dom_index_id_add(lxb_dom_index_t *index, lxb_dom_element_t *element,
+                     const lxb_char_t *id, size_t length)
+{
+    lxb_dom_index_id_t *entry;
+    lxb_dom_index_link_t *link;
+
+    if ((index->opt & LXB_DOM_INDEX_OPT_ID) == 0 || length == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    entry = lexbor_hash_insert(index->ids, lexbor_hash_insert_raw, id, length);
+    if (entry == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    for (link = entry->first; link != NULL; link = link->next) {
+        if (link->element == element) {
+            return LXB_STATUS_OK;
+        }
+    }
+
+    link = lexbor_dobject_alloc(index->links);
+    if (link == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    link->element = element;
+    link->next = entry->first;
+
+    entry->first = link;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_dom_index_id_remove(lxb_dom_index_t *index, lxb_dom_element_t *element,
+                        const lxb_char_t *id, size_t length)
+{
+    lxb_dom_index_id_t *entry;
+    lxb_dom_index_link_t *link, **prev;
+
+    if ((index->opt & LXB_DOM_INDEX_OPT_ID) == 0 || length == 0) {
+        return;
+    }
+
+    entry = lexbor_hash_search(index->ids, lexbor_hash_search_raw, id, length);
+    if (entry == NULL) {
+        return;
+    }
+
+    prev = &entry->first;
+
+    for (link = entry->first; link != NULL; link = link->next) {
+        if (link->element == element) {
+            *prev = link->next;
+
+            lexbor_dobject_free(index->links, link);
+            break;
+        }
+
+        prev = &link->next;
+    }
+
+    if (entry->first == NULL) {
+        lexbor_hash_remove(index->ids, lexbor_hash_search_raw, id, length);
+    }
+}
+
+void
+lxb_dom_index_element_remove(lxb_dom_index_t *index,
+                             lxb_dom_element_t *element)
+{
+    size_t length;
+    const lxb_char_t *id;
+
+    id = lxb_dom_element_id(element, &length);
+    if (id != NULL) {
+        lxb_dom_index_id_remove(index, element, id, length);
+    }
+}
+
+lxb_dom_element_t *
+lxb_dom_index_by_id(lxb_dom_index_t *index, lxb_dom_node_t *root,
+                    const lxb_char_t *id, size_t length)
+{
+    lxb_dom_element_t *found;
+    lxb_dom_index_id_t *entry;
+    lxb_dom_index_link_t *link;
+
+    entry = lexbor_hash_search(index->ids, lexbor_hash_search_raw, id, length);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    found = NULL;
+
+    for (link = entry->first; link != NULL; link = link->next) {
+        if (!lxb_dom_index_id_is(link->element, id, length)
+            || !lxb_dom_index_below(root, lxb_dom_interface_node(link->element)))
+        {
+            continue;
+        }
+
+        if (found == NULL
+            || lxb_dom_index_precedes(lxb_dom_interface_node(link->element),
+                                      lxb_dom_interface_node(found)))
+        {
+            found = link->element;
+        }
+    }
+
+    return found;
+}
+
+static lxb_status_t
+lxb_dom_index_list_append(lxb_dom_index_t *index, lexbor_hash_t *hash,
+                          const lexbor_hash_insert_t *insert,
+                          const lxb_char_t *key, size_t length,
+                          lxb_dom_element_t *element, size_t order)
+{
+    lxb_dom_index_list_t *list;
+    lxb_dom_index_item_t *item;
+
+    list = lexbor_hash_insert(hash, insert, key, length);
+    if (list == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    /* The same class twice in one attribute, differing in case. */
+    if (list->last != NULL && list->last->element == element) {
+        return LXB_STATUS_OK;
+    }
+
+    item = lexbor_dobject_alloc(index->items);
+    if (item == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    item->element = element;
+    item->next = NULL;
+    item->order = order;
+
+    if (list->last != NULL) {
+        list->last->next = item;
+    }
+    else {
+        list->first = item;
+    }
+
+    list->last = item;
+    list->length++;
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+lxb_dom_index_classes_add(lxb_dom_index_t *index, lxb_dom_element_t *element,
+                          size_t order)
+{
+    size_t i;
+    lxb_status_t status;
+    const lxb_dom_element_class_t *cls;
+
+    for (i = 0; i < element->classes_length; i++) {
+        cls = element->classes[i];
+
+        if (index->quirks) {
+            cls = cls->lower;
+        }
+
+        status = lxb_dom_index_list_append(index, index->classes,
+                                           lexbor_hash_insert_raw,
+                                           (const lxb_char_t *) &cls,
+                                           sizeof(cls), element, order);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_dom_index_update(lxb_dom_index_t *index)
+{
+    bool quirks;
+    size_t order;
+    lxb_status_t status;
+    lxb_dom_node_t *node, *root;
+    lxb_dom_element_t *element;
+
+    quirks = index->document->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    if ((!index->stale && index->quirks == quirks) || index->items == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    lexbor_dobject_clean(index->items);
+
+    if (index->tags != NULL) {
+        lexbor_hash_clean(index->tags);
+    }
+
+    if (index->classes != NULL) {
+        lexbor_hash_clean(index->classes);
+    }
+
+    index->stale = true;
+    index->quirks = quirks;
+    index->nodes = 0;
+    index->walked = 0;
+
+    order = 0;
+    root = lxb_dom_interface_node(index->document);
+    node = root->first_child;
+
+    while (node != NULL) {
+        index->nodes++;
+
+        if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            element = lxb_dom_interface_element(node);
+
+            if (index->tags != NULL) {
+                status = lxb_dom_index_list_append(index, index->tags,
+                                        lexbor_hash_insert_raw,
+                                        (const lxb_char_t *) &node->local_name,
+                                        sizeof(lxb_tag_id_t), element, order);
+                if (status != LXB_STATUS_OK) {
+                    return status;
+                }
+            }
+
+            if (index->classes != NULL) {
+                status = lxb_dom_index_classes_add(index, element, order);
+                if (status != LXB_STATUS_OK) {
+                    return status;
+                }
+            }
+
+            order++;
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    index->stale = false;
+
+    return LXB_STATUS_OK;
+}
+
+/* The number of descendants of root, counted up to the limit. */
+static size_t
+lxb_dom_index_count(const lxb_dom_node_t *root, size_t limit)
+{
+    size_t count = 0;
+    const lxb_dom_node_t *node = root->first_child;
+
+    while (node != NULL && count < limit) {
+        count++;
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    return count;
+}
+
+lxb_status_t
+lxb_dom_index_ready(lxb_dom_index_t *index, const lxb_dom_node_t *root)
+{
+    size_t budget;
+    bool quirks;
+
+    quirks = index->document->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    if ((!index->stale && index->quirks == quirks) || index->items == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    if (root != lxb_dom_interface_node(index->document)
+        && index->walked < index->nodes)
+    {
+        budget = index->nodes - index->walked;
+
+        index->walked += lxb_dom_index_count(root, budget);
+
+        if (index->walked < index->nodes) {
+            return LXB_STATUS_NEXT;
+        }
+    }
+
+    return lxb_dom_index_update(index);
+}
+
+bool
+lxb_dom_index_subtree_less(const lxb_dom_node_t *root, size_t limit)
+{
+    return lxb_dom_index_count(root, limit) < limit;
+}
+
+const lxb_dom_index_list_t *
+lxb_dom_index_tag(lxb_dom_index_t *index, lxb_tag_id_t tag_id)
+{
+    if (index->tags == NULL) {
+        return NULL;
+    }
+
+    return lexbor_hash_search(index->tags, lexbor_hash_search_raw,
+                              (const lxb_char_t *) &tag_id,
+                              sizeof(lxb_tag_id_t));
+}
+
+const lxb_dom_index_list_t *
+lxb_dom_index_class(lxb_dom_index_t *index,
+                    const lxb_char_t *name, size_t length)
+{
+    const lxb_dom_element_class_t *cls;
+
+    if (index->classes == NULL || length == 0) {
+        return NULL;
+    }
+
+    cls = lxb_dom_element_class_by_name(index->document, name, length,
+                                        index->quirks);
+    if (cls == NULL) {
+        return NULL;
+    }
+
+    return lexbor_hash_search(index->classes, lexbor_hash_search_raw,
+                              (const lxb_char_t *) &cls, sizeof(cls));
+}
+
+bool
+lxb_dom_index_in_tree(lxb_dom_index_t *index, const lxb_dom_node_t *node)
+{
+    const lxb_dom_node_t *child, *root;
+
+    root = lxb_dom_interface_node(index->document);
+
+    if (node == root) {
+        return true;
+    }
+
+    while (node->parent != NULL && node->parent != root) {
+        node = node->parent;
+    }
+
+    if (node->parent == NULL) {
+        return false;
+    }
+
+    /*
+     * The root of a parsed fragment points to the document
+     * without being its child.
+     */
+    for (child = root->first_child; child != NULL; child = child->next) {
+        if (child == node) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool
+lxb_dom_index_id_is(lxb_dom_element_t *element,
+                    const lxb_char_t *id, size_t length)
+{
+    size_t len;
+    const lxb_char_t *value;
+
+    value = lxb_dom_element_id(element, &len);
+
+    return value != NULL && len == length
+           && lexbor_str_data_ncmp(value, id, length);
+}
+
+bool
+lxb_dom_index_below(const lxb_dom_node_t *root, const lxb_dom_node_t *node)
+{
+    for (node = node->parent; node != NULL; node = node->parent) {
+        if (node == root) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static size_t
+lxb_dom_index_depth(const lxb_dom_node_t *node)
+{
+    size_t depth = 0;
+
+    for (node = node->parent; node != NULL; node = node->parent) {
+        depth++;
+    }
+
+    return depth;
+}
+
+static bool
+lxb_dom_index_precedes(const lxb_dom_node_t *first,
+                       const lxb_dom_node_t *second)
+{
+    size_t f_depth, s_depth;
+
+    f_depth = lxb_dom_index_depth(first);
+    s_depth = lxb_dom_index_depth(second);
+
+    /* An ancestor precedes its descendants. */
+    while (f_depth > s_depth) {
+        first = first->parent;
+        f_depth--;
+
+        if (first == second) {
+            return false;
+        }
+    }
+
+    while (s_depth > f_depth) {
+        second = second->parent;
+        s_depth--;
+
+        if (second == first) {
+            return true;
+        }
+    }
+
+    while (first->parent != second->parent) {
+        first = first->parent;
+        second = second->parent;
+    }
+
+    for (first = first->next; first != NULL; first = first->next) {
+        if (first == second) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+void
+lxb_dom_index_stale_noi(lxb_dom_index_t *index)
+{
+    lxb_dom_index_stale(index);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_DOM_INDEX_H
+#define LEXBOR_DOM_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/core/hash.h"
+#include "lexbor/core/dobject.h"
+
+#include "lexbor/dom/interface.h"
+
+
+typedef unsigned int lxb_dom_index_opt_t;
+
+enum lxb_dom_index_opt {
+    LXB_DOM_INDEX_OPT_UNDEF = 0x00,
+    LXB_DOM_INDEX_OPT_ID    = 1 << 0,
+    LXB_DOM_INDEX_OPT_TAG   = 1 << 1,
+    LXB_DOM_INDEX_OPT_CLASS = 1 << 2
+};
+
+typedef struct lxb_dom_index_link lxb_dom_index_link_t;
+
+struct lxb_dom_index_link {
+    lxb_dom_element_t    *element;
+    lxb_dom_index_link_t *next;
+};
+
+/* All elements that were given the same id. */
+typedef struct {
+    lexbor_hash_entry_t  entry;
+    lxb_dom_index_link_t *first;
+}
+lxb_dom_index_id_t;
+
+typedef struct lxb_dom_index_item lxb_dom_index_item_t;
+
+struct lxb_dom_index_item {
+    lxb_dom_element_t    *element;
+    lxb_dom_index_item_t *next;
+    size_t               order;  /* Position of the element in tree order. */
+};
+
+/* All elements with the same tag or class, in tree order. */
+typedef struct {
+    lexbor_hash_entry_t  entry;
+    lxb_dom_index_item_t *first;
+    lxb_dom_index_item_t *last;
+    size_t               length;
+}
+lxb_dom_index_list_t;
+
+/*
+ * Document index, see lxb_dom_document_index_set().
+ *
+ * The index is told about ids given to elements by the DOM functions
+ * (attribute append, set value, remove) and about inserted and destroyed
+ * elements. Lookups check every candidate against the tree, so an element
+ * that left the tree or changed its id is never returned.
+ *
+ * Tag and class lists are not kept up to date one by one: any change of
+ * the tree or of a class attribute marks them stale, and
+ * lxb_dom_index_update() builds them again in one pass over the document.
+ * Queries go through lxb_dom_index_ready(), which walks instead of building
+ * while that is cheaper, see there.
+ */
+typedef struct {
+    lxb_dom_index_opt_t      opt;
+    lxb_dom_document_t       *document;
+
+    lexbor_hash_t            *ids;
+    lexbor_dobject_t         *links;
+
+    lexbor_hash_t            *tags;
+    lexbor_hash_t            *classes;
+    lexbor_dobject_t         *items;
+    bool                     quirks;
+    bool                     stale;
+
+    size_t                   nodes;   /* Visited by the last build. */
+    size_t                   walked;  /* Walked by queries since stale. */
+}
+lxb_dom_index_t;
+
+
+LXB_API lxb_dom_index_t *
+lxb_dom_index_create(void);
+
+/*
+ * Pools are created with the document allocator and counted in its memory.
+ * The index is empty; see lxb_dom_index_build() to fill it.
+ */
+LXB_API lxb_status_t
+lxb_dom_index_init(lxb_dom_index_t *index, lxb_dom_document_t *document,
+                   lxb_dom_index_opt_t opt);
+
+LXB_API void
+lxb_dom_index_clean(lxb_dom_index_t *index);
+
+LXB_API lxb_dom_index_t *
+lxb_dom_index_destroy(lxb_dom_index_t *index, bool self_destroy);
+
+/* Adds the elements of the root subtree, root inclusive. */
+LXB_API lxb_status_t
+lxb_dom_index_build(lxb_dom_index_t *index, lxb_dom_node_t *root);
+
+LXB_API lxb_status_t
+lxb_dom_index_id_add(lxb_dom_index_t *index, lxb_dom_element_t *element,
+                     const lxb_char_t *id, size_t length);
+
+LXB_API void
+lxb_dom_index_id_remove(lxb_dom_index_t *index, lxb_dom_element_t *element,
+                        const lxb_char_t *id, size_t length);
+
+/* For the element being destroyed. */
+LXB_API void
+lxb_dom_index_element_remove(lxb_dom_index_t *index,
+                             lxb_dom_element_t *element);
+
+/*
+ * The first element in tree order below root with the given id,
+ * as lxb_dom_node_by_id() finds it.
+ */
+LXB_API lxb_dom_element_t *
+lxb_dom_index_by_id(lxb_dom_index_t *index, lxb_dom_node_t *root,
+                    const lxb_char_t *id, size_t length);
+
+/*
+ * Builds the tag and class lists again if they are stale.
+ * Must be called before lxb_dom_index_tag() and lxb_dom_index_class().
+ */
+LXB_API lxb_status_t
+lxb_dom_index_update(lxb_dom_index_t *index);
+
+/*
+ * Whether a query below root can use the tag and class lists.
+ *
+ * Fresh lists can.  Stale lists are built again once the queries walking
+ * instead since the lists went stale have visited as many nodes as the last
+ * build did, and right away for the document itself.  Until then the query
+ * is charged with the nodes below root and should walk them: with changes
+ * between queries no query costs more than twice the walk.
+ *
+ * @return LXB_STATUS_OK if the lists are up to date, LXB_STATUS_NEXT if
+ * the caller should walk, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_dom_index_ready(lxb_dom_index_t *index, const lxb_dom_node_t *root);
+
+/*
+ * Whether root has fewer than limit descendants: then walking them is
+ * cheaper than going through a list of limit elements.  Stops counting at
+ * the limit.
+ */
+LXB_API bool
+lxb_dom_index_subtree_less(const lxb_dom_node_t *root, size_t limit);
+
+/* Elements with the tag (local name), or NULL if there are none. */
+LXB_API const lxb_dom_index_list_t *
+lxb_dom_index_tag(lxb_dom_index_t *index, lxb_tag_id_t tag_id);
+
+/*
+ * Elements with the class, or NULL if there are none.
+ * In quirks mode classes are compared case-insensitively.
+ */
+LXB_API const lxb_dom_index_list_t *
+lxb_dom_index_class(lxb_dom_index_t *index,
+                    const lxb_char_t *name, size_t length);
+
+/*
+ * Whether the node is in the indexed document tree.
+ * Elements of other trees (created, removed) are never in the lists.
+ */
+LXB_API bool
+lxb_dom_index_in_tree(lxb_dom_index_t *index, const lxb_dom_node_t *node);
+
+/* Whether the node is a descendant of root. */
+LXB_API bool
+lxb_dom_index_below(const lxb_dom_node_t *root, const lxb_dom_node_t *node);
+
+/*
+ * Inline functions.
+ */
+lxb_inline void
+lxb_dom_index_stale(lxb_dom_index_t *index)
+{
+    index->stale = true;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API void
+lxb_dom_index_stale_noi(lxb_dom_index_t *index);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_DOM_INDEX_H */
@@ -117,7 +117,7 @@ lxb_dom_attr_interface_destroy(lxb_dom_attr_t *attr)
 
     if (value != NULL) {
         if (value->data != NULL) {
-            lexbor_mraw_free(doc->text, value->data);
+            (void) lxb_dom_document_destroy_text(doc, value->data);
         }
 
         lexbor_mraw_free(doc->mraw, value);
@@ -206,10 +206,47 @@ lxb_dom_attr_set_name_ns(lxb_dom_attr_t *attr, const lxb_char_t *link,
     return LXB_STATUS_OK;
 }
 
+/*
+ * The new id is added before the old one is removed, so on failure
+ * the element stays indexed under the old id.
+ */
+static lxb_status_t
+lxb_dom_attr_index_id(lxb_dom_document_t *doc, lxb_dom_attr_t *attr,
+                      const lxb_char_t *old, size_t old_len)
+{
+    lxb_status_t status;
+    const lexbor_str_t *value = attr->value;
+
+    if (doc->index == NULL || attr->owner == NULL
+        || attr->owner->attr_id != attr)
+    {
+        return LXB_STATUS_OK;
+    }
+
+    if (old != NULL && old_len == value->length
+        && (old_len == 0 || memcmp(old, value->data, old_len) == 0))
+    {
+        return LXB_STATUS_OK;
+    }
+
+    status = lxb_dom_index_id_add(doc->index, attr->owner,
+                                  value->data, value->length);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    if (old != NULL) {
+        lxb_dom_index_id_remove(doc->index, attr->owner, old, old_len);
+    }
+
+    return LXB_STATUS_OK;
+}
+
 lxb_status_t
 lxb_dom_attr_set_value(lxb_dom_attr_t *attr,
                        const lxb_char_t *value, size_t value_len)
 {
+    lxb_status_t status;
     lexbor_str_t old_value, *new_value;
     lxb_dom_document_t *doc = lxb_dom_interface_node(attr)->owner_document;
 
@@ -232,6 +269,24 @@ lxb_dom_attr_set_value(lxb_dom_attr_t *attr,
 
     new_value->data[value_len] = 0x00;
     new_value->length = value_len;
+    doc->changes++;
+
+    if (attr->owner != NULL && attr->owner->attr_class == attr) {
+        status = lxb_dom_element_classes_update(attr->owner);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (doc->index != NULL) {
+            lxb_dom_index_stale(doc->index);
+        }
+    }
+
+    status = lxb_dom_attr_index_id(doc, attr, old_value.data,
+                                   old_value.length);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
 
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
         && doc->attr_mutation->change != NULL && attr->owner != NULL)
@@ -243,7 +298,7 @@ lxb_dom_attr_set_value(lxb_dom_attr_t *attr,
     }
 
     if (old_value.data != NULL) {
-        lexbor_mraw_free(doc->text, old_value.data);
+        (void) lxb_dom_document_destroy_text(doc, old_value.data);
     }
 
     return LXB_STATUS_OK;
@@ -253,19 +308,31 @@ lxb_status_t
 lxb_dom_attr_set_value_wo_copy(lxb_dom_attr_t *attr,
                                lxb_char_t *value, size_t value_len)
 {
-    if (attr->value == NULL) {
-        lxb_dom_document_t *doc = lxb_dom_interface_node(attr)->owner_document;
+    lexbor_str_t old_value;
+    lxb_dom_document_t *doc = lxb_dom_interface_node(attr)->owner_document;
 
-        attr->value = lexbor_mraw_alloc(doc->mraw, sizeof(lexbor_str_t));
+    if (attr->value == NULL) {
+        attr->value = lexbor_mraw_calloc(doc->mraw, sizeof(lexbor_str_t));
         if (attr->value == NULL) {
             return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         }
     }
 
+    old_value = *attr->value;
+
     attr->value->data = value;
     attr->value->length = value_len;
+    doc->changes++;
 
-    return LXB_STATUS_OK;
+    if (attr->owner != NULL && attr->owner->attr_class == attr) {
+        if (doc->index != NULL) {
+            lxb_dom_index_stale(doc->index);
+        }
+
+        return lxb_dom_element_classes_update(attr->owner);
+    }
+
+    return lxb_dom_attr_index_id(doc, attr, old_value.data, old_value.length);
 }
 
 lxb_status_t
@@ -334,15 +401,27 @@ lxb_dom_attr_remove(lxb_dom_attr_t *attr)
     }
 
     doc = lxb_dom_interface_node(attr)->owner_document;
+    doc->changes++;
 
     old_value = NULL;
     old_value_len = 0;
 
     if (element->attr_id == attr) {
+        if (doc->index != NULL && attr->value != NULL) {
+            lxb_dom_index_id_remove(doc->index, element, attr->value->data,
+                                    attr->value->length);
+        }
+
         element->attr_id = NULL;
     }
     else if (element->attr_class == attr) {
+        if (doc->index != NULL) {
+            lxb_dom_index_stale(doc->index);
+        }
+
         element->attr_class = NULL;
+
+        (void) lxb_dom_element_classes_update(element);
     }
 
     if (attr->prev != NULL) {
@@ -388,8 +467,8 @@ lxb_dom_attr_local_name_append(lexbor_hash_t *hash,
         return NULL;
     }
 
-    entry = lexbor_shs_entry_get_lower_static(lxb_dom_attr_res_shs_data,
-                                              name, length);
+    entry = lexbor_shs_perfect_get_lower_static(&lxb_dom_attr_res_phs_data,
+                                                name, length);
     if (entry != NULL) {
         return entry->value;
     }
@@ -454,8 +533,8 @@ lxb_dom_attr_data_by_local_name(lexbor_hash_t *hash,
         return NULL;
     }
 
-    entry = lexbor_shs_entry_get_lower_static(lxb_dom_attr_res_shs_data,
-                                              name, length);
+    entry = lexbor_shs_perfect_get_lower_static(&lxb_dom_attr_res_phs_data,
+                                                name, length);
     if (entry != NULL) {
         return entry->value;
     }
@@ -169,95 +169,150 @@ static const lxb_dom_attr_data_t lxb_dom_attr_res_data_default[LXB_DOM_ATTR__LAS
      LXB_DOM_ATTR_XMLNS, 1, true}
 };
 
-static const lexbor_shs_entry_t lxb_dom_attr_res_shs_data[86] = 
+static const lexbor_shs_entry_t lxb_dom_attr_res_shs_data[86] =
 {
-    {NULL, NULL, 85, 0}, 
-    {"#undef", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR__UNDEF], 6, 2}, 
-    {"nohref", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOHREF], 6, 0}, 
-    {"enctype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ENCTYPE], 7, 4}, 
-    {"http-equiv", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTTP_EQUIV], 10, 0}, 
-    {"readonly", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_READONLY], 8, 8}, 
-    {"focus", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOCUS], 5, 0}, 
-    {"lang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANG], 4, 1}, 
-    {"direction", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIRECTION], 9, 0}, 
-    {"valuetype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALUETYPE], 9, 0}, 
-    {"xmlns", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_XMLNS], 5, 0}, 
-    {"frame", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FRAME], 5, 12}, 
-    {"width", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_WIDTH], 5, 0}, 
-    {"public", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PUBLIC], 6, 0}, 
-    {"shape", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SHAPE], 5, 15}, 
-    {"style", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_STYLE], 5, 0}, 
-    {"active", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACTIVE], 6, 0}, 
-    {"system", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SYSTEM], 6, 0}, 
-    {"is", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_IS], 2, 0}, 
-    {"hreflang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREFLANG], 8, 0}, 
-    {"hover", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HOVER], 5, 0}, 
-    {"class", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLASS], 5, 0}, 
-    {"href", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREF], 4, 0}, 
-    {"target", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TARGET], 6, 0}, 
-    {"src", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SRC], 3, 3}, 
-    {"slot", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SLOT], 4, 5}, 
-    {"compact", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COMPACT], 7, 28}, 
-    {"pool", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_POOL], 4, 0}, 
-    {"content", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CONTENT], 7, 0}, 
-    {"alink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALINK], 5, 0}, 
-    {"nowrap", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOWRAP], 6, 0}, 
-    {"language", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANGUAGE], 8, 0}, 
-    {"valign", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALIGN], 6, 0}, 
-    {"media", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MEDIA], 5, 0}, 
-    {"height", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HEIGHT], 6, 35}, 
-    {"noshade", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOSHADE], 7, 0}, 
-    {"align", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALIGN], 5, 10}, 
-    {"noresize", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NORESIZE], 8, 0}, 
-    {"declare", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DECLARE], 7, 0}, 
-    {"face", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FACE], 4, 0}, 
-    {"size", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SIZE], 4, 11}, 
-    {"scope", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCOPE], 5, 14}, 
-    {"scheme", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCHEME], 6, 0}, 
-    {"disabled", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DISABLED], 8, 0}, 
-    {"required", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REQUIRED], 8, 0}, 
-    {"multiple", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MULTIPLE], 8, 0}, 
-    {"text", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TEXT], 4, 0}, 
-    {"rev", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REV], 3, 19}, 
-    {"alt", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALT], 3, 23}, 
-    {"charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHARSET], 7, 26}, 
-    {"selected", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SELECTED], 8, 0}, 
-    {"accept", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT], 6, 0}, 
-    {"rel", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REL], 3, 30}, 
-    {"id", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ID], 2, 0}, 
-    {"color", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COLOR], 5, 0}, 
-    {"for", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOR], 3, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {"checked", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHECKED], 7, 31}, 
-    {"accept-charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT_CHARSET], 14, 0}, 
-    {"scrolling", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCROLLING], 9, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {"method", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_METHOD], 6, 0}, 
-    {"html", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTML], 4, 34}, 
-    {"bgcolor", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_BGCOLOR], 7, 37}, 
-    {NULL, NULL, 0, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {"dir", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIR], 3, 43}, 
-    {NULL, NULL, 0, 0}, 
-    {"defer", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DEFER], 5, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {"placeholder", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PLACEHOLDER], 11, 0}, 
-    {"maxlength", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MAXLENGTH], 9, 0}, 
-    {"axis", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_AXIS], 4, 0}, 
-    {"rules", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_RULES], 5, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {NULL, NULL, 0, 0}, 
-    {"vlink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VLINK], 5, 50}, 
-    {"clear", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLEAR], 5, 54}, 
-    {"type", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TYPE], 4, 0}, 
-    {"title", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TITLE], 5, 0}, 
-    {"link", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LINK], 4, 0}, 
-    {NULL, NULL, 0, 0}, 
+    {NULL, NULL, 85, 0},
+    {"#undef", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR__UNDEF], 6, 2},
+    {"nohref", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOHREF], 6, 0},
+    {"enctype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ENCTYPE], 7, 4},
+    {"http-equiv", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTTP_EQUIV], 10, 0},
+    {"readonly", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_READONLY], 8, 8},
+    {"focus", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOCUS], 5, 0},
+    {"lang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANG], 4, 1},
+    {"direction", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIRECTION], 9, 0},
+    {"valuetype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALUETYPE], 9, 0},
+    {"xmlns", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_XMLNS], 5, 0},
+    {"frame", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FRAME], 5, 12},
+    {"width", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_WIDTH], 5, 0},
+    {"public", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PUBLIC], 6, 0},
+    {"shape", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SHAPE], 5, 15},
+    {"style", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_STYLE], 5, 0},
+    {"active", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACTIVE], 6, 0},
+    {"system", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SYSTEM], 6, 0},
+    {"is", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_IS], 2, 0},
+    {"hreflang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREFLANG], 8, 0},
+    {"hover", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HOVER], 5, 0},
+    {"class", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLASS], 5, 0},
+    {"href", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREF], 4, 0},
+    {"target", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TARGET], 6, 0},
+    {"src", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SRC], 3, 3},
+    {"slot", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SLOT], 4, 5},
+    {"compact", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COMPACT], 7, 28},
+    {"pool", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_POOL], 4, 0},
+    {"content", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CONTENT], 7, 0},
+    {"alink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALINK], 5, 0},
+    {"nowrap", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOWRAP], 6, 0},
+    {"language", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANGUAGE], 8, 0},
+    {"valign", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALIGN], 6, 0},
+    {"media", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MEDIA], 5, 0},
+    {"height", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HEIGHT], 6, 35},
+    {"noshade", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOSHADE], 7, 0},
+    {"align", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALIGN], 5, 10},
+    {"noresize", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NORESIZE], 8, 0},
+    {"declare", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DECLARE], 7, 0},
+    {"face", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FACE], 4, 0},
+    {"size", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SIZE], 4, 11},
+    {"scope", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCOPE], 5, 14},
+    {"scheme", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCHEME], 6, 0},
+    {"disabled", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DISABLED], 8, 0},
+    {"required", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REQUIRED], 8, 0},
+    {"multiple", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MULTIPLE], 8, 0},
+    {"text", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TEXT], 4, 0},
+    {"rev", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REV], 3, 19},
+    {"alt", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALT], 3, 23},
+    {"charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHARSET], 7, 26},
+    {"selected", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SELECTED], 8, 0},
+    {"accept", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT], 6, 0},
+    {"rel", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REL], 3, 30},
+    {"id", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ID], 2, 0},
+    {"color", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COLOR], 5, 0},
+    {"for", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOR], 3, 0},
+    {NULL, NULL, 0, 0},
+    {NULL, NULL, 0, 0},
+    {"checked", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHECKED], 7, 31},
+    {"accept-charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT_CHARSET], 14, 0},
+    {"scrolling", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCROLLING], 9, 0},
+    {NULL, NULL, 0, 0},
+    {"method", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_METHOD], 6, 0},
+    {"html", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTML], 4, 34},
+    {"bgcolor", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_BGCOLOR], 7, 37},
+    {NULL, NULL, 0, 0},
+    {NULL, NULL, 0, 0},
+    {NULL, NULL, 0, 0},
+    {NULL, NULL, 0, 0},
+    {"dir", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIR], 3, 43},
+    {NULL, NULL, 0, 0},
+    {"defer", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DEFER], 5, 0},
+    {NULL, NULL, 0, 0},
+    {"placeholder", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PLACEHOLDER], 11, 0},
+    {"maxlength", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MAXLENGTH], 9, 0},
+    {"axis", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_AXIS], 4, 0},
+    {"rules", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_RULES], 5, 0},
+    {NULL, NULL, 0, 0},
+    {NULL, NULL, 0, 0},
+    {"vlink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VLINK], 5, 50},
+    {"clear", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLEAR], 5, 54},
+    {"type", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TYPE], 4, 0},
+    {"title", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TITLE], 5, 0},
+    {"link", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LINK], 4, 0},
+    {NULL, NULL, 0, 0},
     {"codetype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CODETYPE], 8, 0}
 };
 
+static const lexbor_shs_entry_t lxb_dom_attr_res_phs_data_entries[73] =
+{
+    {"accept", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT], 6, 0}, {"clear", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLEAR], 5, 0},
+    {"lang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANG], 4, 0}, {"hover", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HOVER], 5, 0},
+    {"target", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TARGET], 6, 0}, {"selected", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SELECTED], 8, 0},
+    {"noresize", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NORESIZE], 8, 0}, {"for", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOR], 3, 0},
+    {"align", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALIGN], 5, 0}, {"href", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREF], 4, 0},
+    {"readonly", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_READONLY], 8, 0}, {"scrolling", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCROLLING], 9, 0},
+    {"id", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ID], 2, 0}, {"maxlength", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MAXLENGTH], 9, 0},
+    {"alink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALINK], 5, 0}, {"declare", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DECLARE], 7, 0},
+    {"compact", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COMPACT], 7, 0}, {"checked", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHECKED], 7, 0},
+    {"type", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TYPE], 4, 0}, {"public", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PUBLIC], 6, 0},
+    {"scheme", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCHEME], 6, 0}, {"slot", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SLOT], 4, 0},
+    {"media", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MEDIA], 5, 0}, {"#undef", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR__UNDEF], 6, 0},
+    {"nowrap", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOWRAP], 6, 0}, {"link", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LINK], 4, 0},
+    {"xmlns", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_XMLNS], 5, 0}, {"placeholder", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_PLACEHOLDER], 11, 0},
+    {"size", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SIZE], 4, 0}, {"accept-charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACCEPT_CHARSET], 14, 0},
+    {"codetype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CODETYPE], 8, 0}, {"valign", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALIGN], 6, 0},
+    {"class", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CLASS], 5, 0}, {"system", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SYSTEM], 6, 0},
+    {"charset", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CHARSET], 7, 0}, {"width", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_WIDTH], 5, 0},
+    {"content", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_CONTENT], 7, 0}, {"direction", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIRECTION], 9, 0},
+    {"src", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SRC], 3, 0}, {"multiple", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_MULTIPLE], 8, 0},
+    {"face", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FACE], 4, 0}, {"frame", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FRAME], 5, 0},
+    {"disabled", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DISABLED], 8, 0}, {"noshade", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOSHADE], 7, 0},
+    {"valuetype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VALUETYPE], 9, 0}, {"pool", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_POOL], 4, 0},
+    {"required", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REQUIRED], 8, 0}, {"rev", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REV], 3, 0},
+    {"bgcolor", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_BGCOLOR], 7, 0}, {"enctype", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ENCTYPE], 7, 0},
+    {"nohref", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_NOHREF], 6, 0}, {"http-equiv", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTTP_EQUIV], 10, 0},
+    {"rules", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_RULES], 5, 0}, {"alt", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ALT], 3, 0},
+    {"color", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_COLOR], 5, 0}, {"vlink", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_VLINK], 5, 0},
+    {"method", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_METHOD], 6, 0}, {"scope", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SCOPE], 5, 0},
+    {"height", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HEIGHT], 6, 0}, {"shape", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_SHAPE], 5, 0},
+    {"title", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TITLE], 5, 0}, {"axis", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_AXIS], 4, 0},
+    {"is", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_IS], 2, 0}, {"defer", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DEFER], 5, 0},
+    {"rel", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_REL], 3, 0}, {"focus", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_FOCUS], 5, 0},
+    {"active", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_ACTIVE], 6, 0}, {"text", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_TEXT], 4, 0},
+    {"html", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HTML], 4, 0}, {"dir", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_DIR], 3, 0},
+    {"hreflang", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_HREFLANG], 8, 0}, {"language", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_LANGUAGE], 8, 0},
+    {"style", (void *) &lxb_dom_attr_res_data_default[LXB_DOM_ATTR_STYLE], 5, 0}
+};
+
+static const uint16_t lxb_dom_attr_res_phs_data_displace[32] =
+{
+    0x0004, 0x0001, 0x0000, 0x0003, 0x0009, 0x0005, 0x0011, 0x0000,
+    0x0003, 0x0001, 0x0002, 0x0006, 0x0000, 0x0003, 0x0001, 0x000a,
+    0x0000, 0x0010, 0x0000, 0x0003, 0x0018, 0x0001, 0x001e, 0x0033,
+    0x0021, 0x0006, 0x0001, 0x0073, 0x000f, 0x0029, 0x0003, 0x0016
+};
+
+static const lexbor_shs_perfect_t lxb_dom_attr_res_phs_data =
+{
+    lxb_dom_attr_res_phs_data_entries, lxb_dom_attr_res_phs_data_displace,
+    73, 27, 14
+};
+
 
 #endif /* LXB_DOM_ATTR_RES_H */
@@ -58,7 +58,9 @@ lxb_dom_character_data_interface_destroy(lxb_dom_character_data_t *character_dat
 
     (void) lxb_dom_node_interface_destroy(node);
 
-    lexbor_str_destroy(&data, doc->text, false);
+    if (data.data != NULL) {
+        (void) lxb_dom_document_destroy_text(doc, data.data);
+    }
 
     return NULL;
 }
@@ -91,8 +93,12 @@ lxb_dom_character_data_replace(lxb_dom_character_data_t *ch_data,
                                const lxb_char_t *data, size_t len,
                                size_t offset, size_t count)
 {
-    if (ch_data->data.data == NULL) {
-        lexbor_str_init(&ch_data->data, ch_data->node.owner_document->text, len);
+    lxb_dom_document_t *doc = ch_data->node.owner_document;
+
+    if (ch_data->data.data == NULL
+        || lxb_dom_document_input_contains(doc, ch_data->data.data, 0))
+    {
+        lexbor_str_init(&ch_data->data, doc->text, len);
         if (ch_data->data.data == NULL) {
             return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         }
@@ -100,8 +106,7 @@ lxb_dom_character_data_replace(lxb_dom_character_data_t *ch_data,
     else if (lexbor_str_size(&ch_data->data) < len) {
         const lxb_char_t *data;
 
-        data = lexbor_str_realloc(&ch_data->data,
-                                  ch_data->node.owner_document->text, (len + 1));
+        data = lexbor_str_realloc(&ch_data->data, doc->text, (len + 1));
         if (data == NULL) {
             return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         }
@@ -111,6 +116,7 @@ lxb_dom_character_data_replace(lxb_dom_character_data_t *ch_data,
 
     ch_data->data.data[len] = 0x00;
     ch_data->data.length = len;
+    doc->changes++;
 
     return LXB_STATUS_OK;
 }
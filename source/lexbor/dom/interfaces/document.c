@@ -83,6 +83,85 @@ lxb_dom_document_create(lxb_dom_document_t *owner)
     return lexbor_calloc(1, sizeof(lxb_dom_document_t));
 }
 
+/*
+ * The memory pools of the document are made and freed with its allocator,
+ * their control structures included.
+ */
+static lexbor_mraw_t *
+lxb_dom_document_mraw_destroy(lxb_dom_document_t *document,
+                              lexbor_mraw_t *mraw)
+{
+    if (mraw == NULL) {
+        return NULL;
+    }
+
+    (void) lexbor_mraw_destroy(mraw, false);
+
+    return lexbor_allocator_free(document->allocator, mraw);
+}
+
+static lexbor_mraw_t *
+lxb_dom_document_mraw_make(lxb_dom_document_t *document, size_t chunk_size)
+{
+    lxb_status_t status;
+    lexbor_mraw_t *mraw;
+
+    mraw = lexbor_allocator_calloc(document->allocator, 1,
+                                   sizeof(lexbor_mraw_t));
+    status = lexbor_mraw_init_allocator(mraw, chunk_size,
+                                        document->allocator);
+    if (status != LXB_STATUS_OK) {
+        return lxb_dom_document_mraw_destroy(document, mraw);
+    }
+
+    lexbor_mem_stat_parent_set(lexbor_mraw_stat(mraw), &document->memory);
+
+    return mraw;
+}
+
+static lexbor_hash_t *
+lxb_dom_document_hash_destroy(lxb_dom_document_t *document,
+                              lexbor_hash_t *hash)
+{
+    if (hash == NULL) {
+        return NULL;
+    }
+
+    (void) lexbor_hash_destroy(hash, false);
+
+    return lexbor_allocator_free(document->allocator, hash);
+}
+
+static void
+lxb_dom_document_index_destroy(lxb_dom_document_t *document)
+{
+    if (document->index != NULL) {
+        (void) lxb_dom_index_destroy(document->index, false);
+        document->index = lexbor_allocator_free(document->allocator,
+                                                document->index);
+    }
+}
+
+static lexbor_hash_t *
+lxb_dom_document_hash_make(lxb_dom_document_t *document,
+                           size_t table_size, size_t struct_size)
+{
+    lxb_status_t status;
+    lexbor_hash_t *hash;
+
+    hash = lexbor_allocator_calloc(document->allocator, 1,
+                                   sizeof(lexbor_hash_t));
+    status = lexbor_hash_init_allocator(hash, table_size, struct_size,
+                                        document->allocator);
+    if (status != LXB_STATUS_OK) {
+        return lxb_dom_document_hash_destroy(document, hash);
+    }
+
+    lexbor_mem_stat_parent_set(lexbor_hash_stat(hash), &document->memory);
+
+    return hash;
+}
+
 lxb_status_t
 lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
                       lxb_dom_interface_create_f create_interface,
@@ -90,7 +169,6 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
                       lxb_dom_interface_destroy_f destroy_interface,
                       lxb_dom_document_dtype_t type, unsigned int ns)
 {
-    lxb_status_t status;
     lxb_dom_node_t *node;
 
     if (document == NULL) {
@@ -115,6 +193,7 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
         document->ns = owner->ns;
         document->prefix = owner->prefix;
         document->attrs = owner->attrs;
+        document->classes = owner->classes;
         document->parser = owner->parser;
         document->user = owner->user;
         document->scripting = owner->scripting;
@@ -123,6 +202,7 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
         document->mutation = owner->mutation;
         document->attr_mutation = owner->attr_mutation;
         document->options = owner->options;
+        document->allocator = owner->allocator;
 
         document->tags_inherited = true;
         document->ns_inherited = true;
@@ -137,45 +217,47 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
     document->attr_mutation = &lxb_dom_document_attr_mutation_cbs;
     document->options = LXB_DOM_DOCUMENT_OPT_UNDEF;
 
-    /* For nodes */
-    document->mraw = lexbor_mraw_create();
-    status = lexbor_mraw_init(document->mraw, (4096 * 8));
+    lexbor_mem_stat_init(&document->memory);
 
-    if (status != LXB_STATUS_OK) {
+    /* For nodes */
+    document->mraw = lxb_dom_document_mraw_make(document, (4096 * 8));
+    if (document->mraw == NULL) {
         goto failed;
     }
 
     /* For text */
-    document->text = lexbor_mraw_create();
-    status = lexbor_mraw_init(document->text, (4096 * 12));
+    document->text = lxb_dom_document_mraw_make(document, (4096 * 12));
+    if (document->text == NULL) {
+        goto failed;
+    }
 
-    if (status != LXB_STATUS_OK) {
+    document->tags = lxb_dom_document_hash_make(document, 128,
+                                                sizeof(lxb_tag_data_t));
+    if (document->tags == NULL) {
         goto failed;
     }
 
-    document->tags = lexbor_hash_create();
-    status = lexbor_hash_init(document->tags, 128, sizeof(lxb_tag_data_t));
-    if (status != LXB_STATUS_OK) {
+    document->ns = lxb_dom_document_hash_make(document, 128,
+                                              sizeof(lxb_ns_data_t));
+    if (document->ns == NULL) {
         goto failed;
     }
 
-    document->ns = lexbor_hash_create();
-    status = lexbor_hash_init(document->ns, 128, sizeof(lxb_ns_data_t));
-    if (status != LXB_STATUS_OK) {
+    document->prefix = lxb_dom_document_hash_make(document, 128,
+                                                  sizeof(lxb_dom_attr_data_t));
+    if (document->prefix == NULL) {
         goto failed;
     }
 
-    document->prefix = lexbor_hash_create();
-    status = lexbor_hash_init(document->prefix, 128,
-                              sizeof(lxb_dom_attr_data_t));
-    if (status != LXB_STATUS_OK) {
+    document->attrs = lxb_dom_document_hash_make(document, 128,
+                                                 sizeof(lxb_dom_attr_data_t));
+    if (document->attrs == NULL) {
         goto failed;
     }
 
-    document->attrs = lexbor_hash_create();
-    status = lexbor_hash_init(document->attrs, 128,
-                              sizeof(lxb_dom_attr_data_t));
-    if (status != LXB_STATUS_OK) {
+    document->classes = lxb_dom_document_hash_make(document, 128,
+                                            sizeof(lxb_dom_element_class_t));
+    if (document->classes == NULL) {
         goto failed;
     }
 
@@ -185,36 +267,95 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
 
 failed:
 
-    lexbor_mraw_destroy(document->mraw, true);
-    lexbor_mraw_destroy(document->text, true);
-    lexbor_hash_destroy(document->tags, true);
-    lexbor_hash_destroy(document->ns, true);
-    lexbor_hash_destroy(document->attrs, true);
-    lexbor_hash_destroy(document->prefix, true);
+    document->mraw = lxb_dom_document_mraw_destroy(document, document->mraw);
+    document->text = lxb_dom_document_mraw_destroy(document, document->text);
+    document->tags = lxb_dom_document_hash_destroy(document, document->tags);
+    document->ns = lxb_dom_document_hash_destroy(document, document->ns);
+    document->attrs = lxb_dom_document_hash_destroy(document,
+                                                    document->attrs);
+    document->classes = lxb_dom_document_hash_destroy(document,
+                                                      document->classes);
+    document->prefix = lxb_dom_document_hash_destroy(document,
+                                                     document->prefix);
 
     return LXB_STATUS_ERROR;
 }
 
-lxb_status_t
-lxb_dom_document_clean(lxb_dom_document_t *document)
+lxb_inline size_t
+lxb_dom_document_retain_rest(size_t retain, size_t retained)
 {
+    return (retained < retain) ? retain - retained : 0;
+}
+
+/*
+ * Shared by clean and rewind: with rewind, memory above retain bytes is
+ * freed, otherwise everything is kept for reuse.
+ */
+static size_t
+lxb_dom_document_reset(lxb_dom_document_t *document, bool rewind,
+                       size_t retain)
+{
+    size_t retained = 0;
+
     if (lxb_dom_interface_node(document)->owner_document == document) {
-        lexbor_mraw_clean(document->mraw);
-        lexbor_mraw_clean(document->text);
-        lexbor_hash_clean(document->tags);
-        lexbor_hash_clean(document->ns);
-        lexbor_hash_clean(document->attrs);
-        lexbor_hash_clean(document->prefix);
+        if (rewind) {
+            retained += lexbor_mraw_rewind(document->mraw, retain);
+            retained += lexbor_mraw_rewind(document->text,
+                                lxb_dom_document_retain_rest(retain, retained));
+            retained += lexbor_hash_rewind(document->attrs,
+                                lxb_dom_document_retain_rest(retain, retained));
+            retained += lexbor_hash_rewind(document->classes,
+                                lxb_dom_document_retain_rest(retain, retained));
+            retained += lexbor_hash_rewind(document->tags,
+                                lxb_dom_document_retain_rest(retain, retained));
+            retained += lexbor_hash_rewind(document->ns,
+                                lxb_dom_document_retain_rest(retain, retained));
+            retained += lexbor_hash_rewind(document->prefix,
+                                lxb_dom_document_retain_rest(retain, retained));
+        }
+        else {
+            lexbor_mraw_clean(document->mraw);
+            lexbor_mraw_clean(document->text);
+            lexbor_hash_clean(document->tags);
+            lexbor_hash_clean(document->ns);
+            lexbor_hash_clean(document->attrs);
+            lexbor_hash_clean(document->classes);
+            lexbor_hash_clean(document->prefix);
+        }
+
+        lxb_dom_document_input_release(document);
+
+        if (document->index != NULL) {
+            lxb_dom_index_clean(document->index);
+        }
+
+        document->memory.exceeded = false;
+        document->changes++;
     }
 
     document->node.first_child = NULL;
     document->node.last_child = NULL;
     document->element = NULL;
     document->doctype = NULL;
+    document->compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    return retained;
+}
+
+lxb_status_t
+lxb_dom_document_clean(lxb_dom_document_t *document)
+{
+    (void) lxb_dom_document_reset(document, false, 0);
 
     return LXB_STATUS_OK;
 }
 
+size_t
+lxb_dom_document_rewind(lxb_dom_document_t *document, size_t retain)
+{
+    return lxb_dom_document_reset(document, true, retain);
+}
+
 lxb_dom_document_t *
 lxb_dom_document_destroy(lxb_dom_document_t *document)
 {
@@ -230,14 +371,103 @@ lxb_dom_document_destroy(lxb_dom_document_t *document)
         return lexbor_mraw_free(owner->mraw, document);
     }
 
-    lexbor_mraw_destroy(document->text, true);
-    lexbor_mraw_destroy(document->mraw, true);
-    lexbor_hash_destroy(document->tags, true);
-    lexbor_hash_destroy(document->ns, true);
-    lexbor_hash_destroy(document->attrs, true);
-    lexbor_hash_destroy(document->prefix, true);
+    lxb_dom_document_input_release(document);
+
+    lxb_dom_document_index_destroy(document);
+
+    lxb_dom_document_mraw_destroy(document, document->text);
+    lxb_dom_document_mraw_destroy(document, document->mraw);
+    lxb_dom_document_hash_destroy(document, document->tags);
+    lxb_dom_document_hash_destroy(document, document->ns);
+    lxb_dom_document_hash_destroy(document, document->attrs);
+    lxb_dom_document_hash_destroy(document, document->classes);
+    lxb_dom_document_hash_destroy(document, document->prefix);
+
+    return lexbor_allocator_free(document->allocator, document);
+}
+
+void
+lxb_dom_document_memory_usage(lxb_dom_document_t *document,
+                              lxb_dom_document_memory_usage_t *usage)
+{
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    usage->total = lexbor_mem_stat_usage(&document->memory);
+    usage->mraw = lexbor_mem_stat_usage(lexbor_mraw_stat(document->mraw));
+    usage->text = lexbor_mem_stat_usage(lexbor_mraw_stat(document->text));
+    usage->tags = lexbor_mem_stat_usage(lexbor_hash_stat(document->tags));
+    usage->attrs = lexbor_mem_stat_usage(lexbor_hash_stat(document->attrs));
+    usage->classes = lexbor_mem_stat_usage(lexbor_hash_stat(document->classes));
+    usage->prefix = lexbor_mem_stat_usage(lexbor_hash_stat(document->prefix));
+    usage->ns = lexbor_mem_stat_usage(lexbor_hash_stat(document->ns));
+}
+
+void
+lxb_dom_document_memory_peak_reset(lxb_dom_document_t *document)
+{
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    lexbor_mem_stat_peak_reset(&document->memory);
+    lexbor_mem_stat_peak_reset(lexbor_mraw_stat(document->mraw));
+    lexbor_mem_stat_peak_reset(lexbor_mraw_stat(document->text));
+    lexbor_mem_stat_peak_reset(lexbor_hash_stat(document->tags));
+    lexbor_mem_stat_peak_reset(lexbor_hash_stat(document->attrs));
+    lexbor_mem_stat_peak_reset(lexbor_hash_stat(document->classes));
+    lexbor_mem_stat_peak_reset(lexbor_hash_stat(document->prefix));
+    lexbor_mem_stat_peak_reset(lexbor_hash_stat(document->ns));
+}
+
+void
+lxb_dom_document_memory_limit_set(lxb_dom_document_t *document, size_t limit)
+{
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    lexbor_mem_stat_limit_set(&document->memory, limit);
+}
+
+bool
+lxb_dom_document_memory_exceeded(lxb_dom_document_t *document)
+{
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    return lexbor_mem_stat_exceeded(&document->memory);
+}
+
+lxb_status_t
+lxb_dom_document_index_set(lxb_dom_document_t *document,
+                           lxb_dom_index_opt_t opt)
+{
+    lxb_status_t status;
+
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    lxb_dom_document_index_destroy(document);
+
+    if (opt == LXB_DOM_INDEX_OPT_UNDEF) {
+        return LXB_STATUS_OK;
+    }
+
+    document->index = lexbor_allocator_calloc(document->allocator, 1,
+                                              sizeof(lxb_dom_index_t));
+
+    status = lxb_dom_index_init(document->index, document, opt);
+    if (status != LXB_STATUS_OK) {
+        goto failed;
+    }
 
-    return lexbor_free(document);
+    status = lxb_dom_index_build(document->index,
+                                 lxb_dom_interface_node(document));
+    if (status != LXB_STATUS_OK) {
+        goto failed;
+    }
+
+    return LXB_STATUS_OK;
+
+failed:
+
+    lxb_dom_document_index_destroy(document);
+
+    return status;
 }
 
 void
@@ -487,7 +717,9 @@ lxb_dom_document_import_node(lxb_dom_document_t *doc, lxb_dom_node_t *node,
             return NULL;
         }
 
-        lxb_dom_node_insert_child(curr, cnode);
+        if (lxb_dom_node_insert_child_status(curr, cnode) != LXB_STATUS_OK) {
+            return NULL;
+        }
 
         if (node->first_child != NULL) {
             node = node->first_child;
@@ -516,6 +748,68 @@ lxb_dom_document_set_default_node_cb(lxb_dom_document_t *document)
     document->mutation = &lxb_dom_document_mutation_cbs;
 }
 
+lxb_status_t
+lxb_dom_document_input_set(lxb_dom_document_t *document,
+                           const lxb_char_t *data, size_t length,
+                           lxb_dom_document_input_release_f release, void *ctx)
+{
+    lxb_dom_document_input_t *input;
+
+    input = &lxb_dom_interface_node(document)->owner_document->input;
+
+    if (input->data != NULL) {
+        return LXB_STATUS_ERROR_WRONG_STAGE;
+    }
+
+    if (data == NULL) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    input->data = data;
+    input->length = length;
+    input->release = release;
+    input->ctx = ctx;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_dom_document_input_release(lxb_dom_document_t *document)
+{
+    lxb_dom_document_input_t *input;
+
+    input = &lxb_dom_interface_node(document)->owner_document->input;
+
+    if (input->data != NULL && input->release != NULL) {
+        input->release(input->data, input->length, input->ctx);
+    }
+
+    memset(input, 0, sizeof(lxb_dom_document_input_t));
+}
+
+lxb_status_t
+lxb_dom_document_input_detach(lxb_dom_document_t *document, lexbor_str_t *str)
+{
+    lexbor_str_t copy;
+
+    if (str->data == NULL
+        || !lxb_dom_document_input_contains(document, str->data, 0))
+    {
+        return LXB_STATUS_OK;
+    }
+
+    copy.data = NULL;
+    copy.length = 0;
+
+    if (lexbor_str_copy(&copy, str, document->text) == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    *str = copy;
+
+    return LXB_STATUS_OK;
+}
+
 
 /*
  * No inline functions for ABI.
@@ -591,3 +885,28 @@ lxb_dom_document_opt_noi(lxb_dom_document_t *document)
 {
     return lxb_dom_document_opt(document);
 }
+
+void
+lxb_dom_document_allocator_set_noi(lxb_dom_document_t *document,
+                                   const lexbor_allocator_t *allocator)
+{
+    lxb_dom_document_allocator_set(document, allocator);
+}
+
+const lexbor_allocator_t *
+lxb_dom_document_allocator_noi(lxb_dom_document_t *document)
+{
+    return lxb_dom_document_allocator(document);
+}
+
+lxb_dom_index_t *
+lxb_dom_document_index_noi(lxb_dom_document_t *document)
+{
+    return lxb_dom_document_index(document);
+}
+
+size_t
+lxb_dom_document_changes_noi(const lxb_dom_document_t *document)
+{
+    return lxb_dom_document_changes(document);
+}
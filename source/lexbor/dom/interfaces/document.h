@@ -15,6 +15,7 @@ extern "C" {
 #include "lexbor/core/hash.h"
 
 #include "lexbor/dom/interface.h"
+#include "lexbor/dom/index.h"
 #include "lexbor/dom/interfaces/node.h"
 #include "lexbor/dom/interfaces/element.h"
 
@@ -36,10 +37,29 @@ lxb_dom_document_dtype_t;
 typedef uint32_t lxb_dom_document_opt_t;
 
 enum lxb_dom_document_opt {
-    LXB_DOM_DOCUMENT_OPT_UNDEF     = 0x00,
-    LXB_DOM_DOCUMENT_OPT_WO_EVENTS = 1 << 0
+    LXB_DOM_DOCUMENT_OPT_UNDEF        = 0x00,
+    LXB_DOM_DOCUMENT_OPT_WO_EVENTS    = 1 << 0,
+    LXB_DOM_DOCUMENT_OPT_BORROW_INPUT = 1 << 1
 };
 
+typedef void
+(*lxb_dom_document_input_release_f)(const lxb_char_t *data, size_t length,
+                                    void *ctx);
+
+/*
+ * Caller-owned input buffer.
+ * With LXB_DOM_DOCUMENT_OPT_BORROW_INPUT text nodes and attribute values
+ * may point into it instead of being copied into the document memory.
+ */
+typedef struct {
+    const lxb_char_t                 *data;
+    size_t                           length;
+
+    lxb_dom_document_input_release_f release;
+    void                             *ctx;
+}
+lxb_dom_document_input_t;
+
 typedef struct lxb_dom_document_css lxb_dom_document_css_t;
 
 /* 4.2.3. Mutation algorithms. */
@@ -61,6 +81,19 @@ typedef struct {
 }
 lxb_dom_document_attr_mutation_cb_t;
 
+typedef struct {
+    lexbor_mem_usage_t total;
+
+    lexbor_mem_usage_t mraw;
+    lexbor_mem_usage_t text;
+    lexbor_mem_usage_t tags;
+    lexbor_mem_usage_t attrs;
+    lexbor_mem_usage_t classes;
+    lexbor_mem_usage_t prefix;
+    lexbor_mem_usage_t ns;
+}
+lxb_dom_document_memory_usage_t;
+
 struct lxb_dom_document {
     lxb_dom_node_t                            node;
 
@@ -81,6 +114,7 @@ struct lxb_dom_document {
     lexbor_mraw_t                             *text;
     lexbor_hash_t                             *tags;
     lexbor_hash_t                             *attrs;
+    lexbor_hash_t                             *classes;
     lexbor_hash_t                             *prefix;
     lexbor_hash_t                             *ns;
     void                                      *parser;
@@ -89,6 +123,19 @@ struct lxb_dom_document {
     lxb_dom_document_css_t                    *css;
 
     lxb_dom_document_opt_t                    options;
+    lxb_dom_document_input_t                  input;
+
+    /* For the memory pools and the index; NULL for lexbor_malloc(). */
+    const lexbor_allocator_t                  *allocator;
+
+    /* All memory pools of the document. */
+    lexbor_mem_stat_t                         memory;
+
+    /* See lxb_dom_document_index_set(). */
+    lxb_dom_index_t                           *index;
+
+    /* Changes of the tree, see lxb_dom_document_changes(). */
+    size_t                                    changes;
 
     bool                                      tags_inherited;
     bool                                      ns_inherited;
@@ -146,9 +193,55 @@ lxb_dom_document_init(lxb_dom_document_t *document, lxb_dom_document_t *owner,
 LXB_API lxb_status_t
 lxb_dom_document_clean(lxb_dom_document_t *document);
 
+/*
+ * Like lxb_dom_document_clean(), but the memory pools keep up to retain bytes
+ * of chunks in total for the next nodes and strings. The first chunk of each
+ * pool is always kept. Returns the number of retained bytes.
+ */
+LXB_API size_t
+lxb_dom_document_rewind(lxb_dom_document_t *document, size_t retain);
+
 LXB_API lxb_dom_document_t *
 lxb_dom_document_destroy(lxb_dom_document_t *document);
 
+/*
+ * Bytes held by the memory pools of the document, in total and per pool.
+ * The peak is the maximum since the document was created or since the last
+ * lxb_dom_document_memory_peak_reset() call. For a document created with
+ * an owner the owner's usage is returned.
+ */
+LXB_API void
+lxb_dom_document_memory_usage(lxb_dom_document_t *document,
+                              lxb_dom_document_memory_usage_t *usage);
+
+LXB_API void
+lxb_dom_document_memory_peak_reset(lxb_dom_document_t *document);
+
+/*
+ * Bytes the memory pools of the document may hold, zero for no limit.
+ * Allocations over the limit fail, the parser then stops with
+ * LXB_STATUS_ERROR_MEMORY_LIMIT and keeps the nodes built so far.
+ */
+LXB_API void
+lxb_dom_document_memory_limit_set(lxb_dom_document_t *document, size_t limit);
+
+/*
+ * True if an allocation failed because of the limit since the limit was set
+ * or the document was cleaned.
+ */
+LXB_API bool
+lxb_dom_document_memory_exceeded(lxb_dom_document_t *document);
+
+/*
+ * Turns document indexes on or off, LXB_DOM_INDEX_OPT_UNDEF for off.
+ * The index is built from the current tree and kept up to date by the DOM
+ * functions; lxb_dom_element_by_id() uses it with LXB_DOM_INDEX_OPT_ID.
+ * Changes made by writing to the node structures directly are not seen.
+ */
+LXB_API lxb_status_t
+lxb_dom_document_index_set(lxb_dom_document_t *document,
+                           lxb_dom_index_opt_t opt);
+
 LXB_API void
 lxb_dom_document_mutation_init(lxb_dom_document_t *document);
 
@@ -201,6 +294,37 @@ lxb_dom_document_import_node(lxb_dom_document_t *doc, lxb_dom_node_t *node,
 LXB_API void
 lxb_dom_document_set_default_node_cb(lxb_dom_document_t *document);
 
+/*
+ * Sets the input buffer of the document.
+ *
+ * The buffer must stay valid and unchanged until the release callback is
+ * called, which happens on document clean or destroy. The release can be
+ * NULL. Only one buffer can be set between cleanings.
+ *
+ * @param[in] lxb_dom_document_t *. Not NULL.
+ * @param[in] Buffer.
+ * @param[in] Buffer length.
+ * @param[in] Release callback. Can be NULL.
+ * @param[in] Context for the release callback.
+ *
+ * @return LXB_STATUS_OK if successful, LXB_STATUS_ERROR_WRONG_STAGE if
+ * a buffer is already set.
+ */
+LXB_API lxb_status_t
+lxb_dom_document_input_set(lxb_dom_document_t *document,
+                           const lxb_char_t *data, size_t length,
+                           lxb_dom_document_input_release_f release, void *ctx);
+
+LXB_API void
+lxb_dom_document_input_release(lxb_dom_document_t *document);
+
+/*
+ * If the string points into the input buffer, replaces it with a copy
+ * allocated from the document text memory.
+ */
+LXB_API lxb_status_t
+lxb_dom_document_input_detach(lxb_dom_document_t *document, lexbor_str_t *str);
+
 
 /*
  * Inline functions
@@ -237,9 +361,37 @@ lxb_dom_document_create_text(lxb_dom_document_t *document, size_t len)
                                             sizeof(lxb_char_t) * len);
 }
 
+/*
+ * Returns true if [data, data + length) lies in the input buffer.
+ */
+lxb_inline bool
+lxb_dom_document_input_contains(lxb_dom_document_t *document,
+                                const lxb_char_t *data, size_t length)
+{
+    const lxb_dom_document_input_t *input;
+
+    input = &lxb_dom_interface_node(document)->owner_document->input;
+
+    return input->data != NULL && data >= input->data
+           && data <= input->data + input->length
+           && length <= (size_t) (input->data + input->length - data);
+}
+
+lxb_inline bool
+lxb_dom_document_input_borrow(lxb_dom_document_t *document,
+                              const lxb_char_t *data, size_t length)
+{
+    return (document->options & LXB_DOM_DOCUMENT_OPT_BORROW_INPUT)
+           && lxb_dom_document_input_contains(document, data, length);
+}
+
 lxb_inline void *
 lxb_dom_document_destroy_text(lxb_dom_document_t *document, lxb_char_t *text)
 {
+    if (lxb_dom_document_input_contains(document, text, 0)) {
+        return NULL;
+    }
+
     return lexbor_mraw_free(document->text, text);
 }
 
@@ -286,6 +438,46 @@ lxb_dom_document_opt(lxb_dom_document_t *document)
     return document->options;
 }
 
+/*
+ * Must be called before lxb_dom_document_init().
+ * Documents created with an owner share the owner's allocator.
+ *
+ * The memory pools and the index of the document are made with the
+ * allocator, and lxb_dom_document_destroy() frees the document object with
+ * it too: allocate the object with lexbor_allocator_calloc().
+ */
+lxb_inline void
+lxb_dom_document_allocator_set(lxb_dom_document_t *document,
+                               const lexbor_allocator_t *allocator)
+{
+    document->allocator = allocator;
+}
+
+lxb_inline const lexbor_allocator_t *
+lxb_dom_document_allocator(lxb_dom_document_t *document)
+{
+    return document->allocator;
+}
+
+/* NULL if no index is turned on. */
+lxb_inline lxb_dom_index_t *
+lxb_dom_document_index(lxb_dom_document_t *document)
+{
+    return lxb_dom_interface_node(document)->owner_document->index;
+}
+
+/*
+ * Grows every time a node is inserted, removed or destroyed, an attribute
+ * is added, changed or removed, text is replaced and the document is
+ * cleaned: what was found out about the tree is out of date once the
+ * value differs.
+ */
+lxb_inline size_t
+lxb_dom_document_changes(const lxb_dom_document_t *document)
+{
+    return document->changes;
+}
+
 /*
  * No inline functions for ABI.
  */
@@ -328,6 +520,19 @@ lxb_dom_document_opt_set_noi(lxb_dom_document_t *document,
 LXB_API lxb_dom_document_opt_t
 lxb_dom_document_opt_noi(lxb_dom_document_t *document);
 
+LXB_API void
+lxb_dom_document_allocator_set_noi(lxb_dom_document_t *document,
+                                   const lexbor_allocator_t *allocator);
+
+LXB_API const lexbor_allocator_t *
+lxb_dom_document_allocator_noi(lxb_dom_document_t *document);
+
+LXB_API lxb_dom_index_t *
+lxb_dom_document_index_noi(lxb_dom_document_t *document);
+
+LXB_API size_t
+lxb_dom_document_changes_noi(const lxb_dom_document_t *document);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -73,6 +73,12 @@ lxb_dom_element_interface_destroy(lxb_dom_element_t *element)
     lxb_dom_attr_t *attr_next;
     lxb_dom_attr_t *attr = element->first_attr;
 
+    lxb_dom_document_t *doc = lxb_dom_interface_node(element)->owner_document;
+
+    if (element->classes != NULL) {
+        lexbor_mraw_free(doc->mraw, element->classes);
+    }
+
     (void) lxb_dom_node_interface_destroy(lxb_dom_interface_node(element));
 
     while (attr != NULL) {
@@ -108,7 +114,10 @@ lxb_dom_element_interface_copy(lxb_dom_element_t *dst,
             return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         }
 
-        (void) lxb_dom_element_attr_append(dst, clone);
+        status = lxb_dom_element_attr_append(dst, clone);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
 
         attr = attr->next;
     }
@@ -350,6 +359,7 @@ lxb_status_t
 lxb_dom_element_attr_append(lxb_dom_element_t *element, lxb_dom_attr_t *attr)
 {
     size_t value_len;
+    lxb_status_t status;
     const lxb_char_t *value;
     lxb_dom_attr_t *exist;
     lxb_dom_document_t *doc = lxb_dom_interface_node(element)->owner_document;
@@ -390,6 +400,30 @@ lxb_dom_element_attr_append(lxb_dom_element_t *element, lxb_dom_attr_t *attr)
 done:
 
     attr->owner = element;
+    doc->changes++;
+
+    if (element->attr_class == attr) {
+        status = lxb_dom_element_classes_update(element);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (doc->index != NULL) {
+            lxb_dom_index_stale(doc->index);
+        }
+    }
+
+    if (doc->index != NULL && element->attr_id == attr) {
+        value = lxb_dom_attr_value(attr, &value_len);
+
+        if (value != NULL) {
+            status = lxb_dom_index_id_add(doc->index, element,
+                                          value, value_len);
+            if (status != LXB_STATUS_OK) {
+                return status;
+            }
+        }
+    }
 
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
         && doc->attr_mutation->append != NULL)
@@ -830,6 +864,142 @@ lxb_dom_element_tag_name(lxb_dom_element_t *element, size_t *len)
     return lxb_dom_element_qualified_name_upper(element, len);
 }
 
+static const lxb_dom_element_class_t *
+lxb_dom_element_class_append(lexbor_hash_t *hash,
+                             const lxb_char_t *name, size_t length)
+{
+    const lxb_char_t *p, *end;
+    lxb_dom_element_class_t *cls, *lower;
+
+    cls = lexbor_hash_insert(hash, lexbor_hash_insert_raw, name, length);
+    if (cls == NULL || cls->lower != NULL) {
+        return cls;
+    }
+
+    end = name + length;
+
+    for (p = name; p < end; p++) {
+        if (*p >= 'A' && *p <= 'Z') {
+            break;
+        }
+    }
+
+    if (p == end) {
+        cls->lower = cls;
+        return cls;
+    }
+
+    lower = lexbor_hash_insert(hash, lexbor_hash_insert_lower, name, length);
+    if (lower == NULL) {
+        return NULL;
+    }
+
+    lower->lower = lower;
+    cls->lower = lower;
+
+    return cls;
+}
+
+lxb_status_t
+lxb_dom_element_classes_update(lxb_dom_element_t *element)
+{
+    size_t i, count;
+    const lxb_char_t *data, *pos, *end;
+    const lxb_dom_element_class_t *cls, **classes;
+    lxb_dom_document_t *doc = lxb_dom_interface_node(element)->owner_document;
+
+    if (element->classes != NULL) {
+        lexbor_mraw_free(doc->mraw, element->classes);
+
+        element->classes = NULL;
+        element->classes_length = 0;
+    }
+
+    if (element->attr_class == NULL || element->attr_class->value == NULL
+        || element->attr_class->value->data == NULL)
+    {
+        return LXB_STATUS_OK;
+    }
+
+    data = element->attr_class->value->data;
+    end = data + element->attr_class->value->length;
+
+    count = 0;
+
+    for (pos = data; pos < end; pos++) {
+        if (!lexbor_utils_whitespace(*pos, ==, ||)
+            && (pos == data || lexbor_utils_whitespace(pos[-1], ==, ||)))
+        {
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    classes = lexbor_mraw_alloc(doc->mraw,
+                                sizeof(lxb_dom_element_class_t *) * count);
+    if (classes == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    count = 0;
+
+    while (data < end) {
+        while (data < end && lexbor_utils_whitespace(*data, ==, ||)) {
+            data++;
+        }
+
+        pos = data;
+
+        while (data < end && !lexbor_utils_whitespace(*data, ==, ||)) {
+            data++;
+        }
+
+        if (pos == data) {
+            break;
+        }
+
+        cls = lxb_dom_element_class_append(doc->classes, pos, data - pos);
+        if (cls == NULL) {
+            lexbor_mraw_free(doc->mraw, classes);
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        for (i = 0; i < count; i++) {
+            if (classes[i] == cls) {
+                break;
+            }
+        }
+
+        if (i == count) {
+            classes[count++] = cls;
+        }
+    }
+
+    element->classes = classes;
+    element->classes_length = count;
+
+    return LXB_STATUS_OK;
+}
+
+const lxb_dom_element_class_t *
+lxb_dom_element_class_by_name(lxb_dom_document_t *document,
+                              const lxb_char_t *name, size_t length,
+                              bool lower)
+{
+    document = lxb_dom_interface_node(document)->owner_document;
+
+    if (lower) {
+        return lexbor_hash_search(document->classes, lexbor_hash_search_lower,
+                                  name, length);
+    }
+
+    return lexbor_hash_search(document->classes, lexbor_hash_search_raw,
+                              name, length);
+}
+
 
 
 /*
@@ -847,6 +1017,19 @@ lxb_dom_element_class_noi(lxb_dom_element_t *element, size_t *len)
     return lxb_dom_element_class(element, len);
 }
 
+const lxb_dom_element_class_t **
+lxb_dom_element_classes_noi(lxb_dom_element_t *element, size_t *len)
+{
+    return lxb_dom_element_classes(element, len);
+}
+
+bool
+lxb_dom_element_has_class_noi(const lxb_dom_element_t *element,
+                              const lxb_dom_element_class_t *cls, bool quirks)
+{
+    return lxb_dom_element_has_class(element, cls, quirks);
+}
+
 bool
 lxb_dom_element_is_custom_noi(lxb_dom_element_t *element)
 {
@@ -46,6 +46,16 @@ typedef enum {
 }
 lxb_dom_element_condition_t;
 
+/* Interned class name, see lxb_dom_element_classes(). */
+typedef struct lxb_dom_element_class lxb_dom_element_class_t;
+
+struct lxb_dom_element_class {
+    lexbor_hash_entry_t           entry;
+
+    /* The same name in lowercase, for quirks mode. */
+    const lxb_dom_element_class_t *lower;
+};
+
 typedef lxb_status_t
 (*lxb_dom_element_attr_change_f)(lxb_dom_element_t *element,
                                  lxb_dom_attr_id_t local_name,
@@ -72,6 +82,10 @@ struct lxb_dom_element {
     lxb_dom_attr_t                 *attr_id;
     lxb_dom_attr_t                 *attr_class;
 
+    /* The class attribute split into interned names, without repeats. */
+    const lxb_dom_element_class_t  **classes;
+    size_t                         classes_length;
+
     lexbor_avl_node_t              *style;
     void                           *list;  /* lxb_css_rule_declaration_list_t */
 
@@ -221,6 +235,23 @@ lxb_dom_element_prefix(lxb_dom_element_t *element, size_t *len);
 LXB_API const lxb_char_t *
 lxb_dom_element_tag_name(lxb_dom_element_t *element, size_t *len);
 
+/*
+ * Splits the class attribute into the interned names again.
+ * The attribute functions do it whenever the class attribute is set,
+ * changed or removed.
+ */
+LXB_API lxb_status_t
+lxb_dom_element_classes_update(lxb_dom_element_t *element);
+
+/*
+ * The interned class name, or NULL if no element has had this class.
+ * With lower, the lowercase name for quirks mode comparisons.
+ */
+LXB_API const lxb_dom_element_class_t *
+lxb_dom_element_class_by_name(lxb_dom_document_t *document,
+                              const lxb_char_t *name, size_t length,
+                              bool lower);
+
 
 /*
  * Inline functions
@@ -253,6 +284,45 @@ lxb_dom_element_class(lxb_dom_element_t *element, size_t *len)
     return lxb_dom_attr_value(element->attr_class, len);
 }
 
+lxb_inline const lxb_dom_element_class_t **
+lxb_dom_element_classes(lxb_dom_element_t *element, size_t *len)
+{
+    if (len != NULL) {
+        *len = element->classes_length;
+    }
+
+    return element->classes;
+}
+
+/*
+ * In quirks mode the class must be the lowercase name,
+ * see lxb_dom_element_class_by_name().
+ */
+lxb_inline bool
+lxb_dom_element_has_class(const lxb_dom_element_t *element,
+                          const lxb_dom_element_class_t *cls, bool quirks)
+{
+    size_t i;
+
+    if (quirks) {
+        for (i = 0; i < element->classes_length; i++) {
+            if (element->classes[i]->lower == cls) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    for (i = 0; i < element->classes_length; i++) {
+        if (element->classes[i] == cls) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 lxb_inline bool
 lxb_dom_element_is_custom(lxb_dom_element_t *element)
 {
@@ -329,6 +399,13 @@ lxb_dom_element_id_noi(lxb_dom_element_t *element, size_t *len);
 LXB_API const lxb_char_t *
 lxb_dom_element_class_noi(lxb_dom_element_t *element, size_t *len);
 
+LXB_API const lxb_dom_element_class_t **
+lxb_dom_element_classes_noi(lxb_dom_element_t *element, size_t *len);
+
+LXB_API bool
+lxb_dom_element_has_class_noi(const lxb_dom_element_t *element,
+                              const lxb_dom_element_class_t *cls, bool quirks);
+
 LXB_API bool
 lxb_dom_element_is_custom_noi(lxb_dom_element_t *element);
 
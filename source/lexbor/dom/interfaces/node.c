@@ -28,6 +28,9 @@ struct lxb_dom_node_cb_ctx {
 
     const lxb_char_t           *value;
     size_t                     value_length;
+
+    const lxb_dom_element_class_t *cls;
+    bool                       quirks;
 };
 
 typedef struct {
@@ -140,6 +143,14 @@ lxb_dom_node_interface_destroy(lxb_dom_node_t *node)
 {
     lxb_dom_document_t *doc = node->owner_document;
 
+    doc->changes++;
+
+    if (doc->index != NULL && node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+        lxb_dom_index_element_remove(doc->index,
+                                     lxb_dom_interface_element(node));
+        lxb_dom_index_stale(doc->index);
+    }
+
     return lexbor_mraw_free(doc->mraw, node);
 }
 
@@ -370,9 +381,21 @@ lxb_dom_node_name(lxb_dom_node_t *node, size_t *len)
     return NULL;
 }
 
+lxb_inline void
+lxb_dom_node_changed(lxb_dom_node_t *node)
+{
+    node->owner_document->changes++;
+
+    if (node->owner_document->index != NULL) {
+        lxb_dom_index_stale(node->owner_document->index);
+    }
+}
+
 void
 lxb_dom_node_insert_child_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_dom_node_changed(node);
+
     if (to->last_child != NULL) {
         to->last_child->next = node;
     }
@@ -387,24 +410,40 @@ lxb_dom_node_insert_child_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
     to->last_child = node;
 }
 
-void
-lxb_dom_node_insert_child(lxb_dom_node_t *to, lxb_dom_node_t *node)
+lxb_status_t
+lxb_dom_node_insert_child_status(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_status_t status = LXB_STATUS_OK;
     lxb_dom_document_t *doc = node->owner_document;
 
     lxb_dom_node_insert_child_wo_events(to, node);
 
+    /* The node is in the tree either way; a failure leaves it unindexed. */
+    if (doc->index != NULL) {
+        status = lxb_dom_index_build(doc->index, node);
+    }
+
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
         && doc->mutation->inserted != NULL)
     {
         (void) lxb_dom_node_shadow_including_descendants(node,
                                    lxb_dom_node_shadow_including_walker, doc);
     }
+
+    return status;
+}
+
+void
+lxb_dom_node_insert_child(lxb_dom_node_t *to, lxb_dom_node_t *node)
+{
+    (void) lxb_dom_node_insert_child_status(to, node);
 }
 
 void
 lxb_dom_node_insert_before_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_dom_node_changed(node);
+
     if (to->prev != NULL) {
         to->prev->next = node;
     }
@@ -421,24 +460,39 @@ lxb_dom_node_insert_before_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
     to->prev = node;
 }
 
-void
-lxb_dom_node_insert_before(lxb_dom_node_t *to, lxb_dom_node_t *node)
+lxb_status_t
+lxb_dom_node_insert_before_status(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_status_t status = LXB_STATUS_OK;
     lxb_dom_document_t *doc = node->owner_document;
 
     lxb_dom_node_insert_before_wo_events(to, node);
 
+    if (doc->index != NULL) {
+        status = lxb_dom_index_build(doc->index, node);
+    }
+
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
         && doc->mutation->inserted != NULL)
     {
         (void) lxb_dom_node_shadow_including_descendants(node,
                                     lxb_dom_node_shadow_including_walker, doc);
     }
+
+    return status;
+}
+
+void
+lxb_dom_node_insert_before(lxb_dom_node_t *to, lxb_dom_node_t *node)
+{
+    (void) lxb_dom_node_insert_before_status(to, node);
 }
 
 void
 lxb_dom_node_insert_after_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_dom_node_changed(node);
+
     if (to->next != NULL) {
         to->next->prev = node;
     }
@@ -454,18 +508,31 @@ lxb_dom_node_insert_after_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node)
     to->next = node;
 }
 
-void
-lxb_dom_node_insert_after(lxb_dom_node_t *to, lxb_dom_node_t *node)
+lxb_status_t
+lxb_dom_node_insert_after_status(lxb_dom_node_t *to, lxb_dom_node_t *node)
 {
+    lxb_status_t status = LXB_STATUS_OK;
     lxb_dom_document_t *doc = node->owner_document;
 
     lxb_dom_node_insert_after_wo_events(to, node);
 
+    if (doc->index != NULL) {
+        status = lxb_dom_index_build(doc->index, node);
+    }
+
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
         && doc->mutation->inserted != NULL) {
         (void) lxb_dom_node_shadow_including_descendants(node,
                                     lxb_dom_node_shadow_including_walker, doc);
     }
+
+    return status;
+}
+
+void
+lxb_dom_node_insert_after(lxb_dom_node_t *to, lxb_dom_node_t *node)
+{
+    (void) lxb_dom_node_insert_after_status(to, node);
 }
 
 lxb_dom_exception_code_t
@@ -677,10 +744,14 @@ lxb_dom_node_insert_node(lxb_dom_node_t *parent, lxb_dom_node_t *node,
     }
 
     if (child == NULL) {
-        lxb_dom_node_insert_child(parent, node);
+        status = lxb_dom_node_insert_child_status(parent, node);
     }
     else {
-        lxb_dom_node_insert_before(child, node);
+        status = lxb_dom_node_insert_before_status(child, node);
+    }
+
+    if (status != LXB_STATUS_OK) {
+        return LXB_DOM_EXCEPTION_ERR;
     }
 
     if (!(lxb_dom_document_opt(doc) & LXB_DOM_DOCUMENT_OPT_WO_EVENTS)
@@ -858,6 +929,8 @@ lxb_dom_node_remove_spec(lxb_dom_node_t *node, bool suppress_observers)
 void
 lxb_dom_node_remove_wo_events(lxb_dom_node_t *node)
 {
+    lxb_dom_node_changed(node);
+
     if (node->parent != NULL) {
         if (node->parent->first_child == node) {
             node->parent->first_child = node->next;
@@ -903,9 +976,7 @@ lxb_dom_node_replace_all(lxb_dom_node_t *parent, lxb_dom_node_t *node)
         lxb_dom_node_destroy_deep(parent->first_child);
     }
 
-    lxb_dom_node_insert_child(parent, node);
-
-    return LXB_STATUS_OK;
+    return lxb_dom_node_insert_child_status(parent, node);
 }
 
 void
@@ -1039,6 +1110,12 @@ lxb_dom_node_by_id(lxb_dom_node_t *root,
                    const lxb_char_t *qualified_name, size_t len)
 {
     lxb_dom_node_id_cb_ctx_t ctx;
+    lxb_dom_index_t *index = root->owner_document->index;
+
+    if (index != NULL && (index->opt & LXB_DOM_INDEX_OPT_ID) && len != 0) {
+        return lxb_dom_interface_node(lxb_dom_index_by_id(index, root,
+                                                          qualified_name, len));
+    }
 
     ctx.node = NULL;
     ctx.value = qualified_name;
@@ -1080,12 +1157,72 @@ lxb_dom_node_by_id_cb(lxb_dom_node_t *node, void *ctx)
     return LEXBOR_ACTION_OK;
 }
 
+/*
+ * Calls the walker for the listed elements below root; the walker still
+ * does all the checks, the list only skips the elements that cannot match.
+ *
+ * Returns false if the subtree is better walked: root has fewer descendants
+ * than the list has elements.
+ */
+static bool
+lxb_dom_node_by_index(lxb_dom_node_t *root, const lxb_dom_index_list_t *list,
+                      lxb_dom_node_simple_walker_f walker_cb, void *ctx)
+{
+    bool below;
+    lxb_dom_node_t *node;
+    const lxb_dom_index_item_t *item;
+
+    if (list == NULL) {
+        return true;
+    }
+
+    if (root->type == LXB_DOM_NODE_TYPE_DOCUMENT) {
+        for (item = list->first; item != NULL; item = item->next) {
+            if (walker_cb(lxb_dom_interface_node(item->element), ctx)
+                == LEXBOR_ACTION_STOP)
+            {
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    if (lxb_dom_index_subtree_less(root, list->length)) {
+        return false;
+    }
+
+    below = false;
+
+    for (item = list->first; item != NULL; item = item->next) {
+        node = lxb_dom_interface_node(item->element);
+
+        if (!lxb_dom_index_below(root, node)) {
+            /* The elements below root are next to each other in the list. */
+            if (below) {
+                break;
+            }
+
+            continue;
+        }
+
+        below = true;
+
+        if (walker_cb(node, ctx) == LEXBOR_ACTION_STOP) {
+            break;
+        }
+    }
+
+    return true;
+}
+
 lxb_status_t
 lxb_dom_node_by_tag_name(lxb_dom_node_t *root,
                          lxb_dom_collection_t *collection,
                          const lxb_char_t *qualified_name, size_t len)
 {
     lxb_status_t status;
+    lxb_dom_index_t *index;
     lxb_dom_node_cb_ctx_t cb_ctx = {0};
 
     cb_ctx.col = collection;
@@ -1107,6 +1244,26 @@ lxb_dom_node_by_tag_name(lxb_dom_node_t *root,
         return status;
     }
 
+    index = root->owner_document->index;
+
+    if (index != NULL && (index->opt & LXB_DOM_INDEX_OPT_TAG)
+        && lxb_dom_index_in_tree(index, root))
+    {
+        status = lxb_dom_index_ready(index, root);
+
+        if (status == LXB_STATUS_OK) {
+            if (lxb_dom_node_by_index(root,
+                                      lxb_dom_index_tag(index, cb_ctx.name_id),
+                                      lxb_dom_node_by_tag_name_cb, &cb_ctx))
+            {
+                return cb_ctx.status;
+            }
+        }
+        else if (status != LXB_STATUS_NEXT) {
+            return status;
+        }
+    }
+
     lxb_dom_node_simple_walk(lxb_dom_interface_node(root),
                              lxb_dom_node_by_tag_name_cb, &cb_ctx);
 
@@ -1156,6 +1313,9 @@ lxb_dom_node_by_class_name(lxb_dom_node_t *root,
                            lxb_dom_collection_t *collection,
                            const lxb_char_t *class_name, size_t len)
 {
+    lxb_status_t status;
+    lxb_dom_index_t *index;
+
     if (class_name == NULL || len == 0) {
         return LXB_STATUS_OK;
     }
@@ -1163,8 +1323,35 @@ lxb_dom_node_by_class_name(lxb_dom_node_t *root,
     lxb_dom_node_cb_ctx_t cb_ctx = {0};
 
     cb_ctx.col = collection;
-    cb_ctx.value = class_name;
-    cb_ctx.value_length = len;
+    cb_ctx.quirks = root->owner_document->compat_mode
+                    == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    /* No element has had such a class. */
+    cb_ctx.cls = lxb_dom_element_class_by_name(root->owner_document,
+                                               class_name, len, cb_ctx.quirks);
+    if (cb_ctx.cls == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    index = root->owner_document->index;
+
+    if (index != NULL && (index->opt & LXB_DOM_INDEX_OPT_CLASS)
+        && lxb_dom_index_in_tree(index, root))
+    {
+        status = lxb_dom_index_ready(index, root);
+
+        if (status == LXB_STATUS_OK) {
+            if (lxb_dom_node_by_index(root,
+                                   lxb_dom_index_class(index, class_name, len),
+                                   lxb_dom_node_by_class_name_cb, &cb_ctx))
+            {
+                return cb_ctx.status;
+            }
+        }
+        else if (status != LXB_STATUS_NEXT) {
+            return status;
+        }
+    }
 
     lxb_dom_node_simple_walk(lxb_dom_interface_node(root),
                              lxb_dom_node_by_class_name_cb, &cb_ctx);
@@ -1180,71 +1367,13 @@ lxb_dom_node_by_class_name_cb(lxb_dom_node_t *node, void *ctx)
     }
 
     lxb_dom_node_cb_ctx_t *cb_ctx = ctx;
-    lxb_dom_element_t *el = lxb_dom_interface_element(node);
 
-    if (el->attr_class == NULL
-        || el->attr_class->value == NULL
-        || el->attr_class->value->length < cb_ctx->value_length)
+    if (lxb_dom_element_has_class(lxb_dom_interface_element(node),
+                                  cb_ctx->cls, cb_ctx->quirks))
     {
-        return LEXBOR_ACTION_OK;
-    }
-
-    const lxb_char_t *data = el->attr_class->value->data;
-    size_t length = el->attr_class->value->length;
-
-    bool is_it = false;
-    const lxb_char_t *pos = data;
-    const lxb_char_t *end = data + length;
-
-    lxb_dom_document_t *doc = el->node.owner_document;
-
-    for (; data < end; data++) {
-        if (lexbor_utils_whitespace(*data, ==, ||)) {
-
-            if (pos != data && (size_t) (data - pos) == cb_ctx->value_length) {
-                if (doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS) {
-                    is_it = lexbor_str_data_ncasecmp(pos, cb_ctx->value,
-                                                     cb_ctx->value_length);
-                }
-                else {
-                    is_it = lexbor_str_data_ncmp(pos, cb_ctx->value,
-                                                 cb_ctx->value_length);
-                }
-
-                if (is_it) {
-                    cb_ctx->status = lxb_dom_collection_append(cb_ctx->col,
-                                                               node);
-                    if (cb_ctx->status != LXB_STATUS_OK) {
-                        return LEXBOR_ACTION_STOP;
-                    }
-
-                    return LEXBOR_ACTION_OK;
-                }
-            }
-
-            if ((size_t) (end - data) < cb_ctx->value_length) {
-                return LEXBOR_ACTION_OK;
-            }
-
-            pos = data + 1;
-        }
-    }
-
-    if ((size_t) (end - pos) == cb_ctx->value_length) {
-        if (doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS) {
-            is_it = lexbor_str_data_ncasecmp(pos, cb_ctx->value,
-                                             cb_ctx->value_length);
-        }
-        else {
-            is_it = lexbor_str_data_ncmp(pos, cb_ctx->value,
-                                         cb_ctx->value_length);
-        }
-
-        if (is_it) {
-            cb_ctx->status = lxb_dom_collection_append(cb_ctx->col, node);
-            if (cb_ctx->status != LXB_STATUS_OK) {
-                return LEXBOR_ACTION_STOP;
-            }
+        cb_ctx->status = lxb_dom_collection_append(cb_ctx->col, node);
+        if (cb_ctx->status != LXB_STATUS_OK) {
+            return LEXBOR_ACTION_STOP;
         }
     }
 
@@ -1598,8 +1727,8 @@ lxb_dom_node_text_content(lxb_dom_node_t *node, size_t *len)
                 goto failed;
             }
 
-            /* +1 == with null '\0' */
-            memcpy(text, ch_data->data.data, sizeof(lxb_char_t) * (length + 1));
+            memcpy(text, ch_data->data.data, sizeof(lxb_char_t) * length);
+            text[length] = 0x00;
 
             break;
         }
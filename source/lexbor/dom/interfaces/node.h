@@ -151,6 +151,20 @@ lxb_dom_node_insert_after_wo_events(lxb_dom_node_t *to, lxb_dom_node_t *node);
 LXB_API void
 lxb_dom_node_insert_after(lxb_dom_node_t *to, lxb_dom_node_t *node);
 
+/*
+ * Same as the insert functions above, but return the status of adding the
+ * inserted subtree to the document index, if any; the node is inserted
+ * either way.
+ */
+LXB_API lxb_status_t
+lxb_dom_node_insert_child_status(lxb_dom_node_t *to, lxb_dom_node_t *node);
+
+LXB_API lxb_status_t
+lxb_dom_node_insert_before_status(lxb_dom_node_t *to, lxb_dom_node_t *node);
+
+LXB_API lxb_status_t
+lxb_dom_node_insert_after_status(lxb_dom_node_t *to, lxb_dom_node_t *node);
+
 LXB_API lxb_dom_exception_code_t
 lxb_dom_node_pre_insert_validity(lxb_dom_node_t *parent, lxb_dom_node_t *node,
                                  lxb_dom_node_t *child);
@@ -31,6 +31,8 @@
 #include "lexbor/html/token.h"
 #include "lexbor/html/serialize.h"
 #include "lexbor/html/serialize_ext.h"
+#include "lexbor/html/stream.h"
+#include "lexbor/html/pool.h"
 #include "lexbor/html/common.h"
 #include "lexbor/html/interfaces/video_element.h"
 #include "lexbor/html/interfaces/data_list_element.h"
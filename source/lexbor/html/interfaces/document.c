@@ -50,6 +50,10 @@ lxb_status_t
 lxb_html_parse_chunk_prepare(lxb_html_parser_t *parser,
                              lxb_html_document_t *document);
 
+static lxb_html_document_t *
+lxb_html_document_interface_init(lxb_dom_document_t *doc,
+                                 lxb_html_document_t *document);
+
 lxb_inline lxb_status_t
 lxb_html_document_parser_prepare(lxb_html_document_t *document);
 
@@ -68,21 +72,27 @@ lxb_html_document_interface_create_handler(lxb_dom_document_t *document,
 lxb_html_document_t *
 lxb_html_document_interface_create(lxb_html_document_t *document)
 {
-    lxb_status_t status;
     lxb_dom_document_t *doc;
 
-    if (document != NULL) {
-        doc = lexbor_mraw_calloc(lxb_html_document_mraw(document),
-                                 sizeof(lxb_html_document_t));
-    }
-    else {
-        doc = lexbor_calloc(1, sizeof(lxb_html_document_t));
+    if (document == NULL) {
+        return lxb_html_document_create_with_allocator(NULL);
     }
 
+    doc = lexbor_mraw_calloc(lxb_html_document_mraw(document),
+                             sizeof(lxb_html_document_t));
     if (doc == NULL) {
         return NULL;
     }
 
+    return lxb_html_document_interface_init(doc, document);
+}
+
+static lxb_html_document_t *
+lxb_html_document_interface_init(lxb_dom_document_t *doc,
+                                 lxb_html_document_t *document)
+{
+    lxb_status_t status;
+
     status = lxb_dom_document_init(doc, lxb_dom_interface_document(document),
                                    lxb_html_document_interface_create_handler,
                                    lxb_html_interface_clone,
@@ -124,6 +134,21 @@ lxb_html_document_create(void)
     return lxb_html_document_interface_create(NULL);
 }
 
+lxb_html_document_t *
+lxb_html_document_create_with_allocator(const lexbor_allocator_t *allocator)
+{
+    lxb_dom_document_t *doc;
+
+    doc = lexbor_allocator_calloc(allocator, 1, sizeof(lxb_html_document_t));
+    if (doc == NULL) {
+        return NULL;
+    }
+
+    lxb_dom_document_allocator_set(doc, allocator);
+
+    return lxb_html_document_interface_init(doc, NULL);
+}
+
 void
 lxb_html_document_clean(lxb_html_document_t *document)
 {
@@ -135,6 +160,18 @@ lxb_html_document_clean(lxb_html_document_t *document)
     lxb_dom_document_clean(lxb_dom_interface_document(document));
 }
 
+size_t
+lxb_html_document_rewind(lxb_html_document_t *document, size_t retain)
+{
+    document->body = NULL;
+    document->head = NULL;
+    document->iframe_srcdoc = NULL;
+    document->ready_state = LXB_HTML_DOCUMENT_READY_STATE_UNDEF;
+
+    return lxb_dom_document_rewind(lxb_dom_interface_document(document),
+                                   retain);
+}
+
 lxb_html_document_t *
 lxb_html_document_destroy(lxb_html_document_t *document)
 {
@@ -184,6 +221,12 @@ lxb_html_document_parse(lxb_html_document_t *document,
     }
 
     status = lxb_html_parse_chunk_process(doc->parser, html, size);
+
+    /* All input is here, a paused chunk is resumed until done. */
+    while (status == LXB_STATUS_CONTINUE) {
+        status = lxb_html_parse_chunk_resume(doc->parser);
+    }
+
     if (status != LXB_STATUS_OK) {
         goto failed;
     }
@@ -194,11 +237,45 @@ lxb_html_document_parse(lxb_html_document_t *document,
 
 failed:
 
+    /* Keep and close the nodes built before the limit or the stop. */
+    if (status == LXB_STATUS_ERROR_MEMORY_LIMIT
+        || status == LXB_STATUS_STOPPED)
+    {
+        (void) lxb_html_parse_chunk_end(doc->parser);
+    }
+
     document->opt = opt;
 
     return status;
 }
 
+lxb_status_t
+lxb_html_document_parse_input(lxb_html_document_t *document,
+                              const lxb_char_t *html, size_t size,
+                              lxb_dom_document_input_release_f release,
+                              void *ctx)
+{
+    lxb_status_t status;
+    lxb_dom_document_t *doc;
+
+    if (document->ready_state != LXB_HTML_DOCUMENT_READY_STATE_UNDEF
+        && document->ready_state != LXB_HTML_DOCUMENT_READY_STATE_LOADING)
+    {
+        lxb_html_document_clean(document);
+    }
+
+    doc = lxb_dom_interface_document(document);
+
+    status = lxb_dom_document_input_set(doc, html, size, release, ctx);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    doc->options |= LXB_DOM_DOCUMENT_OPT_BORROW_INPUT;
+
+    return lxb_html_document_parse(document, html, size);
+}
+
 lxb_status_t
 lxb_html_document_parse_chunk_begin(lxb_html_document_t *document)
 {
@@ -225,6 +302,12 @@ lxb_html_document_parse_chunk(lxb_html_document_t *document,
                                         html, size);
 }
 
+lxb_status_t
+lxb_html_document_parse_chunk_resume(lxb_html_document_t *document)
+{
+    return lxb_html_parse_chunk_resume(document->dom_document.parser);
+}
+
 lxb_status_t
 lxb_html_document_parse_chunk_end(lxb_html_document_t *document)
 {
@@ -255,6 +338,11 @@ lxb_html_document_parse_fragment(lxb_html_document_t *document,
     }
 
     status = lxb_html_parse_fragment_chunk_process(parser, html, size);
+
+    while (status == LXB_STATUS_CONTINUE) {
+        status = lxb_html_parse_chunk_resume(parser);
+    }
+
     if (status != LXB_STATUS_OK) {
         goto failed;
     }
@@ -314,6 +402,12 @@ lxb_html_document_parser_prepare(lxb_html_document_t *document)
 
     if (doc->parser == NULL) {
         doc->parser = lxb_html_parser_create();
+        if (doc->parser == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        lxb_html_parser_allocator_set(doc->parser, doc->allocator);
+
         status = lxb_html_parser_init(doc->parser);
 
         if (status != LXB_STATUS_OK) {
@@ -370,8 +464,12 @@ lxb_html_document_title_set(lxb_html_document_t *document,
             return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         }
 
-        lxb_dom_node_insert_child(lxb_dom_interface_node(document->head),
-                                  lxb_dom_interface_node(el_title));
+        status = lxb_dom_node_insert_child_status(
+                                     lxb_dom_interface_node(document->head),
+                                     lxb_dom_interface_node(el_title));
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
     }
 
     status = lxb_dom_node_text_content_set(lxb_dom_interface_node(el_title),
@@ -66,9 +66,32 @@ lxb_html_document_interface_destroy(lxb_html_document_t *document);
 LXB_API lxb_html_document_t *
 lxb_html_document_create(void);
 
+/*
+ * Like lxb_html_document_create(), but the document takes its memory from
+ * the given allocator: the document object, its memory pools with their
+ * control structures, the document index and the chunks and temporary
+ * buffer of its parser's tokenizer.
+ *
+ * Still made with lexbor_malloc(): the free lists of lexbor_dobject_t pools
+ * (lexbor_array_t), the parser, tokenizer and tree objects, the control
+ * structures of the tokenizer pools, the tree stacks, the parse error lists
+ * and the CSS data of the document.
+ *
+ * With an arena-like allocator most memory of the document can be released
+ * at once by dropping the arena after lxb_html_document_destroy().
+ */
+LXB_API lxb_html_document_t *
+lxb_html_document_create_with_allocator(const lexbor_allocator_t *allocator);
+
 LXB_API void
 lxb_html_document_clean(lxb_html_document_t *document);
 
+/*
+ * See lxb_dom_document_rewind().
+ */
+LXB_API size_t
+lxb_html_document_rewind(lxb_html_document_t *document, size_t retain);
+
 LXB_API lxb_html_document_t *
 lxb_html_document_destroy(lxb_html_document_t *document);
 
@@ -82,6 +105,19 @@ LXB_API lxb_status_t
 lxb_html_document_parse(lxb_html_document_t *document,
                         const lxb_char_t *html, size_t size);
 
+/*
+ * Parses a caller-owned buffer that outlives the document (for example,
+ * mmap'd file). Text nodes and attribute values point into the buffer
+ * whenever the bytes need no decoding; such strings are not null-terminated.
+ * The release callback (can be NULL) is called when the document is cleaned
+ * or destroyed.
+ */
+LXB_API lxb_status_t
+lxb_html_document_parse_input(lxb_html_document_t *document,
+                              const lxb_char_t *html, size_t size,
+                              lxb_dom_document_input_release_f release,
+                              void *ctx);
+
 LXB_API lxb_status_t
 lxb_html_document_parse_chunk_begin(lxb_html_document_t *document);
 
@@ -89,6 +125,16 @@ LXB_API lxb_status_t
 lxb_html_document_parse_chunk(lxb_html_document_t *document,
                               const lxb_char_t *html, size_t size);
 
+/*
+ * With steps set on the parser of the document, see
+ * lxb_html_parser_steps_set(), lxb_html_document_parse_chunk() returns
+ * LXB_STATUS_CONTINUE at a yield point; call this until it does not.
+ * lxb_html_document_parse() and lxb_html_document_parse_fragment() do it
+ * themselves.
+ */
+LXB_API lxb_status_t
+lxb_html_document_parse_chunk_resume(lxb_html_document_t *document);
+
 LXB_API lxb_status_t
 lxb_html_document_parse_chunk_end(lxb_html_document_t *document);
 
@@ -55,7 +55,11 @@ lxb_html_element_inner_html_set(lxb_html_element_t *element,
         child = node->first_child;
 
         lxb_dom_node_remove(child);
-        lxb_dom_node_insert_child(root, child);
+
+        if (lxb_dom_node_insert_child_status(root, child) != LXB_STATUS_OK) {
+            lxb_dom_node_destroy_deep(node);
+            return NULL;
+        }
     }
 
     lxb_dom_node_destroy(node);
@@ -22,6 +22,15 @@
 static void
 lxb_html_parse_fragment_chunk_destroy(lxb_html_parser_t *parser);
 
+static lxb_status_t
+lxb_html_parser_limit_status(lxb_html_parser_t *parser, lxb_status_t status);
+
+static lxb_status_t
+lxb_html_parse_chunk_complete(lxb_html_parser_t *parser);
+
+static void
+lxb_html_parse_fragment_chunk_failed(lxb_html_parser_t *parser);
+
 
 lxb_html_parser_t *
 lxb_html_parser_create(void)
@@ -38,6 +47,12 @@ lxb_html_parser_init(lxb_html_parser_t *parser)
 
     /* Tokenizer */
     parser->tkz = lxb_html_tokenizer_create();
+    if (parser->tkz == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    lxb_html_tokenizer_allocator_set(parser->tkz, parser->allocator);
+
     lxb_status_t status = lxb_html_tokenizer_init(parser->tkz);
 
     if (status != LXB_STATUS_OK) {
@@ -74,6 +89,8 @@ lxb_html_parser_clean(lxb_html_parser_t *parser)
 
     parser->state = LXB_HTML_PARSER_STATE_BEGIN;
 
+    lxb_html_tokenizer_root(parser->tkz)->memory.exceeded = false;
+
     lxb_html_tokenizer_clean(parser->tkz);
     lxb_html_tree_clean(parser->tree);
 }
@@ -129,6 +146,7 @@ lxb_html_parse(lxb_html_parser_t *parser, const lxb_char_t *html, size_t size)
     }
 
     lxb_html_parse_chunk_process(parser, html, size);
+    lxb_html_parse_chunk_complete(parser);
     if (parser->status != LXB_STATUS_OK) {
         goto failed;
     }
@@ -142,6 +160,14 @@ lxb_html_parse(lxb_html_parser_t *parser, const lxb_char_t *html, size_t size)
 
 failed:
 
+    if (parser->status == LXB_STATUS_ERROR_MEMORY_LIMIT
+        || parser->status == LXB_STATUS_STOPPED)
+    {
+        (void) lxb_html_parse_chunk_end(parser);
+
+        return document;
+    }
+
     lxb_html_document_interface_destroy(document);
 
     return NULL;
@@ -170,6 +196,7 @@ lxb_html_parse_fragment_by_tag_id(lxb_html_parser_t *parser,
     }
 
     lxb_html_parse_fragment_chunk_process(parser, html, size);
+    lxb_html_parse_chunk_complete(parser);
     if (parser->status != LXB_STATUS_OK) {
         return NULL;
     }
@@ -284,27 +311,41 @@ lxb_status_t
 lxb_html_parse_fragment_chunk_process(lxb_html_parser_t *parser,
                                       const lxb_char_t *html, size_t size)
 {
-    if (parser->state != LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS) {
+    if (parser->state != LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS
+        || lxb_html_tokenizer_paused(parser->tkz))
+    {
         return LXB_STATUS_ERROR_WRONG_STAGE;
     }
 
     parser->status = lxb_html_tree_chunk(parser->tree, html, size);
-    if (parser->status != LXB_STATUS_OK) {
-        lxb_html_html_element_interface_destroy(lxb_html_interface_html(parser->root));
-
-        parser->state = LXB_HTML_PARSER_STATE_ERROR;
-        parser->root = NULL;
-
-        lxb_html_parse_fragment_chunk_destroy(parser);
+    if (parser->status != LXB_STATUS_OK
+        && parser->status != LXB_STATUS_CONTINUE)
+    {
+        lxb_html_parse_fragment_chunk_failed(parser);
     }
 
     return parser->status;
 }
 
+static void
+lxb_html_parse_fragment_chunk_failed(lxb_html_parser_t *parser)
+{
+    parser->status = lxb_html_parser_limit_status(parser, parser->status);
+
+    lxb_html_html_element_interface_destroy(lxb_html_interface_html(parser->root));
+
+    parser->state = LXB_HTML_PARSER_STATE_ERROR;
+    parser->root = NULL;
+
+    lxb_html_parse_fragment_chunk_destroy(parser);
+}
+
 lxb_dom_node_t *
 lxb_html_parse_fragment_chunk_end(lxb_html_parser_t *parser)
 {
-    if (parser->state != LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS) {
+    if (parser->state != LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS
+        || lxb_html_tokenizer_paused(parser->tkz))
+    {
         parser->status = LXB_STATUS_ERROR_WRONG_STAGE;
 
         return NULL;
@@ -312,6 +353,8 @@ lxb_html_parse_fragment_chunk_end(lxb_html_parser_t *parser)
 
     parser->status = lxb_html_tree_end(parser->tree);
     if (parser->status != LXB_STATUS_OK) {
+        parser->status = lxb_html_parser_limit_status(parser, parser->status);
+
         lxb_html_html_element_interface_destroy(lxb_html_interface_html(parser->root));
 
         parser->root = NULL;
@@ -387,7 +430,7 @@ lxb_html_parse_chunk_begin(lxb_html_parser_t *parser)
         lxb_html_parser_clean(parser);
     }
 
-    document = lxb_html_document_interface_create(NULL);
+    document = lxb_html_document_create_with_allocator(parser->allocator);
     if (document == NULL) {
         parser->state = LXB_HTML_PARSER_STATE_ERROR;
         parser->status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
@@ -398,6 +441,9 @@ lxb_html_parse_chunk_begin(lxb_html_parser_t *parser)
     document->dom_document.scripting = parser->tree->scripting;
     document->dom_document.options = parser->dom_opt;
 
+    lxb_dom_document_memory_limit_set(lxb_dom_interface_document(document),
+                                      parser->memory_limit);
+
     parser->status = lxb_html_parse_chunk_prepare(parser, document);
     if (parser->status != LXB_STATUS_OK) {
         return lxb_html_document_destroy(document);
@@ -410,26 +456,89 @@ lxb_status_t
 lxb_html_parse_chunk_process(lxb_html_parser_t *parser,
                              const lxb_char_t *html, size_t size)
 {
-    if (parser->state != LXB_HTML_PARSER_STATE_PROCESS) {
+    if (parser->state != LXB_HTML_PARSER_STATE_PROCESS
+        || lxb_html_tokenizer_paused(parser->tkz))
+    {
         return LXB_STATUS_ERROR_WRONG_STAGE;
     }
 
     parser->status = lxb_html_tree_chunk(parser->tree, html, size);
-    if (parser->status != LXB_STATUS_OK) {
+    if (parser->status != LXB_STATUS_OK
+        && parser->status != LXB_STATUS_CONTINUE)
+    {
+        parser->status = lxb_html_parser_limit_status(parser, parser->status);
         parser->state = LXB_HTML_PARSER_STATE_ERROR;
     }
 
     return parser->status;
 }
 
+lxb_status_t
+lxb_html_parse_chunk_resume(lxb_html_parser_t *parser)
+{
+    if ((parser->state != LXB_HTML_PARSER_STATE_PROCESS
+         && parser->state != LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS)
+        || !lxb_html_tokenizer_paused(parser->tkz))
+    {
+        return LXB_STATUS_ERROR_WRONG_STAGE;
+    }
+
+    parser->status = lxb_html_tokenizer_chunk_resume(parser->tkz);
+    if (parser->status == LXB_STATUS_OK
+        || parser->status == LXB_STATUS_CONTINUE)
+    {
+        return parser->status;
+    }
+
+    if (parser->state == LXB_HTML_PARSER_STATE_FRAGMENT_PROCESS) {
+        lxb_html_parse_fragment_chunk_failed(parser);
+    }
+    else {
+        parser->status = lxb_html_parser_limit_status(parser, parser->status);
+        parser->state = LXB_HTML_PARSER_STATE_ERROR;
+    }
+
+    return parser->status;
+}
+
+/* For the calls parsing all input at once. */
+static lxb_status_t
+lxb_html_parse_chunk_complete(lxb_html_parser_t *parser)
+{
+    while (parser->status == LXB_STATUS_CONTINUE) {
+        (void) lxb_html_parse_chunk_resume(parser);
+    }
+
+    return parser->status;
+}
+
 lxb_status_t
 lxb_html_parse_chunk_end(lxb_html_parser_t *parser)
 {
-    if (parser->state != LXB_HTML_PARSER_STATE_PROCESS) {
+    if (lxb_html_tokenizer_paused(parser->tkz)) {
         return LXB_STATUS_ERROR_WRONG_STAGE;
     }
 
+    if (parser->state != LXB_HTML_PARSER_STATE_PROCESS) {
+        if (parser->state != LXB_HTML_PARSER_STATE_ERROR
+            || (parser->status != LXB_STATUS_ERROR_MEMORY_LIMIT
+                && parser->status != LXB_STATUS_STOPPED))
+        {
+            return LXB_STATUS_ERROR_WRONG_STAGE;
+        }
+
+        /* Close what was built so far, the tree stays as it is. */
+        (void) lxb_html_tree_open_elements_pop_all(parser->tree);
+
+        lxb_html_tokenizer_tree_set(parser->tkz, parser->original_tree);
+
+        parser->state = LXB_HTML_PARSER_STATE_END;
+
+        return parser->status;
+    }
+
     parser->status = lxb_html_tree_end(parser->tree);
+    parser->status = lxb_html_parser_limit_status(parser, parser->status);
 
     if (parser->status == LXB_STATUS_OK) {
         parser->status = lxb_html_tree_open_elements_pop_all(parser->tree);
@@ -445,6 +554,57 @@ lxb_html_parse_chunk_end(lxb_html_parser_t *parser)
     return parser->status;
 }
 
+/*
+ * A failed allocation is reported as LXB_STATUS_ERROR_MEMORY_LIMIT if it
+ * was a limit of the tokenizer or of the document that stopped it.
+ */
+static lxb_status_t
+lxb_html_parser_limit_status(lxb_html_parser_t *parser, lxb_status_t status)
+{
+    lxb_dom_document_t *doc;
+
+    if (status == LXB_STATUS_OK) {
+        return status;
+    }
+
+    if (lexbor_mem_stat_exceeded(&lxb_html_tokenizer_root(parser->tkz)->memory)) {
+        return LXB_STATUS_ERROR_MEMORY_LIMIT;
+    }
+
+    if (parser->tree->document != NULL) {
+        doc = lxb_dom_interface_document(parser->tree->document);
+
+        if (lxb_dom_document_memory_exceeded(doc)) {
+            return LXB_STATUS_ERROR_MEMORY_LIMIT;
+        }
+    }
+
+    return status;
+}
+
+void
+lxb_html_parser_memory_limit_set(lxb_html_parser_t *parser, size_t limit)
+{
+    parser->memory_limit = limit;
+
+    lexbor_mem_stat_limit_set(&lxb_html_tokenizer_root(parser->tkz)->memory,
+                              limit);
+}
+
+void
+lxb_html_parser_steps_set(lxb_html_parser_t *parser, size_t steps,
+                          lxb_html_tokenizer_yield_f yield, void *ctx)
+{
+    lxb_html_tokenizer_steps_set(parser->tkz, steps, yield, ctx);
+}
+
+void
+lxb_html_parser_memory_usage(lxb_html_parser_t *parser,
+                             lxb_html_tokenizer_memory_usage_t *usage)
+{
+    lxb_html_tokenizer_memory_usage(parser->tkz, usage);
+}
+
 /*
  * No inline functions for ABI.
  */
@@ -496,3 +656,10 @@ lxb_html_parser_dom_opt_set_noi(lxb_html_parser_t *parser,
 {
     lxb_html_parser_dom_opt_set(parser, opt);
 }
+
+void
+lxb_html_parser_allocator_set_noi(lxb_html_parser_t *parser,
+                                  const lexbor_allocator_t *allocator)
+{
+    lxb_html_parser_allocator_set(parser, allocator);
+}
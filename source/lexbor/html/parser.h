@@ -28,19 +28,25 @@ typedef enum {
 lxb_html_parser_state_t;
 
 typedef struct {
-    lxb_html_tokenizer_t    *tkz;
-    lxb_html_tree_t         *tree;
-    lxb_html_tree_t         *original_tree;
+    lxb_html_tokenizer_t     *tkz;
+    lxb_html_tree_t          *tree;
+    lxb_html_tree_t          *original_tree;
 
-    lxb_dom_node_t          *root;
-    lxb_dom_node_t          *form;
+    lxb_dom_node_t           *root;
+    lxb_dom_node_t           *form;
 
-    lxb_html_parser_state_t state;
-    lxb_status_t            status;
+    lxb_html_parser_state_t  state;
+    lxb_status_t             status;
 
-    lxb_dom_document_opt_t  dom_opt;
+    lxb_dom_document_opt_t   dom_opt;
 
-    size_t                  ref_count;
+    /* For the memory pools of the parser and of the documents it creates. */
+    const lexbor_allocator_t *allocator;
+
+    /* See lxb_html_parser_memory_limit_set(). */
+    size_t                   memory_limit;
+
+    size_t                   ref_count;
 }
 lxb_html_parser_t;
 
@@ -86,6 +92,13 @@ LXB_API lxb_status_t
 lxb_html_parse_chunk_process(lxb_html_parser_t *parser,
                              const lxb_char_t *html, size_t size);
 
+/*
+ * Continues a chunk paused at a yield point, see lxb_html_parser_steps_set().
+ * Returns LXB_STATUS_CONTINUE while the chunk is not done.
+ */
+LXB_API lxb_status_t
+lxb_html_parse_chunk_resume(lxb_html_parser_t *parser);
+
 LXB_API lxb_status_t
 lxb_html_parse_chunk_end(lxb_html_parser_t *parser);
 
@@ -102,6 +115,38 @@ lxb_html_parse_fragment_chunk_process(lxb_html_parser_t *parser,
 LXB_API lxb_dom_node_t *
 lxb_html_parse_fragment_chunk_end(lxb_html_parser_t *parser);
 
+/*
+ * Yield points for lxb_html_parse_chunk_process() and
+ * lxb_html_parse_fragment_chunk_process(), see lxb_html_tokenizer_steps_set().
+ * A paused chunk returns LXB_STATUS_CONTINUE; the caller keeps the chunk
+ * unchanged and calls lxb_html_parse_chunk_resume() until it returns
+ * something else. lxb_html_parse() and lxb_html_parse_fragment() parse
+ * the whole input regardless.
+ */
+LXB_API void
+lxb_html_parser_steps_set(lxb_html_parser_t *parser, size_t steps,
+                          lxb_html_tokenizer_yield_f yield, void *ctx);
+
+/*
+ * Memory of the parser's tokenizer, see lxb_html_tokenizer_memory_usage().
+ * Nodes and strings of the parsed document are counted by the document.
+ */
+LXB_API void
+lxb_html_parser_memory_usage(lxb_html_parser_t *parser,
+                             lxb_html_tokenizer_memory_usage_t *usage);
+
+/*
+ * Zero for no limit. The limit applies to the tokenizer of the parser and,
+ * see lxb_dom_document_memory_limit_set(), to each document created by
+ * lxb_html_parse() and lxb_html_parse_chunk_begin().
+ *
+ * On LXB_STATUS_ERROR_MEMORY_LIMIT lxb_html_parse() returns the partially
+ * built document, check lxb_html_parser_status().  It does the same on
+ * LXB_STATUS_STOPPED, see lxb_html_tree_callback_element_set().
+ */
+LXB_API void
+lxb_html_parser_memory_limit_set(lxb_html_parser_t *parser, size_t limit);
+
 
 /*
  * Inline functions
@@ -155,6 +200,16 @@ lxb_html_parser_dom_opt_set(lxb_html_parser_t *parser,
     parser->dom_opt = opt;
 }
 
+/*
+ * Must be called before lxb_html_parser_init().
+ */
+lxb_inline void
+lxb_html_parser_allocator_set(lxb_html_parser_t *parser,
+                              const lexbor_allocator_t *allocator)
+{
+    parser->allocator = allocator;
+}
+
 
 /*
  * No inline functions for ABI.
@@ -184,6 +239,10 @@ LXB_API void
 lxb_html_parser_dom_opt_set_noi(lxb_html_parser_t *parser,
                                  lxb_dom_document_opt_t opt);
 
+LXB_API void
+lxb_html_parser_allocator_set_noi(lxb_html_parser_t *parser,
+                                  const lexbor_allocator_t *allocator);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/html/pool.h"
+
+
+lxb_html_document_pool_t *
+lxb_html_document_pool_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_html_document_pool_t));
+}
+
+lxb_status_t
+lxb_html_document_pool_init(lxb_html_document_pool_t *pool, size_t size,
+                            size_t retain, const lexbor_allocator_t *allocator)
+{
+    if (pool == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    if (size == 0) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    pool->documents = lexbor_malloc(sizeof(lxb_html_document_t *) * size);
+    if (pool->documents == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    pool->length = 0;
+    pool->size = size;
+    pool->retain = retain;
+    pool->allocator = allocator;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_html_document_pool_clean(lxb_html_document_pool_t *pool)
+{
+    while (pool->length != 0) {
+        pool->length--;
+
+        (void) lxb_html_document_destroy(pool->documents[pool->length]);
+    }
+}
+
+lxb_html_document_pool_t *
+lxb_html_document_pool_destroy(lxb_html_document_pool_t *pool,
+                               bool self_destroy)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    if (pool->documents != NULL) {
+        lxb_html_document_pool_clean(pool);
+
+        pool->documents = lexbor_free(pool->documents);
+    }
+
+    if (self_destroy) {
+        return lexbor_free(pool);
+    }
+
+    return pool;
+}
+
+lxb_html_document_t *
+lxb_html_document_pool_acquire(lxb_html_document_pool_t *pool)
+{
+    if (pool->length != 0) {
+        pool->length--;
+
+        return pool->documents[pool->length];
+    }
+
+    return lxb_html_document_create_with_allocator(pool->allocator);
+}
+
+void
+lxb_html_document_pool_release(lxb_html_document_pool_t *pool,
+                               lxb_html_document_t *document)
+{
+    lxb_dom_document_t *doc;
+
+    if (document == NULL) {
+        return;
+    }
+
+    doc = lxb_dom_interface_document(document);
+
+    if (pool->length >= pool->size
+        || doc->node.owner_document != doc
+        || doc->allocator != pool->allocator
+        || doc->css != NULL)
+    {
+        (void) lxb_html_document_destroy(document);
+        return;
+    }
+
+    (void) lxb_html_document_rewind(document, pool->retain);
+
+    /* Everything the user could set, back to lxb_html_document_create(). */
+    doc->user = NULL;
+    doc->options = 0;
+    doc->scripting = false;
+
+    (void) lxb_dom_document_index_set(doc, LXB_DOM_INDEX_OPT_UNDEF);
+
+    document->done = NULL;
+    document->opt = 0;
+
+    lxb_html_document_mutation_init(document);
+
+    pool->documents[pool->length] = document;
+    pool->length++;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+size_t
+lxb_html_document_pool_length_noi(lxb_html_document_pool_t *pool)
+{
+    return lxb_html_document_pool_length(pool);
+}
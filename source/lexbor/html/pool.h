@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+/*
+ * Pool of HTML documents for repeated parsing.
+ *
+ * A released document is rewound instead of destroyed: the tree is dropped,
+ * but the chunks of its memory pools, hash tables and parser stay allocated
+ * for the next document. The retain value caps the memory each idle document
+ * keeps in its pools, so one huge page does not pin its memory forever.
+ */
+
+#ifndef LEXBOR_HTML_POOL_H
+#define LEXBOR_HTML_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/html/base.h"
+#include "lexbor/html/interfaces/document.h"
+
+
+typedef struct {
+    lxb_html_document_t      **documents;
+    size_t                   length;
+    size_t                   size;
+    size_t                   retain;
+
+    const lexbor_allocator_t *allocator;
+}
+lxb_html_document_pool_t;
+
+
+LXB_API lxb_html_document_pool_t *
+lxb_html_document_pool_create(void);
+
+/*
+ * size: maximum number of idle documents, documents released over it are
+ *       destroyed.
+ * retain: maximum bytes kept in the memory pools of an idle document.
+ * allocator: for documents created by the pool, can be NULL.
+ */
+LXB_API lxb_status_t
+lxb_html_document_pool_init(lxb_html_document_pool_t *pool, size_t size,
+                            size_t retain, const lexbor_allocator_t *allocator);
+
+/*
+ * Destroys all idle documents.
+ */
+LXB_API void
+lxb_html_document_pool_clean(lxb_html_document_pool_t *pool);
+
+/*
+ * Documents taken from the pool and not released are not destroyed.
+ */
+LXB_API lxb_html_document_pool_t *
+lxb_html_document_pool_destroy(lxb_html_document_pool_t *pool,
+                               bool self_destroy);
+
+/*
+ * Returns an idle document or a new one if there are none.
+ */
+LXB_API lxb_html_document_t *
+lxb_html_document_pool_acquire(lxb_html_document_pool_t *pool);
+
+/*
+ * Rewinds the document and keeps it for lxb_html_document_pool_acquire().
+ * The user data, options and callbacks of the document are reset.
+ *
+ * The document is destroyed instead if the pool is full, if it was created
+ * with another allocator, is not an owner document or has style sheets.
+ */
+LXB_API void
+lxb_html_document_pool_release(lxb_html_document_pool_t *pool,
+                               lxb_html_document_t *document);
+
+
+/*
+ * Inline functions
+ */
+lxb_inline size_t
+lxb_html_document_pool_length(lxb_html_document_pool_t *pool)
+{
+    return pool->length;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API size_t
+lxb_html_document_pool_length_noi(lxb_html_document_pool_t *pool);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_HTML_POOL_H */
@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/html/stream.h"
+
+
+#define LXB_HTML_STREAM_ATTRS_SIZE 16
+
+
+static lxb_html_token_t *
+lxb_html_stream_token_done(lxb_html_tokenizer_t *tkz,
+                           lxb_html_token_t *token, void *ctx);
+
+static lxb_status_t
+lxb_html_stream_attrs(lxb_html_stream_t *stream, lxb_html_token_attr_t *attr);
+
+static void
+lxb_html_stream_attrs_release(lxb_html_stream_t *stream,
+                              lxb_html_token_t *token);
+
+
+lxb_html_stream_t *
+lxb_html_stream_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_html_stream_t));
+}
+
+lxb_status_t
+lxb_html_stream_init(lxb_html_stream_t *stream,
+                     lxb_html_stream_event_f callback, void *ctx)
+{
+    lxb_status_t status;
+
+    if (stream == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    if (callback == NULL) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    stream->tkz = lxb_html_tokenizer_create();
+    if (stream->tkz == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    status = lxb_html_tokenizer_init(stream->tkz);
+    if (status != LXB_STATUS_OK) {
+        goto failed;
+    }
+
+    lxb_html_tokenizer_slices_set(stream->tkz, true);
+    lxb_html_tokenizer_callback_token_done_set(stream->tkz,
+                                               lxb_html_stream_token_done,
+                                               stream);
+
+    stream->attrs_size = LXB_HTML_STREAM_ATTRS_SIZE;
+    stream->attrs = lexbor_malloc(sizeof(lxb_html_stream_attr_t)
+                                  * stream->attrs_size);
+    if (stream->attrs == NULL) {
+        status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        goto failed;
+    }
+
+    stream->callback = callback;
+    stream->ctx = ctx;
+    stream->scripting = false;
+    stream->status = LXB_STATUS_OK;
+
+    return LXB_STATUS_OK;
+
+failed:
+
+    /* Not shared yet; init may have failed before the reference was set. */
+    stream->tkz = lxb_html_tokenizer_destroy(stream->tkz);
+
+    return status;
+}
+
+void
+lxb_html_stream_clean(lxb_html_stream_t *stream)
+{
+    lxb_html_tokenizer_clean(stream->tkz);
+
+    stream->status = LXB_STATUS_OK;
+}
+
+lxb_html_stream_t *
+lxb_html_stream_destroy(lxb_html_stream_t *stream)
+{
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    stream->tkz = lxb_html_tokenizer_unref(stream->tkz);
+
+    if (stream->attrs != NULL) {
+        stream->attrs = lexbor_free(stream->attrs);
+    }
+
+    return lexbor_free(stream);
+}
+
+lxb_status_t
+lxb_html_stream_begin(lxb_html_stream_t *stream)
+{
+    stream->status = lxb_html_tokenizer_begin(stream->tkz);
+
+    return stream->status;
+}
+
+lxb_status_t
+lxb_html_stream_chunk(lxb_html_stream_t *stream,
+                      const lxb_char_t *data, size_t size)
+{
+    if (stream->status != LXB_STATUS_OK) {
+        return stream->status;
+    }
+
+    stream->status = lxb_html_tokenizer_chunk(stream->tkz, data, size);
+
+    return stream->status;
+}
+
+lxb_status_t
+lxb_html_stream_end(lxb_html_stream_t *stream)
+{
+    if (stream->status != LXB_STATUS_OK) {
+        return stream->status;
+    }
+
+    stream->status = lxb_html_tokenizer_end(stream->tkz);
+
+    return stream->status;
+}
+
+lxb_status_t
+lxb_html_stream_parse(lxb_html_stream_t *stream,
+                      const lxb_char_t *data, size_t size)
+{
+    lxb_status_t status;
+
+    status = lxb_html_stream_begin(stream);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    status = lxb_html_stream_chunk(stream, data, size);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    return lxb_html_stream_end(stream);
+}
+
+/*
+ * Text and comments that were not rewritten point into the input.
+ */
+lxb_inline void
+lxb_html_stream_str_set(lxb_html_stream_str_t *str, lxb_html_token_t *token)
+{
+    str->data = token->text_start;
+    str->length = token->text_end - token->text_start;
+    str->is_input = (token->type & LXB_HTML_TOKEN_TYPE_SLICE) != 0;
+}
+
+static lxb_html_token_t *
+lxb_html_stream_token_done(lxb_html_tokenizer_t *tkz,
+                           lxb_html_token_t *token, void *ctx)
+{
+    size_t length;
+    lxb_status_t status;
+    lxb_html_stream_t *stream = ctx;
+    lxb_html_stream_event_t *event = &stream->event;
+    lxb_html_token_attr_t *attr = token->attr_first;
+
+    static const lxb_html_stream_str_t empty = {NULL, 0, false};
+
+    event->tag_id = token->tag_id;
+    event->name = empty;
+    event->data = empty;
+    event->attrs_length = 0;
+    event->self_closing = false;
+    event->token = token;
+
+    switch (token->tag_id) {
+        case LXB_TAG__END_OF_FILE:
+            return token;
+
+        case LXB_TAG__TEXT:
+            event->type = LXB_HTML_STREAM_EVENT_TEXT;
+
+            lxb_html_stream_str_set(&event->data, token);
+            break;
+
+        case LXB_TAG__EM_COMMENT:
+            event->type = LXB_HTML_STREAM_EVENT_COMMENT;
+
+            lxb_html_stream_str_set(&event->data, token);
+            break;
+
+        case LXB_TAG__PROCESSINGINSTRUCTION:
+            event->type = LXB_HTML_STREAM_EVENT_PROCESSING_INSTRUCTION;
+
+            /* For processing instructions null_count is the target length. */
+            event->name.data = token->text_start;
+            event->name.length = token->null_count;
+
+            event->data.data = token->text_start + token->null_count;
+            event->data.length = token->text_end - event->data.data;
+            break;
+
+        case LXB_TAG__EM_DOCTYPE:
+            event->type = LXB_HTML_STREAM_EVENT_DOCTYPE;
+
+            /* The first attribute is the doctype name. */
+            if (attr != NULL) {
+                event->name.data = lxb_html_token_attr_name(attr, &length);
+                event->name.length = length;
+
+                attr = attr->next;
+            }
+
+            break;
+
+        default:
+            event->name.data = lxb_tag_name_by_id(token->tag_id, &length);
+            event->name.length = length;
+
+            event->self_closing = token->type & LXB_HTML_TOKEN_TYPE_CLOSE_SELF;
+
+            if (token->type & LXB_HTML_TOKEN_TYPE_CLOSE) {
+                event->type = LXB_HTML_STREAM_EVENT_END_TAG;
+                break;
+            }
+
+            event->type = LXB_HTML_STREAM_EVENT_START_TAG;
+
+            lxb_html_tokenizer_set_state_by_tag(tkz, stream->scripting,
+                                                token->tag_id, LXB_NS_HTML);
+            break;
+    }
+
+    status = lxb_html_stream_attrs(stream, attr);
+    if (status == LXB_STATUS_OK) {
+        event->attrs = stream->attrs;
+        status = stream->callback(stream, event, stream->ctx);
+    }
+
+    lxb_html_stream_attrs_release(stream, token);
+
+    if (status != LXB_STATUS_OK) {
+        tkz->status = status;
+        return NULL;
+    }
+
+    return token;
+}
+
+static lxb_status_t
+lxb_html_stream_attrs(lxb_html_stream_t *stream, lxb_html_token_attr_t *attr)
+{
+    size_t length, new_size;
+    lxb_html_stream_attr_t *sattr, *attrs;
+    lxb_html_stream_event_t *event = &stream->event;
+
+    while (attr != NULL) {
+        if (event->attrs_length >= stream->attrs_size) {
+            new_size = stream->attrs_size * 2;
+
+            attrs = lexbor_realloc(stream->attrs,
+                                   sizeof(lxb_html_stream_attr_t) * new_size);
+            if (attrs == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            stream->attrs = attrs;
+            stream->attrs_size = new_size;
+        }
+
+        sattr = &stream->attrs[event->attrs_length++];
+
+        sattr->name.data = lxb_html_token_attr_name(attr, &length);
+        sattr->name.length = length;
+        sattr->name.is_input = false;
+
+        sattr->value.data = attr->value;
+        sattr->value.length = attr->value_size;
+        sattr->value.is_input = attr->type & LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE;
+
+        sattr->attr_data = attr->name;
+
+        attr = attr->next;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static void
+lxb_html_stream_attrs_release(lxb_html_stream_t *stream,
+                              lxb_html_token_t *token)
+{
+    lxb_html_token_attr_t *attr, *next;
+    lxb_html_tokenizer_t *tkz = stream->tkz;
+
+    attr = token->attr_first;
+
+    while (attr != NULL) {
+        next = attr->next;
+
+        if (attr->value != NULL
+            && !(attr->type & LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE))
+        {
+            lexbor_mraw_free(tkz->attrs_mraw, attr->value);
+        }
+
+        lxb_html_token_attr_destroy(attr, tkz->dobj_token_attr);
+
+        attr = next;
+    }
+
+    token->attr_first = NULL;
+    token->attr_last = NULL;
+}
+
+
+/*
+ * No inline functions for ABI.
+ */
+lxb_html_tokenizer_t *
+lxb_html_stream_tokenizer_noi(lxb_html_stream_t *stream)
+{
+    return lxb_html_stream_tokenizer(stream);
+}
+
+lxb_status_t
+lxb_html_stream_status_noi(lxb_html_stream_t *stream)
+{
+    return lxb_html_stream_status(stream);
+}
+
+void
+lxb_html_stream_scripting_set_noi(lxb_html_stream_t *stream, bool scripting)
+{
+    lxb_html_stream_scripting_set(stream, scripting);
+}
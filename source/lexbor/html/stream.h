@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+/*
+ * Streaming (SAX-like) interface over the HTML tokenizer.
+ *
+ * No tree is built. Every token is reported as an event with strings given
+ * as (pointer, length) pairs, valid only during the callback call.
+ *
+ * Text, comment and attribute value data is not copied while nothing in it
+ * is rewritten (character references, NULL, CR/LF normalization) and the
+ * token is not split between chunks: the string points into the chunk passed
+ * to lxb_html_stream_chunk() and is_input is set. Once something is
+ * rewritten, the tokenizer copies the data into its reusable temporary buffer
+ * and the string points there.
+ *
+ * What is saved is the copy into the temporary buffer, the copy the caller
+ * would otherwise need to keep the data, and, for attribute values,
+ * the allocation from attrs_mraw.
+ * Processing instruction data always points into the temporary buffer.
+ */
+
+#ifndef LEXBOR_HTML_STREAM_H
+#define LEXBOR_HTML_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/html/base.h"
+#include "lexbor/html/tokenizer.h"
+
+
+typedef enum {
+    LXB_HTML_STREAM_EVENT_START_TAG              = 0x00,
+    LXB_HTML_STREAM_EVENT_END_TAG                = 0x01,
+    LXB_HTML_STREAM_EVENT_TEXT                   = 0x02,
+    LXB_HTML_STREAM_EVENT_COMMENT                = 0x03,
+    LXB_HTML_STREAM_EVENT_DOCTYPE                = 0x04,
+    LXB_HTML_STREAM_EVENT_PROCESSING_INSTRUCTION = 0x05
+}
+lxb_html_stream_event_type_t;
+
+typedef struct {
+    const lxb_char_t *data;
+    size_t           length;
+
+    /* The data points into the input chunk. */
+    bool             is_input;
+}
+lxb_html_stream_str_t;
+
+typedef struct {
+    /* Lowercase name. */
+    lxb_html_stream_str_t     name;
+    /* data is NULL for attributes without a value. */
+    lxb_html_stream_str_t     value;
+
+    const lxb_dom_attr_data_t *attr_data;
+}
+lxb_html_stream_attr_t;
+
+/*
+ * START_TAG, END_TAG: name is the lowercase tag name, attrs are attributes.
+ * TEXT, COMMENT: data is the text.
+ * DOCTYPE: name is the doctype name, attrs are PUBLIC and SYSTEM
+ * identifiers, if any.
+ * PROCESSING_INSTRUCTION: name is the target, data is the data.
+ */
+typedef struct {
+    lxb_html_stream_event_type_t type;
+    lxb_tag_id_t                 tag_id;
+
+    lxb_html_stream_str_t        name;
+    lxb_html_stream_str_t        data;
+
+    const lxb_html_stream_attr_t *attrs;
+    size_t                       attrs_length;
+
+    bool                         self_closing;
+
+    /* Original token; begin and end point into the input. */
+    const lxb_html_token_t       *token;
+}
+lxb_html_stream_event_t;
+
+typedef struct lxb_html_stream lxb_html_stream_t;
+
+/*
+ * Return LXB_STATUS_OK to continue; any other status stops tokenization
+ * and is returned from lxb_html_stream_chunk()/lxb_html_stream_end().
+ */
+typedef lxb_status_t
+(*lxb_html_stream_event_f)(lxb_html_stream_t *stream,
+                           const lxb_html_stream_event_t *event, void *ctx);
+
+struct lxb_html_stream {
+    lxb_html_tokenizer_t    *tkz;
+
+    lxb_html_stream_event_f callback;
+    void                    *ctx;
+
+    lxb_html_stream_event_t event;
+    lxb_html_stream_attr_t  *attrs;
+    size_t                  attrs_size;
+
+    bool                    scripting;
+    lxb_status_t            status;
+};
+
+
+LXB_API lxb_html_stream_t *
+lxb_html_stream_create(void);
+
+LXB_API lxb_status_t
+lxb_html_stream_init(lxb_html_stream_t *stream,
+                     lxb_html_stream_event_f callback, void *ctx);
+
+LXB_API void
+lxb_html_stream_clean(lxb_html_stream_t *stream);
+
+LXB_API lxb_html_stream_t *
+lxb_html_stream_destroy(lxb_html_stream_t *stream);
+
+LXB_API lxb_status_t
+lxb_html_stream_begin(lxb_html_stream_t *stream);
+
+LXB_API lxb_status_t
+lxb_html_stream_chunk(lxb_html_stream_t *stream,
+                      const lxb_char_t *data, size_t size);
+
+LXB_API lxb_status_t
+lxb_html_stream_end(lxb_html_stream_t *stream);
+
+/*
+ * Begin, one chunk, end.
+ */
+LXB_API lxb_status_t
+lxb_html_stream_parse(lxb_html_stream_t *stream,
+                      const lxb_char_t *data, size_t size);
+
+
+/*
+ * Inline functions
+ */
+lxb_inline lxb_html_tokenizer_t *
+lxb_html_stream_tokenizer(lxb_html_stream_t *stream)
+{
+    return stream->tkz;
+}
+
+lxb_inline lxb_status_t
+lxb_html_stream_status(lxb_html_stream_t *stream)
+{
+    return stream->status;
+}
+
+/*
+ * Affects the noscript element: with scripting its content is raw text.
+ */
+lxb_inline void
+lxb_html_stream_scripting_set(lxb_html_stream_t *stream, bool scripting)
+{
+    stream->scripting = scripting;
+}
+
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API lxb_html_tokenizer_t *
+lxb_html_stream_tokenizer_noi(lxb_html_stream_t *stream);
+
+LXB_API lxb_status_t
+lxb_html_stream_status_noi(lxb_html_stream_t *stream);
+
+LXB_API void
+lxb_html_stream_scripting_set_noi(lxb_html_stream_t *stream, bool scripting);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_HTML_STREAM_H */
@@ -23,9 +23,10 @@ typedef struct lxb_html_token_attr lxb_html_token_attr_t;
 typedef int lxb_html_token_attr_type_t;
 
 enum lxb_html_token_attr_type {
-    LXB_HTML_TOKEN_ATTR_TYPE_UNDEF      = 0x0000,
-    LXB_HTML_TOKEN_ATTR_TYPE_NAME_NULL  = 0x0001,
-    LXB_HTML_TOKEN_ATTR_TYPE_VALUE_NULL = 0x0002
+    LXB_HTML_TOKEN_ATTR_TYPE_UNDEF       = 0x0000,
+    LXB_HTML_TOKEN_ATTR_TYPE_NAME_NULL   = 0x0001,
+    LXB_HTML_TOKEN_ATTR_TYPE_VALUE_NULL  = 0x0002,
+    LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE = 0x0004
 };
 
 struct lxb_html_token_attr {
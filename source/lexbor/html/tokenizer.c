@@ -51,31 +51,43 @@ lxb_html_tokenizer_init(lxb_html_tokenizer_t *tkz)
         return LXB_STATUS_ERROR_OBJECT_IS_NULL;
     }
 
+    lexbor_mem_stat_init(&tkz->memory);
+
     /* mraw for templary strings or structures */
     tkz->mraw = lexbor_mraw_create();
-    status = lexbor_mraw_init(tkz->mraw, 1024);
+    status = lexbor_mraw_init_allocator(tkz->mraw, 1024, tkz->allocator);
     if (status != LXB_STATUS_OK) {
         return status;
     }
 
+    lexbor_mem_stat_parent_set(lexbor_mraw_stat(tkz->mraw), &tkz->memory);
+
     /* Init Token */
     tkz->token = NULL;
 
     tkz->dobj_token = lexbor_dobject_create();
-    status = lexbor_dobject_init(tkz->dobj_token,
-                                 4096, sizeof(lxb_html_token_t));
+    status = lexbor_dobject_init_allocator(tkz->dobj_token,
+                                           4096, sizeof(lxb_html_token_t),
+                                           tkz->allocator);
     if (status != LXB_STATUS_OK) {
         return status;
     }
 
+    lexbor_mem_stat_parent_set(lexbor_dobject_stat(tkz->dobj_token),
+                               &tkz->memory);
+
     /* Init Token Attributes */
     tkz->dobj_token_attr = lexbor_dobject_create();
-    status = lexbor_dobject_init(tkz->dobj_token_attr, 4096,
-                                 sizeof(lxb_html_token_attr_t));
+    status = lexbor_dobject_init_allocator(tkz->dobj_token_attr, 4096,
+                                           sizeof(lxb_html_token_attr_t),
+                                           tkz->allocator);
     if (status != LXB_STATUS_OK) {
         return status;
     }
 
+    lexbor_mem_stat_parent_set(lexbor_dobject_stat(tkz->dobj_token_attr),
+                               &tkz->memory);
+
     /* Parse errors */
     tkz->parse_errors = lexbor_array_obj_create();
     status = lexbor_array_obj_init(tkz->parse_errors, 16,
@@ -85,7 +97,9 @@ lxb_html_tokenizer_init(lxb_html_tokenizer_t *tkz)
     }
 
     /* Temporary memory for tag name and attributes. */
-    tkz->start = lexbor_malloc(LXB_HTML_TKZ_TEMP_SIZE * sizeof(lxb_char_t));
+    tkz->start = lexbor_allocator_malloc(tkz->allocator,
+                                         LXB_HTML_TKZ_TEMP_SIZE
+                                         * sizeof(lxb_char_t));
     if (tkz->start == NULL) {
         return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
     }
@@ -93,6 +107,8 @@ lxb_html_tokenizer_init(lxb_html_tokenizer_t *tkz)
     tkz->pos = tkz->start;
     tkz->end = tkz->start + LXB_HTML_TKZ_TEMP_SIZE;
 
+    lexbor_mem_stat_add(&tkz->memory, LXB_HTML_TKZ_TEMP_SIZE);
+
     tkz->tree = NULL;
     tkz->tags = NULL;
     tkz->attrs = NULL;
@@ -107,6 +123,9 @@ lxb_html_tokenizer_init(lxb_html_tokenizer_t *tkz)
     tkz->is_eof = false;
     tkz->status = LXB_STATUS_OK;
 
+    tkz->step_count = 0;
+    tkz->paused = NULL;
+
     tkz->base = NULL;
     tkz->ref_count = 1;
 
@@ -123,6 +142,7 @@ lxb_html_tokenizer_inherit(lxb_html_tokenizer_t *tkz_to,
     tkz_to->attrs = tkz_from->attrs;
     tkz_to->attrs_mraw = tkz_from->attrs_mraw;
     tkz_to->mraw = tkz_from->mraw;
+    tkz_to->allocator = tkz_from->allocator;
 
     /* Token and Attributes */
     tkz_to->token = NULL;
@@ -147,6 +167,12 @@ lxb_html_tokenizer_inherit(lxb_html_tokenizer_t *tkz_to,
     tkz_to->is_eof = false;
     tkz_to->status = LXB_STATUS_OK;
 
+    tkz_to->steps = tkz_from->steps;
+    tkz_to->step_count = 0;
+    tkz_to->yield = tkz_from->yield;
+    tkz_to->yield_ctx = tkz_from->yield_ctx;
+    tkz_to->paused = NULL;
+
     tkz_to->base = tkz_from;
     tkz_to->ref_count = 1;
 
@@ -204,6 +230,13 @@ lxb_html_tokenizer_clean(lxb_html_tokenizer_t *tkz)
     tkz->is_eof = false;
     tkz->status = LXB_STATUS_OK;
 
+    tkz->step_count = 0;
+    tkz->paused = NULL;
+
+    tkz->slice_begin = NULL;
+    tkz->slice_end = NULL;
+    tkz->slice = NULL;
+
     tkz->utf8_buf_len = 0;
 
     tkz->pos = tkz->start;
@@ -234,7 +267,7 @@ lxb_html_tokenizer_destroy(lxb_html_tokenizer_t *tkz)
         lexbor_mraw_destroy(tkz->mraw, true);
         lexbor_dobject_destroy(tkz->dobj_token, true);
         lexbor_dobject_destroy(tkz->dobj_token_attr, true);
-        lexbor_free(tkz->start);
+        lexbor_allocator_free(tkz->allocator, tkz->start);
     }
 
     tkz->parse_errors = lexbor_array_obj_destroy(tkz->parse_errors, true);
@@ -242,6 +275,30 @@ lxb_html_tokenizer_destroy(lxb_html_tokenizer_t *tkz)
     return lexbor_free(tkz);
 }
 
+void
+lxb_html_tokenizer_memory_usage(lxb_html_tokenizer_t *tkz,
+                                lxb_html_tokenizer_memory_usage_t *usage)
+{
+    tkz = lxb_html_tokenizer_root(tkz);
+
+    usage->total = lexbor_mem_stat_usage(&tkz->memory);
+    usage->mraw = lexbor_mem_stat_usage(lexbor_mraw_stat(tkz->mraw));
+    usage->tokens = lexbor_mem_stat_usage(lexbor_dobject_stat(tkz->dobj_token));
+    usage->token_attrs =
+                lexbor_mem_stat_usage(lexbor_dobject_stat(tkz->dobj_token_attr));
+}
+
+void
+lxb_html_tokenizer_memory_peak_reset(lxb_html_tokenizer_t *tkz)
+{
+    tkz = lxb_html_tokenizer_root(tkz);
+
+    lexbor_mem_stat_peak_reset(&tkz->memory);
+    lexbor_mem_stat_peak_reset(lexbor_mraw_stat(tkz->mraw));
+    lexbor_mem_stat_peak_reset(lexbor_dobject_stat(tkz->dobj_token));
+    lexbor_mem_stat_peak_reset(lexbor_dobject_stat(tkz->dobj_token_attr));
+}
+
 lxb_status_t
 lxb_html_tokenizer_tags_make(lxb_html_tokenizer_t *tkz, size_t table_size)
 {
@@ -556,12 +613,90 @@ lxb_html_tokenizer_validate_input(lxb_html_tokenizer_t *tkz,
     }
 }
 
+/*
+ * The chunk goes away: copy what the unfinished token still refers to.
+ */
+static void
+lxb_html_tokenizer_unslice(lxb_html_tokenizer_t *tkz)
+{
+    lxb_char_t *value;
+    lxb_html_token_attr_t *attr;
+
+    lxb_html_tokenizer_temp_unslice(tkz);
+
+    if (tkz->token == NULL) {
+        return;
+    }
+
+    for (attr = tkz->token->attr_first; attr != NULL; attr = attr->next) {
+        if (!(attr->type & LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE)) {
+            continue;
+        }
+
+        value = lexbor_mraw_alloc(tkz->attrs_mraw, attr->value_size + 1);
+        if (value == NULL) {
+            tkz->status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            return;
+        }
+
+        memcpy(value, attr->value, attr->value_size);
+        value[attr->value_size] = 0x00;
+
+        attr->value = value;
+        attr->type &= ~LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE;
+    }
+}
+
+static lxb_status_t
+lxb_html_tokenizer_chunk_process(lxb_html_tokenizer_t *tkz,
+                                 const lxb_char_t *data, const lxb_char_t *end)
+{
+    if (tkz->steps == 0) {
+        while (data < end) {
+            data = tkz->state(tkz, data, end);
+        }
+    }
+    else {
+        tkz->step_count = 0;
+
+        while (data < end) {
+            data = tkz->state(tkz, data, end);
+
+            if (tkz->step_count >= tkz->steps) {
+                tkz->step_count = 0;
+
+                if (data < end && tkz->status == LXB_STATUS_OK
+                    && (tkz->yield == NULL || tkz->yield(tkz, tkz->yield_ctx)))
+                {
+                    /* The chunk and the slices stay as they are. */
+                    tkz->paused = data;
+
+                    return LXB_STATUS_CONTINUE;
+                }
+            }
+        }
+    }
+
+    tkz->paused = NULL;
+
+    lxb_html_tokenizer_unslice(tkz);
+
+    tkz->slice_begin = NULL;
+    tkz->slice_end = NULL;
+
+    return tkz->status;
+}
+
 lxb_status_t
 lxb_html_tokenizer_chunk(lxb_html_tokenizer_t *tkz, const lxb_char_t *data,
                          size_t size)
 {
     const lxb_char_t *end = data + size;
 
+    if (tkz->paused != NULL) {
+        return LXB_STATUS_ERROR_WRONG_STAGE;
+    }
+
     if (tkz->opt & LXB_HTML_TOKENIZER_OPT_VALIDATE_INPUT) {
         lxb_html_tokenizer_validate_input(tkz, data, size);
     }
@@ -570,11 +705,20 @@ lxb_html_tokenizer_chunk(lxb_html_tokenizer_t *tkz, const lxb_char_t *data,
     tkz->status = LXB_STATUS_OK;
     tkz->last = end;
 
-    while (data < end) {
-        data = tkz->state(tkz, data, end);
+    tkz->slice_begin = data;
+    tkz->slice_end = end;
+
+    return lxb_html_tokenizer_chunk_process(tkz, data, end);
+}
+
+lxb_status_t
+lxb_html_tokenizer_chunk_resume(lxb_html_tokenizer_t *tkz)
+{
+    if (tkz->paused == NULL) {
+        return LXB_STATUS_ERROR_WRONG_STAGE;
     }
 
-    return tkz->status;
+    return lxb_html_tokenizer_chunk_process(tkz, tkz->paused, tkz->last);
 }
 
 lxb_status_t
@@ -582,6 +726,10 @@ lxb_html_tokenizer_end(lxb_html_tokenizer_t *tkz)
 {
     const lxb_char_t *data, *end;
 
+    if (tkz->paused != NULL) {
+        return LXB_STATUS_ERROR_WRONG_STAGE;
+    }
+
     tkz->status = LXB_STATUS_OK;
 
     /* Send a fake EOF data. */
@@ -810,3 +958,29 @@ lxb_html_tokenizer_keep_duplicate_set_noi(lxb_html_tokenizer_t *tkz,
 {
     lxb_html_tokenizer_keep_duplicate_set(tkz, keep);
 }
+
+void
+lxb_html_tokenizer_slices_set_noi(lxb_html_tokenizer_t *tkz, bool enabled)
+{
+    lxb_html_tokenizer_slices_set(tkz, enabled);
+}
+
+void
+lxb_html_tokenizer_allocator_set_noi(lxb_html_tokenizer_t *tkz,
+                                     const lexbor_allocator_t *allocator)
+{
+    lxb_html_tokenizer_allocator_set(tkz, allocator);
+}
+
+void
+lxb_html_tokenizer_steps_set_noi(lxb_html_tokenizer_t *tkz, size_t steps,
+                                 lxb_html_tokenizer_yield_f yield, void *ctx)
+{
+    lxb_html_tokenizer_steps_set(tkz, steps, yield, ctx);
+}
+
+bool
+lxb_html_tokenizer_paused_noi(lxb_html_tokenizer_t *tkz)
+{
+    return lxb_html_tokenizer_paused(tkz);
+}
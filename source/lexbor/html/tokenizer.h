@@ -24,7 +24,8 @@ extern "C" {
 enum {
     LXB_HTML_TOKENIZER_OPT_UNDEF               = 0x00,
     LXB_HTML_TOKENIZER_OPT_VALIDATE_INPUT      = 1 << 3,
-    LXB_HTML_TOKENIZER_OPT_ATTR_KEEP_DUPLICATE = 1 << 4
+    LXB_HTML_TOKENIZER_OPT_ATTR_KEEP_DUPLICATE = 1 << 4,
+    LXB_HTML_TOKENIZER_OPT_SLICES              = 1 << 5
 };
 
 /* State */
@@ -36,6 +37,19 @@ typedef lxb_html_token_t *
 (*lxb_html_tokenizer_token_f)(lxb_html_tokenizer_t *tkz,
                               lxb_html_token_t *token, void *ctx);
 
+/* Return true to pause the tokenizer, see lxb_html_tokenizer_steps_set(). */
+typedef bool
+(*lxb_html_tokenizer_yield_f)(lxb_html_tokenizer_t *tkz, void *ctx);
+
+
+typedef struct {
+    lexbor_mem_usage_t total;
+
+    lexbor_mem_usage_t mraw;
+    lexbor_mem_usage_t tokens;
+    lexbor_mem_usage_t token_attrs;
+}
+lxb_html_tokenizer_memory_usage_t;
 
 struct lxb_html_tokenizer {
     lxb_html_tokenizer_state_f       state;
@@ -80,6 +94,20 @@ struct lxb_html_tokenizer {
     const lxb_char_t                 *begin;
     const lxb_char_t                 *last;
 
+    /*
+     * Input the tokens may point to with LXB_HTML_TOKENIZER_OPT_SLICES.
+     * The current chunk while it is processed, NULL otherwise.
+     */
+    const lxb_char_t                 *slice_begin;
+    const lxb_char_t                 *slice_end;
+
+    /*
+     * Where the bytes in the temp buffer start in the current chunk while
+     * nothing was rewritten (character references, NULL, CR); the bytes are
+     * not copied then. NULL once they are in the buffer.
+     */
+    const lxb_char_t                 *slice;
+
     /* Entities */
     const lexbor_sbst_entry_static_t *entity;
     const lexbor_sbst_entry_static_t *entity_match;
@@ -94,10 +122,25 @@ struct lxb_html_tokenizer {
     lxb_status_t                     status;
     bool                             is_eof;
 
+    /* Yield points, see lxb_html_tokenizer_steps_set(). */
+    size_t                           steps;
+    size_t                           step_count;
+    lxb_html_tokenizer_yield_f       yield;
+    void                             *yield_ctx;
+
+    /* Where a paused chunk continues, NULL if not paused. */
+    const lxb_char_t                 *paused;
+
     /* Input stream validation (for cross-chunk UTF-8). */
     lxb_char_t                       utf8_buf[4];
     unsigned                         utf8_buf_len;
 
+    /* For the memory pools and the temporary buffer. */
+    const lexbor_allocator_t         *allocator;
+
+    /* The pools above and the temporary buffer. */
+    lexbor_mem_stat_t                memory;
+
     lxb_html_tokenizer_t             *base;
     size_t                           ref_count;
 };
@@ -150,6 +193,14 @@ LXB_API lxb_status_t
 lxb_html_tokenizer_chunk(lxb_html_tokenizer_t *tkz,
                          const lxb_char_t *data, size_t size);
 
+/*
+ * Continues the chunk paused at a yield point. The chunk passed to
+ * lxb_html_tokenizer_chunk() must stay unchanged until then.
+ * Returns LXB_STATUS_CONTINUE if it paused again.
+ */
+LXB_API lxb_status_t
+lxb_html_tokenizer_chunk_resume(lxb_html_tokenizer_t *tkz);
+
 LXB_API lxb_status_t
 lxb_html_tokenizer_end(lxb_html_tokenizer_t *tkz);
 
@@ -171,6 +222,17 @@ lxb_html_tokenizer_attr_last_duplicate(lxb_html_tokenizer_t *tkz);
 LXB_API void
 lxb_html_tokenizer_validate_close_tag(lxb_html_tokenizer_t *tkz);
 
+/*
+ * Bytes held by the tokenizer: memory pools and the temporary buffer.
+ * An inherited tokenizer reports the usage of its base.
+ */
+LXB_API void
+lxb_html_tokenizer_memory_usage(lxb_html_tokenizer_t *tkz,
+                                lxb_html_tokenizer_memory_usage_t *usage);
+
+LXB_API void
+lxb_html_tokenizer_memory_peak_reset(lxb_html_tokenizer_t *tkz);
+
 /*
  * Inline functions
  */
@@ -180,6 +242,37 @@ lxb_html_tokenizer_status_set(lxb_html_tokenizer_t *tkz, lxb_status_t status)
     tkz->status = status;
 }
 
+/*
+ * Must be called before lxb_html_tokenizer_init().
+ */
+lxb_inline void
+lxb_html_tokenizer_allocator_set(lxb_html_tokenizer_t *tkz,
+                                 const lexbor_allocator_t *allocator)
+{
+    tkz->allocator = allocator;
+}
+
+/*
+ * After every steps tokens lxb_html_tokenizer_chunk() asks yield, or pauses
+ * unconditionally if yield is NULL. A paused chunk returns
+ * LXB_STATUS_CONTINUE and is continued by lxb_html_tokenizer_chunk_resume().
+ * Zero steps turns yield points off.
+ */
+lxb_inline void
+lxb_html_tokenizer_steps_set(lxb_html_tokenizer_t *tkz, size_t steps,
+                             lxb_html_tokenizer_yield_f yield, void *ctx)
+{
+    tkz->steps = steps;
+    tkz->yield = yield;
+    tkz->yield_ctx = ctx;
+}
+
+lxb_inline bool
+lxb_html_tokenizer_paused(lxb_html_tokenizer_t *tkz)
+{
+    return tkz->paused != NULL;
+}
+
 lxb_inline void
 lxb_html_tokenizer_tags_set(lxb_html_tokenizer_t *tkz, lexbor_hash_t *tags)
 {
@@ -286,24 +379,86 @@ lxb_html_tokenizer_keep_duplicate_set(lxb_html_tokenizer_t *tkz, bool keep)
     }
 }
 
+/*
+ * With slices enabled, attribute values, text and comments that did not need
+ * rewriting within one chunk are not copied: attribute values point into the
+ * input chunk instead of attrs_mraw and have
+ * LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE set, text_start and text_end of such
+ * tokens point into the input chunk and they have LXB_HTML_TOKEN_TYPE_SLICE
+ * set. The values are not null-terminated.
+ */
+lxb_inline void
+lxb_html_tokenizer_slices_set(lxb_html_tokenizer_t *tkz, bool enabled)
+{
+    if (enabled) {
+        tkz->opt |= LXB_HTML_TOKENIZER_OPT_SLICES;
+    }
+    else {
+        tkz->opt &= ~LXB_HTML_TOKENIZER_OPT_SLICES;
+    }
+}
+
+lxb_inline lxb_html_tokenizer_t *
+lxb_html_tokenizer_root(lxb_html_tokenizer_t *tkz)
+{
+    while (tkz->base != NULL) {
+        tkz = tkz->base;
+    }
+
+    return tkz;
+}
+
 lxb_inline lxb_status_t
 lxb_html_tokenizer_temp_realloc(lxb_html_tokenizer_t *tkz, size_t size)
 {
+    lxb_char_t *start;
     size_t length = tkz->pos - tkz->start;
     size_t new_size = (tkz->end - tkz->start) + size + 4096;
+    lexbor_mem_stat_t *memory = &lxb_html_tokenizer_root(tkz)->memory;
+
+    if (!lexbor_mem_stat_reserve(memory, size + 4096)) {
+        tkz->status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        return tkz->status;
+    }
 
-    tkz->start = (lxb_char_t *)lexbor_realloc(tkz->start, new_size);
-    if (tkz->start == NULL) {
+    start = (lxb_char_t *) lexbor_allocator_realloc(tkz->allocator,
+                                                    tkz->start, new_size);
+    if (start == NULL) {
         tkz->status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
         return tkz->status;
     }
 
+    tkz->start = start;
+
+    lexbor_mem_stat_add(memory, size + 4096);
+
     tkz->pos = tkz->start + length;
     tkz->end = tkz->start + new_size;
 
     return LXB_STATUS_OK;
 }
 
+/*
+ * Copies the bytes the temp buffer only refers to while it is a slice.
+ */
+lxb_inline void
+lxb_html_tokenizer_temp_unslice(lxb_html_tokenizer_t *tkz)
+{
+    if (tkz->slice != NULL) {
+        memcpy(tkz->start, tkz->slice, tkz->pos - tkz->start);
+        tkz->slice = NULL;
+    }
+}
+
+/*
+ * The bytes collected in the temp buffer, wherever they are.
+ */
+lxb_inline const lxb_char_t *
+lxb_html_tokenizer_temp_data(lxb_html_tokenizer_t *tkz)
+{
+    return (tkz->slice != NULL) ? tkz->slice : tkz->start;
+}
+
 lxb_inline lxb_status_t
 lxb_html_tokenizer_temp_append_data(lxb_html_tokenizer_t *tkz,
                                     const lxb_char_t *data)
@@ -316,6 +471,15 @@ lxb_html_tokenizer_temp_append_data(lxb_html_tokenizer_t *tkz,
         }
     }
 
+    if (tkz->slice != NULL) {
+        if (tkz->begin == tkz->slice + (tkz->pos - tkz->start)) {
+            tkz->pos += size;
+            return LXB_STATUS_OK;
+        }
+
+        lxb_html_tokenizer_temp_unslice(tkz);
+    }
+
     tkz->pos = (lxb_char_t *) memcpy(tkz->pos, tkz->begin, size) + size;
 
     return LXB_STATUS_OK;
@@ -331,6 +495,15 @@ lxb_html_tokenizer_temp_append(lxb_html_tokenizer_t *tkz,
         }
     }
 
+    if (tkz->slice != NULL) {
+        if (data == tkz->slice + (tkz->pos - tkz->start)) {
+            tkz->pos += size;
+            return LXB_STATUS_OK;
+        }
+
+        lxb_html_tokenizer_temp_unslice(tkz);
+    }
+
     tkz->pos = (lxb_char_t *) memcpy(tkz->pos, data, size) + size;
 
     return LXB_STATUS_OK;
@@ -381,6 +554,20 @@ LXB_API void
 lxb_html_tokenizer_keep_duplicate_set_noi(lxb_html_tokenizer_t *tkz,
                                           bool keep);
 
+LXB_API void
+lxb_html_tokenizer_slices_set_noi(lxb_html_tokenizer_t *tkz, bool enabled);
+
+LXB_API void
+lxb_html_tokenizer_allocator_set_noi(lxb_html_tokenizer_t *tkz,
+                                     const lexbor_allocator_t *allocator);
+
+LXB_API void
+lxb_html_tokenizer_steps_set_noi(lxb_html_tokenizer_t *tkz, size_t steps,
+                                 lxb_html_tokenizer_yield_f yield, void *ctx);
+
+LXB_API bool
+lxb_html_tokenizer_paused_noi(lxb_html_tokenizer_t *tkz);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
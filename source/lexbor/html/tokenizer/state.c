@@ -17,10 +17,20 @@
     LXB_EXTERN const size_t     lexbor_str_res_replacement_character[160];
 #endif
 
-#include "lexbor/core/swar.h"
+#include "lexbor/core/simd.h"
 #include "lexbor/html/tokenizer/res.h"
 
 
+/*
+ * Attribute value (unquoted) state: all bytes with a special meaning.
+ */
+static const lxb_char_t lxb_html_tokenizer_state_unquoted_set[] =
+{
+    0x09, 0x0A, 0x0C, 0x0D, 0x20, 0x26, 0x3E, 0x00,
+    0x22, 0x27, 0x3C, 0x3D, 0x60
+};
+
+
 const lxb_tag_data_t *
 lxb_tag_append_lower(lexbor_hash_t *hash,
                      const lxb_char_t *name, size_t length);
@@ -253,8 +263,9 @@ lxb_html_tokenizer_state_data(lxb_html_tokenizer_t *tkz,
                               const lxb_char_t *data, const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
-    data = lexbor_swar_seek4(data, end, 0x3C, 0x26, 0x0D, 0x00);
+    data = lexbor_simd_seek4(data, end, 0x3C, 0x26, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -287,6 +298,7 @@ lxb_html_tokenizer_state_data(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -369,6 +381,7 @@ lxb_html_tokenizer_state_plaintext(lxb_html_tokenizer_t *tkz,
                                    const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
     while (data != end) {
         switch (*data) {
@@ -384,6 +397,7 @@ lxb_html_tokenizer_state_plaintext(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -932,8 +946,9 @@ lxb_html_tokenizer_state_attribute_value_double_quoted(lxb_html_tokenizer_t *tkz
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
-    data = lexbor_swar_seek4(data, end, 0x22, 0x26, 0x0D, 0x00);
+    data = lexbor_simd_seek4(data, end, 0x22, 0x26, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -969,6 +984,7 @@ lxb_html_tokenizer_state_attribute_value_double_quoted(lxb_html_tokenizer_t *tkz
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1028,6 +1044,9 @@ lxb_html_tokenizer_state_attribute_value_single_quoted(lxb_html_tokenizer_t *tkz
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek4(data, end, 0x27, 0x26, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -1063,6 +1082,7 @@ lxb_html_tokenizer_state_attribute_value_single_quoted(lxb_html_tokenizer_t *tkz
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1122,6 +1142,10 @@ lxb_html_tokenizer_state_attribute_value_unquoted(lxb_html_tokenizer_t *tkz,
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek_set(data, end, lxb_html_tokenizer_state_unquoted_set,
+                                sizeof(lxb_html_tokenizer_state_unquoted_set));
 
     while (data != end) {
         switch (*data) {
@@ -1355,6 +1379,9 @@ lxb_html_tokenizer_state_bogus_comment(lxb_html_tokenizer_t *tkz,
                                        const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek3(data, end, 0x3E, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -1381,6 +1408,7 @@ lxb_html_tokenizer_state_bogus_comment(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1649,6 +1677,9 @@ lxb_html_tokenizer_state_cdata_section(lxb_html_tokenizer_t *tkz,
                                        const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek3(data, end, 0x5D, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -1672,6 +1703,7 @@ lxb_html_tokenizer_state_cdata_section(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1957,6 +1989,8 @@ lxb_html_tokenizer_state_processing_instruction_data(lxb_html_tokenizer_t *tkz,
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
 
+    data = lexbor_simd_seek4(data, end, 0x3F, 0x3E, 0x0D, 0x00);
+
     while (data < end) {
         switch (*data) {
             /* U+003F QUESTION MARK (?) */
@@ -1984,6 +2018,7 @@ lxb_html_tokenizer_state_processing_instruction_data(lxb_html_tokenizer_t *tkz,
                 data += 1;
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+
                 tkz->pos[-1] = 0x0A;
 
                 if (data >= end) {
@@ -2126,6 +2161,9 @@ _lxb_html_tokenizer_state_char_ref(lxb_html_tokenizer_t *tkz,
                                    const lxb_char_t *data,
                                    const lxb_char_t *end)
 {
+    /* The reference is looked up and replaced in the temp buffer. */
+    lxb_html_tokenizer_temp_unslice(tkz);
+
     /* ASCII alphanumeric */
     if (lexbor_str_res_alphanumeric_character[ *data ] != LEXBOR_STR_RES_SLIP) {
         tkz->entity = &lxb_html_tokenizer_res_entities_sbst[1];
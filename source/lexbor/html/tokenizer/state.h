@@ -16,6 +16,20 @@ extern "C" {
 #define lxb_html_tokenizer_state_begin_set(tkz, v_data)                        \
     (tkz->begin = v_data)
 
+/*
+ * Data collected from here is only referred to, while it is not rewritten,
+ * see lxb_html_tokenizer_slices_set().
+ */
+#define lxb_html_tokenizer_state_slice_set(tkz, v_data)                        \
+    do {                                                                       \
+        if ((tkz->opt & LXB_HTML_TOKENIZER_OPT_SLICES)                         \
+            && tkz->pos == tkz->start && tkz->slice_begin != NULL)             \
+        {                                                                      \
+            tkz->slice = v_data;                                               \
+        }                                                                      \
+    }                                                                          \
+    while (0)
+
 #define lxb_html_tokenizer_state_append_data_m(tkz, v_data)                    \
     do {                                                                       \
         if (lxb_html_tokenizer_temp_append_data(tkz, v_data)) {                \
@@ -34,6 +48,16 @@ extern "C" {
     }                                                                          \
     while (0)
 
+/*
+ * Appends the input bytes at v_data, equal to v_str, while the temp buffer is
+ * a slice: they are in the same chunk then and stay uncopied. Otherwise v_data
+ * can be in a previous chunk and v_str is appended.
+ */
+#define lxb_html_tokenizer_state_append_input_m(tkz, v_data, v_str, size)      \
+    lxb_html_tokenizer_state_append_m(tkz, (tkz->slice != NULL)                \
+                                      ? (const lxb_char_t *) (v_data)          \
+                                      : (const lxb_char_t *) (v_str), size)
+
 #define lxb_html_tokenizer_state_append_replace_m(tkz)                         \
     do {                                                                       \
         if (lxb_html_tokenizer_temp_append(tkz,                                \
@@ -57,6 +81,17 @@ extern "C" {
     }                                                                          \
     while (0)
 
+/*
+ * The end tag name after "</" at entity_start in the temp buffer.
+ */
+#define lxb_html_tokenizer_state_set_end_tag_m(tkz)                            \
+    do {                                                                       \
+        const lxb_char_t *temp = lxb_html_tokenizer_temp_data(tkz);            \
+        lxb_html_tokenizer_state_set_tag_m(tkz, &temp[tkz->entity_start] + 2,  \
+                                           temp + (tkz->pos - tkz->start));    \
+    }                                                                          \
+    while (0)
+
 #define lxb_html_tokenizer_state_set_name_m(tkz)                               \
     do {                                                                       \
         lxb_dom_attr_data_t *data;                                             \
@@ -76,6 +111,12 @@ extern "C" {
                                                                                \
         attr->value_size = (size_t) (tkz->pos - tkz->start);                   \
                                                                                \
+        if (tkz->slice != NULL) {                                              \
+            attr->value = (lxb_char_t *) tkz->slice;                           \
+            attr->type |= LXB_HTML_TOKEN_ATTR_TYPE_VALUE_SLICE;                \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
         attr->value = lexbor_mraw_alloc(tkz->attrs_mraw, attr->value_size + 1);\
         if (attr->value == NULL) {                                             \
             tkz->status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;                  \
@@ -89,6 +130,7 @@ extern "C" {
 #define lxb_html_tokenizer_state_token_set_begin(tkz, v_begin)                 \
     do {                                                                       \
         tkz->pos = tkz->start;                                                 \
+        tkz->slice = NULL;                                                     \
         tkz->token->begin = v_begin;                                           \
     }                                                                          \
     while (0)
@@ -123,6 +165,7 @@ extern "C" {
 #define lxb_html_tokenizer_state_token_attr_set_name_begin(tkz, v_begin)       \
     do {                                                                       \
         tkz->pos = tkz->start;                                                 \
+        tkz->slice = NULL;                                                     \
         tkz->token->attr_last->name_begin = v_begin;                           \
     }                                                                          \
     while (0)
@@ -136,6 +179,7 @@ extern "C" {
 #define lxb_html_tokenizer_state_token_attr_set_value_begin(tkz, v_begin)      \
     do {                                                                       \
         tkz->pos = tkz->start;                                                 \
+        tkz->slice = NULL;                                                     \
         tkz->token->attr_last->value_begin = v_begin;                          \
     }                                                                          \
     while (0)
@@ -147,6 +191,8 @@ extern "C" {
     (tkz->token->attr_last->value_end = tkz->last)
 
 #define _lxb_html_tokenizer_state_token_done_m(tkz, v_end)                     \
+    tkz->step_count++;                                                         \
+                                                                               \
     if (!(tkz->opt & LXB_HTML_TOKENIZER_OPT_ATTR_KEEP_DUPLICATE)) {            \
         lxb_html_tokenizer_attr_last_duplicate(tkz);                           \
     }                                                                          \
@@ -171,6 +217,7 @@ extern "C" {
         }                                                                      \
         lxb_html_token_clean(tkz->token);                                      \
         tkz->pos = tkz->start;                                                 \
+        tkz->slice = NULL;                                                     \
     }                                                                          \
     while (0)
 
@@ -179,6 +226,7 @@ extern "C" {
         _lxb_html_tokenizer_state_token_done_m(tkz, v_end)                     \
         lxb_html_token_clean(tkz->token);                                      \
         tkz->pos = tkz->start;                                                 \
+        tkz->slice = NULL;                                                     \
     }                                                                          \
     while (0)
 
@@ -192,6 +240,13 @@ extern "C" {
 
 #define lxb_html_tokenizer_state_set_text(tkz)                                 \
     do {                                                                       \
+        if (tkz->slice != NULL) {                                              \
+            tkz->token->text_start = tkz->slice;                               \
+            tkz->token->text_end = tkz->slice + (tkz->pos - tkz->start);       \
+            tkz->token->type |= LXB_HTML_TOKEN_TYPE_SLICE;                     \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
         tkz->token->text_start = tkz->start;                                   \
         tkz->token->text_end = tkz->pos;                                       \
     }                                                                          \
@@ -6,6 +6,7 @@
 
 #include "lexbor/html/tokenizer/state_comment.h"
 #include "lexbor/html/tokenizer/state.h"
+#include "lexbor/core/simd.h"
 
 #ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
 LXB_EXTERN const lxb_char_t lexbor_str_res_ansi_replacement_character[4];
@@ -75,6 +76,7 @@ lxb_html_tokenizer_state_comment_before_start(lxb_html_tokenizer_t *tkz,
     if (tkz->is_eof == false) {
         lxb_html_tokenizer_state_token_set_begin(tkz, data);
         lxb_html_tokenizer_state_token_set_end(tkz, data);
+        lxb_html_tokenizer_state_slice_set(tkz, data);
     }
 
     tkz->token->tag_id = LXB_TAG__EM_COMMENT;
@@ -169,6 +171,9 @@ lxb_html_tokenizer_state_comment(lxb_html_tokenizer_t *tkz,
                                  const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek4(data, end, 0x3C, 0x2D, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -203,6 +208,7 @@ lxb_html_tokenizer_state_comment(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
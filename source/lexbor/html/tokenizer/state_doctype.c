@@ -781,6 +781,7 @@ lxb_html_tokenizer_state_doctype_public_identifier_double_quoted(lxb_html_tokeni
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
     while (data != end) {
         switch (*data) {
@@ -822,6 +823,7 @@ lxb_html_tokenizer_state_doctype_public_identifier_double_quoted(lxb_html_tokeni
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -897,6 +899,7 @@ lxb_html_tokenizer_state_doctype_public_identifier_single_quoted(lxb_html_tokeni
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
     while (data != end) {
         switch (*data) {
@@ -938,6 +941,7 @@ lxb_html_tokenizer_state_doctype_public_identifier_single_quoted(lxb_html_tokeni
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1336,6 +1340,7 @@ lxb_html_tokenizer_state_doctype_system_identifier_double_quoted(lxb_html_tokeni
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
     while (data != end) {
         switch (*data) {
@@ -1377,6 +1382,7 @@ lxb_html_tokenizer_state_doctype_system_identifier_double_quoted(lxb_html_tokeni
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1452,6 +1458,7 @@ lxb_html_tokenizer_state_doctype_system_identifier_single_quoted(lxb_html_tokeni
     }
 
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
 
     while (data != end) {
         switch (*data) {
@@ -1493,6 +1500,7 @@ lxb_html_tokenizer_state_doctype_system_identifier_single_quoted(lxb_html_tokeni
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -6,6 +6,7 @@
 
 #include "lexbor/html/tokenizer/state_rawtext.h"
 #include "lexbor/html/tokenizer/state.h"
+#include "lexbor/core/simd.h"
 
 #ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
     LXB_EXTERN const lxb_char_t lexbor_str_res_ansi_replacement_character[4];
@@ -64,6 +65,9 @@ lxb_html_tokenizer_state_rawtext(lxb_html_tokenizer_t *tkz,
                                  const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek3(data, end, 0x3C, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -88,6 +92,7 @@ lxb_html_tokenizer_state_rawtext(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -176,7 +181,7 @@ lxb_html_tokenizer_state_rawtext_end_tag_open(lxb_html_tokenizer_t *tkz,
         tkz->state = lxb_html_tokenizer_state_rawtext;
     }
 
-    lxb_html_tokenizer_state_append_m(tkz, "/", 1);
+    lxb_html_tokenizer_state_append_input_m(tkz, data - 1, "/", 1);
 
     return data;
 }
@@ -206,8 +211,7 @@ lxb_html_tokenizer_state_rawtext_end_tag_name(lxb_html_tokenizer_t *tkz,
             case 0x0D:
             case 0x20:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -219,8 +223,7 @@ lxb_html_tokenizer_state_rawtext_end_tag_name(lxb_html_tokenizer_t *tkz,
             /* U+002F SOLIDUS (/) */
             case 0x2F:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -232,8 +235,7 @@ lxb_html_tokenizer_state_rawtext_end_tag_name(lxb_html_tokenizer_t *tkz,
             /* U+003E GREATER-THAN SIGN (>) */
             case 0x3E:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
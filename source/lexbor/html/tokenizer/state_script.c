@@ -6,6 +6,7 @@
 
 #include "lexbor/html/tokenizer/state_script.h"
 #include "lexbor/html/tokenizer/state.h"
+#include "lexbor/core/simd.h"
 
 #ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
     LXB_EXTERN const size_t lexbor_str_res_alpha_character[256];
@@ -151,6 +152,9 @@ lxb_html_tokenizer_state_script_data(lxb_html_tokenizer_t *tkz,
                                      const lxb_char_t *end)
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
+    lxb_html_tokenizer_state_slice_set(tkz, data);
+
+    data = lexbor_simd_seek3(data, end, 0x3C, 0x0D, 0x00);
 
     while (data != end) {
         switch (*data) {
@@ -176,6 +180,7 @@ lxb_html_tokenizer_state_script_data(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -274,7 +279,7 @@ lxb_html_tokenizer_state_script_data_end_tag_open(lxb_html_tokenizer_t *tkz,
         tkz->state = lxb_html_tokenizer_state_script_data;
     }
 
-    lxb_html_tokenizer_state_append_m(tkz, "/", 1);
+    lxb_html_tokenizer_state_append_input_m(tkz, data - 1, "/", 1);
 
     return data;
 }
@@ -304,8 +309,7 @@ lxb_html_tokenizer_state_script_data_end_tag_name(lxb_html_tokenizer_t *tkz,
             case 0x0D:
             case 0x20:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -318,8 +322,7 @@ lxb_html_tokenizer_state_script_data_end_tag_name(lxb_html_tokenizer_t *tkz,
             /* U+002F SOLIDUS (/) */
             case 0x2F:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -332,8 +335,7 @@ lxb_html_tokenizer_state_script_data_end_tag_name(lxb_html_tokenizer_t *tkz,
             /* U+003E GREATER-THAN SIGN (>) */
             case 0x3E:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -458,6 +460,8 @@ lxb_html_tokenizer_state_script_data_escaped(lxb_html_tokenizer_t *tkz,
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
 
+    data = lexbor_simd_seek4(data, end, 0x2D, 0x3C, 0x0D, 0x00);
+
     while (data != end) {
         switch (*data) {
             /* U+002D HYPHEN-MINUS (-) */
@@ -490,6 +494,7 @@ lxb_html_tokenizer_state_script_data_escaped(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -684,7 +689,7 @@ lxb_html_tokenizer_state_script_data_escaped_end_tag_open(lxb_html_tokenizer_t *
         tkz->state = lxb_html_tokenizer_state_script_data_escaped;
     }
 
-    lxb_html_tokenizer_state_append_m(tkz, "/", 1);
+    lxb_html_tokenizer_state_append_input_m(tkz, data - 1, "/", 1);
 
     return data;
 }
@@ -715,8 +720,7 @@ lxb_html_tokenizer_state_script_data_escaped_end_tag_name(
             case 0x0D:
             case 0x20:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -729,8 +733,7 @@ lxb_html_tokenizer_state_script_data_escaped_end_tag_name(
             /* U+002F SOLIDUS (/) */
             case 0x2F:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -743,8 +746,7 @@ lxb_html_tokenizer_state_script_data_escaped_end_tag_name(
             /* U+003E GREATER-THAN SIGN (>) */
             case 0x3E:
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
-                lxb_html_tokenizer_state_set_tag_m(tkz, &tkz->start[tkz->entity_start] + 2,
-                                                   tkz->pos);
+                lxb_html_tokenizer_state_set_end_tag_m(tkz);
 
                 if (tkz->tmp_tag_id != tkz->token->tag_id) {
                     goto anything_else;
@@ -843,7 +845,8 @@ lxb_html_tokenizer_state_script_data_double_escape_start(lxb_html_tokenizer_t *t
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
 
                 if ((tkz->pos - &tkz->start[tkz->entity_start]) == 6
-                    && lexbor_str_data_ncasecmp(&tkz->start[tkz->entity_start],
+                    && lexbor_str_data_ncasecmp(lxb_html_tokenizer_temp_data(tkz)
+                                              + tkz->entity_start,
                                                 (const lxb_char_t *) "script", 6))
                 {
                     tkz->state =
@@ -888,6 +891,8 @@ lxb_html_tokenizer_state_script_data_double_escaped(lxb_html_tokenizer_t *tkz,
 {
     lxb_html_tokenizer_state_begin_set(tkz, data);
 
+    data = lexbor_simd_seek4(data, end, 0x2D, 0x3C, 0x0D, 0x00);
+
     while (data != end) {
         switch (*data) {
             /* U+002D HYPHEN-MINUS (-) */
@@ -920,6 +925,7 @@ lxb_html_tokenizer_state_script_data_double_escaped(lxb_html_tokenizer_t *tkz,
                 }
 
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
+                lxb_html_tokenizer_temp_unslice(tkz);
                 tkz->pos[-1] = 0x0A;
 
                 lxb_html_tokenizer_state_begin_set(tkz, data + 1);
@@ -1139,7 +1145,7 @@ lxb_html_tokenizer_state_script_data_double_escaped_end_tag_open(
         tkz->state = lxb_html_tokenizer_state_script_data_double_escaped;
     }
 
-    lxb_html_tokenizer_state_append_m(tkz, "/", 1);
+    lxb_html_tokenizer_state_append_input_m(tkz, data - 1, "/", 1);
 
     return data;
 }
@@ -1176,7 +1182,8 @@ lxb_html_tokenizer_state_script_data_double_escape_end(
                 lxb_html_tokenizer_state_append_data_m(tkz, data);
 
                 if ((tkz->pos - &tkz->start[tkz->entity_start]) == 6
-                    && lexbor_str_data_ncasecmp(&tkz->start[tkz->entity_start],
+                    && lexbor_str_data_ncasecmp(lxb_html_tokenizer_temp_data(tkz)
+                                              + tkz->entity_start,
                                                 (const lxb_char_t *) "script", 6))
                 {
                     tkz->state = lxb_html_tokenizer_state_script_data_escaped;
@@ -115,6 +115,10 @@ lxb_html_tree_init(lxb_html_tree_t *tree, lxb_html_tokenizer_t *tkz)
     tree->mode = lxb_html_tree_insertion_mode_initial;
     tree->before_append_attr = NULL;
 
+    tree->callback_element = NULL;
+    tree->callback_element_ctx = NULL;
+    tree->callback_element_status = LXB_STATUS_OK;
+
     tree->status = LXB_STATUS_OK;
 
     tree->ref_count = 1;
@@ -174,6 +178,8 @@ lxb_html_tree_clean(lxb_html_tree_t *tree)
     tree->mode = lxb_html_tree_insertion_mode_initial;
     tree->before_append_attr = NULL;
 
+    tree->callback_element_status = LXB_STATUS_OK;
+
     tree->status = LXB_STATUS_OK;
 }
 
@@ -296,6 +302,10 @@ lxb_html_tree_insertion_mode(lxb_html_tree_t *tree, lxb_html_token_t *token)
 {
     while (lxb_html_tree_construction_dispatcher(tree, token) == false) {}
 
+    if (tree->status == LXB_STATUS_OK) {
+        return tree->callback_element_status;
+    }
+
     return tree->status;
 }
 
@@ -420,6 +430,10 @@ lxb_html_tree_insert_foreign_element(lxb_html_tree_t *tree,
         return lxb_html_interface_destroy(element);
     }
 
+    if (only_add_stack == false) {
+        lxb_html_tree_element_inserted(tree, lxb_dom_interface_node(element));
+    }
+
     return element;
 }
 
@@ -494,7 +508,10 @@ lxb_html_tree_append_attributes(lxb_html_tree_t *tree,
             }
         }
 
-        lxb_dom_element_attr_append(element, attr);
+        status = lxb_dom_element_attr_append(element, attr);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
 
         token_attr = token_attr->next;
     }
@@ -533,7 +550,10 @@ lxb_html_tree_append_attributes_from_element(lxb_html_tree_t *tree,
             }
         }
 
-        lxb_dom_element_attr_append(element, new_attr);
+        status = lxb_dom_element_attr_append(element, new_attr);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
 
         attr = attr->next;
     }
@@ -667,26 +687,33 @@ lxb_html_tree_adjust_foreign_attributes(lxb_html_tree_t *tree,
     return LXB_STATUS_OK;
 }
 
+lxb_status_t
+lxb_html_tree_make_text(lxb_html_tree_t *tree, lxb_html_token_t *token,
+                        lexbor_str_t *str)
+{
+    if (token->type & LXB_HTML_TOKEN_TYPE_SLICE) {
+        str->data = (lxb_char_t *) token->text_start;
+        str->length = token->text_end - token->text_start;
+
+        return LXB_STATUS_OK;
+    }
+
+    return lxb_html_token_make_text(token, str,
+                                    tree->document->dom_document.text);
+}
+
 lxb_status_t
 lxb_html_tree_insert_character(lxb_html_tree_t *tree, lxb_html_token_t *token,
                                lxb_dom_node_t **ret_node)
 {
-    size_t size;
     lxb_status_t status;
     lexbor_str_t str = {0};
 
-    size = token->text_end - token->text_start;
-
-    lexbor_str_init(&str, tree->document->dom_document.text, size + 1);
-    if (str.data == NULL) {
-        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    status = lxb_html_tree_make_text(tree, token, &str);
+    if (status != LXB_STATUS_OK) {
+        return status;
     }
 
-    memcpy(str.data, token->text_start, size);
-
-    str.data[size] = 0x00;
-    str.length = size;
-
     status = lxb_html_tree_insert_character_for_data(tree, &str, ret_node);
     if (status != LXB_STATUS_OK) {
         return status;
@@ -700,6 +727,7 @@ lxb_html_tree_insert_character_for_data(lxb_html_tree_t *tree,
                                         lexbor_str_t *str,
                                         lxb_dom_node_t **ret_node)
 {
+    lxb_status_t status;
     const lxb_char_t *data;
     lxb_dom_node_t *pos;
     lxb_dom_character_data_t *chrs = NULL;
@@ -742,6 +770,13 @@ lxb_html_tree_insert_character_for_data(lxb_html_tree_t *tree,
     }
 
     if (chrs != NULL) {
+        /* The text can point into the input; appending needs own memory. */
+        status = lxb_dom_document_input_detach(&tree->document->dom_document,
+                                               &chrs->data);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
         /* This is error. This can not happen, but... */
         if (chrs->data.data == NULL) {
             data = lexbor_str_init(&chrs->data, tree->document->dom_document.text,
@@ -778,7 +813,10 @@ lxb_html_tree_insert_character_for_data(lxb_html_tree_t *tree,
 
 destroy_str:
 
-    lexbor_str_destroy(str, tree->document->dom_document.text, false);
+    if (str->data != NULL) {
+        (void) lxb_dom_document_destroy_text(&tree->document->dom_document,
+                                             str->data);
+    }
 
     return LXB_STATUS_OK;
 }
@@ -1631,8 +1669,37 @@ lxb_html_tree_adoption_agency_algorithm(lxb_html_tree_t *tree,
             return false;
         }
 
+        /*
+         * The elements made in State 14.7 hold each the next one, down to
+         * the furthest block.  They go into the tree one by one, so that
+         * each is reported before it has a child.
+         */
+        lxb_dom_node_t *chain, *child;
+
+        node = last;
+        chain = (node != furthest_block) ? node->first_child : NULL;
+
+        if (chain != NULL) {
+            lxb_dom_node_remove_wo_events(chain);
+        }
+
         lxb_html_tree_insert_node(pos, last, ipos);
 
+        while (node != furthest_block) {
+            lxb_html_tree_element_inserted(tree, node);
+
+            child = chain;
+            chain = (child != furthest_block) ? child->first_child : NULL;
+
+            if (chain != NULL) {
+                lxb_dom_node_remove_wo_events(chain);
+            }
+
+            lxb_dom_node_insert_child_wo_events(node, child);
+
+            node = child;
+        }
+
         /* State 16 */
         lxb_html_token_t fake_token = {0};
 
@@ -1665,6 +1732,8 @@ lxb_html_tree_adoption_agency_algorithm(lxb_html_tree_t *tree,
         /* State 18 */
         lxb_dom_node_insert_child_wo_events(furthest_block, node);
 
+        lxb_html_tree_element_inserted(tree, node);
+
         /* State 19 */
         lxb_html_tree_active_formatting_remove(tree, formatting_index);
 
@@ -1708,15 +1777,17 @@ lxb_html_tree_html_integration_point(lxb_dom_node_t *node)
         }
 
         if (attr->value->length == 9
-            && lexbor_str_data_casecmp(attr->value->data,
-                                       (const lxb_char_t *) "text/html"))
+            && lexbor_str_data_ncasecmp(attr->value->data,
+                                        (const lxb_char_t *) "text/html",
+                                        9))
         {
             return true;
         }
 
         if (attr->value->length == 21
-            && lexbor_str_data_casecmp(attr->value->data,
-                                       (const lxb_char_t *) "application/xhtml+xml"))
+            && lexbor_str_data_ncasecmp(attr->value->data,
+                                        (const lxb_char_t *) "application/xhtml+xml",
+                                        21))
         {
             return true;
         }
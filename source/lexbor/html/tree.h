@@ -30,6 +30,13 @@ typedef lxb_status_t
 (*lxb_html_tree_append_attr_f)(lxb_html_tree_t *tree,
                                lxb_dom_attr_t *attr, void *ctx);
 
+/*
+ * Called for each element as it is put into the tree, see
+ * lxb_html_tree_callback_element_set().
+ */
+typedef lxb_status_t
+(*lxb_html_tree_element_f)(lxb_dom_element_t *element, void *ctx);
+
 typedef struct {
     lexbor_array_obj_t *text_list;
     bool               have_non_ws;
@@ -60,6 +67,10 @@ struct lxb_html_tree {
     lxb_html_tree_insertion_mode_f original_mode;
     lxb_html_tree_append_attr_f    before_append_attr;
 
+    lxb_html_tree_element_f        callback_element;
+    void                           *callback_element_ctx;
+    lxb_status_t                   callback_element_status;
+
     lxb_status_t                   status;
 
     size_t                         ref_count;
@@ -141,6 +152,16 @@ LXB_API lxb_status_t
 lxb_html_tree_adjust_foreign_attributes(lxb_html_tree_t *tree,
                                         lxb_dom_attr_t *attr, void *ctx);
 
+/*
+ * Makes a text string from the token.
+ * With LXB_DOM_DOCUMENT_OPT_BORROW_INPUT the string points into the document
+ * input buffer if the text did not need rewriting; such a string is not
+ * null-terminated.
+ */
+LXB_API lxb_status_t
+lxb_html_tree_make_text(lxb_html_tree_t *tree, lxb_html_token_t *token,
+                        lexbor_str_t *str);
+
 LXB_API lxb_status_t
 lxb_html_tree_insert_character(lxb_html_tree_t *tree, lxb_html_token_t *token,
                                lxb_dom_node_t **ret_node);
@@ -244,6 +265,11 @@ lxb_html_tree_begin(lxb_html_tree_t *tree, lxb_html_document_t *document)
 lxb_inline lxb_status_t
 lxb_html_tree_chunk(lxb_html_tree_t *tree, const lxb_char_t *html, size_t size)
 {
+    /* Tokens can point into the chunk only if the document keeps it alive. */
+    lxb_html_tokenizer_slices_set(tree->tkz_ref,
+        lxb_dom_document_input_borrow(&tree->document->dom_document,
+                                      html, size));
+
     return lxb_html_tokenizer_chunk(tree->tkz_ref, html, size);
 }
 
@@ -261,14 +287,23 @@ lxb_inline lxb_status_t
 lxb_html_tree_build(lxb_html_tree_t *tree, lxb_html_document_t *document,
                     const lxb_char_t *html, size_t size)
 {
+    lxb_status_t status;
+
     tree->status = lxb_html_tree_begin(tree, document);
     if (tree->status != LXB_STATUS_OK) {
         return tree->status;
     }
 
-    tree->status = lxb_html_tree_chunk(tree, html, size);
-    if (tree->status != LXB_STATUS_OK) {
-        return tree->status;
+    /* tree->status is read by the builder, so not set while paused. */
+    status = lxb_html_tree_chunk(tree, html, size);
+
+    while (status == LXB_STATUS_CONTINUE) {
+        status = lxb_html_tokenizer_chunk_resume(tree->tkz_ref);
+    }
+
+    if (status != LXB_STATUS_OK) {
+        tree->status = status;
+        return status;
     }
 
     return lxb_html_tree_end(tree);
@@ -375,6 +410,50 @@ lxb_html_tree_scripting_set(lxb_html_tree_t *tree, bool scripting)
     tree->scripting = scripting;
 }
 
+/*
+ * The callback is called for each element created by the parser once it is
+ * in the tree, with its attributes, ancestors and preceding siblings; its
+ * children and following siblings are not there yet.  Elements moved later
+ * by the adoption agency algorithm or foster parenting are not reported
+ * again; a foster parented element has the table after it, and the
+ * element that the adoption agency algorithm makes for the formatting
+ * element is reported holding the children it took over.  Attributes that
+ * a later <html> or <body> start tag adds to the existing element are not
+ * reported.
+ *
+ * If the callback returns LXB_STATUS_STOP, the parsing ends there: the tree
+ * built so far is kept and the parser returns LXB_STATUS_STOPPED.  Any other
+ * status than LXB_STATUS_OK ends the parsing with that status.
+ *
+ * The callback stays set after the tree is cleaned; NULL removes it.
+ */
+lxb_inline void
+lxb_html_tree_callback_element_set(lxb_html_tree_t *tree,
+                                   lxb_html_tree_element_f cb, void *ctx)
+{
+    tree->callback_element = cb;
+    tree->callback_element_ctx = ctx;
+}
+
+lxb_inline void
+lxb_html_tree_element_inserted(lxb_html_tree_t *tree, lxb_dom_node_t *node)
+{
+    lxb_status_t status;
+
+    if (tree->callback_element == NULL
+        || tree->callback_element_status != LXB_STATUS_OK)
+    {
+        return;
+    }
+
+    status = tree->callback_element(lxb_dom_interface_element(node),
+                                    tree->callback_element_ctx);
+    if (status != LXB_STATUS_OK) {
+        tree->callback_element_status = (status == LXB_STATUS_STOP)
+                                        ? LXB_STATUS_STOPPED : status;
+    }
+}
+
 lxb_inline void
 lxb_html_tree_attach_document(lxb_html_tree_t *tree, lxb_html_document_t *doc)
 {
@@ -172,5 +172,7 @@ lxb_html_tree_insertion_mode_before_html_html(lxb_html_tree_t *tree,
     lxb_dom_document_attach_element(&tree->document->dom_document,
                                     lxb_dom_interface_element(node_html));
 
+    lxb_html_tree_element_inserted(tree, node_html);
+
     return LXB_STATUS_OK;
 }
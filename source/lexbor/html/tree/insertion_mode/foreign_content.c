@@ -145,8 +145,7 @@ lxb_html_tree_insertion_mode_foreign_content_text(lxb_html_tree_t *tree,
                                                              tree->document->dom_document.text);
     }
     else {
-        tree->status = lxb_html_token_make_text(token, &str,
-                                                tree->document->dom_document.text);
+        tree->status = lxb_html_tree_make_text(tree, token, &str);
     }
 
     if (tree->status != LXB_STATUS_OK) {
@@ -155,7 +154,10 @@ lxb_html_tree_insertion_mode_foreign_content_text(lxb_html_tree_t *tree,
 
     /* Can be zero only if all NULL are gone */
     if (str.length == 0) {
-        lexbor_str_destroy(&str, tree->document->dom_document.text, false);
+        if (str.data != NULL) {
+            (void) lxb_dom_document_destroy_text(&tree->document->dom_document,
+                                                 str.data);
+        }
 
         return true;
     }
@@ -92,8 +92,7 @@ lxb_html_tree_insertion_mode_in_body_text(lxb_html_tree_t *tree,
                                                           tree->document->dom_document.text);
     }
     else {
-        tree->status = lxb_html_token_make_text(token, &str,
-                                                tree->document->dom_document.text);
+        tree->status = lxb_html_tree_make_text(tree, token, &str);
     }
 
     if (tree->status != LXB_STATUS_OK) {
@@ -102,7 +101,10 @@ lxb_html_tree_insertion_mode_in_body_text(lxb_html_tree_t *tree,
 
     /* Can be zero only if all NULL are gone */
     if (str.length == 0) {
-        lexbor_str_destroy(&str, tree->document->dom_document.text, false);
+        if (str.data != NULL) {
+            (void) lxb_dom_document_destroy_text(&tree->document->dom_document,
+                                                 str.data);
+        }
 
         return true;
     }
@@ -1330,7 +1332,8 @@ lxb_html_tree_insertion_mode_in_body_input(lxb_html_tree_t *tree,
                                          (lxb_char_t *) "type", 4);
     if (attr != NULL) {
         if (attr->value == NULL || attr->value->length != 6
-            || lexbor_str_data_cmp(attr->value->data, (lxb_char_t *) "hidden") == false)
+            || lexbor_str_data_ncmp(attr->value->data,
+                                    (lxb_char_t *) "hidden", 6) == false)
         {
             tree->frameset_ok = false;
         }
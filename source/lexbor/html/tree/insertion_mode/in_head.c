@@ -281,6 +281,8 @@ lxb_html_tree_insertion_mode_in_head_script(lxb_html_tree_t *tree,
 
     lxb_html_tree_insert_node(ap_node, lxb_dom_interface_node(element), ipos);
 
+    lxb_html_tree_element_inserted(tree, lxb_dom_interface_node(element));
+
     /*
      * Need for tokenizer state Script
      * See description for
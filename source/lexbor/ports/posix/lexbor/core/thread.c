@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/core/thread.h"
+
+
+#ifndef LEXBOR_WITHOUT_THREADS
+
+#include <pthread.h>
+
+
+typedef struct {
+    pthread_t       id;
+    lexbor_thread_f func;
+    void            *ctx;
+}
+lexbor_thread_t;
+
+
+static void *
+lexbor_thread_start(void *arg)
+{
+    lexbor_thread_t *thread = arg;
+
+    thread->func(thread->ctx);
+
+    return NULL;
+}
+
+void *
+lexbor_thread_create(lexbor_thread_f func, void *ctx)
+{
+    lexbor_thread_t *thread;
+
+    thread = lexbor_malloc(sizeof(lexbor_thread_t));
+    if (thread == NULL) {
+        return NULL;
+    }
+
+    thread->func = func;
+    thread->ctx = ctx;
+
+    if (pthread_create(&thread->id, NULL, lexbor_thread_start, thread) != 0) {
+        return lexbor_free(thread);
+    }
+
+    return thread;
+}
+
+void
+lexbor_thread_join(void *thread)
+{
+    if (thread != NULL) {
+        (void) pthread_join(((lexbor_thread_t *) thread)->id, NULL);
+        lexbor_free(thread);
+    }
+}
+
+#else /* LEXBOR_WITHOUT_THREADS */
+
+void *
+lexbor_thread_create(lexbor_thread_f func, void *ctx)
+{
+    return NULL;
+}
+
+void
+lexbor_thread_join(void *thread)
+{
+}
+
+#endif /* LEXBOR_WITHOUT_THREADS */
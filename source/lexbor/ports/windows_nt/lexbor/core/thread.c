@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/core/thread.h"
+
+
+#ifndef LEXBOR_WITHOUT_THREADS
+
+#include <windows.h>
+
+
+typedef struct {
+    HANDLE          handle;
+    lexbor_thread_f func;
+    void            *ctx;
+}
+lexbor_thread_t;
+
+
+static DWORD WINAPI
+lexbor_thread_start(LPVOID arg)
+{
+    lexbor_thread_t *thread = arg;
+
+    thread->func(thread->ctx);
+
+    return 0;
+}
+
+void *
+lexbor_thread_create(lexbor_thread_f func, void *ctx)
+{
+    lexbor_thread_t *thread;
+
+    thread = lexbor_malloc(sizeof(lexbor_thread_t));
+    if (thread == NULL) {
+        return NULL;
+    }
+
+    thread->func = func;
+    thread->ctx = ctx;
+
+    thread->handle = CreateThread(NULL, 0, lexbor_thread_start, thread, 0, NULL);
+    if (thread->handle == NULL) {
+        return lexbor_free(thread);
+    }
+
+    return thread;
+}
+
+void
+lexbor_thread_join(void *thread)
+{
+    lexbor_thread_t *th = thread;
+
+    if (th != NULL) {
+        (void) WaitForSingleObject(th->handle, INFINITE);
+        (void) CloseHandle(th->handle);
+
+        lexbor_free(th);
+    }
+}
+
+#else /* LEXBOR_WITHOUT_THREADS */
+
+void *
+lexbor_thread_create(lexbor_thread_f func, void *ctx)
+{
+    return NULL;
+}
+
+void
+lexbor_thread_join(void *thread)
+{
+}
+
+#endif /* LEXBOR_WITHOUT_THREADS */
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/selectors/lru.h"
+
+
+static void
+lxb_selectors_lru_link(lxb_selectors_lru_t *lru,
+                       lxb_selectors_lru_entry_t *entry);
+
+static void
+lxb_selectors_lru_unlink(lxb_selectors_lru_t *lru,
+                         lxb_selectors_lru_entry_t *entry);
+
+static void
+lxb_selectors_lru_drop(lxb_selectors_lru_t *lru,
+                       lxb_selectors_lru_entry_t *entry);
+
+static lxb_selectors_lru_entry_t *
+lxb_selectors_lru_entry_destroy(lxb_selectors_lru_entry_t *entry);
+
+
+lxb_selectors_lru_t *
+lxb_selectors_lru_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_selectors_lru_t));
+}
+
+lxb_status_t
+lxb_selectors_lru_init(lxb_selectors_lru_t *lru, size_t capacity)
+{
+    lxb_status_t status;
+
+    if (lru == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    if (capacity == 0) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    lru->hash = lexbor_hash_create();
+    status = lexbor_hash_init(lru->hash, lexbor_min(capacity * 2, 1024),
+                              sizeof(lxb_selectors_lru_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lru->parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(lru->parser, NULL);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lru->first = NULL;
+    lru->last = NULL;
+    lru->length = 0;
+    lru->capacity = capacity;
+    lru->hits = 0;
+    lru->misses = 0;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_lru_clean(lxb_selectors_lru_t *lru)
+{
+    while (lru->last != NULL) {
+        lxb_selectors_lru_drop(lru, lru->last);
+    }
+
+    lru->hits = 0;
+    lru->misses = 0;
+}
+
+lxb_selectors_lru_t *
+lxb_selectors_lru_destroy(lxb_selectors_lru_t *lru, bool self_destroy)
+{
+    if (lru == NULL) {
+        return NULL;
+    }
+
+    if (lru->hash != NULL) {
+        lxb_selectors_lru_clean(lru);
+
+        lru->hash = lexbor_hash_destroy(lru->hash, true);
+    }
+
+    lru->parser = lxb_css_parser_destroy(lru->parser, true);
+
+    if (self_destroy) {
+        return lexbor_free(lru);
+    }
+
+    return lru;
+}
+
+static lxb_status_t
+lxb_selectors_lru_parse(lxb_selectors_lru_t *lru,
+                        lxb_selectors_lru_entry_t *entry,
+                        const lxb_char_t *data, size_t length)
+{
+    lxb_status_t status;
+
+    entry->memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(entry->memory, 64);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lxb_css_parser_memory_set(lru->parser, entry->memory);
+
+    entry->list = lxb_css_selectors_parse(lru->parser, data, length);
+
+    /* The memory goes with the entry, not with the parser. */
+    lxb_css_parser_memory_set(lru->parser, NULL);
+
+    if (entry->list == NULL) {
+        status = lxb_css_parser_status(lru->parser);
+
+        return (status != LXB_STATUS_OK) ? status
+                                         : LXB_STATUS_ERROR_UNEXPECTED_DATA;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_lru_get(lxb_selectors_lru_t *lru, const lxb_char_t *data,
+                      size_t length, lxb_selectors_lru_entry_t **entry)
+{
+    lxb_status_t status;
+    lxb_selectors_lru_entry_t *value;
+    lxb_selectors_lru_bucket_t *bucket;
+
+    *entry = NULL;
+
+    bucket = lexbor_hash_search(lru->hash, lexbor_hash_search_raw,
+                                data, length);
+    if (bucket != NULL) {
+        value = bucket->value;
+
+        if (value != lru->first) {
+            lxb_selectors_lru_unlink(lru, value);
+            lxb_selectors_lru_link(lru, value);
+        }
+
+        lru->hits++;
+    }
+    else {
+        value = lexbor_calloc(1, sizeof(lxb_selectors_lru_entry_t));
+        if (value == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        status = lxb_selectors_lru_parse(lru, value, data, length);
+        if (status != LXB_STATUS_OK) {
+            (void) lxb_selectors_lru_entry_destroy(value);
+            return status;
+        }
+
+        if (lru->length == lru->capacity) {
+            lxb_selectors_lru_drop(lru, lru->last);
+        }
+
+        bucket = lexbor_hash_insert(lru->hash, lexbor_hash_insert_raw,
+                                    data, length);
+        if (bucket == NULL) {
+            (void) lxb_selectors_lru_entry_destroy(value);
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        bucket->value = value;
+
+        value->key = &bucket->entry;
+        value->refs = 1;
+
+        lxb_selectors_lru_link(lru, value);
+
+        lru->length++;
+        lru->misses++;
+    }
+
+    value->refs++;
+    *entry = value;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_lru_release(lxb_selectors_lru_entry_t *entry)
+{
+    if (--entry->refs == 0) {
+        (void) lxb_selectors_lru_entry_destroy(entry);
+    }
+}
+
+const lxb_selectors_program_t *
+lxb_selectors_lru_program(lxb_selectors_lru_entry_t *entry)
+{
+    lxb_status_t status;
+
+    if (entry->program != NULL) {
+        return entry->program;
+    }
+
+    entry->program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(entry->program);
+    if (status != LXB_STATUS_OK) {
+        goto failed;
+    }
+
+    status = lxb_selectors_program_compile(entry->program, entry->list);
+    if (status != LXB_STATUS_OK) {
+        goto failed;
+    }
+
+    return entry->program;
+
+failed:
+
+    entry->program = lxb_selectors_program_destroy(entry->program, true);
+
+    return NULL;
+}
+
+static void
+lxb_selectors_lru_link(lxb_selectors_lru_t *lru,
+                       lxb_selectors_lru_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = lru->first;
+
+    if (lru->first != NULL) {
+        lru->first->prev = entry;
+    }
+    else {
+        lru->last = entry;
+    }
+
+    lru->first = entry;
+}
+
+static void
+lxb_selectors_lru_unlink(lxb_selectors_lru_t *lru,
+                         lxb_selectors_lru_entry_t *entry)
+{
+    if (entry->prev != NULL) {
+        entry->prev->next = entry->next;
+    }
+    else {
+        lru->first = entry->next;
+    }
+
+    if (entry->next != NULL) {
+        entry->next->prev = entry->prev;
+    }
+    else {
+        lru->last = entry->prev;
+    }
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+/* Takes the entry out of the cache; it is freed once released by all. */
+static void
+lxb_selectors_lru_drop(lxb_selectors_lru_t *lru,
+                       lxb_selectors_lru_entry_t *entry)
+{
+    lxb_selectors_lru_unlink(lru, entry);
+
+    lexbor_hash_remove(lru->hash, lexbor_hash_search_raw,
+                       lexbor_hash_entry_str(entry->key), entry->key->length);
+
+    entry->key = NULL;
+    lru->length--;
+
+    lxb_selectors_lru_release(entry);
+}
+
+static lxb_selectors_lru_entry_t *
+lxb_selectors_lru_entry_destroy(lxb_selectors_lru_entry_t *entry)
+{
+    (void) lxb_selectors_program_destroy(entry->program, true);
+
+    /* The list is in the memory. */
+    (void) lxb_css_memory_destroy(entry->memory, true);
+
+    return lexbor_free(entry);
+}
+
+/*
+ * No inline functions for ABI.
+ */
+size_t
+lxb_selectors_lru_length_noi(const lxb_selectors_lru_t *lru)
+{
+    return lxb_selectors_lru_length(lru);
+}
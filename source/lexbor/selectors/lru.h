@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SELECTORS_LRU_H
+#define LEXBOR_SELECTORS_LRU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/selectors/program.h"
+#include "lexbor/css/parser.h"
+#include "lexbor/core/hash.h"
+
+
+typedef struct lxb_selectors_lru_entry lxb_selectors_lru_entry_t;
+
+/*
+ * A parsed selector list with its own lxb_css_memory_t.
+ *
+ * The list and the program are never changed once made, so they can be used
+ * with any document and any lxb_selectors_t.  An entry lives as long as the
+ * cache holds it or someone has not released it.
+ */
+struct lxb_selectors_lru_entry {
+    lxb_css_selector_list_t   *list;
+    lxb_selectors_program_t   *program;  /* Made on first request. */
+    lxb_css_memory_t          *memory;
+
+    size_t                    refs;
+    lexbor_hash_entry_t       *key;      /* NULL once out of the cache. */
+
+    lxb_selectors_lru_entry_t *prev;     /* More recently used. */
+    lxb_selectors_lru_entry_t *next;
+};
+
+typedef struct {
+    lexbor_hash_entry_t       entry;
+    lxb_selectors_lru_entry_t *value;
+}
+lxb_selectors_lru_bucket_t;
+
+/*
+ * Parsed selector lists by their source text, at most capacity of them.
+ * When the cache is full, the least recently used list is dropped.
+ *
+ * Texts are compared byte by byte: "div p" and "div  p" are two entries.
+ * Texts that do not parse are not kept.
+ */
+typedef struct {
+    lexbor_hash_t             *hash;
+    lxb_css_parser_t          *parser;
+
+    lxb_selectors_lru_entry_t *first;    /* Most recently used. */
+    lxb_selectors_lru_entry_t *last;
+
+    size_t                    length;
+    size_t                    capacity;
+
+    size_t                    hits;
+    size_t                    misses;
+}
+lxb_selectors_lru_t;
+
+
+LXB_API lxb_selectors_lru_t *
+lxb_selectors_lru_create(void);
+
+/*
+ * @param[in] lxb_selectors_lru_t *.
+ * @param[in] size_t.  The most selector lists in the cache, not 0.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_lru_init(lxb_selectors_lru_t *lru, size_t capacity);
+
+/*
+ * Drops all selector lists.  Entries that are not released yet stay valid.
+ */
+LXB_API void
+lxb_selectors_lru_clean(lxb_selectors_lru_t *lru);
+
+LXB_API lxb_selectors_lru_t *
+lxb_selectors_lru_destroy(lxb_selectors_lru_t *lru, bool self_destroy);
+
+/*
+ * The selector list for the text, parsed on the first request.
+ *
+ * The entry must be given back with lxb_selectors_lru_release(), also after
+ * the cache is cleaned or destroyed.
+ *
+ * @param[in] lxb_selectors_lru_t *.
+ * @param[in] const lxb_char_t *.  Selectors text.
+ * @param[in] size_t.  Length of the text.
+ * @param[out] lxb_selectors_lru_entry_t **.  The entry, NULL on failure.
+ *
+ * @return LXB_STATUS_OK if successful, LXB_STATUS_ERROR_UNEXPECTED_DATA if
+ * the text is not a selector list, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_lru_get(lxb_selectors_lru_t *lru, const lxb_char_t *data,
+                      size_t length, lxb_selectors_lru_entry_t **entry);
+
+LXB_API void
+lxb_selectors_lru_release(lxb_selectors_lru_entry_t *entry);
+
+/*
+ * The list of the entry compiled by lxb_selectors_program_compile(), made
+ * once and kept with the entry.
+ *
+ * @return the program, or NULL on memory allocation failure.
+ */
+LXB_API const lxb_selectors_program_t *
+lxb_selectors_lru_program(lxb_selectors_lru_entry_t *entry);
+
+
+/*
+ * Inline functions.
+ */
+lxb_inline size_t
+lxb_selectors_lru_length(const lxb_selectors_lru_t *lru)
+{
+    return lru->length;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API size_t
+lxb_selectors_lru_length_noi(const lxb_selectors_lru_t *lru);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SELECTORS_LRU_H */
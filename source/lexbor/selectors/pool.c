@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/selectors/pool.h"
+#include "lexbor/core/thread.h"
+
+
+/* Units for each worker, so that a slow unit does not hold up the rest. */
+#define LXB_SELECTORS_POOL_UNITS 8
+
+
+static void
+lxb_selectors_pool_run(void *ctx);
+
+static lxb_status_t
+lxb_selectors_pool_found_cb(lxb_dom_node_t *node,
+                            lxb_css_selector_specificity_t spec, void *ctx);
+
+
+lxb_selectors_pool_t *
+lxb_selectors_pool_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_selectors_pool_t));
+}
+
+lxb_status_t
+lxb_selectors_pool_init(lxb_selectors_pool_t *pool, size_t workers)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_selectors_pool_worker_t *worker;
+
+    if (pool == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    if (workers == 0) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    pool->workers = lexbor_calloc(workers, sizeof(lxb_selectors_pool_worker_t));
+    if (pool->workers == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    pool->length = workers;
+
+    for (i = 0; i < workers; i++) {
+        worker = &pool->workers[i];
+
+        worker->pool = pool;
+        worker->first = i;
+
+        worker->found = lexbor_array_obj_create();
+        status = lexbor_array_obj_init(worker->found, 256,
+                                       sizeof(lxb_selectors_pool_found_t));
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        /* The first worker uses the lxb_selectors_t of the caller. */
+        if (i == 0) {
+            continue;
+        }
+
+        worker->selectors = lxb_selectors_create();
+        status = lxb_selectors_init(worker->selectors);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    pool->units_size = workers * LXB_SELECTORS_POOL_UNITS * 2;
+    pool->units = lexbor_malloc(sizeof(lxb_selectors_pool_unit_t)
+                                * pool->units_size);
+    if (pool->units == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    pool->units_length = 0;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_pool_clean(lxb_selectors_pool_t *pool)
+{
+    size_t i;
+
+    for (i = 0; i < pool->length; i++) {
+        lexbor_array_obj_clean(pool->workers[i].found);
+
+        if (pool->workers[i].selectors != NULL && i != 0) {
+            lxb_selectors_clean(pool->workers[i].selectors);
+        }
+    }
+
+    pool->units_length = 0;
+}
+
+lxb_selectors_pool_t *
+lxb_selectors_pool_destroy(lxb_selectors_pool_t *pool, bool self_destroy)
+{
+    size_t i;
+
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    if (pool->workers != NULL) {
+        for (i = 0; i < pool->length; i++) {
+            pool->workers[i].found =
+                lexbor_array_obj_destroy(pool->workers[i].found, true);
+
+            if (i != 0) {
+                pool->workers[i].selectors =
+                    lxb_selectors_destroy(pool->workers[i].selectors, true);
+            }
+        }
+
+        pool->workers = lexbor_free(pool->workers);
+    }
+
+    if (pool->units != NULL) {
+        pool->units = lexbor_free(pool->units);
+    }
+
+    if (self_destroy) {
+        return lexbor_free(pool);
+    }
+
+    return pool;
+}
+
+static lxb_status_t
+lxb_selectors_pool_unit_append(lxb_selectors_pool_unit_t **units,
+                               size_t *length, size_t *size,
+                               lxb_dom_node_t *node, bool deep)
+{
+    lxb_selectors_pool_unit_t *tmp;
+
+    if (*length == *size) {
+        tmp = lexbor_realloc(*units, sizeof(lxb_selectors_pool_unit_t)
+                                     * *size * 2);
+        if (tmp == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        *units = tmp;
+        *size *= 2;
+    }
+
+    (*units)[*length].node = node;
+    (*units)[*length].deep = deep;
+    (*length)++;
+
+    return LXB_STATUS_OK;
+}
+
+/* The element children of the node, each with its subtree. */
+static lxb_status_t
+lxb_selectors_pool_unit_children(lxb_selectors_pool_unit_t **units,
+                                 size_t *length, size_t *size,
+                                 lxb_dom_node_t *node)
+{
+    lxb_status_t status;
+
+    for (node = node->first_child; node != NULL; node = node->next) {
+        if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            status = lxb_selectors_pool_unit_append(units, length, size,
+                                                    node, true);
+            if (status != LXB_STATUS_OK) {
+                return status;
+            }
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+/*
+ * Cuts the tree into units in document order.  A unit with a subtree is
+ * replaced by its node alone and the subtrees of its children, level by
+ * level, until there are enough units for the workers.
+ */
+static lxb_status_t
+lxb_selectors_pool_split(lxb_selectors_pool_t *pool, lxb_dom_node_t *root,
+                         bool match_root)
+{
+    size_t i, need, length, size;
+    bool split;
+    lxb_status_t status;
+    lxb_selectors_pool_unit_t *units, *unit;
+
+    pool->units_length = 0;
+
+    if (match_root && root->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+        status = lxb_selectors_pool_unit_append(&pool->units,
+                                                &pool->units_length,
+                                                &pool->units_size,
+                                                root, false);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    status = lxb_selectors_pool_unit_children(&pool->units,
+                                              &pool->units_length,
+                                              &pool->units_size, root);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    need = pool->length * LXB_SELECTORS_POOL_UNITS;
+
+    while (pool->units_length < need) {
+        size = pool->units_size;
+        length = 0;
+
+        units = lexbor_malloc(sizeof(lxb_selectors_pool_unit_t) * size);
+        if (units == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        split = false;
+
+        for (i = 0; i < pool->units_length; i++) {
+            unit = &pool->units[i];
+
+            if (!unit->deep || unit->node->first_child == NULL
+                || length + (pool->units_length - i) >= need)
+            {
+                status = lxb_selectors_pool_unit_append(&units, &length, &size,
+                                                        unit->node,
+                                                        unit->deep);
+            }
+            else {
+                split = true;
+
+                status = lxb_selectors_pool_unit_append(&units, &length, &size,
+                                                        unit->node, false);
+                if (status == LXB_STATUS_OK) {
+                    status = lxb_selectors_pool_unit_children(&units, &length,
+                                                              &size,
+                                                              unit->node);
+                }
+            }
+
+            if (status != LXB_STATUS_OK) {
+                lexbor_free(units);
+                return status;
+            }
+        }
+
+        lexbor_free(pool->units);
+
+        pool->units = units;
+        pool->units_length = length;
+        pool->units_size = size;
+
+        if (!split) {
+            break;
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_pool_find(lxb_selectors_pool_t *pool, lxb_selectors_t *selectors,
+                        lxb_dom_node_t *root,
+                        const lxb_css_selector_list_t *list,
+                        lxb_selectors_cb_f cb, void *ctx)
+{
+    size_t i, n;
+    void **threads;
+    lxb_status_t status;
+    lxb_selectors_opt_t options;
+    lxb_selectors_pool_unit_t *unit;
+    lxb_selectors_pool_found_t *found;
+    lxb_selectors_pool_worker_t *worker;
+
+    if (pool->length == 1) {
+        return lxb_selectors_find(selectors, root, list, cb, ctx);
+    }
+
+    options = selectors->options;
+
+    status = lxb_selectors_pool_split(pool, root,
+                                      options & LXB_SELECTORS_OPT_MATCH_ROOT);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    if (pool->units_length < 2) {
+        return lxb_selectors_find(selectors, root, list, cb, ctx);
+    }
+
+    threads = lexbor_calloc(pool->length, sizeof(void *));
+    if (threads == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    pool->workers[0].selectors = selectors;
+
+    for (i = 0; i < pool->length; i++) {
+        worker = &pool->workers[i];
+
+        worker->list = list;
+        worker->status = LXB_STATUS_OK;
+        /*
+         * Every unit would go through the whole index lists, and the index
+         * would be shared between the threads: units are walked.
+         */
+        worker->selectors->options = options | LXB_SELECTORS_OPT_MATCH_ROOT
+                                     | LXB_SELECTORS_OPT_WALK;
+
+        lexbor_array_obj_clean(worker->found);
+    }
+
+    for (i = 1; i < pool->length; i++) {
+        threads[i] = lexbor_thread_create(lxb_selectors_pool_run,
+                                          &pool->workers[i]);
+    }
+
+    lxb_selectors_pool_run(&pool->workers[0]);
+
+    for (i = 1; i < pool->length; i++) {
+        if (threads[i] != NULL) {
+            lexbor_thread_join(threads[i]);
+        }
+        else {
+            lxb_selectors_pool_run(&pool->workers[i]);
+        }
+    }
+
+    lexbor_free(threads);
+
+    selectors->options = options;
+    pool->workers[0].selectors = NULL;
+
+    for (i = 0; i < pool->length; i++) {
+        if (pool->workers[i].status != LXB_STATUS_OK) {
+            return pool->workers[i].status;
+        }
+    }
+
+    /* What was found, in document order. */
+
+    for (i = 0; i < pool->units_length; i++) {
+        unit = &pool->units[i];
+        worker = &pool->workers[i % pool->length];
+
+        for (n = unit->begin; n < unit->end; n++) {
+            found = lexbor_array_obj_get(worker->found, n);
+
+            status = cb(found->node, found->spec, ctx);
+            if (status != LXB_STATUS_OK) {
+                if (status == LXB_STATUS_STOP) {
+                    return LXB_STATUS_OK;
+                }
+
+                return status;
+            }
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static void
+lxb_selectors_pool_run(void *ctx)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_selectors_pool_unit_t *unit;
+    lxb_selectors_pool_worker_t *worker = ctx;
+    lxb_selectors_pool_t *pool = worker->pool;
+
+    for (i = worker->first; i < pool->units_length; i += pool->length) {
+        unit = &pool->units[i];
+        unit->begin = lexbor_array_obj_length(worker->found);
+
+        if (unit->deep) {
+            status = lxb_selectors_find(worker->selectors, unit->node,
+                                        worker->list,
+                                        lxb_selectors_pool_found_cb,
+                                        worker->found);
+        }
+        else {
+            status = lxb_selectors_match_node(worker->selectors, unit->node,
+                                              worker->list,
+                                              lxb_selectors_pool_found_cb,
+                                              worker->found);
+        }
+
+        unit->end = lexbor_array_obj_length(worker->found);
+
+        if (status != LXB_STATUS_OK) {
+            worker->status = status;
+            return;
+        }
+    }
+}
+
+static lxb_status_t
+lxb_selectors_pool_found_cb(lxb_dom_node_t *node,
+                            lxb_css_selector_specificity_t spec, void *ctx)
+{
+    lxb_selectors_pool_found_t *found;
+
+    found = lexbor_array_obj_push(ctx);
+    if (found == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    found->node = node;
+    found->spec = spec;
+
+    return LXB_STATUS_OK;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SELECTORS_POOL_H
+#define LEXBOR_SELECTORS_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/selectors/selectors.h"
+#include "lexbor/core/array_obj.h"
+
+
+typedef struct lxb_selectors_pool lxb_selectors_pool_t;
+
+/* A part of the tree, searched by one worker. */
+typedef struct {
+    lxb_dom_node_t *node;
+    bool           deep;    /* The node with its subtree, else the node. */
+    size_t         begin;   /* Found nodes in the results of the worker. */
+    size_t         end;
+}
+lxb_selectors_pool_unit_t;
+
+typedef struct {
+    lxb_dom_node_t                 *node;
+    lxb_css_selector_specificity_t spec;
+}
+lxb_selectors_pool_found_t;
+
+typedef struct {
+    lxb_selectors_pool_t          *pool;
+    lxb_selectors_t               *selectors;
+    lexbor_array_obj_t            *found;
+    size_t                        first;   /* Index of the first unit. */
+    const lxb_css_selector_list_t *list;
+    lxb_status_t                  status;
+}
+lxb_selectors_pool_worker_t;
+
+/*
+ * Searches independent parts of the tree in several threads.
+ *
+ * Each worker has its own lxb_selectors_t; the first worker runs in the
+ * calling thread with the lxb_selectors_t given to
+ * lxb_selectors_pool_find().  Units are given to workers in turn.
+ */
+struct lxb_selectors_pool {
+    lxb_selectors_pool_worker_t *workers;
+    size_t                      length;
+
+    lxb_selectors_pool_unit_t   *units;
+    size_t                      units_length;
+    size_t                      units_size;
+};
+
+
+LXB_API lxb_selectors_pool_t *
+lxb_selectors_pool_create(void);
+
+/*
+ * @param[in] lxb_selectors_pool_t *.
+ * @param[in] size_t.  Workers, with the calling thread; usually the number
+ * of CPU cores.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_pool_init(lxb_selectors_pool_t *pool, size_t workers);
+
+LXB_API void
+lxb_selectors_pool_clean(lxb_selectors_pool_t *pool);
+
+LXB_API lxb_selectors_pool_t *
+lxb_selectors_pool_destroy(lxb_selectors_pool_t *pool, bool self_destroy);
+
+/*
+ * Same as lxb_selectors_find(), with the work split between the workers of
+ * the pool.
+ *
+ * The tree is cut into units: the children of the root, and, while there
+ * are too few units for the workers, the children of those, each parent
+ * being matched alone.  The workers match their units in parallel and keep
+ * what they found; then the callback is called in the calling thread, in
+ * document order, exactly as lxb_selectors_find() calls it.
+ *
+ * The units are walked, as with LXB_SELECTORS_OPT_WALK: the document
+ * index is not used, so each unit costs as much as its subtree.
+ *
+ * The tree and the selector list must not be changed during the search.
+ *
+ * The search is serial unless lexbor is built with
+ * -DLEXBOR_WITHOUT_THREADS=OFF (the default is ON).  Built with
+ * LEXBOR_WITHOUT_THREADS, or when a thread cannot be started, the units are
+ * searched one after another in the calling thread.
+ *
+ * @param[in] lxb_selectors_pool_t *.
+ * @param[in] lxb_selectors_t *.  Used by the calling thread; its options
+ * apply to all workers.
+ * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ * @param[in] lxb_selectors_cb_f.  Callback for a found node.
+ * @param[in] void *.  Context for the callback.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_pool_find(lxb_selectors_pool_t *pool, lxb_selectors_t *selectors,
+                        lxb_dom_node_t *root,
+                        const lxb_css_selector_list_t *list,
+                        lxb_selectors_cb_f cb, void *ctx);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SELECTORS_POOL_H */
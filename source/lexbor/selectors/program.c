@@ -0,0 +1,923 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/selectors/program.h"
+#include "lexbor/core/utils.h"
+
+#ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
+    LXB_EXTERN const lxb_char_t lexbor_str_res_map_lowercase[256];
+#endif
+
+
+static lxb_status_t
+lxb_selectors_program_found_cb(lxb_dom_node_t *node,
+                               lxb_css_selector_specificity_t spec, void *ctx);
+
+
+lxb_selectors_program_t *
+lxb_selectors_program_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_selectors_program_t));
+}
+
+lxb_status_t
+lxb_selectors_program_init(lxb_selectors_program_t *program)
+{
+    if (program == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    program->size = 64;
+    program->insts = lexbor_malloc(sizeof(lxb_selectors_inst_t)
+                                   * program->size);
+    if (program->insts == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    program->mraw = lexbor_mraw_create();
+
+    return lexbor_mraw_init(program->mraw, 1024);
+}
+
+void
+lxb_selectors_program_clean(lxb_selectors_program_t *program)
+{
+    lexbor_mraw_clean(program->mraw);
+
+    program->length = 0;
+    program->count = 0;
+    program->fallbacks = 0;
+}
+
+lxb_selectors_program_t *
+lxb_selectors_program_destroy(lxb_selectors_program_t *program,
+                              bool self_destroy)
+{
+    if (program == NULL) {
+        return NULL;
+    }
+
+    if (program->insts != NULL) {
+        program->insts = lexbor_free(program->insts);
+    }
+
+    program->mraw = lexbor_mraw_destroy(program->mraw, true);
+
+    if (self_destroy) {
+        return lexbor_free(program);
+    }
+
+    return program;
+}
+
+static lxb_selectors_inst_t *
+lxb_selectors_program_append(lxb_selectors_program_t *program,
+                             lxb_selectors_op_t op)
+{
+    lxb_selectors_inst_t *inst;
+
+    if (program->length == program->size) {
+        inst = lexbor_realloc(program->insts, sizeof(lxb_selectors_inst_t)
+                                              * program->size * 2);
+        if (inst == NULL) {
+            return NULL;
+        }
+
+        program->insts = inst;
+        program->size *= 2;
+    }
+
+    inst = &program->insts[program->length++];
+
+    memset(inst, 0, sizeof(lxb_selectors_inst_t));
+    inst->op = op;
+
+    return inst;
+}
+
+static const lxb_char_t *
+lxb_selectors_program_lower(lxb_selectors_program_t *program,
+                            const lxb_char_t *data, size_t length)
+{
+    size_t i;
+    lxb_char_t *lower;
+
+    lower = lexbor_mraw_alloc(program->mraw, length + 1);
+    if (lower == NULL) {
+        return NULL;
+    }
+
+    for (i = 0; i < length; i++) {
+        lower[i] = lexbor_str_res_map_lowercase[data[i]];
+    }
+
+    lower[length] = 0x00;
+
+    return lower;
+}
+
+/* Cheap checks of a compound go first. */
+static unsigned
+lxb_selectors_program_rank(const lxb_css_selector_t *selector)
+{
+    switch (selector->type) {
+        case LXB_CSS_SELECTOR_TYPE_ELEMENT:
+        case LXB_CSS_SELECTOR_TYPE_ID:
+        case LXB_CSS_SELECTOR_TYPE_CLASS:
+            return 0;
+
+        case LXB_CSS_SELECTOR_TYPE_ATTRIBUTE:
+            return 1;
+
+        default:
+            return 2;
+    }
+}
+
+/*
+ * LXB_STATUS_NEXT if the selector cannot be compiled.
+ */
+static lxb_status_t
+lxb_selectors_program_simple(lxb_selectors_program_t *program,
+                             const lxb_css_selector_t *selector)
+{
+    lxb_selectors_inst_t *inst;
+    const lxb_css_selector_anb_of_t *anb;
+    const lxb_css_selector_pseudo_t *pseudo;
+    const lxb_css_selector_attribute_t *attr;
+
+    switch (selector->type) {
+        case LXB_CSS_SELECTOR_TYPE_ANY:
+            return LXB_STATUS_OK;
+
+        case LXB_CSS_SELECTOR_TYPE_ELEMENT:
+            inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_TAG);
+            break;
+
+        case LXB_CSS_SELECTOR_TYPE_ID:
+            inst = lxb_selectors_program_append(program, LXB_SELECTORS_OP_ID);
+            if (inst == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            inst->value = selector->name.data;
+            inst->value_length = selector->name.length;
+            inst->lower = lxb_selectors_program_lower(program,
+                                                      selector->name.data,
+                                                      selector->name.length);
+            if (inst->lower == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            return LXB_STATUS_OK;
+
+        case LXB_CSS_SELECTOR_TYPE_CLASS:
+            inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_CLASS);
+            break;
+
+        case LXB_CSS_SELECTOR_TYPE_ATTRIBUTE:
+            inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_ATTR);
+            if (inst == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            attr = &selector->u.attribute;
+
+            inst->name = selector->name.data;
+            inst->name_length = selector->name.length;
+            inst->match = attr->match;
+            inst->modifier = attr->modifier;
+
+            if (attr->value.data == NULL) {
+                return LXB_STATUS_OK;
+            }
+
+            inst->value = attr->value.data;
+            inst->value_length = attr->value.length;
+            inst->lower = lxb_selectors_program_lower(program,
+                                                      attr->value.data,
+                                                      attr->value.length);
+            if (inst->lower == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            return LXB_STATUS_OK;
+
+        case LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS:
+            inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_PSEUDO_CLASS);
+            if (inst == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            inst->selector = selector;
+
+            return LXB_STATUS_OK;
+
+        case LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS_FUNCTION:
+            pseudo = &selector->u.pseudo;
+            anb = pseudo->data;
+
+            switch (pseudo->type) {
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_CHILD:
+                    if (anb->of != NULL) {
+                        return LXB_STATUS_NEXT;
+                    }
+
+                    inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_NTH_CHILD);
+                    break;
+
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_CHILD:
+                    if (anb->of != NULL) {
+                        return LXB_STATUS_NEXT;
+                    }
+
+                    inst = lxb_selectors_program_append(program,
+                                            LXB_SELECTORS_OP_NTH_LAST_CHILD);
+                    break;
+
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_OF_TYPE:
+                    inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_NTH_OF_TYPE);
+                    break;
+
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_OF_TYPE:
+                    inst = lxb_selectors_program_append(program,
+                                            LXB_SELECTORS_OP_NTH_LAST_OF_TYPE);
+                    break;
+
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_CURRENT:
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_HAS:
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_IS:
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_LEXBOR_CONTAINS:
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NOT:
+                case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_WHERE:
+                    return LXB_STATUS_NEXT;
+
+                default:
+                    inst = lxb_selectors_program_append(program,
+                                                        LXB_SELECTORS_OP_FAIL);
+                    return (inst != NULL) ? LXB_STATUS_OK
+                                          : LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            if (inst == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            inst->a = anb->anb.a;
+            inst->b = anb->anb.b;
+
+            return LXB_STATUS_OK;
+
+        default:
+            /* Pseudo-elements never match elements. */
+            inst = lxb_selectors_program_append(program, LXB_SELECTORS_OP_FAIL);
+            return (inst != NULL) ? LXB_STATUS_OK
+                                  : LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    if (inst == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    inst->name = selector->name.data;
+    inst->name_length = selector->name.length;
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+lxb_selectors_program_selector(lxb_selectors_program_t *program,
+                               const lxb_css_selector_list_t *list)
+{
+    unsigned rank;
+    lxb_status_t status;
+    lxb_selectors_op_t op;
+    const lxb_css_selector_t *selector, *first;
+
+    selector = list->last;
+
+    while (selector != NULL) {
+        /* The compound: from its last simple selector to first. */
+        first = selector;
+
+        while (first->combinator == LXB_CSS_SELECTOR_COMBINATOR_CLOSE
+               && first->prev != NULL)
+        {
+            first = first->prev;
+        }
+
+        for (rank = 0; rank < 3; rank++) {
+            for (selector = first; ; selector = selector->next) {
+                if (lxb_selectors_program_rank(selector) == rank) {
+                    status = lxb_selectors_program_simple(program, selector);
+                    if (status != LXB_STATUS_OK) {
+                        return status;
+                    }
+                }
+
+                if (selector == list->last
+                    || selector->next->combinator
+                       != LXB_CSS_SELECTOR_COMBINATOR_CLOSE)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (first->prev == NULL) {
+            return LXB_STATUS_OK;
+        }
+
+        switch (first->combinator) {
+            case LXB_CSS_SELECTOR_COMBINATOR_DESCENDANT:
+                op = LXB_SELECTORS_OP_DESCENDANT;
+                break;
+
+            case LXB_CSS_SELECTOR_COMBINATOR_CHILD:
+                op = LXB_SELECTORS_OP_CHILD;
+                break;
+
+            case LXB_CSS_SELECTOR_COMBINATOR_SIBLING:
+                op = LXB_SELECTORS_OP_SIBLING;
+                break;
+
+            case LXB_CSS_SELECTOR_COMBINATOR_FOLLOWING:
+                op = LXB_SELECTORS_OP_FOLLOWING;
+                break;
+
+            default:
+                return LXB_STATUS_NEXT;
+        }
+
+        if (lxb_selectors_program_append(program, op) == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        selector = first->prev;
+    }
+
+    /* An empty selector. */
+
+    if (lxb_selectors_program_append(program, LXB_SELECTORS_OP_FAIL) == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_program_compile(lxb_selectors_program_t *program,
+                              const lxb_css_selector_list_t *list)
+{
+    lxb_selectors_program_clean(program);
+
+    return lxb_selectors_program_append_list(program, list);
+}
+
+lxb_status_t
+lxb_selectors_program_append_list(lxb_selectors_program_t *program,
+                                  const lxb_css_selector_list_t *list)
+{
+    size_t begin;
+    lxb_status_t status;
+    lxb_selectors_inst_t *inst;
+
+    for (; list != NULL; list = list->next) {
+        begin = program->length;
+
+        inst = lxb_selectors_program_append(program, LXB_SELECTORS_OP_BEGIN);
+        if (inst == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        inst->list = list;
+
+        status = lxb_selectors_program_selector(program, list);
+
+        if (status == LXB_STATUS_NEXT) {
+            program->length = begin + 1;
+            program->fallbacks++;
+
+            inst = lxb_selectors_program_append(program,
+                                                LXB_SELECTORS_OP_FALLBACK);
+            if (inst == NULL) {
+                return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+            }
+
+            inst->list = list;
+        }
+        else if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (lxb_selectors_program_append(program,
+                                         LXB_SELECTORS_OP_END) == NULL)
+        {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        program->insts[begin].a = program->length - begin;
+        program->count++;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+uintptr_t
+lxb_selectors_program_bind_inst(const lxb_selectors_inst_t *inst,
+                                lxb_dom_document_t *doc, bool quirks)
+{
+    const lxb_dom_attr_data_t *attr_data;
+
+    switch (inst->op) {
+        case LXB_SELECTORS_OP_TAG:
+            return lxb_tag_id_by_name(doc->tags, inst->name,
+                                      inst->name_length);
+
+        case LXB_SELECTORS_OP_CLASS:
+            return (uintptr_t) lxb_dom_element_class_by_name(doc, inst->name,
+                                                             inst->name_length,
+                                                             quirks);
+
+        case LXB_SELECTORS_OP_ATTR:
+            attr_data = lxb_dom_attr_data_by_local_name(doc->attrs,
+                                                        inst->name,
+                                                        inst->name_length);
+            return (attr_data != NULL) ? attr_data->attr_id
+                                       : LXB_DOM_ATTR__UNDEF;
+
+        default:
+            return 0;
+    }
+}
+
+lxb_status_t
+lxb_selectors_program_bind(lxb_selectors_t *selectors,
+                           const lxb_selectors_program_t *program,
+                           lxb_dom_document_t *doc, bool quirks)
+{
+    size_t i, size;
+    uintptr_t *bound;
+
+    if (program->length > selectors->bound_size) {
+        size = program->length + 64;
+
+        bound = lexbor_realloc(selectors->bound, sizeof(uintptr_t) * size);
+        if (bound == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        selectors->bound = bound;
+        selectors->bound_size = size;
+    }
+
+    bound = selectors->bound;
+
+    for (i = 0; i < program->length; i++) {
+        bound[i] = lxb_selectors_program_bind_inst(&program->insts[i],
+                                                   doc, quirks);
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_inline bool
+lxb_selectors_program_eq(const lxb_char_t *data, const lxb_selectors_inst_t *inst,
+                         size_t length, bool ins)
+{
+    size_t i;
+
+    if (!ins) {
+        return memcmp(data, inst->value, length) == 0;
+    }
+
+    for (i = 0; i < length; i++) {
+        if (lexbor_str_res_map_lowercase[data[i]] != inst->lower[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool
+lxb_selectors_program_attr(const lxb_selectors_inst_t *inst, uintptr_t attr_id,
+                           const lxb_dom_node_t *node)
+{
+    bool ins;
+    size_t i, length;
+    const lxb_char_t *data, *end, *pos;
+    const lxb_dom_attr_t *attr;
+
+    if (attr_id == LXB_DOM_ATTR__UNDEF) {
+        return false;
+    }
+
+    attr = lxb_dom_element_attr_by_id(lxb_dom_interface_element(node),
+                                      attr_id);
+    if (attr == NULL) {
+        return false;
+    }
+
+    if (inst->value == NULL) {
+        return true;
+    }
+
+    if (attr->value != NULL) {
+        data = attr->value->data;
+        length = attr->value->length;
+    }
+    else {
+        data = (const lxb_char_t *) "";
+        length = 0;
+    }
+
+    switch (inst->modifier) {
+        case LXB_CSS_SELECTOR_MODIFIER_I:
+            ins = true;
+            break;
+
+        case LXB_CSS_SELECTOR_MODIFIER_S:
+            ins = false;
+            break;
+
+        default:
+            ins = lxb_selectors_attribute_case_insensitive(node, attr_id);
+            break;
+    }
+
+    switch (inst->match) {
+        case LXB_CSS_SELECTOR_MATCH_EQUAL:
+            return length == inst->value_length
+                   && lxb_selectors_program_eq(data, inst, length, ins);
+
+        case LXB_CSS_SELECTOR_MATCH_INCLUDE:
+            if (inst->value_length == 0 || length < inst->value_length) {
+                return false;
+            }
+
+            end = data + length;
+
+            while (data < end) {
+                while (data < end && lexbor_utils_whitespace(*data, ==, ||)) {
+                    data++;
+                }
+
+                pos = data;
+
+                while (data < end && !lexbor_utils_whitespace(*data, ==, ||)) {
+                    data++;
+                }
+
+                if ((size_t) (data - pos) == inst->value_length
+                    && lxb_selectors_program_eq(pos, inst,
+                                                inst->value_length, ins))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+
+        case LXB_CSS_SELECTOR_MATCH_DASH:
+            if (length == inst->value_length) {
+                return lxb_selectors_program_eq(data, inst, length, ins);
+            }
+
+            return length > inst->value_length
+                   && data[inst->value_length] == '-'
+                   && lxb_selectors_program_eq(data, inst,
+                                               inst->value_length, ins);
+
+        case LXB_CSS_SELECTOR_MATCH_PREFIX:
+            return inst->value_length != 0 && length >= inst->value_length
+                   && lxb_selectors_program_eq(data, inst,
+                                               inst->value_length, ins);
+
+        case LXB_CSS_SELECTOR_MATCH_SUFFIX:
+            return inst->value_length != 0 && length >= inst->value_length
+                   && lxb_selectors_program_eq(data + length
+                                               - inst->value_length, inst,
+                                               inst->value_length, ins);
+
+        case LXB_CSS_SELECTOR_MATCH_SUBSTRING:
+            if (inst->value_length == 0 || length < inst->value_length) {
+                return false;
+            }
+
+            for (i = 0; i <= length - inst->value_length; i++) {
+                if (lxb_selectors_program_eq(data + i, inst,
+                                             inst->value_length, ins))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+
+        default:
+            return false;
+    }
+}
+
+lxb_inline bool
+lxb_selectors_program_anb(const lxb_selectors_inst_t *inst, size_t index)
+{
+    long diff;
+
+    if (inst->a == 0) {
+        return inst->b >= 0 && (size_t) inst->b == index;
+    }
+
+    diff = (long) index - inst->b;
+
+    return diff % inst->a == 0 && diff / inst->a >= 0;
+}
+
+bool
+lxb_selectors_program_test(lxb_selectors_t *selectors,
+                           const lxb_selectors_inst_t *inst, uintptr_t bound,
+                           lxb_dom_node_t *node, bool quirks)
+{
+    size_t index;
+    const lxb_dom_element_t *element;
+
+    element = lxb_dom_interface_element(node);
+
+    switch (inst->op) {
+        case LXB_SELECTORS_OP_TAG:
+            return node->local_name == bound;
+
+        case LXB_SELECTORS_OP_ID:
+            return element->attr_id != NULL
+                   && element->attr_id->value != NULL
+                   && element->attr_id->value->length == inst->value_length
+                   && lxb_selectors_program_eq(element->attr_id->value->data,
+                                               inst, inst->value_length,
+                                               quirks);
+
+        case LXB_SELECTORS_OP_CLASS:
+            return bound != 0
+                   && lxb_dom_element_has_class(element,
+                                    (const lxb_dom_element_class_t *) bound,
+                                    quirks);
+
+        case LXB_SELECTORS_OP_ATTR:
+            return lxb_selectors_program_attr(inst, bound, node);
+
+        case LXB_SELECTORS_OP_PSEUDO_CLASS:
+            return lxb_selectors_pseudo_class_match(selectors, inst->selector,
+                                                    node);
+
+        case LXB_SELECTORS_OP_NTH_CHILD:
+        case LXB_SELECTORS_OP_NTH_LAST_CHILD:
+            index = lxb_selectors_nth_index(selectors, node, false,
+                                    inst->op == LXB_SELECTORS_OP_NTH_LAST_CHILD);
+
+            return lxb_selectors_program_anb(inst, index);
+
+        case LXB_SELECTORS_OP_NTH_OF_TYPE:
+        case LXB_SELECTORS_OP_NTH_LAST_OF_TYPE:
+            index = lxb_selectors_nth_index(selectors, node, true,
+                                inst->op == LXB_SELECTORS_OP_NTH_LAST_OF_TYPE);
+
+            return lxb_selectors_program_anb(inst, index);
+
+        default:
+            return false;
+    }
+}
+
+/* Matches the node to the instructions up to END. */
+static bool
+lxb_selectors_program_run(lxb_selectors_t *selectors,
+                          const lxb_selectors_inst_t *inst,
+                          const uintptr_t *bound, lxb_dom_node_t *node,
+                          bool quirks)
+{
+    for (;; inst++, bound++) {
+        switch (inst->op) {
+            case LXB_SELECTORS_OP_END:
+                return true;
+
+            case LXB_SELECTORS_OP_DESCENDANT:
+                for (node = node->parent; node != NULL; node = node->parent) {
+                    if (node->type == LXB_DOM_NODE_TYPE_ELEMENT
+                        && lxb_selectors_program_run(selectors, inst + 1,
+                                                     bound + 1, node, quirks))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+
+            case LXB_SELECTORS_OP_CHILD:
+                node = node->parent;
+
+                if (node == NULL || node->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+                    return false;
+                }
+
+                break;
+
+            case LXB_SELECTORS_OP_SIBLING:
+                do {
+                    node = node->prev;
+                }
+                while (node != NULL && node->type != LXB_DOM_NODE_TYPE_ELEMENT);
+
+                if (node == NULL) {
+                    return false;
+                }
+
+                break;
+
+            case LXB_SELECTORS_OP_FOLLOWING:
+                for (node = node->prev; node != NULL; node = node->prev) {
+                    if (node->type == LXB_DOM_NODE_TYPE_ELEMENT
+                        && lxb_selectors_program_run(selectors, inst + 1,
+                                                     bound + 1, node, quirks))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+
+            default:
+                if (!lxb_selectors_program_test(selectors, inst, *bound,
+                                                node, quirks))
+                {
+                    return false;
+                }
+
+                break;
+        }
+    }
+}
+
+static lxb_status_t
+lxb_selectors_program_node(lxb_selectors_t *selectors,
+                           const lxb_selectors_program_t *program,
+                           lxb_dom_node_t *node, bool quirks,
+                           lxb_selectors_cb_f cb, void *ctx)
+{
+    bool found;
+    lxb_status_t status;
+    const uintptr_t *bound;
+    const lxb_selectors_inst_t *inst, *end;
+
+    inst = program->insts;
+    end = inst + program->length;
+    bound = selectors->bound;
+
+    while (inst < end) {
+        if (inst[1].op == LXB_SELECTORS_OP_FALLBACK) {
+            found = false;
+
+            status = lxb_selectors_match_node_single(selectors, node,
+                                                     inst->list,
+                                                     lxb_selectors_program_found_cb,
+                                                     &found);
+            if (status != LXB_STATUS_OK) {
+                return status;
+            }
+        }
+        else {
+            found = lxb_selectors_program_run(selectors, inst + 1,
+                                              bound + 1, node, quirks);
+        }
+
+        if (found) {
+            status = cb(node, inst->list->specificity, ctx);
+            if (status != LXB_STATUS_OK) {
+                return status;
+            }
+
+            if (selectors->options & LXB_SELECTORS_OPT_MATCH_FIRST) {
+                return LXB_STATUS_OK;
+            }
+        }
+
+        bound += inst->a;
+        inst += inst->a;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_program_find(lxb_selectors_t *selectors,
+                           const lxb_selectors_program_t *program,
+                           lxb_dom_node_t *root,
+                           lxb_selectors_cb_f cb, void *ctx)
+{
+    bool quirks;
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+    lxb_dom_document_t *doc;
+
+    if (selectors->options & LXB_SELECTORS_OPT_MATCH_ROOT) {
+        node = root;
+
+        if (node->type == LXB_DOM_NODE_TYPE_DOCUMENT) {
+            node = root->first_child;
+        }
+    }
+    else {
+        node = root->first_child;
+    }
+
+    if (node == NULL || program->length == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    doc = root->owner_document;
+    quirks = doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    status = lxb_selectors_program_bind(selectors, program, doc, quirks);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lxb_selectors_cache_begin(selectors);
+
+    do {
+        if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            status = lxb_selectors_program_node(selectors, program, node,
+                                                quirks, cb, ctx);
+            if (status != LXB_STATUS_OK) {
+                if (status == LXB_STATUS_STOP) {
+                    status = LXB_STATUS_OK;
+                }
+
+                break;
+            }
+
+            if (node->first_child != NULL) {
+                node = node->first_child;
+                continue;
+            }
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+    while (true);
+
+    lxb_selectors_cache_end(selectors);
+
+    return status;
+}
+
+lxb_status_t
+lxb_selectors_program_match_node(lxb_selectors_t *selectors,
+                                 const lxb_selectors_program_t *program,
+                                 lxb_dom_node_t *node,
+                                 lxb_selectors_cb_f cb, void *ctx)
+{
+    bool quirks;
+    lxb_status_t status;
+    lxb_dom_document_t *doc;
+
+    if (node->type != LXB_DOM_NODE_TYPE_ELEMENT || program->length == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    doc = node->owner_document;
+    quirks = doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    status = lxb_selectors_program_bind(selectors, program, doc, quirks);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    return lxb_selectors_program_node(selectors, program, node, quirks,
+                                      cb, ctx);
+}
+
+static lxb_status_t
+lxb_selectors_program_found_cb(lxb_dom_node_t *node,
+                               lxb_css_selector_specificity_t spec, void *ctx)
+{
+    *((bool *) ctx) = true;
+
+    return LXB_STATUS_OK;
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SELECTORS_PROGRAM_H
+#define LEXBOR_SELECTORS_PROGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/selectors/selectors.h"
+#include "lexbor/core/mraw.h"
+
+
+typedef enum {
+    LXB_SELECTORS_OP_BEGIN = 0x00,     /* A selector of the list starts. */
+    LXB_SELECTORS_OP_END,              /* The selector matched. */
+    LXB_SELECTORS_OP_FAIL,             /* Never matches. */
+    LXB_SELECTORS_OP_FALLBACK,         /* Checked by lxb_selectors_t. */
+    LXB_SELECTORS_OP_TAG,
+    LXB_SELECTORS_OP_ID,
+    LXB_SELECTORS_OP_CLASS,
+    LXB_SELECTORS_OP_ATTR,
+    LXB_SELECTORS_OP_PSEUDO_CLASS,
+    LXB_SELECTORS_OP_NTH_CHILD,
+    LXB_SELECTORS_OP_NTH_LAST_CHILD,
+    LXB_SELECTORS_OP_NTH_OF_TYPE,
+    LXB_SELECTORS_OP_NTH_LAST_OF_TYPE,
+    LXB_SELECTORS_OP_DESCENDANT,
+    LXB_SELECTORS_OP_CHILD,
+    LXB_SELECTORS_OP_SIBLING,
+    LXB_SELECTORS_OP_FOLLOWING
+}
+lxb_selectors_op_t;
+
+/*
+ * One step of a compiled selector.
+ *
+ * For BEGIN, "a" is the number of instructions up to the next selector.
+ * For the An+B pseudo-classes, "a" and "b" are An+B.
+ * For ATTR, "value" is NULL if only the presence of the attribute matters.
+ */
+typedef struct {
+    lxb_selectors_op_t            op;
+
+    lxb_css_selector_match_t      match;
+    lxb_css_selector_modifier_t   modifier;
+
+    const lxb_char_t              *name;
+    size_t                        name_length;
+
+    const lxb_char_t              *value;
+    const lxb_char_t              *lower;   /* Lowercase copy of value. */
+    size_t                        value_length;
+
+    long                          a;
+    long                          b;
+
+    const lxb_css_selector_t      *selector;
+    const lxb_css_selector_list_t *list;
+}
+lxb_selectors_inst_t;
+
+/*
+ * A selector list compiled into flat instructions.
+ *
+ * Each selector of the list is a run of instructions from BEGIN to END,
+ * taken from right to left: the simple selectors of a compound, then a
+ * combinator, then the simple selectors of the previous compound, and so on.
+ * Ids and attribute values are kept lowercased, An+B is taken out of the
+ * selectors.
+ *
+ * Tag, attribute and class names are looked up in the document once per
+ * lxb_selectors_program_find() or lxb_selectors_program_match_node() call,
+ * and kept in the lxb_selectors_t object; the program itself is never
+ * changed by them and can be used for any number of documents.
+ *
+ * Selectors with :has(), :is(), :where(), :not(), :current(), "of S",
+ * :lexbor-contains() or the column combinator are not compiled: they are
+ * checked by lxb_selectors_match_node_single().
+ *
+ * The selector list must outlive the program.
+ */
+typedef struct {
+    lxb_selectors_inst_t *insts;
+    size_t               length;
+    size_t               size;
+
+    lexbor_mraw_t        *mraw;
+
+    size_t               count;      /* Selectors in the program. */
+    size_t               fallbacks;  /* Selectors that are not compiled. */
+}
+lxb_selectors_program_t;
+
+
+LXB_API lxb_selectors_program_t *
+lxb_selectors_program_create(void);
+
+LXB_API lxb_status_t
+lxb_selectors_program_init(lxb_selectors_program_t *program);
+
+LXB_API void
+lxb_selectors_program_clean(lxb_selectors_program_t *program);
+
+LXB_API lxb_selectors_program_t *
+lxb_selectors_program_destroy(lxb_selectors_program_t *program,
+                              bool self_destroy);
+
+/*
+ * Compiles the selector list, replacing the previous program.
+ *
+ * @param[in] lxb_selectors_program_t *.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_program_compile(lxb_selectors_program_t *program,
+                              const lxb_css_selector_list_t *list);
+
+/*
+ * Compiles the selector list after the instructions already in the program.
+ *
+ * @param[in] lxb_selectors_program_t *.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_program_append_list(lxb_selectors_program_t *program,
+                                  const lxb_css_selector_list_t *list);
+
+/*
+ * Same as lxb_selectors_find() for the compiled list.
+ *
+ * The options of the lxb_selectors_t object apply, the document indexes and
+ * the ancestor filter are not used.  lxb_selectors_selector() is not
+ * available in the callback.
+ *
+ * @param[in] lxb_selectors_t *.
+ * @param[in] const lxb_selectors_program_t *.
+ * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
+ * @param[in] lxb_selectors_cb_f.  Callback for a found node.
+ * @param[in] void *.  Context for the callback.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_program_find(lxb_selectors_t *selectors,
+                           const lxb_selectors_program_t *program,
+                           lxb_dom_node_t *root,
+                           lxb_selectors_cb_f cb, void *ctx);
+
+/*
+ * Same as lxb_selectors_match_node() for the compiled list.
+ */
+LXB_API lxb_status_t
+lxb_selectors_program_match_node(lxb_selectors_t *selectors,
+                                 const lxb_selectors_program_t *program,
+                                 lxb_dom_node_t *node,
+                                 lxb_selectors_cb_f cb, void *ctx);
+
+/*
+ * Looks up the names of the program in the document and keeps them in
+ * selectors->bound, one for each instruction.
+ *
+ * Done by lxb_selectors_program_find() and lxb_selectors_program_match_node();
+ * needed only before lxb_selectors_program_test().
+ */
+LXB_API lxb_status_t
+lxb_selectors_program_bind(lxb_selectors_t *selectors,
+                           const lxb_selectors_program_t *program,
+                           lxb_dom_document_t *doc, bool quirks);
+
+/*
+ * The value lxb_selectors_program_bind() keeps for one instruction: the tag
+ * id, class or attribute id of its name in the document, 0 if the document
+ * does not have the name or the instruction has no name to look up.
+ */
+LXB_API uintptr_t
+lxb_selectors_program_bind_inst(const lxb_selectors_inst_t *inst,
+                                lxb_dom_document_t *doc, bool quirks);
+
+/*
+ * Checks the element against one instruction that is not a combinator,
+ * BEGIN, END or FALLBACK.  The bound value is the one of the instruction in
+ * selectors->bound.
+ */
+LXB_API bool
+lxb_selectors_program_test(lxb_selectors_t *selectors,
+                           const lxb_selectors_inst_t *inst, uintptr_t bound,
+                           lxb_dom_node_t *node, bool quirks);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SELECTORS_PROGRAM_H */
@@ -8,9 +8,35 @@
 
 #include <math.h>
 
+#ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
+    LXB_EXTERN const lxb_char_t lexbor_str_res_map_lowercase[256];
+#endif
+
+
+static lxb_status_t
+lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                   lxb_selectors_bloom_t *bloom);
+
+static lxb_selectors_bloom_t *
+lxb_selectors_bloom_prepare(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                            const lxb_css_selector_list_t *list);
+
+static lxb_status_t
+lxb_selectors_bloom_begin(lxb_selectors_bloom_t *bloom, lxb_dom_node_t *node);
 
 static lxb_status_t
-lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root);
+lxb_selectors_bloom_push(lxb_selectors_bloom_t *bloom, lxb_dom_node_t *node);
+
+static void
+lxb_selectors_bloom_pop(lxb_selectors_bloom_t *bloom);
+
+static bool
+lxb_selectors_bloom_may_match(const lxb_selectors_bloom_t *bloom);
+
+static lxb_status_t
+lxb_selectors_tree_index(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                         const lxb_css_selector_list_t *list,
+                         lxb_dom_index_t *index);
 
 static lxb_status_t
 lxb_selectors_run(lxb_selectors_t *selectors, lxb_dom_node_t *node);
@@ -63,6 +89,10 @@ static lxb_selectors_entry_t *
 lxb_selectors_state_after_find(lxb_selectors_t *selectors,
                                lxb_selectors_entry_t *entry);
 
+static lxb_selectors_entry_t *
+lxb_selectors_state_after_has(lxb_selectors_t *selectors,
+                              lxb_selectors_entry_t *entry);
+
 static lxb_selectors_entry_t *
 lxb_selectors_state_after_not(lxb_selectors_t *selectors,
                               lxb_selectors_entry_t *entry);
@@ -86,6 +116,11 @@ lxb_selectors_match_element(const lxb_css_selector_t *selector,
 static bool
 lxb_selectors_match_id(const lxb_css_selector_t *selector, lxb_dom_node_t *node);
 
+static bool
+lxb_selectors_match_class_name(const lxb_css_selector_t *selector,
+                               lxb_dom_node_t *node,
+                               lxb_selectors_entry_t *entry);
+
 static bool
 lxb_selectors_match_class(const lexbor_str_t *target, const lexbor_str_t *src,
                           bool quirks);
@@ -95,11 +130,12 @@ lxb_selectors_match_attribute(const lxb_css_selector_t *selector,
                               lxb_dom_node_t *node, lxb_selectors_entry_t *entry);
 
 static bool
-lxb_selectors_match_attribute_html_case_insensitive(lxb_dom_node_t *node,
+lxb_selectors_match_attribute_html_case_insensitive(const lxb_dom_node_t *node,
                                                    lxb_dom_attr_id_t attr_id);
 
 static bool
-lxb_selectors_pseudo_class(const lxb_css_selector_t *selector,
+lxb_selectors_pseudo_class(lxb_selectors_t *selectors,
+                           const lxb_css_selector_t *selector,
                            const lxb_dom_node_t *node);
 
 static bool
@@ -118,13 +154,15 @@ static bool
 lxb_selectors_pseudo_class_first_child(const lxb_dom_node_t *node);
 
 static bool
-lxb_selectors_pseudo_class_first_of_type(const lxb_dom_node_t *node);
+lxb_selectors_pseudo_class_first_of_type(lxb_selectors_t *selectors,
+                                         const lxb_dom_node_t *node);
 
 static bool
 lxb_selectors_pseudo_class_last_child(const lxb_dom_node_t *node);
 
 static bool
-lxb_selectors_pseudo_class_last_of_type(const lxb_dom_node_t *node);
+lxb_selectors_pseudo_class_last_of_type(lxb_selectors_t *selectors,
+                                        const lxb_dom_node_t *node);
 
 static bool
 lxb_selectors_pseudo_class_read_write(const lxb_dom_node_t *node);
@@ -136,10 +174,21 @@ static lxb_status_t
 lxb_selectors_cb_ok(lxb_dom_node_t *node,
                     lxb_css_selector_specificity_t spec, void *ctx);
 
+static lxb_status_t
+lxb_selectors_cb_has(lxb_dom_node_t *node,
+                     lxb_css_selector_specificity_t spec, void *ctx);
+
 static lxb_status_t
 lxb_selectors_cb_not(lxb_dom_node_t *node,
                      lxb_css_selector_specificity_t spec, void *ctx);
 
+static lxb_selectors_cache_entry_t *
+lxb_selectors_cache_search(lxb_selectors_cache_t *cache,
+                           const lxb_dom_node_t *node, const void *key);
+
+static void
+lxb_selectors_has_remember(lxb_selectors_t *selectors, bool found);
+
 static lxb_status_t
 lxb_selectors_cb_nth_ok(lxb_dom_node_t *node,
                         lxb_css_selector_specificity_t spec, void *ctx);
@@ -174,6 +223,15 @@ lxb_selectors_init(lxb_selectors_t *selectors)
         return status;
     }
 
+    selectors->bloom = lexbor_calloc(1, sizeof(lxb_selectors_bloom_t));
+    if (selectors->bloom == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    selectors->bound = NULL;
+    selectors->bound_size = 0;
+
+    memset(&selectors->cache, 0, sizeof(lxb_selectors_cache_t));
     selectors->options = LXB_SELECTORS_OPT_DEFAULT;
 
     return LXB_STATUS_OK;
@@ -196,6 +254,22 @@ lxb_selectors_destroy(lxb_selectors_t *selectors, bool self_destroy)
     selectors->objs = lexbor_dobject_destroy(selectors->objs, true);
     selectors->nested = lexbor_dobject_destroy(selectors->nested, true);
 
+    if (selectors->bloom != NULL) {
+        if (selectors->bloom->stack != NULL) {
+            lexbor_free(selectors->bloom->stack);
+        }
+
+        selectors->bloom = lexbor_free(selectors->bloom);
+    }
+
+    if (selectors->bound != NULL) {
+        selectors->bound = lexbor_free(selectors->bound);
+    }
+
+    if (selectors->cache.entries != NULL) {
+        selectors->cache.entries = lexbor_free(selectors->cache.entries);
+    }
+
     if (self_destroy) {
         return lexbor_free(selectors);
     }
@@ -558,6 +632,8 @@ lxb_selectors_find(lxb_selectors_t *selectors, lxb_dom_node_t *root,
                    const lxb_css_selector_list_t *list,
                    lxb_selectors_cb_f cb, void *ctx)
 {
+    lxb_status_t status;
+    lxb_dom_index_t *index;
     lxb_selectors_entry_t *entry;
     lxb_selectors_nested_t nested;
 
@@ -573,17 +649,81 @@ lxb_selectors_find(lxb_selectors_t *selectors, lxb_dom_node_t *root,
     nested.cb = cb;
     nested.ctx = ctx;
     nested.forward = false;
+    nested.single = false;
 
     selectors->current = &nested;
     selectors->status = LXB_STATUS_OK;
 
-    return lxb_selectors_tree(selectors, root);
+    index = root->owner_document->index;
+
+    lxb_selectors_cache_begin(selectors);
+
+    if (index != NULL
+        && (selectors->options & LXB_SELECTORS_OPT_WALK) == 0
+        && (index->opt & (LXB_DOM_INDEX_OPT_TAG|LXB_DOM_INDEX_OPT_CLASS))
+        && lxb_dom_index_in_tree(index, root))
+    {
+        status = lxb_selectors_tree_index(selectors, root, list, index);
+        if (status != LXB_STATUS_NEXT) {
+            goto done;
+        }
+    }
+
+    status = lxb_selectors_tree(selectors, root,
+                                lxb_selectors_bloom_prepare(selectors, root,
+                                                            list));
+
+done:
+
+    lxb_selectors_cache_end(selectors);
+
+    return status;
+}
+
+lxb_status_t
+lxb_selectors_find_limit(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                         const lxb_css_selector_list_t *list, size_t limit,
+                         lxb_selectors_cb_f cb, void *ctx)
+{
+    lxb_status_t status;
+
+    selectors->limit = limit;
+
+    status = lxb_selectors_find(selectors, root, list, cb, ctx);
+
+    selectors->limit = 0;
+
+    return status;
+}
+
+static lxb_status_t
+lxb_selectors_first_cb(lxb_dom_node_t *node,
+                       lxb_css_selector_specificity_t spec, void *ctx)
+{
+    *((lxb_dom_node_t **) ctx) = node;
+
+    return LXB_STATUS_OK;
 }
 
 lxb_status_t
-lxb_selectors_match_node(lxb_selectors_t *selectors, lxb_dom_node_t *node,
+lxb_selectors_find_first(lxb_selectors_t *selectors, lxb_dom_node_t *root,
                          const lxb_css_selector_list_t *list,
-                         lxb_selectors_cb_f cb, void *ctx)
+                         lxb_dom_node_t **node)
+{
+    lxb_status_t status;
+
+    *node = NULL;
+
+    status = lxb_selectors_find_limit(selectors, root, list, 1,
+                                      lxb_selectors_first_cb, node);
+
+    return (status == LXB_STATUS_STOPPED) ? LXB_STATUS_OK : status;
+}
+
+static lxb_status_t
+lxb_selectors_match_node_ext(lxb_selectors_t *selectors, lxb_dom_node_t *node,
+                             const lxb_css_selector_list_t *list,
+                             lxb_selectors_cb_f cb, void *ctx, bool single)
 {
     lxb_status_t status;
     lxb_selectors_entry_t *entry;
@@ -605,6 +745,7 @@ lxb_selectors_match_node(lxb_selectors_t *selectors, lxb_dom_node_t *node,
     nested.cb = cb;
     nested.ctx = ctx;
     nested.forward = false;
+    nested.single = single;
 
     selectors->current = &nested;
     selectors->status = LXB_STATUS_OK;
@@ -616,6 +757,38 @@ lxb_selectors_match_node(lxb_selectors_t *selectors, lxb_dom_node_t *node,
     return status;
 }
 
+lxb_status_t
+lxb_selectors_match_node(lxb_selectors_t *selectors, lxb_dom_node_t *node,
+                         const lxb_css_selector_list_t *list,
+                         lxb_selectors_cb_f cb, void *ctx)
+{
+    return lxb_selectors_match_node_ext(selectors, node, list, cb, ctx, false);
+}
+
+lxb_status_t
+lxb_selectors_match_node_single(lxb_selectors_t *selectors,
+                                lxb_dom_node_t *node,
+                                const lxb_css_selector_list_t *list,
+                                lxb_selectors_cb_f cb, void *ctx)
+{
+    return lxb_selectors_match_node_ext(selectors, node, list, cb, ctx, true);
+}
+
+bool
+lxb_selectors_pseudo_class_match(lxb_selectors_t *selectors,
+                                 const lxb_css_selector_t *selector,
+                                 const lxb_dom_node_t *node)
+{
+    return lxb_selectors_pseudo_class(selectors, selector, node);
+}
+
+bool
+lxb_selectors_attribute_case_insensitive(const lxb_dom_node_t *node,
+                                         lxb_dom_attr_id_t attr_id)
+{
+    return lxb_selectors_match_attribute_html_case_insensitive(node, attr_id);
+}
+
 lxb_status_t
 lxb_selectors_find_reverse(lxb_selectors_t *selectors, lxb_dom_node_t *root,
                            const lxb_css_selector_list_t *list,
@@ -625,7 +798,8 @@ lxb_selectors_find_reverse(lxb_selectors_t *selectors, lxb_dom_node_t *root,
 }
 
 static lxb_status_t
-lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root)
+lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                   lxb_selectors_bloom_t *bloom)
 {
     lxb_status_t status;
     lxb_dom_node_t *node;
@@ -636,18 +810,539 @@ lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root)
         if (node->type == LXB_DOM_NODE_TYPE_DOCUMENT) {
             node = root->first_child;
         }
-    }
-    else {
-        node = root->first_child;
-    }
+    }
+    else {
+        node = root->first_child;
+    }
+
+    if (node == NULL) {
+        goto out;
+    }
+
+    if (bloom != NULL) {
+        status = lxb_selectors_bloom_begin(bloom, node->parent);
+        if (status != LXB_STATUS_OK) {
+            goto failed;
+        }
+    }
+
+    do {
+        if (node->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+            goto next;
+        }
+
+        if (bloom == NULL || lxb_selectors_bloom_may_match(bloom)) {
+            status = lxb_selectors_run(selectors, node);
+            if (status != LXB_STATUS_OK) {
+                if (status == LXB_STATUS_STOP) {
+                    break;
+                }
+
+                goto failed;
+            }
+        }
+
+        if (node->first_child != NULL) {
+            if (bloom != NULL) {
+                status = lxb_selectors_bloom_push(bloom, node);
+                if (status != LXB_STATUS_OK) {
+                    goto failed;
+                }
+            }
+
+            node = node->first_child;
+        }
+        else {
+
+        next:
+
+            while (node != root && node->next == NULL) {
+                node = node->parent;
+
+                if (bloom != NULL) {
+                    lxb_selectors_bloom_pop(bloom);
+                }
+            }
+
+            if (node == root) {
+                break;
+            }
+
+            node = node->next;
+        }
+    }
+    while (true);
+
+out:
+    lxb_selectors_clean(selectors);
+
+    return LXB_STATUS_OK;
+
+failed:
+
+    lxb_selectors_clean(selectors);
+
+    return status;
+}
+
+lxb_inline uint32_t
+lxb_selectors_bloom_key(uintptr_t value, unsigned type)
+{
+    uint64_t hash;
+
+    hash = (((uint64_t) value << 2) | type) * 0x9E3779B97F4A7C15ULL;
+
+    return (uint32_t) (hash >> 32);
+}
+
+lxb_inline uint32_t
+lxb_selectors_bloom_key_id(const lxb_char_t *data, size_t length)
+{
+    uint32_t hash;
+    const lxb_char_t *end;
+
+    /* Ids are compared case-insensitively in quirks mode. */
+    hash = 2166136261U;
+
+    for (end = data + length; data < end; data++) {
+        hash = (hash ^ lexbor_str_res_map_lowercase[*data]) * 16777619U;
+    }
+
+    return lxb_selectors_bloom_key(hash, 1);
+}
+
+lxb_inline uint32_t
+lxb_selectors_bloom_key_class(const lxb_dom_element_class_t *cls)
+{
+    /* Classes too, so the lowercase twin stands for all of them. */
+    return lxb_selectors_bloom_key((uintptr_t) cls->lower, 2);
+}
+
+lxb_inline bool
+lxb_selectors_bloom_has(const lxb_selectors_bloom_t *bloom, uint32_t key)
+{
+    const uint32_t mask = (1 << LXB_SELECTORS_BLOOM_BITS) - 1;
+
+    return bloom->counters[key & mask] != 0
+           && bloom->counters[(key >> LXB_SELECTORS_BLOOM_BITS) & mask] != 0;
+}
+
+lxb_inline void
+lxb_selectors_bloom_counter_inc(lxb_selectors_bloom_t *bloom, size_t idx)
+{
+    if (bloom->counters[idx] != UINT8_MAX) {
+        bloom->counters[idx]++;
+    }
+}
+
+lxb_inline void
+lxb_selectors_bloom_counter_dec(lxb_selectors_bloom_t *bloom, size_t idx)
+{
+    if (bloom->counters[idx] != UINT8_MAX) {
+        bloom->counters[idx]--;
+    }
+}
+
+/* Adds the keys of the node to the filter; not elements have none. */
+static lxb_status_t
+lxb_selectors_bloom_push(lxb_selectors_bloom_t *bloom, lxb_dom_node_t *node)
+{
+    size_t i, need, size, count;
+    uint32_t key, *stack;
+    lxb_dom_element_t *element;
+    const uint32_t mask = (1 << LXB_SELECTORS_BLOOM_BITS) - 1;
+
+    element = NULL;
+    need = 1;
+
+    if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+        element = lxb_dom_interface_element(node);
+        need += 2 + element->classes_length;
+    }
+
+    if (bloom->length + need > bloom->size) {
+        size = (bloom->size != 0) ? bloom->size * 2 : 256;
+
+        while (size < bloom->length + need) {
+            size *= 2;
+        }
+
+        stack = lexbor_realloc(bloom->stack, size * sizeof(uint32_t));
+        if (stack == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        bloom->stack = stack;
+        bloom->size = size;
+    }
+
+    count = 0;
+
+    if (element != NULL) {
+        bloom->stack[bloom->length + count++] =
+            lxb_selectors_bloom_key(node->local_name, 0);
+
+        if (element->attr_id != NULL && element->attr_id->value != NULL) {
+            bloom->stack[bloom->length + count++] =
+                lxb_selectors_bloom_key_id(element->attr_id->value->data,
+                                           element->attr_id->value->length);
+        }
+
+        for (i = 0; i < element->classes_length; i++) {
+            bloom->stack[bloom->length + count++] =
+                lxb_selectors_bloom_key_class(element->classes[i]);
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        key = bloom->stack[bloom->length + i];
+
+        lxb_selectors_bloom_counter_inc(bloom, key & mask);
+        lxb_selectors_bloom_counter_inc(bloom,
+                                        (key >> LXB_SELECTORS_BLOOM_BITS) & mask);
+    }
+
+    bloom->length += count;
+    bloom->stack[bloom->length++] = (uint32_t) count;
+
+    return LXB_STATUS_OK;
+}
+
+/* Takes away the keys of the last added node, if the walk added it. */
+static void
+lxb_selectors_bloom_pop(lxb_selectors_bloom_t *bloom)
+{
+    uint32_t key, count;
+    const uint32_t mask = (1 << LXB_SELECTORS_BLOOM_BITS) - 1;
+
+    if (bloom->length <= bloom->base) {
+        return;
+    }
+
+    count = bloom->stack[--bloom->length];
+
+    while (count-- != 0) {
+        key = bloom->stack[--bloom->length];
+
+        lxb_selectors_bloom_counter_dec(bloom, key & mask);
+        lxb_selectors_bloom_counter_dec(bloom,
+                                        (key >> LXB_SELECTORS_BLOOM_BITS) & mask);
+    }
+}
+
+/*
+ * Fills the filter with the node and its ancestors.  They stay in the filter
+ * for the whole walk, so their order on the stack does not matter.
+ */
+static lxb_status_t
+lxb_selectors_bloom_begin(lxb_selectors_bloom_t *bloom, lxb_dom_node_t *node)
+{
+    lxb_status_t status;
+
+    memset(bloom->counters, 0, sizeof(bloom->counters));
+
+    bloom->length = 0;
+    bloom->base = 0;
+
+    for (; node != NULL; node = node->parent) {
+        status = lxb_selectors_bloom_push(bloom, node);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    bloom->base = bloom->length;
+
+    return LXB_STATUS_OK;
+}
+
+/* Whether the ancestors may have all keys of some selector in the list. */
+static bool
+lxb_selectors_bloom_may_match(const lxb_selectors_bloom_t *bloom)
+{
+    size_t i, j;
+
+    for (i = 0; i < bloom->count; i++) {
+        for (j = 0; j < bloom->lengths[i]; j++) {
+            if (!lxb_selectors_bloom_has(bloom, bloom->keys[i][j])) {
+                break;
+            }
+        }
+
+        if (j == bloom->lengths[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Collects the keys of the compounds that must match ancestors of the node
+ * matching the selector: those on the left of a descendant or child
+ * combinator.  A compound on the left of a sibling combinator matches
+ * a sibling (of the node or of an ancestor) and is skipped.
+ *
+ * A tag or class that no element of the document has is a key no element
+ * sets, so the selector never passes the filter.
+ */
+static void
+lxb_selectors_bloom_list(lxb_selectors_bloom_t *bloom,
+                         const lxb_css_selector_t *selector,
+                         lxb_dom_document_t *doc, size_t idx)
+{
+    bool ancestor;
+    size_t length;
+    uint32_t key;
+    lxb_tag_id_t tag_id;
+    const lxb_dom_element_class_t *cls;
+
+    ancestor = false;
+    length = 0;
+
+    for (; selector != NULL && length < LXB_SELECTORS_BLOOM_KEYS;
+         selector = selector->prev)
+    {
+        if (ancestor) {
+            switch (selector->type) {
+                case LXB_CSS_SELECTOR_TYPE_ELEMENT:
+                    tag_id = lxb_tag_id_by_name(doc->tags, selector->name.data,
+                                                selector->name.length);
+
+                    key = lxb_selectors_bloom_key(tag_id, 0);
+                    break;
+
+                case LXB_CSS_SELECTOR_TYPE_ID:
+                    key = lxb_selectors_bloom_key_id(selector->name.data,
+                                                     selector->name.length);
+                    break;
+
+                case LXB_CSS_SELECTOR_TYPE_CLASS:
+                    cls = lxb_dom_element_class_by_name(doc,
+                                                        selector->name.data,
+                                                        selector->name.length,
+                                                        true);
+                    key = (cls != NULL) ? lxb_selectors_bloom_key_class(cls)
+                                        : lxb_selectors_bloom_key(0, 0);
+                    break;
+
+                default:
+                    goto next;
+            }
+
+            bloom->keys[idx][length++] = key;
+        }
+
+    next:
+
+        switch (selector->combinator) {
+            case LXB_CSS_SELECTOR_COMBINATOR_CLOSE:
+                break;
+
+            case LXB_CSS_SELECTOR_COMBINATOR_DESCENDANT:
+            case LXB_CSS_SELECTOR_COMBINATOR_CHILD:
+                ancestor = true;
+                break;
+
+            default:
+                ancestor = false;
+                break;
+        }
+    }
+
+    bloom->lengths[idx] = length;
+}
+
+/*
+ * Keys of every selector in the list, or NULL if the filter would not skip
+ * anything: some selector has no keys or the list is too long.
+ */
+static lxb_selectors_bloom_t *
+lxb_selectors_bloom_prepare(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                            const lxb_css_selector_list_t *list)
+{
+    lxb_selectors_bloom_t *bloom = selectors->bloom;
+
+    if (bloom == NULL) {
+        return NULL;
+    }
+
+    bloom->count = 0;
+
+    for (; list != NULL; list = list->next) {
+        if (bloom->count == LXB_SELECTORS_BLOOM_LISTS) {
+            return NULL;
+        }
+
+        lxb_selectors_bloom_list(bloom, list->last, root->owner_document,
+                                 bloom->count);
+
+        if (bloom->lengths[bloom->count] == 0) {
+            return NULL;
+        }
+
+        bloom->count++;
+    }
+
+    return bloom;
+}
+
+/*
+ * The index list of the tag or class of the last compound selector,
+ * the shorter one if it has both.  Returns false if there is neither.
+ */
+static bool
+lxb_selectors_index_list(const lxb_css_selector_t *selector,
+                         lxb_dom_index_t *index, lxb_dom_document_t *doc,
+                         const lxb_dom_index_list_t **out)
+{
+    bool found;
+    lxb_tag_id_t tag_id;
+    const lxb_dom_index_list_t *list;
+
+    found = false;
+    *out = NULL;
+
+    do {
+        list = NULL;
+
+        if (selector->type == LXB_CSS_SELECTOR_TYPE_ELEMENT
+            && index->tags != NULL)
+        {
+            tag_id = lxb_tag_id_by_name(doc->tags, selector->name.data,
+                                        selector->name.length);
+            if (tag_id != LXB_TAG__UNDEF) {
+                list = lxb_dom_index_tag(index, tag_id);
+            }
+        }
+        else if (selector->type == LXB_CSS_SELECTOR_TYPE_CLASS
+                 && index->classes != NULL)
+        {
+            list = lxb_dom_index_class(index, selector->name.data,
+                                       selector->name.length);
+        }
+        else {
+            goto next;
+        }
+
+        if (!found || list == NULL
+            || (*out != NULL && list->length < (*out)->length))
+        {
+            *out = list;
+        }
+
+        found = true;
+
+    next:
+
+        if (selector->combinator != LXB_CSS_SELECTOR_COMBINATOR_CLOSE
+            || selector->prev == NULL)
+        {
+            break;
+        }
+
+        selector = selector->prev;
+    }
+    while (true);
+
+    return found;
+}
+
+/*
+ * Same as lxb_selectors_tree(), but visits only the elements of the index
+ * lists: an element that is in none of them cannot match the last compound
+ * of any selector in the list.  The lists are merged in tree order, so the
+ * callback sees the nodes in the same order.
+ *
+ * Returns LXB_STATUS_NEXT if some selector has no tag or class to look up,
+ * if the lists are stale and walking is cheaper than building them, see
+ * lxb_dom_index_ready(), or if root has fewer descendants than the lists
+ * have elements.
+ */
+static lxb_status_t
+lxb_selectors_tree_index(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                         const lxb_css_selector_list_t *list,
+                         lxb_dom_index_t *index)
+{
+    bool below;
+    size_t i, length, order, total;
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+    const lxb_dom_index_list_t *ilist;
+    const lxb_dom_index_item_t *items[LXB_SELECTORS_INDEX_LISTS];
+
+    status = lxb_dom_index_ready(index, root);
+    if (status != LXB_STATUS_OK) {
+        return LXB_STATUS_NEXT;
+    }
+
+    total = 0;
+    length = 0;
+
+    for (; list != NULL; list = list->next) {
+        if (length == LXB_SELECTORS_INDEX_LISTS
+            || !lxb_selectors_index_list(list->last, index,
+                                         root->owner_document, &ilist))
+        {
+            return LXB_STATUS_NEXT;
+        }
+
+        if (ilist != NULL) {
+            items[length++] = ilist->first;
+            total += ilist->length;
+        }
+        else {
+            items[length++] = NULL;
+        }
+    }
+
+    if (root->type != LXB_DOM_NODE_TYPE_DOCUMENT
+        && lxb_dom_index_subtree_less(root, total))
+    {
+        return LXB_STATUS_NEXT;
+    }
+
+    below = false;
+
+    do {
+        node = NULL;
+        order = SIZE_MAX;
+
+        for (i = 0; i < length; i++) {
+            if (items[i] != NULL && items[i]->order < order) {
+                order = items[i]->order;
+                node = lxb_dom_interface_node(items[i]->element);
+            }
+        }
+
+        if (node == NULL) {
+            break;
+        }
+
+        for (i = 0; i < length; i++) {
+            if (items[i] != NULL && items[i]->order == order) {
+                items[i] = items[i]->next;
+            }
+        }
+
+        if (node == root) {
+            below = true;
+
+            if ((selectors->options & LXB_SELECTORS_OPT_MATCH_ROOT) == 0) {
+                continue;
+            }
+        }
+        else if (root->type != LXB_DOM_NODE_TYPE_DOCUMENT) {
+            if (!lxb_dom_index_below(root, node)) {
+                /* Root and the elements below it are next to each other. */
+                if (below) {
+                    break;
+                }
 
-    if (node == NULL) {
-        goto out;
-    }
+                continue;
+            }
 
-    do {
-        if (node->type != LXB_DOM_NODE_TYPE_ELEMENT) {
-            goto next;
+            below = true;
         }
 
         status = lxb_selectors_run(selectors, node);
@@ -660,28 +1355,9 @@ lxb_selectors_tree(lxb_selectors_t *selectors, lxb_dom_node_t *root)
 
             return status;
         }
-
-        if (node->first_child != NULL) {
-            node = node->first_child;
-        }
-        else {
-
-        next:
-
-            while (node != root && node->next == NULL) {
-                node = node->parent;
-            }
-
-            if (node == root) {
-                break;
-            }
-
-            node = node->next;
-        }
     }
     while (true);
 
-out:
     lxb_selectors_clean(selectors);
 
     return LXB_STATUS_OK;
@@ -941,6 +1617,12 @@ lxb_selectors_state_found(lxb_selectors_t *selectors,
                                     selector->list->specificity,
                                     current->ctx);
 
+    if (current->parent == NULL && selectors->limit != 0
+        && selectors->status == LXB_STATUS_OK && --selectors->limit == 0)
+    {
+        selectors->status = LXB_STATUS_STOPPED;
+    }
+
     if ((selectors->options & LXB_SELECTORS_OPT_MATCH_FIRST) == 0
         && current->parent == NULL)
     {
@@ -1059,7 +1741,7 @@ static lxb_selectors_entry_t *
 lxb_selectors_next_list(lxb_selectors_t *selectors,
                         lxb_selectors_entry_t *entry)
 {
-    if (entry->selector->list->next == NULL) {
+    if (entry->selector->list->next == NULL || selectors->current->single) {
         return lxb_selectors_exit(selectors);
     }
 
@@ -1171,6 +1853,15 @@ lxb_selectors_state_after_find(lxb_selectors_t *selectors,
     return selectors->current->entry;
 }
 
+static lxb_selectors_entry_t *
+lxb_selectors_state_after_has(lxb_selectors_t *selectors,
+                              lxb_selectors_entry_t *entry)
+{
+    lxb_selectors_has_remember(selectors, false);
+
+    return lxb_selectors_state_after_find(selectors, entry);
+}
+
 static lxb_selectors_entry_t *
 lxb_selectors_state_after_not(lxb_selectors_t *selectors,
                               lxb_selectors_entry_t *entry)
@@ -1292,8 +1983,6 @@ static bool
 lxb_selectors_match(lxb_selectors_t *selectors, lxb_selectors_entry_t *entry,
                     lxb_dom_node_t *node)
 {
-    lxb_dom_element_t *element;
-
     switch (entry->selector->type) {
         case LXB_CSS_SELECTOR_TYPE_ANY:
             return true;
@@ -1305,24 +1994,13 @@ lxb_selectors_match(lxb_selectors_t *selectors, lxb_selectors_entry_t *entry,
             return lxb_selectors_match_id(entry->selector, node);
 
         case LXB_CSS_SELECTOR_TYPE_CLASS:
-            element = lxb_dom_interface_element(node);
-
-            if (element->attr_class == NULL 
-                || element->attr_class->value == NULL)
-            {
-                return false;
-            }
-
-            return lxb_selectors_match_class(element->attr_class->value,
-                                             &entry->selector->name,
-                                             node->owner_document->compat_mode
-                                             == LXB_DOM_DOCUMENT_CMODE_QUIRKS);
+            return lxb_selectors_match_class_name(entry->selector, node, entry);
 
         case LXB_CSS_SELECTOR_TYPE_ATTRIBUTE:
             return lxb_selectors_match_attribute(entry->selector, node, entry);
 
         case LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS:
-            return lxb_selectors_pseudo_class(entry->selector, node);
+            return lxb_selectors_pseudo_class(selectors, entry->selector, node);
 
         case LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS_FUNCTION:
             return lxb_selectors_pseudo_class_function(selectors,
@@ -1385,6 +2063,38 @@ lxb_selectors_match_id(const lxb_css_selector_t *selector, lxb_dom_node_t *node)
     return lexbor_str_data_ncmp(trg->data, src->data, src->length);
 }
 
+static bool
+lxb_selectors_match_class_name(const lxb_css_selector_t *selector,
+                               lxb_dom_node_t *node,
+                               lxb_selectors_entry_t *entry)
+{
+    bool quirks;
+    const lxb_dom_element_class_t *cls;
+    lxb_dom_element_t *element = lxb_dom_interface_element(node);
+
+    if (element->classes_length == 0) {
+        return false;
+    }
+
+    quirks = node->owner_document->compat_mode
+             == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    if (entry->id == 0) {
+        cls = lxb_dom_element_class_by_name(node->owner_document,
+                                            selector->name.data,
+                                            selector->name.length, quirks);
+        if (cls == NULL) {
+            return false;
+        }
+
+        entry->id = (uintptr_t) cls;
+    }
+
+    return lxb_dom_element_has_class(element,
+                                     (const lxb_dom_element_class_t *) entry->id,
+                                     quirks);
+}
+
 static bool
 lxb_selectors_match_class(const lexbor_str_t *target, const lexbor_str_t *src,
                           bool quirks)
@@ -1592,7 +2302,7 @@ lxb_selectors_match_attribute(const lxb_css_selector_t *selector,
 }
 
 static bool
-lxb_selectors_match_attribute_html_case_insensitive(lxb_dom_node_t *node,
+lxb_selectors_match_attribute_html_case_insensitive(const lxb_dom_node_t *node,
                                                    lxb_dom_attr_id_t attr_id)
 {
     if (node->ns != LXB_NS_HTML
@@ -1656,7 +2366,8 @@ lxb_selectors_match_attribute_html_case_insensitive(lxb_dom_node_t *node,
 }
 
 static bool
-lxb_selectors_pseudo_class(const lxb_css_selector_t *selector,
+lxb_selectors_pseudo_class(lxb_selectors_t *selectors,
+                           const lxb_css_selector_t *selector,
                            const lxb_dom_node_t *node)
 {
     lexbor_str_t *str;
@@ -1780,7 +2491,7 @@ lxb_selectors_pseudo_class(const lxb_css_selector_t *selector,
             return lxb_selectors_pseudo_class_first_child(node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_FIRST_OF_TYPE:
-            return lxb_selectors_pseudo_class_first_of_type(node);
+            return lxb_selectors_pseudo_class_first_of_type(selectors, node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_FOCUS:
             attr = lxb_dom_element_attr_by_id(lxb_dom_interface_element(node),
@@ -1817,7 +2528,7 @@ lxb_selectors_pseudo_class(const lxb_css_selector_t *selector,
             return lxb_selectors_pseudo_class_last_child(node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_LAST_OF_TYPE:
-            return lxb_selectors_pseudo_class_last_of_type(node);
+            return lxb_selectors_pseudo_class_last_of_type(selectors, node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_LINK:
             if (node->local_name == LXB_TAG_A
@@ -1839,8 +2550,8 @@ lxb_selectors_pseudo_class(const lxb_css_selector_t *selector,
             && lxb_selectors_pseudo_class_last_child(node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_ONLY_OF_TYPE:
-            return lxb_selectors_pseudo_class_first_of_type(node)
-            && lxb_selectors_pseudo_class_last_of_type(node);
+            return lxb_selectors_pseudo_class_first_of_type(selectors, node)
+            && lxb_selectors_pseudo_class_last_of_type(selectors, node);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_OPTIONAL:
             if (node->local_name == LXB_TAG_INPUT
@@ -1974,8 +2685,8 @@ lxb_selectors_pseudo_class_function(lxb_selectors_t *selectors,
 {
     bool is;
     size_t index;
-    lxb_dom_node_t *base;
     lxb_selectors_nested_t *current;
+    lxb_selectors_cache_entry_t *cached;
     const lexbor_str_t *str;
     const lxb_dom_text_t *text;
     const lxb_css_selector_list_t *list;
@@ -1989,14 +2700,22 @@ lxb_selectors_pseudo_class_function(lxb_selectors_t *selectors,
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_HAS:
             list = (lxb_css_selector_list_t *) pseudo->data;
 
+            if (selectors->cache.depth != 0) {
+                cached = lxb_selectors_cache_search(&selectors->cache, node,
+                                                    list->first);
+                if (cached != NULL) {
+                    return cached->u.found;
+                }
+            }
+
             current = lxb_selectors_nested_make(selectors, node,
                                                 list->first, true);
             if (current == NULL) {
                 goto failed;
             }
 
-            current->cb = lxb_selectors_cb_ok;
-            current->return_state = lxb_selectors_state_after_find;
+            current->cb = lxb_selectors_cb_has;
+            current->return_state = lxb_selectors_state_after_has;
             selectors->state = lxb_selectors_state_find_forward;
 
             break;
@@ -2052,60 +2771,17 @@ lxb_selectors_pseudo_class_function(lxb_selectors_t *selectors,
                 return true;
             }
 
-            index = 0;
-
-            if (pseudo->type == LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_CHILD) {
-                while (node != NULL) {
-                    if (node->local_name != LXB_TAG__TEXT
-                        && node->local_name != LXB_TAG__EM_COMMENT)
-                    {
-                        index++;
-                    }
-
-                    node = node->prev;
-                }
-            }
-            else {
-                while (node != NULL) {
-                    if (node->local_name != LXB_TAG__TEXT
-                        && node->local_name != LXB_TAG__EM_COMMENT)
-                    {
-                        index++;
-                    }
-
-                    node = node->next;
-                }
-            }
+            index = lxb_selectors_nth_index(selectors, node, false,
+                    pseudo->type
+                    == LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_CHILD);
 
             return lxb_selectors_anb_calc(pseudo->data, index);
 
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_OF_TYPE:
         case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_OF_TYPE:
-            index = 0;
-            base = node;
-
-            if (pseudo->type == LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_OF_TYPE) {
-                while (node != NULL) {
-                    if(node->local_name == base->local_name
-                       && node->ns == base->ns)
-                    {
-                        index++;
-                    }
-
-                    node = node->prev;
-                }
-            }
-            else {
-                while (node != NULL) {
-                    if(node->local_name == base->local_name
-                       && node->ns == base->ns)
-                    {
-                        index++;
-                    }
-
-                    node = node->next;
-                }
-            }
+            index = lxb_selectors_nth_index(selectors, node, true,
+                    pseudo->type
+                    == LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_OF_TYPE);
 
             return lxb_selectors_anb_calc(pseudo->data, index);
 
@@ -2235,9 +2911,15 @@ lxb_selectors_pseudo_class_first_child(const lxb_dom_node_t *node)
 }
 
 static bool
-lxb_selectors_pseudo_class_first_of_type(const lxb_dom_node_t *node)
+lxb_selectors_pseudo_class_first_of_type(lxb_selectors_t *selectors,
+                                         const lxb_dom_node_t *node)
 {
     const lxb_dom_node_t *root = node;
+
+    if (selectors->cache.depth != 0) {
+        return lxb_selectors_nth_index(selectors, node, true, false) == 1;
+    }
+
     node = node->prev;
 
     while (node) {
@@ -2272,9 +2954,15 @@ lxb_selectors_pseudo_class_last_child(const lxb_dom_node_t *node)
 }
 
 static bool
-lxb_selectors_pseudo_class_last_of_type(const lxb_dom_node_t *node)
+lxb_selectors_pseudo_class_last_of_type(lxb_selectors_t *selectors,
+                                        const lxb_dom_node_t *node)
 {
     const lxb_dom_node_t *root = node;
+
+    if (selectors->cache.depth != 0) {
+        return lxb_selectors_nth_index(selectors, node, true, true) == 1;
+    }
+
     node = node->next;
 
     while (node) {
@@ -2331,6 +3019,303 @@ lxb_selectors_anb_calc(lxb_css_selector_anb_of_t *anb, size_t index)
     return false;
 }
 
+static void
+lxb_selectors_cache_next_gen(lxb_selectors_cache_t *cache)
+{
+    cache->length = 0;
+    cache->gen++;
+
+    if (cache->gen == 0) {
+        if (cache->entries != NULL) {
+            memset(cache->entries, 0,
+                   sizeof(lxb_selectors_cache_entry_t) * cache->size);
+        }
+
+        cache->gen = 1;
+    }
+}
+
+void
+lxb_selectors_cache_begin(lxb_selectors_t *selectors)
+{
+    lxb_selectors_cache_t *cache = &selectors->cache;
+
+    if (cache->depth++ != 0) {
+        return;
+    }
+
+    lxb_selectors_cache_next_gen(cache);
+
+    cache->doc = NULL;
+}
+
+void
+lxb_selectors_cache_end(lxb_selectors_t *selectors)
+{
+    selectors->cache.depth--;
+}
+
+lxb_inline size_t
+lxb_selectors_cache_hash(const lxb_dom_node_t *node, const void *key,
+                         size_t size)
+{
+    uint64_t hash;
+
+    hash = ((uint64_t) (uintptr_t) node ^ ((uint64_t) (uintptr_t) key << 17))
+           * 0x9E3779B97F4A7C15ULL;
+
+    return (size_t) (hash >> 32) & (size - 1);
+}
+
+/* Starts a new generation if the tree of the node has changed. */
+lxb_inline void
+lxb_selectors_cache_check(lxb_selectors_cache_t *cache,
+                          const lxb_dom_node_t *node)
+{
+    size_t changes;
+    const lxb_dom_document_t *doc = node->owner_document;
+
+    changes = lxb_dom_document_changes(doc);
+
+    if (cache->doc == doc && cache->changes == changes) {
+        return;
+    }
+
+    if (cache->doc != NULL) {
+        lxb_selectors_cache_next_gen(cache);
+    }
+
+    cache->doc = doc;
+    cache->changes = changes;
+}
+
+static lxb_selectors_cache_entry_t *
+lxb_selectors_cache_search(lxb_selectors_cache_t *cache,
+                           const lxb_dom_node_t *node, const void *key)
+{
+    size_t idx;
+    lxb_selectors_cache_entry_t *entry;
+
+    lxb_selectors_cache_check(cache, node);
+
+    if (cache->entries == NULL) {
+        return NULL;
+    }
+
+    idx = lxb_selectors_cache_hash(node, key, cache->size);
+
+    for (;; idx = (idx + 1) & (cache->size - 1)) {
+        entry = &cache->entries[idx];
+
+        if (entry->gen != cache->gen) {
+            return NULL;
+        }
+
+        if (entry->node == node && entry->key == key) {
+            return entry;
+        }
+    }
+}
+
+static lxb_status_t
+lxb_selectors_cache_grow(lxb_selectors_cache_t *cache)
+{
+    size_t i, idx, size;
+    lxb_selectors_cache_entry_t *entries, *entry;
+
+    size = (cache->entries != NULL) ? cache->size * 2 : 256;
+
+    entries = lexbor_calloc(size, sizeof(lxb_selectors_cache_entry_t));
+    if (entries == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    for (i = 0; i < cache->size; i++) {
+        entry = &cache->entries[i];
+
+        if (entry->gen != cache->gen) {
+            continue;
+        }
+
+        idx = lxb_selectors_cache_hash(entry->node, entry->key, size);
+
+        while (entries[idx].gen == cache->gen) {
+            idx = (idx + 1) & (size - 1);
+        }
+
+        entries[idx] = *entry;
+    }
+
+    if (cache->entries != NULL) {
+        lexbor_free(cache->entries);
+    }
+
+    cache->entries = entries;
+    cache->size = size;
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_selectors_cache_entry_t *
+lxb_selectors_cache_insert(lxb_selectors_cache_t *cache,
+                           const lxb_dom_node_t *node, const void *key)
+{
+    size_t idx;
+    lxb_selectors_cache_entry_t *entry;
+
+    lxb_selectors_cache_check(cache, node);
+
+    /* At most a half full. */
+    if (cache->length >= cache->size / 2) {
+        if (lxb_selectors_cache_grow(cache) != LXB_STATUS_OK) {
+            return NULL;
+        }
+    }
+
+    idx = lxb_selectors_cache_hash(node, key, cache->size);
+
+    for (;; idx = (idx + 1) & (cache->size - 1)) {
+        entry = &cache->entries[idx];
+
+        if (entry->gen != cache->gen) {
+            break;
+        }
+
+        if (entry->node == node && entry->key == key) {
+            return entry;
+        }
+    }
+
+    memset(entry, 0, sizeof(lxb_selectors_cache_entry_t));
+
+    entry->node = node;
+    entry->key = key;
+    entry->gen = cache->gen;
+
+    cache->length++;
+
+    return entry;
+}
+
+/* Whether the sibling counts for the position of the node. */
+lxb_inline bool
+lxb_selectors_nth_counts(const lxb_dom_node_t *sibling,
+                         const lxb_dom_node_t *node, bool of_type)
+{
+    if (of_type) {
+        return sibling->local_name == node->local_name
+               && sibling->ns == node->ns;
+    }
+
+    return sibling->local_name != LXB_TAG__TEXT
+           && sibling->local_name != LXB_TAG__EM_COMMENT;
+}
+
+/* Positions of all siblings of the node that count, from both ends. */
+static lxb_status_t
+lxb_selectors_nth_fill(lxb_selectors_cache_t *cache,
+                       const lxb_dom_node_t *node, bool of_type)
+{
+    size_t count, total, idx;
+    const lxb_dom_node_t *first, *sibling;
+    lxb_selectors_cache_entry_t *entry;
+
+    first = (node->parent != NULL) ? node->parent->first_child : node;
+
+    while (first->prev != NULL) {
+        first = first->prev;
+    }
+
+    total = 0;
+
+    for (sibling = first; sibling != NULL; sibling = sibling->next) {
+        total += lxb_selectors_nth_counts(sibling, node, of_type);
+    }
+
+    idx = (of_type) ? 2 : 0;
+    count = 0;
+
+    for (sibling = first; sibling != NULL; sibling = sibling->next) {
+        if (!lxb_selectors_nth_counts(sibling, node, of_type)) {
+            continue;
+        }
+
+        entry = lxb_selectors_cache_insert(cache, sibling, NULL);
+        if (entry == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        count++;
+
+        entry->u.index[idx] = count;
+        entry->u.index[idx + 1] = total - count + 1;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+size_t
+lxb_selectors_nth_index(lxb_selectors_t *selectors, const lxb_dom_node_t *node,
+                        bool of_type, bool last)
+{
+    size_t index, idx;
+    const lxb_dom_node_t *sibling;
+    lxb_selectors_cache_entry_t *entry;
+    lxb_selectors_cache_t *cache = &selectors->cache;
+
+    idx = (of_type) ? 2 : 0;
+    idx += last;
+
+    if (cache->depth != 0) {
+        entry = lxb_selectors_cache_search(cache, node, NULL);
+
+        if (entry == NULL || entry->u.index[idx] == 0) {
+            if (lxb_selectors_nth_fill(cache, node, of_type) == LXB_STATUS_OK) {
+                entry = lxb_selectors_cache_search(cache, node, NULL);
+            }
+            else {
+                entry = NULL;
+            }
+        }
+
+        if (entry != NULL) {
+            return entry->u.index[idx];
+        }
+    }
+
+    /* Without the cache, or out of memory. */
+
+    index = 0;
+
+    for (sibling = node; sibling != NULL;
+         sibling = (last) ? sibling->next : sibling->prev)
+    {
+        index += lxb_selectors_nth_counts(sibling, node, of_type);
+    }
+
+    return index;
+}
+
+/* Remembers whether :has() matched for the node being checked. */
+static void
+lxb_selectors_has_remember(lxb_selectors_t *selectors, bool found)
+{
+    lxb_selectors_nested_t *current;
+    lxb_selectors_cache_entry_t *entry;
+
+    if (selectors->cache.depth == 0) {
+        return;
+    }
+
+    current = selectors->current;
+
+    entry = lxb_selectors_cache_insert(&selectors->cache, current->root,
+                                       current->top->selector);
+    if (entry != NULL) {
+        entry->u.found = found;
+    }
+}
+
 static lxb_status_t
 lxb_selectors_cb_ok(lxb_dom_node_t *node,
                     lxb_css_selector_specificity_t spec, void *ctx)
@@ -2342,6 +3327,18 @@ lxb_selectors_cb_ok(lxb_dom_node_t *node,
     return LXB_STATUS_OK;
 }
 
+static lxb_status_t
+lxb_selectors_cb_has(lxb_dom_node_t *node,
+                     lxb_css_selector_specificity_t spec, void *ctx)
+{
+    lxb_selectors_t *selectors = ctx;
+
+    lxb_selectors_has_remember(selectors, true);
+    lxb_selectors_switch_to_found_check(selectors, selectors->current->parent);
+
+    return LXB_STATUS_OK;
+}
+
 static lxb_status_t
 lxb_selectors_cb_not(lxb_dom_node_t *node,
                      lxb_css_selector_specificity_t spec, void *ctx)
@@ -2376,3 +3373,9 @@ lxb_selectors_selector_noi(const lxb_selectors_t *selectors)
 {
     return lxb_selectors_selector(selectors);
 }
+
+size_t
+lxb_selectors_cache_depth_noi(const lxb_selectors_t *selectors)
+{
+    return lxb_selectors_cache_depth(selectors);
+}
@@ -18,6 +18,21 @@ extern "C" {
 #include "lexbor/core/array_obj.h"
 
 
+/*
+ * The most selectors in a list for which lxb_selectors_find() takes the
+ * candidates from the document index, see lxb_dom_document_index_set().
+ */
+#define LXB_SELECTORS_INDEX_LISTS 16
+
+/*
+ * Ancestor filter of lxb_selectors_find(): the size of the counting Bloom
+ * filter (bits of the index), the most keys taken from one selector and
+ * the most selectors in a list for which the filter is used.
+ */
+#define LXB_SELECTORS_BLOOM_BITS  12
+#define LXB_SELECTORS_BLOOM_KEYS  4
+#define LXB_SELECTORS_BLOOM_LISTS 16
+
 typedef enum {
     LXB_SELECTORS_OPT_DEFAULT = 0x00,
 
@@ -54,7 +69,17 @@ typedef enum {
      * any of the selectors.  That is, the callback will be called only once
      * for example above.  This way we get rid of duplicates in the search.
      */
-    LXB_SELECTORS_OPT_MATCH_FIRST = 1 << 2
+    LXB_SELECTORS_OPT_MATCH_FIRST = 1 << 2,
+
+    /*
+     * Walks the tree below the root even if the document has an index, see
+     * lxb_dom_document_index_set().
+     *
+     * Picking the elements from the index lists costs as much as the lists
+     * are long, wherever the root is.  This option is for searches that are
+     * known to cover a small part of the document.
+     */
+    LXB_SELECTORS_OPT_WALK = 1 << 3
 }
 lxb_selectors_opt_t;
 
@@ -96,17 +121,88 @@ struct lxb_selectors_nested {
     size_t                   index;
 
     bool                     forward;
+    bool                     single;
 };
 
+/*
+ * Tags, ids and classes of the ancestors of the node being checked.
+ *
+ * Every key sets two counters; the keys of each ancestor are kept on a stack
+ * (followed by their number) to be taken away again when the walk leaves it.
+ * A counter that reached the maximum is never decreased.
+ */
+typedef struct {
+    uint8_t  counters[1 << LXB_SELECTORS_BLOOM_BITS];
+
+    uint32_t *stack;
+    size_t   length;
+    size_t   size;
+    size_t   base;
+
+    /* Keys the ancestors must have, for each selector in the list. */
+    uint32_t keys[LXB_SELECTORS_BLOOM_LISTS][LXB_SELECTORS_BLOOM_KEYS];
+    size_t   lengths[LXB_SELECTORS_BLOOM_LISTS];
+    size_t   count;
+}
+lxb_selectors_bloom_t;
+
+typedef struct {
+    const lxb_dom_node_t *node;
+    const void           *key;   /* NULL for positions, else :has() list. */
+    size_t               gen;
+
+    union {
+        /* Child, last child, of type, last of type; 0 if not known yet. */
+        size_t index[4];
+        bool   found;
+    }
+    u;
+}
+lxb_selectors_cache_entry_t;
+
+/*
+ * What is found out about nodes during a search: positions of elements
+ * among their siblings (see lxb_selectors_nth_index()) and whether
+ * a :has() argument matched relative to an element.
+ *
+ * The positions of all siblings are found at once, the first time one of
+ * them is asked for.  Entries of an older generation are empty: a new
+ * generation starts for every lxb_selectors_find() call (outside of
+ * lxb_selectors_cache_begin() and lxb_selectors_cache_end()) and whenever
+ * lxb_dom_document_changes() of the document differs from what it was.
+ */
+typedef struct {
+    lxb_selectors_cache_entry_t *entries;
+    size_t                      size;
+    size_t                      length;
+    size_t                      gen;
+    size_t                      depth;
+
+    /* The document the entries are about and its changes then. */
+    const lxb_dom_document_t    *doc;
+    size_t                      changes;
+}
+lxb_selectors_cache_t;
+
 struct lxb_selectors {
     lxb_selectors_state_cb_f state;
     lexbor_dobject_t         *objs;
     lexbor_dobject_t         *nested;
+    lxb_selectors_bloom_t    *bloom;
+
+    /* Names of a lxb_selectors_program_t looked up in the document. */
+    uintptr_t                *bound;
+    size_t                   bound_size;
+
+    lxb_selectors_cache_t    cache;   /* Positions and :has() results. */
 
     lxb_selectors_nested_t   *current;
 
     lxb_selectors_opt_t      options;
     lxb_status_t             status;
+
+    /* Calls of the callback left, see lxb_selectors_find_limit(). */
+    size_t                   limit;
 };
 
 
@@ -170,6 +266,23 @@ lxb_selectors_destroy(lxb_selectors_t *selectors, bool self_destroy);
  *
  * To change the search behavior, see lxb_selectors_opt_set().
  *
+ * If the document has a tag or class index (LXB_DOM_INDEX_OPT_TAG,
+ * LXB_DOM_INDEX_OPT_CLASS) and every selector in the list has a tag or
+ * class in its last compound, only the elements with them are checked,
+ * unless LXB_SELECTORS_OPT_WALK is set.  The callback must not change
+ * the tree in this case.
+ *
+ * Otherwise, if every selector in the list has a tag, id or class in a
+ * compound that must match an ancestor (as "div" and ".a" in "div .a > p"),
+ * the walk keeps the ancestors of the current node in a Bloom filter and
+ * skips the nodes whose ancestors cannot have them all.  The callback must
+ * not change the tags, ids and classes of the ancestors in this case.
+ *
+ * The positions of elements among their siblings, for :nth-child() and
+ * the like, are found once per search, see lxb_selectors_nth_index(); the
+ * result of :has() is found once per element and argument.  What was
+ * found is forgotten when the callback changes the tree.
+ *
  * @param[in] lxb_selectors_t *.
  * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
  * @param[in] const lxb_css_selector_list_t *.  Selectors List.
@@ -184,6 +297,45 @@ lxb_selectors_find(lxb_selectors_t *selectors, lxb_dom_node_t *root,
                    const lxb_css_selector_list_t *list,
                    lxb_selectors_cb_f cb, void *ctx);
 
+/*
+ * Same as lxb_selectors_find(), but the search ends as soon as the callback
+ * has been called limit times: no more nodes are visited and the nested
+ * searches of :has(), :not() and the like are left at once.
+ *
+ * A limit of 0 means no limit.
+ *
+ * @param[in] lxb_selectors_t *.
+ * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ * @param[in] size_t.  The most calls of the callback.
+ * @param[in] lxb_selectors_cb_f.  Callback for a found node.
+ * @param[in] void *.  Context for the callback.
+ *
+ * @return LXB_STATUS_STOPPED if the limit was reached, LXB_STATUS_OK if
+ * the whole tree was searched (or the callback returned LXB_STATUS_STOP),
+ * otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_find_limit(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                         const lxb_css_selector_list_t *list, size_t limit,
+                         lxb_selectors_cb_f cb, void *ctx);
+
+/*
+ * The first node found by the selector list in document order, as
+ * querySelector() does.  The search ends at that node.
+ *
+ * @param[in] lxb_selectors_t *.
+ * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ * @param[out] lxb_dom_node_t **.  The node, or NULL if nothing is found.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_find_first(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+                         const lxb_css_selector_list_t *list,
+                         lxb_dom_node_t **node);
+
 /*
  * Match a node to a Selectors List.
  *
@@ -215,6 +367,68 @@ lxb_selectors_match_node(lxb_selectors_t *selectors, lxb_dom_node_t *node,
                          const lxb_css_selector_list_t *list,
                          lxb_selectors_cb_f cb, void *ctx);
 
+/*
+ * Same as lxb_selectors_match_node(), but only for the first selector of
+ * the list: the following selectors (list->next) are not checked.
+ *
+ * For callers that keep the selectors of a list apart, for example bucketed
+ * by their last compound.
+ */
+LXB_API lxb_status_t
+lxb_selectors_match_node_single(lxb_selectors_t *selectors,
+                                lxb_dom_node_t *node,
+                                const lxb_css_selector_list_t *list,
+                                lxb_selectors_cb_f cb, void *ctx);
+
+/*
+ * Whether the node matches the pseudo-class (not a function), as it is
+ * checked by lxb_selectors_find().
+ */
+LXB_API bool
+lxb_selectors_pseudo_class_match(lxb_selectors_t *selectors,
+                                 const lxb_css_selector_t *selector,
+                                 const lxb_dom_node_t *node);
+
+/*
+ * Whether the values of the attribute of the node are compared ignoring
+ * case when the selector has no modifier: the attributes of HTML elements
+ * listed by the HTML standard.
+ */
+LXB_API bool
+lxb_selectors_attribute_case_insensitive(const lxb_dom_node_t *node,
+                                         lxb_dom_attr_id_t attr_id);
+
+/*
+ * The position of the node among its siblings, counted from 1, as seen by
+ * :nth-child() (of_type is false) or :nth-of-type() (true); from the end
+ * if last is true.
+ *
+ * Inside lxb_selectors_find() or between lxb_selectors_cache_begin()
+ * and lxb_selectors_cache_end() the positions are cached, so that
+ * checking every child of a node costs as much as counting them once.
+ * The results of :has() are cached there too.
+ */
+LXB_API size_t
+lxb_selectors_nth_index(lxb_selectors_t *selectors, const lxb_dom_node_t *node,
+                        bool of_type, bool last);
+
+/*
+ * Keeps the cached positions of elements among their siblings and results
+ * of :has() from one lxb_selectors_match_node() or lxb_selectors_find()
+ * call to the next, until the matching lxb_selectors_cache_end().
+ * Calls can be nested.
+ *
+ * The cache is emptied when the tree changes (see
+ * lxb_dom_document_changes()).  The selector lists must not be destroyed
+ * in between: results of :has() are told apart by the address of the
+ * argument.
+ */
+LXB_API void
+lxb_selectors_cache_begin(lxb_selectors_t *selectors);
+
+LXB_API void
+lxb_selectors_cache_end(lxb_selectors_t *selectors);
+
 /*
  * Deprecated!
  * This function does exactly the same thing as lxb_selectors_match_node().
@@ -258,6 +472,20 @@ lxb_selectors_selector(const lxb_selectors_t *selectors)
     return selectors->current->entry->selector->list;
 }
 
+/*
+ * The number of lxb_selectors_cache_begin() calls not yet ended, 0 if the
+ * cache is not kept between searches.
+ *
+ * @param[in] const lxb_selectors_t *.
+ *
+ * @return size_t.
+ */
+lxb_inline size_t
+lxb_selectors_cache_depth(const lxb_selectors_t *selectors)
+{
+    return selectors->cache.depth;
+}
+
 /*
  * Not inline for inline.
  */
@@ -274,6 +502,12 @@ lxb_selectors_opt_set_noi(lxb_selectors_t *selectors, lxb_selectors_opt_t opt);
 LXB_API const lxb_css_selector_list_t *
 lxb_selectors_selector_noi(const lxb_selectors_t *selectors);
 
+/*
+ * Same as lxb_selectors_cache_depth() function, but not inline.
+ */
+LXB_API size_t
+lxb_selectors_cache_depth_noi(const lxb_selectors_t *selectors);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
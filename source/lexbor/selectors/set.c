@@ -0,0 +1,1013 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/selectors/set.h"
+
+
+static lxb_status_t
+lxb_selectors_set_found_cb(lxb_dom_node_t *node,
+                           lxb_css_selector_specificity_t spec, void *ctx);
+
+static int
+lxb_selectors_set_unbound_cmp(const void *first, const void *second);
+
+
+lxb_selectors_set_t *
+lxb_selectors_set_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_selectors_set_t));
+}
+
+lxb_status_t
+lxb_selectors_set_init(lxb_selectors_set_t *set)
+{
+    lxb_status_t status;
+
+    if (set == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    set->program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(set->program);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    set->ids = lexbor_hash_create();
+    status = lexbor_hash_init(set->ids, 128,
+                              sizeof(lxb_selectors_set_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    set->classes = lexbor_hash_create();
+    status = lexbor_hash_init(set->classes, 128,
+                              sizeof(lxb_selectors_set_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    set->tags = lexbor_hash_create();
+    status = lexbor_hash_init(set->tags, 64,
+                              sizeof(lxb_selectors_set_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    set->nodes = lexbor_dobject_create();
+    status = lexbor_dobject_init(set->nodes, 512,
+                                 sizeof(lxb_selectors_set_node_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    set->roots_size = 16;
+    set->roots = lexbor_malloc(sizeof(lxb_selectors_set_node_t *)
+                               * set->roots_size);
+    if (set->roots == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    memset(&set->universal, 0, sizeof(lxb_selectors_set_node_t));
+
+    set->length = 0;
+    set->shared = 0;
+    set->gen = 0;
+    set->doc = NULL;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_set_clean(lxb_selectors_set_t *set)
+{
+    lxb_selectors_program_clean(set->program);
+
+    lexbor_hash_clean(set->ids);
+    lexbor_hash_clean(set->classes);
+    lexbor_hash_clean(set->tags);
+    lexbor_dobject_clean(set->nodes);
+
+    memset(&set->universal, 0, sizeof(lxb_selectors_set_node_t));
+
+    set->length = 0;
+    set->shared = 0;
+    set->gen = 0;
+    set->doc = NULL;
+}
+
+lxb_selectors_set_t *
+lxb_selectors_set_destroy(lxb_selectors_set_t *set, bool self_destroy)
+{
+    if (set == NULL) {
+        return NULL;
+    }
+
+    set->program = lxb_selectors_program_destroy(set->program, true);
+    set->ids = lexbor_hash_destroy(set->ids, true);
+    set->classes = lexbor_hash_destroy(set->classes, true);
+    set->tags = lexbor_hash_destroy(set->tags, true);
+    set->nodes = lexbor_dobject_destroy(set->nodes, true);
+
+    if (set->roots != NULL) {
+        set->roots = lexbor_free(set->roots);
+    }
+
+    if (set->bits != NULL) {
+        set->bits = lexbor_free(set->bits);
+    }
+
+    if (set->bound != NULL) {
+        set->bound = lexbor_free(set->bound);
+    }
+
+    if (set->unbound != NULL) {
+        set->unbound = lexbor_free(set->unbound);
+    }
+
+    if (self_destroy) {
+        return lexbor_free(set);
+    }
+
+    return set;
+}
+
+/* The root of the bucket for the last compound of the selector. */
+static lxb_selectors_set_node_t *
+lxb_selectors_set_root(lxb_selectors_set_t *set,
+                       const lxb_css_selector_t *selector)
+{
+    lexbor_hash_t *hash;
+    lxb_selectors_set_bucket_t *bucket;
+    const lxb_css_selector_t *key, *cls, *tag;
+
+    key = NULL;
+    cls = NULL;
+    tag = NULL;
+
+    do {
+        switch (selector->type) {
+            case LXB_CSS_SELECTOR_TYPE_ID:
+                key = selector;
+                break;
+
+            case LXB_CSS_SELECTOR_TYPE_CLASS:
+                cls = selector;
+                break;
+
+            case LXB_CSS_SELECTOR_TYPE_ELEMENT:
+                tag = selector;
+                break;
+
+            default:
+                break;
+        }
+
+        if (key != NULL
+            || selector->combinator != LXB_CSS_SELECTOR_COMBINATOR_CLOSE
+            || selector->prev == NULL)
+        {
+            break;
+        }
+
+        selector = selector->prev;
+    }
+    while (true);
+
+    if (key != NULL) {
+        hash = set->ids;
+    }
+    else if (cls != NULL) {
+        hash = set->classes;
+        key = cls;
+    }
+    else if (tag != NULL) {
+        hash = set->tags;
+        key = tag;
+    }
+    else {
+        return &set->universal;
+    }
+
+    bucket = lexbor_hash_insert(hash, lexbor_hash_insert_lower,
+                                key->name.data, key->name.length);
+    if (bucket == NULL) {
+        return NULL;
+    }
+
+    if (bucket->root == NULL) {
+        bucket->root = lexbor_dobject_calloc(set->nodes);
+    }
+
+    return bucket->root;
+}
+
+/* Whether two instructions check the same. */
+static bool
+lxb_selectors_set_inst_eq(const lxb_selectors_inst_t *first,
+                          const lxb_selectors_inst_t *second)
+{
+    if (first->op != second->op) {
+        return false;
+    }
+
+    switch (first->op) {
+        case LXB_SELECTORS_OP_TAG:
+        case LXB_SELECTORS_OP_CLASS:
+            return first->name_length == second->name_length
+                   && memcmp(first->name, second->name,
+                             first->name_length) == 0;
+
+        case LXB_SELECTORS_OP_ID:
+            return first->value_length == second->value_length
+                   && memcmp(first->value, second->value,
+                             first->value_length) == 0;
+
+        case LXB_SELECTORS_OP_ATTR:
+            if (first->name_length != second->name_length
+                || memcmp(first->name, second->name, first->name_length) != 0
+                || first->match != second->match
+                || first->modifier != second->modifier)
+            {
+                return false;
+            }
+
+            if (first->value == NULL || second->value == NULL) {
+                return first->value == second->value;
+            }
+
+            return first->value_length == second->value_length
+                   && memcmp(first->value, second->value,
+                             first->value_length) == 0;
+
+        case LXB_SELECTORS_OP_PSEUDO_CLASS:
+            return first->selector->u.pseudo.type
+                   == second->selector->u.pseudo.type;
+
+        case LXB_SELECTORS_OP_NTH_CHILD:
+        case LXB_SELECTORS_OP_NTH_LAST_CHILD:
+        case LXB_SELECTORS_OP_NTH_OF_TYPE:
+        case LXB_SELECTORS_OP_NTH_LAST_OF_TYPE:
+            return first->a == second->a && first->b == second->b;
+
+        case LXB_SELECTORS_OP_FALLBACK:
+            return first->list == second->list;
+
+        case LXB_SELECTORS_OP_END:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+/* Puts the instructions of one selector, up to END, under the root. */
+static lxb_status_t
+lxb_selectors_set_insert(lxb_selectors_set_t *set,
+                         lxb_selectors_set_node_t *root, size_t begin,
+                         size_t id)
+{
+    size_t i;
+    bool end;
+    const lxb_selectors_inst_t *insts;
+    lxb_selectors_set_node_t *node, *child, *last;
+
+    insts = set->program->insts;
+    node = root;
+
+    for (i = begin + 1; ; i++) {
+        end = insts[i].op == LXB_SELECTORS_OP_END;
+        last = NULL;
+
+        for (child = node->child; child != NULL; child = child->next) {
+            if ((end && insts[child->inst].op == LXB_SELECTORS_OP_END
+                 && child->id == id)
+                || lxb_selectors_set_inst_eq(&insts[child->inst], &insts[i]))
+            {
+                break;
+            }
+
+            last = child;
+        }
+
+        if (child != NULL) {
+            if (end) {
+                /* The same selector twice in one list. */
+                return LXB_STATUS_OK;
+            }
+
+            set->shared++;
+            node = child;
+
+            continue;
+        }
+
+        child = lexbor_dobject_calloc(set->nodes);
+        if (child == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        child->inst = i;
+        child->id = id;
+        child->parent = node;
+
+        if (last != NULL) {
+            last->next = child;
+        }
+        else {
+            node->child = child;
+        }
+
+        node = child;
+
+        if (end) {
+            break;
+        }
+    }
+
+    for (; node != NULL; node = node->parent) {
+        node->leaves++;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_set_append(lxb_selectors_set_t *set,
+                         const lxb_css_selector_list_t *list)
+{
+    size_t begin, size;
+    uint64_t *bits;
+    lxb_status_t status;
+    const lxb_selectors_inst_t *inst;
+    lxb_selectors_set_node_t *root;
+
+    begin = set->program->length;
+
+    status = lxb_selectors_program_append_list(set->program, list);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    for (; begin < set->program->length; begin += inst->a) {
+        inst = &set->program->insts[begin];
+
+        root = lxb_selectors_set_root(set, inst->list->last);
+        if (root == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        status = lxb_selectors_set_insert(set, root, begin, set->length);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    set->length++;
+    set->doc = NULL;
+
+    size = lxb_selectors_set_words(set);
+
+    if (size > set->bits_size) {
+        size *= 2;
+
+        bits = lexbor_realloc(set->bits, sizeof(uint64_t) * size);
+        if (bits == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        set->bits = bits;
+        set->bits_size = size;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+/* Keeps the instructions that got no value from the document. */
+static lxb_status_t
+lxb_selectors_set_unbound_make(lxb_selectors_set_t *set)
+{
+    size_t i, length;
+    const lxb_selectors_inst_t *inst;
+    lxb_selectors_set_unbound_t *unbound;
+
+    if (set->program->length > set->unbound_size) {
+        length = set->program->length;
+
+        unbound = lexbor_realloc(set->unbound,
+                                 sizeof(lxb_selectors_set_unbound_t) * length);
+        if (unbound == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        set->unbound = unbound;
+        set->unbound_size = length;
+    }
+
+    length = 0;
+
+    for (i = 0; i < set->program->length; i++) {
+        inst = &set->program->insts[i];
+
+        switch (inst->op) {
+            case LXB_SELECTORS_OP_TAG:
+            case LXB_SELECTORS_OP_CLASS:
+            case LXB_SELECTORS_OP_ATTR:
+                if (set->bound[i] == 0) {
+                    set->unbound[length].inst = inst;
+                    set->unbound[length].index = i;
+                    length++;
+                }
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* The same names side by side, so each is looked up once. */
+    qsort(set->unbound, length, sizeof(lxb_selectors_set_unbound_t),
+          lxb_selectors_set_unbound_cmp);
+
+    set->unbound_length = length;
+
+    return LXB_STATUS_OK;
+}
+
+static int
+lxb_selectors_set_unbound_cmp(const void *first, const void *second)
+{
+    const lxb_selectors_inst_t *a, *b;
+
+    a = ((const lxb_selectors_set_unbound_t *) first)->inst;
+    b = ((const lxb_selectors_set_unbound_t *) second)->inst;
+
+    if (a->op != b->op) {
+        return (a->op < b->op) ? -1 : 1;
+    }
+
+    if (a->name_length != b->name_length) {
+        return (a->name_length < b->name_length) ? -1 : 1;
+    }
+
+    return memcmp(a->name, b->name, a->name_length);
+}
+
+lxb_status_t
+lxb_selectors_set_bind(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                       lxb_dom_document_t *doc)
+{
+    bool quirks;
+    size_t size;
+    uintptr_t *bound;
+    lxb_status_t status;
+
+    doc = lxb_dom_interface_node(doc)->owner_document;
+    quirks = doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    status = lxb_selectors_program_bind(selectors, set->program, doc, quirks);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    if (set->program->length > set->bound_size) {
+        size = set->program->length;
+
+        bound = lexbor_realloc(set->bound, sizeof(uintptr_t) * size);
+        if (bound == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        set->bound = bound;
+        set->bound_size = size;
+    }
+
+    memcpy(set->bound, selectors->bound,
+           sizeof(uintptr_t) * set->program->length);
+
+    status = lxb_selectors_set_unbound_make(set);
+    if (status != LXB_STATUS_OK) {
+        set->doc = NULL;
+        return status;
+    }
+
+    set->doc = doc;
+    set->doc_tags_hash = doc->tags;
+    set->doc_attrs_hash = doc->attrs;
+    set->doc_classes_hash = doc->classes;
+    set->quirks = quirks;
+    set->doc_tags = lexbor_hash_count(doc->tags);
+    set->doc_attrs = lexbor_hash_count(doc->attrs);
+    set->doc_classes = lexbor_hash_count(doc->classes);
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_set_unbind(lxb_selectors_set_t *set)
+{
+    set->doc = NULL;
+}
+
+/*
+ * The names were looked up in this document, as it is now or with fewer
+ * names: in the same name tables, which keep a name found until they are
+ * cleaned, see lxb_selectors_set_unbind().
+ */
+lxb_inline bool
+lxb_selectors_set_bound(const lxb_selectors_set_t *set,
+                        const lxb_dom_document_t *doc)
+{
+    return set->doc == doc
+           && set->doc_tags_hash == doc->tags
+           && set->doc_attrs_hash == doc->attrs
+           && set->doc_classes_hash == doc->classes
+           && set->quirks == (doc->compat_mode == LXB_DOM_DOCUMENT_CMODE_QUIRKS)
+           && set->doc_tags <= lexbor_hash_count(doc->tags)
+           && set->doc_attrs <= lexbor_hash_count(doc->attrs)
+           && set->doc_classes <= lexbor_hash_count(doc->classes);
+}
+
+/*
+ * Looks up again the names the document did not have, for the kinds of
+ * names it got new ones of.  A name found keeps its value until the
+ * document is cleaned, so nothing else can change.
+ */
+static void
+lxb_selectors_set_rebind(lxb_selectors_set_t *set, lxb_dom_document_t *doc)
+{
+    bool tags, attrs, classes, check;
+    size_t i, j, length;
+    uintptr_t value;
+    const lxb_selectors_inst_t *inst;
+
+    tags = set->doc_tags != lexbor_hash_count(doc->tags);
+    attrs = set->doc_attrs != lexbor_hash_count(doc->attrs);
+    classes = set->doc_classes != lexbor_hash_count(doc->classes);
+
+    if (!tags && !attrs && !classes) {
+        return;
+    }
+
+    i = 0;
+    length = 0;
+
+    while (i < set->unbound_length) {
+        inst = set->unbound[i].inst;
+
+        switch (inst->op) {
+            case LXB_SELECTORS_OP_TAG:
+                check = tags;
+                break;
+
+            case LXB_SELECTORS_OP_CLASS:
+                check = classes;
+                break;
+
+            default:
+                check = attrs;
+                break;
+        }
+
+        value = (check) ? lxb_selectors_program_bind_inst(inst, doc,
+                                                          set->quirks) : 0;
+        j = i;
+
+        do {
+            if (value != 0) {
+                set->bound[set->unbound[j].index] = value;
+            }
+            else {
+                set->unbound[length++] = set->unbound[j];
+            }
+
+            j++;
+        }
+        while (j < set->unbound_length
+               && lxb_selectors_set_unbound_cmp(&set->unbound[i],
+                                                &set->unbound[j]) == 0);
+
+        i = j;
+    }
+
+    set->unbound_length = length;
+
+    set->doc_tags = lexbor_hash_count(doc->tags);
+    set->doc_attrs = lexbor_hash_count(doc->attrs);
+    set->doc_classes = lexbor_hash_count(doc->classes);
+}
+
+/* Makes the names of the set up to date for the document. */
+static lxb_status_t
+lxb_selectors_set_prepare(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                          lxb_dom_document_t *doc)
+{
+    doc = lxb_dom_interface_node(doc)->owner_document;
+
+    if (!lxb_selectors_set_bound(set, doc)) {
+        return lxb_selectors_set_bind(set, selectors, doc);
+    }
+
+    lxb_selectors_set_rebind(set, doc);
+
+    return LXB_STATUS_OK;
+}
+
+/* All END nodes at and below the node are matched for the element. */
+lxb_inline bool
+lxb_selectors_set_done(const lxb_selectors_set_t *set,
+                       const lxb_selectors_set_node_t *node)
+{
+    return node->gen == set->gen && node->hits == node->leaves;
+}
+
+static void
+lxb_selectors_set_hit(lxb_selectors_set_t *set, lxb_selectors_set_node_t *node)
+{
+    set->bits[node->id / 64] |= (uint64_t) 1 << (node->id % 64);
+
+    for (; node != NULL; node = node->parent) {
+        if (node->gen != set->gen) {
+            node->gen = set->gen;
+            node->hits = 0;
+        }
+
+        node->hits++;
+    }
+}
+
+/* Matches the node to the ways to go on from the parent. */
+static lxb_status_t
+lxb_selectors_set_run(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                      lxb_selectors_set_node_t *parent, lxb_dom_node_t *node)
+{
+    bool found;
+    lxb_status_t status;
+    lxb_dom_node_t *next;
+    lxb_selectors_set_node_t *child;
+    const lxb_selectors_inst_t *inst;
+
+    for (child = parent->child; child != NULL; child = child->next) {
+        if (lxb_selectors_set_done(set, child)) {
+            continue;
+        }
+
+        inst = &set->program->insts[child->inst];
+        next = node;
+
+        switch (inst->op) {
+            case LXB_SELECTORS_OP_END:
+                lxb_selectors_set_hit(set, child);
+                continue;
+
+            case LXB_SELECTORS_OP_FALLBACK:
+                found = false;
+
+                status = lxb_selectors_match_node_single(selectors, node,
+                                                         inst->list,
+                                                         lxb_selectors_set_found_cb,
+                                                         &found);
+                if (status != LXB_STATUS_OK) {
+                    return status;
+                }
+
+                if (!found) {
+                    continue;
+                }
+
+                break;
+
+            case LXB_SELECTORS_OP_DESCENDANT:
+                for (next = node->parent; next != NULL; next = next->parent) {
+                    if (next->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+                        continue;
+                    }
+
+                    status = lxb_selectors_set_run(set, selectors, child, next);
+                    if (status != LXB_STATUS_OK) {
+                        return status;
+                    }
+
+                    if (lxb_selectors_set_done(set, child)) {
+                        break;
+                    }
+                }
+
+                continue;
+
+            case LXB_SELECTORS_OP_CHILD:
+                next = node->parent;
+
+                if (next == NULL || next->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+                    continue;
+                }
+
+                break;
+
+            case LXB_SELECTORS_OP_SIBLING:
+                do {
+                    next = next->prev;
+                }
+                while (next != NULL && next->type != LXB_DOM_NODE_TYPE_ELEMENT);
+
+                if (next == NULL) {
+                    continue;
+                }
+
+                break;
+
+            case LXB_SELECTORS_OP_FOLLOWING:
+                for (next = node->prev; next != NULL; next = next->prev) {
+                    if (next->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+                        continue;
+                    }
+
+                    status = lxb_selectors_set_run(set, selectors, child, next);
+                    if (status != LXB_STATUS_OK) {
+                        return status;
+                    }
+
+                    if (lxb_selectors_set_done(set, child)) {
+                        break;
+                    }
+                }
+
+                continue;
+
+            default:
+                if (!lxb_selectors_program_test(selectors, inst,
+                                                set->bound[child->inst],
+                                                node, set->quirks))
+                {
+                    continue;
+                }
+
+                break;
+        }
+
+        status = lxb_selectors_set_run(set, selectors, child, next);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+lxb_selectors_set_root_add(lxb_selectors_set_t *set, size_t *length,
+                           lxb_selectors_set_node_t *root)
+{
+    size_t i;
+    lxb_selectors_set_node_t **roots;
+
+    if (root == NULL || root->child == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    /* Classes that differ only in case share the bucket. */
+    for (i = 0; i < *length; i++) {
+        if (set->roots[i] == root) {
+            return LXB_STATUS_OK;
+        }
+    }
+
+    if (*length == set->roots_size) {
+        roots = lexbor_realloc(set->roots, sizeof(lxb_selectors_set_node_t *)
+                                          * set->roots_size * 2);
+        if (roots == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        set->roots = roots;
+        set->roots_size *= 2;
+    }
+
+    set->roots[(*length)++] = root;
+
+    return LXB_STATUS_OK;
+}
+
+/* The bitmap of the element, with the names already bound. */
+static lxb_status_t
+lxb_selectors_set_node(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                       lxb_dom_node_t *node, bool *any)
+{
+    size_t i, length;
+    lxb_status_t status;
+    const lxb_char_t *name;
+    lxb_dom_element_t *element;
+    const lxb_dom_element_class_t *cls;
+    const lxb_selectors_set_bucket_t *bucket;
+
+    element = lxb_dom_interface_element(node);
+    length = 0;
+
+    if (element->attr_id != NULL && element->attr_id->value != NULL) {
+        bucket = lexbor_hash_search(set->ids, lexbor_hash_search_lower,
+                                    element->attr_id->value->data,
+                                    element->attr_id->value->length);
+
+        status = lxb_selectors_set_root_add(set, &length,
+                                            (bucket != NULL) ? bucket->root
+                                                             : NULL);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    for (i = 0; i < element->classes_length; i++) {
+        cls = element->classes[i]->lower;
+
+        bucket = lexbor_hash_search(set->classes, lexbor_hash_search_raw,
+                                    lexbor_hash_entry_str(&cls->entry),
+                                    cls->entry.length);
+
+        status = lxb_selectors_set_root_add(set, &length,
+                                            (bucket != NULL) ? bucket->root
+                                                             : NULL);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    name = lxb_dom_element_local_name(element, &i);
+
+    if (name != NULL) {
+        bucket = lexbor_hash_search(set->tags, lexbor_hash_search_lower,
+                                    name, i);
+
+        status = lxb_selectors_set_root_add(set, &length,
+                                            (bucket != NULL) ? bucket->root
+                                                             : NULL);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    status = lxb_selectors_set_root_add(set, &length, &set->universal);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    memset(set->bits, 0, sizeof(uint64_t) * lxb_selectors_set_words(set));
+
+    set->gen++;
+
+    for (i = 0; i < length; i++) {
+        status = lxb_selectors_set_run(set, selectors, set->roots[i], node);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+    }
+
+    *any = false;
+
+    for (i = 0; i < lxb_selectors_set_words(set); i++) {
+        if (set->bits[i] != 0) {
+            *any = true;
+            break;
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_set_match_node(lxb_selectors_set_t *set,
+                             lxb_selectors_t *selectors, lxb_dom_node_t *node,
+                             const uint64_t **bits)
+{
+    bool any;
+    lxb_status_t status;
+
+    if (set->length == 0) {
+        *bits = NULL;
+        return LXB_STATUS_OK;
+    }
+
+    if (node->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+        memset(set->bits, 0, sizeof(uint64_t) * lxb_selectors_set_words(set));
+
+        *bits = set->bits;
+        return LXB_STATUS_OK;
+    }
+
+    status = lxb_selectors_set_prepare(set, selectors, node->owner_document);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    status = lxb_selectors_set_node(set, selectors, node, &any);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    *bits = set->bits;
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_selectors_set_find(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                       lxb_dom_node_t *root, lxb_selectors_set_cb_f cb,
+                       void *ctx)
+{
+    bool any;
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+
+    if (selectors->options & LXB_SELECTORS_OPT_MATCH_ROOT) {
+        node = root;
+
+        if (node->type == LXB_DOM_NODE_TYPE_DOCUMENT) {
+            node = root->first_child;
+        }
+    }
+    else {
+        node = root->first_child;
+    }
+
+    if (node == NULL || set->length == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    status = lxb_selectors_set_prepare(set, selectors, root->owner_document);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    lxb_selectors_cache_begin(selectors);
+
+    do {
+        if (node->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            status = lxb_selectors_set_node(set, selectors, node, &any);
+
+            if (status == LXB_STATUS_OK && any) {
+                status = cb(node, set->bits, ctx);
+            }
+
+            if (status != LXB_STATUS_OK) {
+                if (status == LXB_STATUS_STOP) {
+                    status = LXB_STATUS_OK;
+                }
+
+                break;
+            }
+
+            if (node->first_child != NULL) {
+                node = node->first_child;
+                continue;
+            }
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+    while (true);
+
+    lxb_selectors_cache_end(selectors);
+
+    return status;
+}
+
+static lxb_status_t
+lxb_selectors_set_found_cb(lxb_dom_node_t *node,
+                           lxb_css_selector_specificity_t spec, void *ctx)
+{
+    *((bool *) ctx) = true;
+
+    return LXB_STATUS_OK;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+size_t
+lxb_selectors_set_length_noi(const lxb_selectors_set_t *set)
+{
+    return lxb_selectors_set_length(set);
+}
+
+size_t
+lxb_selectors_set_words_noi(const lxb_selectors_set_t *set)
+{
+    return lxb_selectors_set_words(set);
+}
+
+bool
+lxb_selectors_set_bit_noi(const uint64_t *bits, size_t id)
+{
+    return lxb_selectors_set_bit(bits, id);
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SELECTORS_SET_H
+#define LEXBOR_SELECTORS_SET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/selectors/program.h"
+#include "lexbor/core/hash.h"
+#include "lexbor/core/dobject.h"
+
+
+typedef struct lxb_selectors_set_node lxb_selectors_set_node_t;
+
+/*
+ * One instruction of the compiled selectors, shared by all selectors that
+ * have the same instructions up to it, taken from right to left.
+ * The children are the different ways to go on; an END node ends
+ * the selectors of one list.
+ */
+struct lxb_selectors_set_node {
+    size_t                   inst;    /* In the program of the set. */
+    size_t                   id;      /* For END, the id of the list. */
+
+    size_t                   leaves;  /* END nodes at and below the node. */
+    size_t                   hits;    /* Those matched for the element. */
+    size_t                   gen;
+
+    lxb_selectors_set_node_t *parent;
+    lxb_selectors_set_node_t *child;
+    lxb_selectors_set_node_t *next;
+};
+
+/* An instruction whose name the document did not have when bound. */
+typedef struct {
+    const lxb_selectors_inst_t *inst;
+    size_t                     index;   /* In the program of the set. */
+}
+lxb_selectors_set_unbound_t;
+
+/* Selectors with the same key in the last compound. */
+typedef struct {
+    lexbor_hash_entry_t      entry;
+    lxb_selectors_set_node_t *root;
+}
+lxb_selectors_set_bucket_t;
+
+/*
+ * Matches an element against many selector lists at once.
+ *
+ * Each appended list gets an id, the number of lists appended before it.
+ * The selectors of all lists are compiled into one lxb_selectors_program_t
+ * and put into buckets by the last compound, as lxb_style_rules_t does: by
+ * id if it has one, else by class, else by tag, else into the universal
+ * bucket.  Within a bucket, selectors that start (from the right) with the
+ * same instructions share them, so "div.a > p span" and "li > p span" check
+ * "span", the child combinator and "p" once for both.
+ *
+ * The result for an element is a bitmap: bit N of it is set if the list
+ * with id N matches.
+ *
+ * The selector lists must outlive the set.
+ */
+typedef struct {
+    lxb_selectors_program_t    *program;
+
+    lexbor_hash_t              *ids;
+    lexbor_hash_t              *classes;
+    lexbor_hash_t              *tags;
+    lxb_selectors_set_node_t   universal;
+
+    lexbor_dobject_t           *nodes;
+
+    size_t                     length;  /* Lists in the set. */
+    size_t                     shared;  /* Instructions shared on append. */
+    size_t                     gen;
+
+    uint64_t                   *bits;
+    size_t                     bits_size;
+
+    lxb_selectors_set_node_t   **roots;
+    size_t                     roots_size;
+
+    /*
+     * Names of the program looked up in the document, with the name
+     * tables of the document they came from.
+     */
+    uintptr_t                  *bound;
+    size_t                     bound_size;
+    const lxb_dom_document_t   *doc;
+    const lexbor_hash_t        *doc_tags_hash;
+    const lexbor_hash_t        *doc_attrs_hash;
+    const lexbor_hash_t        *doc_classes_hash;
+    size_t                     doc_tags;
+    size_t                     doc_attrs;
+    size_t                     doc_classes;
+    bool                       quirks;
+
+    /*
+     * Names only these can change while the document gets new ones,
+     * ordered by op and name.
+     */
+    lxb_selectors_set_unbound_t *unbound;
+    size_t                      unbound_length;
+    size_t                      unbound_size;
+}
+lxb_selectors_set_t;
+
+/*
+ * Called for each element that matches at least one list of the set.
+ *
+ * The bitmap holds lxb_selectors_set_words() words and is valid only
+ * during the call.
+ */
+typedef lxb_status_t
+(*lxb_selectors_set_cb_f)(lxb_dom_node_t *node, const uint64_t *bits,
+                          void *ctx);
+
+
+LXB_API lxb_selectors_set_t *
+lxb_selectors_set_create(void);
+
+LXB_API lxb_status_t
+lxb_selectors_set_init(lxb_selectors_set_t *set);
+
+LXB_API void
+lxb_selectors_set_clean(lxb_selectors_set_t *set);
+
+LXB_API lxb_selectors_set_t *
+lxb_selectors_set_destroy(lxb_selectors_set_t *set, bool self_destroy);
+
+/*
+ * Adds the selector list to the set.  Its id is lxb_selectors_set_length()
+ * before the call.
+ *
+ * If it fails, the set must be cleaned before it is used again.
+ *
+ * @param[in] lxb_selectors_set_t *.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_set_append(lxb_selectors_set_t *set,
+                         const lxb_css_selector_list_t *list);
+
+/*
+ * Looks up the tag, attribute and class names of the set in the document.
+ *
+ * Must be called before lxb_selectors_set_match_node() for the nodes of
+ * a document; lxb_selectors_set_find() does it by itself.
+ *
+ * @param[in] lxb_selectors_set_t *.
+ * @param[in] lxb_selectors_t *.
+ * @param[in] lxb_dom_document_t *.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_set_bind(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                       lxb_dom_document_t *doc);
+
+/*
+ * Forgets the names looked up in the document, so that the next call
+ * looks them up again.
+ *
+ * Must be called after the document is cleaned or destroyed if the set is
+ * then used with it, or with a document that can have its address.
+ *
+ * @param[in] lxb_selectors_set_t *.
+ */
+LXB_API void
+lxb_selectors_set_unbind(lxb_selectors_set_t *set);
+
+/*
+ * Matches the element against all lists of the set.
+ *
+ * On success, bits is set to the bitmap of the matching lists.  It stays
+ * valid until the next call for the set.
+ *
+ * The names are looked up again if the document is another one, has other
+ * name tables, fewer names or another mode, so the tree can change between
+ * calls.  A cleaned document is not told apart from the one it was, see
+ * lxb_selectors_set_unbind().  If the document only got new names since
+ * lxb_selectors_set_bind(), just the names it did not have are looked up
+ * again, once for each distinct name.  Matching does not change the
+ * document: sets can take turns on it, and threads can match it at once,
+ * each with its own set and lxb_selectors_t.
+ *
+ * @param[in] lxb_selectors_set_t *.
+ * @param[in] lxb_selectors_t *.
+ * @param[in] lxb_dom_node_t *.  The element.
+ * @param[out] const uint64_t **.  The bitmap of the matching lists.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_set_match_node(lxb_selectors_set_t *set,
+                             lxb_selectors_t *selectors, lxb_dom_node_t *node,
+                             const uint64_t **bits);
+
+/*
+ * Matches every element below root against the set, in tree order.
+ *
+ * LXB_SELECTORS_OPT_MATCH_ROOT applies, other options are not used.
+ * The callback can return LXB_STATUS_STOP to end the search.
+ *
+ * @param[in] lxb_selectors_set_t *.
+ * @param[in] lxb_selectors_t *.
+ * @param[in] lxb_dom_node_t *.  The node from which the search will begin.
+ * @param[in] lxb_selectors_set_cb_f.  Callback for a matching element.
+ * @param[in] void *.  Context for the callback.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_set_find(lxb_selectors_set_t *set, lxb_selectors_t *selectors,
+                       lxb_dom_node_t *root, lxb_selectors_set_cb_f cb,
+                       void *ctx);
+
+
+/*
+ * Inline functions.
+ */
+lxb_inline size_t
+lxb_selectors_set_length(const lxb_selectors_set_t *set)
+{
+    return set->length;
+}
+
+/* Words in the bitmap of the set. */
+lxb_inline size_t
+lxb_selectors_set_words(const lxb_selectors_set_t *set)
+{
+    return (set->length + 63) / 64;
+}
+
+lxb_inline bool
+lxb_selectors_set_bit(const uint64_t *bits, size_t id)
+{
+    return (bits[id / 64] >> (id % 64)) & 1;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API size_t
+lxb_selectors_set_length_noi(const lxb_selectors_set_t *set);
+
+LXB_API size_t
+lxb_selectors_set_words_noi(const lxb_selectors_set_t *set);
+
+LXB_API bool
+lxb_selectors_set_bit_noi(const uint64_t *bits, size_t id);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SELECTORS_SET_H */
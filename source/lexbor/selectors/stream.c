@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/selectors/stream.h"
+
+
+static bool
+lxb_selectors_stream_selector_supported(const lxb_css_selector_t *selector);
+
+
+lxb_selectors_stream_t *
+lxb_selectors_stream_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_selectors_stream_t));
+}
+
+lxb_status_t
+lxb_selectors_stream_init(lxb_selectors_stream_t *stream,
+                          lxb_selectors_set_cb_f cb, void *ctx)
+{
+    lxb_status_t status;
+
+    if (stream == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    if (cb == NULL) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    stream->set = lxb_selectors_set_create();
+    status = lxb_selectors_set_init(stream->set);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    stream->selectors = lxb_selectors_create();
+    status = lxb_selectors_init(stream->selectors);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    stream->cb = cb;
+    stream->ctx = ctx;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_selectors_stream_clean(lxb_selectors_stream_t *stream)
+{
+    lxb_selectors_set_clean(stream->set);
+    lxb_selectors_clean(stream->selectors);
+}
+
+lxb_selectors_stream_t *
+lxb_selectors_stream_destroy(lxb_selectors_stream_t *stream,
+                             bool self_destroy)
+{
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    stream->set = lxb_selectors_set_destroy(stream->set, true);
+    stream->selectors = lxb_selectors_destroy(stream->selectors, true);
+
+    if (self_destroy) {
+        return lexbor_free(stream);
+    }
+
+    return stream;
+}
+
+lxb_status_t
+lxb_selectors_stream_append(lxb_selectors_stream_t *stream,
+                            const lxb_css_selector_list_t *list)
+{
+    if (!lxb_selectors_stream_supported(list)) {
+        return LXB_STATUS_ERROR_UNEXPECTED_DATA;
+    }
+
+    return lxb_selectors_set_append(stream->set, list);
+}
+
+bool
+lxb_selectors_stream_supported(const lxb_css_selector_list_t *list)
+{
+    const lxb_css_selector_t *selector;
+
+    for (; list != NULL; list = list->next) {
+        for (selector = list->first; selector != NULL;
+             selector = selector->next)
+        {
+            if (!lxb_selectors_stream_selector_supported(selector)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool
+lxb_selectors_stream_selector_supported(const lxb_css_selector_t *selector)
+{
+    const lxb_css_selector_anb_of_t *anb;
+    const lxb_css_selector_pseudo_t *pseudo;
+
+    if (selector->combinator == LXB_CSS_SELECTOR_COMBINATOR_CELL) {
+        return false;
+    }
+
+    pseudo = &selector->u.pseudo;
+
+    if (selector->type == LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS) {
+        switch (pseudo->type) {
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_BLANK:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_EMPTY:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_FOCUS_WITHIN:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_LAST_CHILD:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_LAST_OF_TYPE:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_ONLY_CHILD:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_ONLY_OF_TYPE:
+            case LXB_CSS_SELECTOR_PSEUDO_CLASS_TARGET_WITHIN:
+                return false;
+
+            default:
+                return true;
+        }
+    }
+
+    if (selector->type != LXB_CSS_SELECTOR_TYPE_PSEUDO_CLASS_FUNCTION) {
+        return true;
+    }
+
+    switch (pseudo->type) {
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_HAS:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_LEXBOR_CONTAINS:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_COL:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_CHILD:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_COL:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_LAST_OF_TYPE:
+            return false;
+
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_CURRENT:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_IS:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NOT:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_WHERE:
+            return lxb_selectors_stream_supported(pseudo->data);
+
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_CHILD:
+        case LXB_CSS_SELECTOR_PSEUDO_CLASS_FUNCTION_NTH_OF_TYPE:
+            anb = pseudo->data;
+
+            return anb == NULL || lxb_selectors_stream_supported(anb->of);
+
+        default:
+            return true;
+    }
+}
+
+lxb_status_t
+lxb_selectors_stream_element(lxb_dom_element_t *element, void *ctx)
+{
+    size_t i, words;
+    lxb_status_t status;
+    const uint64_t *bits;
+    lxb_selectors_stream_t *stream = ctx;
+
+    status = lxb_selectors_set_match_node(stream->set, stream->selectors,
+                                          lxb_dom_interface_node(element),
+                                          &bits);
+    if (status != LXB_STATUS_OK || bits == NULL) {
+        return status;
+    }
+
+    words = lxb_selectors_set_words(stream->set);
+
+    for (i = 0; i < words; i++) {
+        if (bits[i] != 0) {
+            return stream->cb(lxb_dom_interface_node(element), bits,
+                              stream->ctx);
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_SELECTORS_STREAM_H
+#define LEXBOR_SELECTORS_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/selectors/set.h"
+
+
+/*
+ * Matches elements against a selector set while the tree is being built.
+ *
+ * Each element is matched once, when the builder puts it into the tree:
+ * its ancestors, preceding siblings and attributes are known then, its
+ * children and following siblings are not.  So only selectors that do not
+ * look at what comes after the element can be appended, see
+ * lxb_selectors_stream_supported().
+ *
+ * For the HTML parser:
+ *
+ *     lxb_html_tree_callback_element_set(lxb_html_parser_tree(parser),
+ *                                        lxb_selectors_stream_element,
+ *                                        stream);
+ *
+ * The callback of the stream can return LXB_STATUS_STOP to end
+ * the parsing.
+ */
+typedef struct {
+    lxb_selectors_set_t    *set;
+    lxb_selectors_t        *selectors;
+
+    lxb_selectors_set_cb_f cb;
+    void                   *ctx;
+}
+lxb_selectors_stream_t;
+
+
+LXB_API lxb_selectors_stream_t *
+lxb_selectors_stream_create(void);
+
+/*
+ * @param[in] lxb_selectors_stream_t *.
+ * @param[in] lxb_selectors_set_cb_f.  Called for each element that matches
+ * at least one list, with the bitmap of the matching lists.
+ * @param[in] void *.  Context for the callback.
+ *
+ * @return LXB_STATUS_OK if successful, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_stream_init(lxb_selectors_stream_t *stream,
+                          lxb_selectors_set_cb_f cb, void *ctx);
+
+LXB_API void
+lxb_selectors_stream_clean(lxb_selectors_stream_t *stream);
+
+LXB_API lxb_selectors_stream_t *
+lxb_selectors_stream_destroy(lxb_selectors_stream_t *stream,
+                             bool self_destroy);
+
+/*
+ * Adds the selector list to the set of the stream, see
+ * lxb_selectors_set_append().
+ *
+ * @param[in] lxb_selectors_stream_t *.
+ * @param[in] const lxb_css_selector_list_t *.  Selectors List.
+ *
+ * @return LXB_STATUS_OK if successful, LXB_STATUS_ERROR_UNEXPECTED_DATA if
+ * the list is not supported, otherwise an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_stream_append(lxb_selectors_stream_t *stream,
+                            const lxb_css_selector_list_t *list);
+
+/*
+ * Whether the selector list can be matched before the element has children
+ * and following siblings.
+ *
+ * Not supported, also inside :is(), :where(), :not() and "of S": :has(),
+ * :empty, :blank, :last-child, :only-child, :last-of-type, :only-of-type,
+ * :nth-last-child(), :nth-last-of-type(), :nth-col(), :nth-last-col(),
+ * :focus-within, :target-within, :lexbor-contains() and the column
+ * combinator.
+ */
+LXB_API bool
+lxb_selectors_stream_supported(const lxb_css_selector_list_t *list);
+
+/*
+ * Matches the element, just put into the tree, against the set.
+ *
+ * Has the type lxb_html_tree_element_f; ctx is the stream.  Before the
+ * stream is used for a document cleaned or made after the previous one was
+ * destroyed, call lxb_selectors_set_unbind() for stream->set.
+ *
+ * @return the status of the callback, or an error status value.
+ */
+LXB_API lxb_status_t
+lxb_selectors_stream_element(lxb_dom_element_t *element, void *ctx);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_SELECTORS_STREAM_H */
@@ -6,6 +6,7 @@
 
 #include "lexbor/style/dom/interfaces/document.h"
 #include "lexbor/style/dom/interfaces/element.h"
+#include "lexbor/style/rules.h"
 
 
 static const lexbor_hash_search_t  lxb_style_dom_document_css_customs_se = {
@@ -271,38 +272,38 @@ lxb_status_t
 lxb_dom_document_stylesheet_apply(lxb_dom_document_t *document,
                                   lxb_css_stylesheet_t *sst)
 {
-    lxb_status_t status = LXB_STATUS_OK;
-    lxb_css_rule_t *rule;
-    lxb_css_rule_list_t *list;
-
-    rule = sst->root;
+    lxb_status_t status;
+    lxb_style_rules_t rules;
 
-    if (rule->type != LXB_CSS_RULE_LIST) {
+    if (sst->root->type != LXB_CSS_RULE_LIST) {
         return LXB_STATUS_ERROR_WRONG_ARGS;
     }
 
-    list = lxb_css_rule_list(rule);
-    rule = list->first;
+    /*
+     * One pass over the document: every element is checked only against
+     * the rules whose last compound has its id, one of its classes or its
+     * tag, or no key at all.
+     *
+     * As with attaching the rules one by one, a rule that fails does not
+     * stop the others.
+     */
 
-    while (rule != NULL) {
-        switch (rule->type) {
-            case LXB_CSS_RULE_STYLE:
-                status = lxb_dom_document_style_attach(document,
-                                                       lxb_css_rule_style(rule));
-                break;
+    memset(&rules, 0, sizeof(lxb_style_rules_t));
 
-            default:
-                break;
-        }
+    status = lxb_style_rules_init(&rules);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
 
-        if (status != LXB_STATUS_OK) {
-            /* FIXME: what to do with an error? */
-        }
+    /* FIXME: what to do with an error? */
+    (void) lxb_style_rules_append_stylesheet(&rules, sst);
+    (void) lxb_style_rules_apply(&rules, document);
 
-        rule = rule->next;
-    }
+done:
 
-    return LXB_STATUS_OK;
+    (void) lxb_style_rules_destroy(&rules, false);
+
+    return status;
 }
 
 lxb_status_t
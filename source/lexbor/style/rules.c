@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include "lexbor/style/rules.h"
+#include "lexbor/style/dom/interfaces/document.h"
+#include "lexbor/style/dom/interfaces/element.h"
+
+
+static lxb_status_t
+lxb_style_rules_cb(lxb_dom_node_t *node,
+                   lxb_css_selector_specificity_t spec, void *ctx);
+
+
+lxb_style_rules_t *
+lxb_style_rules_create(void)
+{
+    return lexbor_calloc(1, sizeof(lxb_style_rules_t));
+}
+
+lxb_status_t
+lxb_style_rules_init(lxb_style_rules_t *rules)
+{
+    lxb_status_t status;
+
+    if (rules == NULL) {
+        return LXB_STATUS_ERROR_OBJECT_IS_NULL;
+    }
+
+    rules->ids = lexbor_hash_create();
+    status = lexbor_hash_init(rules->ids, 128,
+                              sizeof(lxb_style_rules_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    rules->classes = lexbor_hash_create();
+    status = lexbor_hash_init(rules->classes, 128,
+                              sizeof(lxb_style_rules_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    rules->tags = lexbor_hash_create();
+    status = lexbor_hash_init(rules->tags, 64,
+                              sizeof(lxb_style_rules_bucket_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    rules->items = lexbor_dobject_create();
+    status = lexbor_dobject_init(rules->items, 256,
+                                 sizeof(lxb_style_rules_item_t));
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    rules->cursors_size = 16;
+    rules->cursors = lexbor_malloc(sizeof(lxb_style_rules_item_t *)
+                                   * rules->cursors_size);
+    if (rules->cursors == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    rules->universal.first = NULL;
+    rules->universal.last = NULL;
+    rules->length = 0;
+
+    return LXB_STATUS_OK;
+}
+
+void
+lxb_style_rules_clean(lxb_style_rules_t *rules)
+{
+    lexbor_hash_clean(rules->ids);
+    lexbor_hash_clean(rules->classes);
+    lexbor_hash_clean(rules->tags);
+    lexbor_dobject_clean(rules->items);
+
+    rules->universal.first = NULL;
+    rules->universal.last = NULL;
+    rules->length = 0;
+}
+
+lxb_style_rules_t *
+lxb_style_rules_destroy(lxb_style_rules_t *rules, bool self_destroy)
+{
+    if (rules == NULL) {
+        return NULL;
+    }
+
+    rules->ids = lexbor_hash_destroy(rules->ids, true);
+    rules->classes = lexbor_hash_destroy(rules->classes, true);
+    rules->tags = lexbor_hash_destroy(rules->tags, true);
+    rules->items = lexbor_dobject_destroy(rules->items, true);
+
+    if (rules->cursors != NULL) {
+        rules->cursors = lexbor_free(rules->cursors);
+    }
+
+    if (self_destroy) {
+        return lexbor_free(rules);
+    }
+
+    return rules;
+}
+
+/* The bucket for the last compound of the selector. */
+static lxb_style_rules_bucket_t *
+lxb_style_rules_bucket(lxb_style_rules_t *rules,
+                       const lxb_css_selector_t *selector)
+{
+    lexbor_hash_t *hash;
+    const lxb_css_selector_t *cls, *tag;
+
+    cls = NULL;
+    tag = NULL;
+
+    do {
+        switch (selector->type) {
+            case LXB_CSS_SELECTOR_TYPE_ID:
+                return lexbor_hash_insert(rules->ids, lexbor_hash_insert_lower,
+                                          selector->name.data,
+                                          selector->name.length);
+
+            case LXB_CSS_SELECTOR_TYPE_CLASS:
+                cls = selector;
+                break;
+
+            case LXB_CSS_SELECTOR_TYPE_ELEMENT:
+                tag = selector;
+                break;
+
+            default:
+                break;
+        }
+
+        if (selector->combinator != LXB_CSS_SELECTOR_COMBINATOR_CLOSE
+            || selector->prev == NULL)
+        {
+            break;
+        }
+
+        selector = selector->prev;
+    }
+    while (true);
+
+    if (cls != NULL) {
+        hash = rules->classes;
+    }
+    else if (tag != NULL) {
+        hash = rules->tags;
+        cls = tag;
+    }
+    else {
+        return &rules->universal;
+    }
+
+    return lexbor_hash_insert(hash, lexbor_hash_insert_lower,
+                              cls->name.data, cls->name.length);
+}
+
+lxb_status_t
+lxb_style_rules_append(lxb_style_rules_t *rules, lxb_css_rule_style_t *style)
+{
+    lxb_style_rules_item_t *item;
+    lxb_style_rules_bucket_t *bucket;
+    const lxb_css_selector_list_t *list;
+
+    for (list = style->selector; list != NULL; list = list->next) {
+        if (list->last == NULL) {
+            continue;
+        }
+
+        bucket = lxb_style_rules_bucket(rules, list->last);
+        if (bucket == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        item = lexbor_dobject_alloc(rules->items);
+        if (item == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        item->style = style;
+        item->list = list;
+        item->order = rules->length++;
+        item->next = NULL;
+
+        if (bucket->last != NULL) {
+            bucket->last->next = item;
+        }
+        else {
+            bucket->first = item;
+        }
+
+        bucket->last = item;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_style_rules_append_stylesheet(lxb_style_rules_t *rules,
+                                  lxb_css_stylesheet_t *sst)
+{
+    lxb_status_t status, first;
+    lxb_css_rule_t *rule;
+
+    rule = sst->root;
+    first = LXB_STATUS_OK;
+
+    if (rule->type != LXB_CSS_RULE_LIST) {
+        return LXB_STATUS_ERROR_WRONG_ARGS;
+    }
+
+    for (rule = lxb_css_rule_list(rule)->first; rule != NULL;
+         rule = rule->next)
+    {
+        if (rule->type != LXB_CSS_RULE_STYLE) {
+            continue;
+        }
+
+        status = lxb_style_rules_append(rules, lxb_css_rule_style(rule));
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+    }
+
+    return first;
+}
+
+static lxb_status_t
+lxb_style_rules_cursor(lxb_style_rules_t *rules, size_t *length,
+                       const lxb_style_rules_bucket_t *bucket)
+{
+    size_t i;
+    lxb_style_rules_item_t **cursors;
+
+    if (bucket == NULL || bucket->first == NULL) {
+        return LXB_STATUS_OK;
+    }
+
+    /* Classes that differ only in case share the bucket. */
+    for (i = 0; i < *length; i++) {
+        if (rules->cursors[i] == bucket->first) {
+            return LXB_STATUS_OK;
+        }
+    }
+
+    if (*length == rules->cursors_size) {
+        cursors = lexbor_realloc(rules->cursors,
+                                 sizeof(lxb_style_rules_item_t *)
+                                 * rules->cursors_size * 2);
+        if (cursors == NULL) {
+            return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        }
+
+        rules->cursors = cursors;
+        rules->cursors_size *= 2;
+    }
+
+    rules->cursors[(*length)++] = bucket->first;
+
+    return LXB_STATUS_OK;
+}
+
+lxb_status_t
+lxb_style_rules_element_apply(lxb_style_rules_t *rules,
+                              lxb_dom_element_t *element)
+{
+    size_t i, length, min;
+    lxb_status_t status, first;
+    const lxb_char_t *name;
+    lxb_dom_node_t *node;
+    lxb_style_rules_item_t *item;
+    const lxb_dom_element_class_t *cls;
+    const lxb_style_rules_bucket_t *bucket;
+
+    node = lxb_dom_interface_node(element);
+    length = 0;
+    first = LXB_STATUS_OK;
+
+    if (element->attr_id != NULL && element->attr_id->value != NULL) {
+        bucket = lexbor_hash_search(rules->ids, lexbor_hash_search_lower,
+                                    element->attr_id->value->data,
+                                    element->attr_id->value->length);
+
+        status = lxb_style_rules_cursor(rules, &length, bucket);
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+    }
+
+    for (i = 0; i < element->classes_length; i++) {
+        cls = element->classes[i]->lower;
+
+        bucket = lexbor_hash_search(rules->classes, lexbor_hash_search_raw,
+                                    lexbor_hash_entry_str(&cls->entry),
+                                    cls->entry.length);
+
+        status = lxb_style_rules_cursor(rules, &length, bucket);
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+    }
+
+    name = lxb_dom_element_local_name(element, &i);
+
+    if (name != NULL) {
+        bucket = lexbor_hash_search(rules->tags, lexbor_hash_search_lower,
+                                    name, i);
+
+        status = lxb_style_rules_cursor(rules, &length, bucket);
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+    }
+
+    status = lxb_style_rules_cursor(rules, &length, &rules->universal);
+    if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+        first = status;
+    }
+
+    /* Merge the buckets, so the rules are applied in their order. */
+
+    while (length != 0) {
+        min = 0;
+
+        for (i = 1; i < length; i++) {
+            if (rules->cursors[i]->order < rules->cursors[min]->order) {
+                min = i;
+            }
+        }
+
+        item = rules->cursors[min];
+
+        if (item->next != NULL) {
+            rules->cursors[min] = item->next;
+        }
+        else {
+            rules->cursors[min] = rules->cursors[--length];
+        }
+
+        if (item->style->declarations == NULL) {
+            continue;
+        }
+
+        status = lxb_selectors_match_node_single(node->owner_document->css->selectors,
+                                                 node, item->list,
+                                                 lxb_style_rules_cb,
+                                                 item->style);
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+    }
+
+    return first;
+}
+
+lxb_status_t
+lxb_style_rules_apply(lxb_style_rules_t *rules, lxb_dom_document_t *document)
+{
+    lxb_status_t status, first;
+    lxb_selectors_t *selectors;
+    lxb_dom_node_t *root, *node;
+
+    if (rules->length == 0) {
+        return LXB_STATUS_OK;
+    }
+
+    root = lxb_dom_interface_node(document);
+    node = root->first_child;
+    first = LXB_STATUS_OK;
+
+    /* Sibling positions are found once for the whole document. */
+    selectors = document->css->selectors;
+    lxb_selectors_cache_begin(selectors);
+
+    while (node != NULL) {
+        if (node->type != LXB_DOM_NODE_TYPE_ELEMENT) {
+            goto next;
+        }
+
+        status = lxb_style_rules_element_apply(rules,
+                                               lxb_dom_interface_element(node));
+        if (status != LXB_STATUS_OK && first == LXB_STATUS_OK) {
+            first = status;
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+    next:
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    lxb_selectors_cache_end(selectors);
+
+    return first;
+}
+
+static lxb_status_t
+lxb_style_rules_cb(lxb_dom_node_t *node,
+                   lxb_css_selector_specificity_t spec, void *ctx)
+{
+    lxb_css_rule_style_t *style = ctx;
+
+    return lxb_dom_element_style_list_append(lxb_dom_interface_element(node),
+                                             style->declarations, spec);
+}
+
+/*
+ * No inline functions for ABI.
+ */
+size_t
+lxb_style_rules_length_noi(const lxb_style_rules_t *rules)
+{
+    return lxb_style_rules_length(rules);
+}
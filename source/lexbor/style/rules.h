@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#ifndef LEXBOR_STYLE_RULES_H
+#define LEXBOR_STYLE_RULES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lexbor/style/base.h"
+#include "lexbor/core/hash.h"
+#include "lexbor/core/dobject.h"
+
+
+typedef struct lxb_style_rules_item lxb_style_rules_item_t;
+
+struct lxb_style_rules_item {
+    lxb_css_rule_style_t          *style;
+    const lxb_css_selector_list_t *list;   /* One selector of the rule. */
+    size_t                        order;   /* Position in the rule set. */
+    lxb_style_rules_item_t        *next;
+};
+
+/* Selectors with the same key in the last compound, in rule set order. */
+typedef struct {
+    lexbor_hash_entry_t    entry;
+    lxb_style_rules_item_t *first;
+    lxb_style_rules_item_t *last;
+}
+lxb_style_rules_bucket_t;
+
+/*
+ * Style rules bucketed by the last compound of their selectors: by id if it
+ * has one, else by class, else by tag, else in the universal bucket.
+ *
+ * An element is checked only against the selectors of the buckets of its
+ * id, classes and tag and of the universal bucket.  Keys are lowercase, so
+ * a bucket holds the selectors for any case of the name; the selectors
+ * themselves decide whether the case matters.
+ */
+typedef struct {
+    lexbor_hash_t            *ids;
+    lexbor_hash_t            *classes;
+    lexbor_hash_t            *tags;
+    lxb_style_rules_bucket_t universal;
+
+    lexbor_dobject_t         *items;
+    size_t                   length;
+
+    lxb_style_rules_item_t   **cursors;
+    size_t                   cursors_size;
+}
+lxb_style_rules_t;
+
+
+LXB_API lxb_style_rules_t *
+lxb_style_rules_create(void);
+
+LXB_API lxb_status_t
+lxb_style_rules_init(lxb_style_rules_t *rules);
+
+LXB_API void
+lxb_style_rules_clean(lxb_style_rules_t *rules);
+
+LXB_API lxb_style_rules_t *
+lxb_style_rules_destroy(lxb_style_rules_t *rules, bool self_destroy);
+
+/*
+ * Adds every selector of the style rule.  The rule must outlive the set.
+ * Rules are applied in the order they were added.
+ */
+LXB_API lxb_status_t
+lxb_style_rules_append(lxb_style_rules_t *rules, lxb_css_rule_style_t *style);
+
+/*
+ * Adds the style rules of the stylesheet, other rules are skipped.
+ * A rule that fails to be added is skipped too; the first error is returned.
+ */
+LXB_API lxb_status_t
+lxb_style_rules_append_stylesheet(lxb_style_rules_t *rules,
+                                  lxb_css_stylesheet_t *sst);
+
+/*
+ * Attaches the declarations of the matching rules to the element, as
+ * lxb_dom_document_style_attach() does for each rule in turn.
+ * The document must have CSS initialized, see lxb_style_init().
+ *
+ * A failure in one rule does not stop the others: they are all applied and
+ * the first error is returned.
+ */
+LXB_API lxb_status_t
+lxb_style_rules_element_apply(lxb_style_rules_t *rules,
+                              lxb_dom_element_t *element);
+
+/* Same as lxb_style_rules_element_apply() for all document elements. */
+LXB_API lxb_status_t
+lxb_style_rules_apply(lxb_style_rules_t *rules, lxb_dom_document_t *document);
+
+/*
+ * Inline functions.
+ */
+lxb_inline size_t
+lxb_style_rules_length(const lxb_style_rules_t *rules)
+{
+    return rules->length;
+}
+
+/*
+ * No inline functions for ABI.
+ */
+LXB_API size_t
+lxb_style_rules_length_noi(const lxb_style_rules_t *rules);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LEXBOR_STYLE_RULES_H */
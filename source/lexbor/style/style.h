@@ -20,6 +20,7 @@ extern "C" {
 #include "lexbor/style/html/interfaces/document.h"
 #include "lexbor/style/html/interfaces/element.h"
 #include "lexbor/style/html/interfaces/style_element.h"
+#include "lexbor/style/rules.h"
 
 
 LXB_API uintptr_t
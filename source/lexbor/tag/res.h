@@ -566,3 +566,125 @@ static const lexbor_shs_entry_t lxb_tag_res_shs_data_default[263] =
     {NULL, NULL, 0, 0}
 };
 
+static const lexbor_shs_entry_t lxb_tag_res_phs_default_entries[199] =
+{
+    {"acronym", (void *) &lxb_tag_res_data_default[9], 7, 0}, {"mi", (void *) &lxb_tag_res_data_default[129], 2, 0},
+    {"summary", (void *) &lxb_tag_res_data_default[176], 7, 0}, {"time", (void *) &lxb_tag_res_data_default[188], 4, 0},
+    {"h5", (void *) &lxb_tag_res_data_default[96], 2, 0}, {"strike", (void *) &lxb_tag_res_data_default[172], 6, 0},
+    {"canvas", (void *) &lxb_tag_res_data_default[35], 6, 0}, {"fecomposite", (void *) &lxb_tag_res_data_default[60], 11, 0},
+    {"hgroup", (void *) &lxb_tag_res_data_default[100], 6, 0}, {"output", (void *) &lxb_tag_res_data_default[145], 6, 0},
+    {"fefuncg", (void *) &lxb_tag_res_data_default[69], 7, 0}, {"table", (void *) &lxb_tag_res_data_default[179], 5, 0},
+    {"hr", (void *) &lxb_tag_res_data_default[101], 2, 0}, {"em", (void *) &lxb_tag_res_data_default[55], 2, 0},
+    {"a", (void *) &lxb_tag_res_data_default[7], 1, 0}, {"?processinginstruction", (void *) &lxb_tag_res_data_default[6], 22, 0},
+    {"nextid", (void *) &lxb_tag_res_data_default[136], 6, 0}, {"listing", (void *) &lxb_tag_res_data_default[117], 7, 0},
+    {"textpath", (void *) &lxb_tag_res_data_default[184], 8, 0}, {"applet", (void *) &lxb_tag_res_data_default[18], 6, 0},
+    {"meta", (void *) &lxb_tag_res_data_default[125], 4, 0}, {"legend", (void *) &lxb_tag_res_data_default[113], 6, 0},
+    {"mfenced", (void *) &lxb_tag_res_data_default[127], 7, 0}, {"div", (void *) &lxb_tag_res_data_default[52], 3, 0},
+    {"q", (void *) &lxb_tag_res_data_default[153], 1, 0}, {"fespecularlighting", (void *) &lxb_tag_res_data_default[78], 18, 0},
+    {"mo", (void *) &lxb_tag_res_data_default[131], 2, 0}, {"del", (void *) &lxb_tag_res_data_default[46], 3, 0},
+    {"altglyphdef", (void *) &lxb_tag_res_data_default[12], 11, 0}, {"marquee", (void *) &lxb_tag_res_data_default[122], 7, 0},
+    {"altglyph", (void *) &lxb_tag_res_data_default[11], 8, 0}, {"!doctype", (void *) &lxb_tag_res_data_default[5], 8, 0},
+    {"p", (void *) &lxb_tag_res_data_default[146], 1, 0}, {"!--", (void *) &lxb_tag_res_data_default[4], 3, 0},
+    {"mglyph", (void *) &lxb_tag_res_data_default[128], 6, 0}, {"progress", (void *) &lxb_tag_res_data_default[152], 8, 0},
+    {"input", (void *) &lxb_tag_res_data_default[107], 5, 0}, {"slot", (void *) &lxb_tag_res_data_default[167], 4, 0},
+    {"ins", (void *) &lxb_tag_res_data_default[108], 3, 0}, {"details", (void *) &lxb_tag_res_data_default[48], 7, 0},
+    {"lineargradient", (void *) &lxb_tag_res_data_default[115], 14, 0}, {"audio", (void *) &lxb_tag_res_data_default[22], 5, 0},
+    {"femergenode", (void *) &lxb_tag_res_data_default[74], 11, 0}, {"fepointlight", (void *) &lxb_tag_res_data_default[77], 12, 0},
+    {"b", (void *) &lxb_tag_res_data_default[23], 1, 0}, {"annotation-xml", (void *) &lxb_tag_res_data_default[17], 14, 0},
+    {"code", (void *) &lxb_tag_res_data_default[40], 4, 0}, {"multicol", (void *) &lxb_tag_res_data_default[134], 8, 0},
+    {"font", (void *) &lxb_tag_res_data_default[85], 4, 0}, {"fedisplacementmap", (void *) &lxb_tag_res_data_default[63], 17, 0},
+    {"body", (void *) &lxb_tag_res_data_default[32], 4, 0}, {"var", (void *) &lxb_tag_res_data_default[195], 3, 0},
+    {"desc", (void *) &lxb_tag_res_data_default[47], 4, 0}, {"malignmark", (void *) &lxb_tag_res_data_default[119], 10, 0},
+    {"big", (void *) &lxb_tag_res_data_default[29], 3, 0}, {"map", (void *) &lxb_tag_res_data_default[120], 3, 0},
+    {"pre", (void *) &lxb_tag_res_data_default[151], 3, 0}, {"cite", (void *) &lxb_tag_res_data_default[38], 4, 0},
+    {"dl", (void *) &lxb_tag_res_data_default[53], 2, 0}, {"thead", (void *) &lxb_tag_res_data_default[187], 5, 0},
+    {"feflood", (void *) &lxb_tag_res_data_default[66], 7, 0}, {"femerge", (void *) &lxb_tag_res_data_default[73], 7, 0},
+    {"meter", (void *) &lxb_tag_res_data_default[126], 5, 0}, {"bdi", (void *) &lxb_tag_res_data_default[26], 3, 0},
+    {"embed", (void *) &lxb_tag_res_data_default[56], 5, 0}, {"area", (void *) &lxb_tag_res_data_default[19], 4, 0},
+    {"feblend", (void *) &lxb_tag_res_data_default[57], 7, 0}, {"picture", (void *) &lxb_tag_res_data_default[149], 7, 0},
+    {"fedistantlight", (void *) &lxb_tag_res_data_default[64], 14, 0}, {"address", (void *) &lxb_tag_res_data_default[10], 7, 0},
+    {"bdo", (void *) &lxb_tag_res_data_default[27], 3, 0}, {"fefuncr", (void *) &lxb_tag_res_data_default[70], 7, 0},
+    {"ul", (void *) &lxb_tag_res_data_default[194], 2, 0}, {"rtc", (void *) &lxb_tag_res_data_default[158], 3, 0},
+    {"fetile", (void *) &lxb_tag_res_data_default[80], 6, 0}, {"glyphref", (void *) &lxb_tag_res_data_default[91], 8, 0},
+    {"frameset", (void *) &lxb_tag_res_data_default[90], 8, 0}, {"fefuncb", (void *) &lxb_tag_res_data_default[68], 7, 0},
+    {"tfoot", (void *) &lxb_tag_res_data_default[185], 5, 0}, {"dialog", (void *) &lxb_tag_res_data_default[50], 6, 0},
+    {"blink", (void *) &lxb_tag_res_data_default[30], 5, 0}, {"article", (void *) &lxb_tag_res_data_default[20], 7, 0},
+    {"col", (void *) &lxb_tag_res_data_default[41], 3, 0}, {"h6", (void *) &lxb_tag_res_data_default[97], 2, 0},
+    {"textarea", (void *) &lxb_tag_res_data_default[183], 8, 0}, {"img", (void *) &lxb_tag_res_data_default[106], 3, 0},
+    {"figcaption", (void *) &lxb_tag_res_data_default[83], 10, 0}, {"feoffset", (void *) &lxb_tag_res_data_default[76], 8, 0},
+    {"aside", (void *) &lxb_tag_res_data_default[21], 5, 0}, {"fediffuselighting", (void *) &lxb_tag_res_data_default[62], 17, 0},
+    {"image", (void *) &lxb_tag_res_data_default[105], 5, 0}, {"title", (void *) &lxb_tag_res_data_default[189], 5, 0},
+    {"frame", (void *) &lxb_tag_res_data_default[89], 5, 0}, {"fedropshadow", (void *) &lxb_tag_res_data_default[65], 12, 0},
+    {"sup", (void *) &lxb_tag_res_data_default[177], 3, 0}, {"noembed", (void *) &lxb_tag_res_data_default[138], 7, 0},
+    {"rt", (void *) &lxb_tag_res_data_default[157], 2, 0}, {"nobr", (void *) &lxb_tag_res_data_default[137], 4, 0},
+    {"selectedcontent", (void *) &lxb_tag_res_data_default[166], 15, 0}, {"path", (void *) &lxb_tag_res_data_default[148], 4, 0},
+    {"html", (void *) &lxb_tag_res_data_default[102], 4, 0}, {"head", (void *) &lxb_tag_res_data_default[98], 4, 0},
+    {"menu", (void *) &lxb_tag_res_data_default[124], 4, 0}, {"ol", (void *) &lxb_tag_res_data_default[142], 2, 0},
+    {"s", (void *) &lxb_tag_res_data_default[160], 1, 0}, {"optgroup", (void *) &lxb_tag_res_data_default[143], 8, 0},
+    {"rb", (void *) &lxb_tag_res_data_default[155], 2, 0}, {"link", (void *) &lxb_tag_res_data_default[116], 4, 0},
+    {"feconvolvematrix", (void *) &lxb_tag_res_data_default[61], 16, 0}, {"fegaussianblur", (void *) &lxb_tag_res_data_default[71], 14, 0},
+    {"mn", (void *) &lxb_tag_res_data_default[130], 2, 0}, {"datalist", (void *) &lxb_tag_res_data_default[44], 8, 0},
+    {"small", (void *) &lxb_tag_res_data_default[168], 5, 0}, {"span", (void *) &lxb_tag_res_data_default[171], 4, 0},
+    {"fecomponenttransfer", (void *) &lxb_tag_res_data_default[59], 19, 0}, {"h1", (void *) &lxb_tag_res_data_default[92], 2, 0},
+    {"ms", (void *) &lxb_tag_res_data_default[132], 2, 0}, {"center", (void *) &lxb_tag_res_data_default[37], 6, 0},
+    {"object", (void *) &lxb_tag_res_data_default[141], 6, 0}, {"radialgradient", (void *) &lxb_tag_res_data_default[154], 14, 0},
+    {"u", (void *) &lxb_tag_res_data_default[193], 1, 0}, {"video", (void *) &lxb_tag_res_data_default[196], 5, 0},
+    {"button", (void *) &lxb_tag_res_data_default[34], 6, 0}, {"math", (void *) &lxb_tag_res_data_default[123], 4, 0},
+    {"tt", (void *) &lxb_tag_res_data_default[192], 2, 0}, {"h4", (void *) &lxb_tag_res_data_default[95], 2, 0},
+    {"isindex", (void *) &lxb_tag_res_data_default[109], 7, 0}, {"h2", (void *) &lxb_tag_res_data_default[93], 2, 0},
+    {"#undef", (void *) &lxb_tag_res_data_default[0], 6, 0}, {"search", (void *) &lxb_tag_res_data_default[163], 6, 0},
+    {"script", (void *) &lxb_tag_res_data_default[162], 6, 0}, {"template", (void *) &lxb_tag_res_data_default[182], 8, 0},
+    {"nav", (void *) &lxb_tag_res_data_default[135], 3, 0}, {"sub", (void *) &lxb_tag_res_data_default[175], 3, 0},
+    {"footer", (void *) &lxb_tag_res_data_default[86], 6, 0}, {"rp", (void *) &lxb_tag_res_data_default[156], 2, 0},
+    {"data", (void *) &lxb_tag_res_data_default[43], 4, 0}, {"altglyphitem", (void *) &lxb_tag_res_data_default[13], 12, 0},
+    {"dd", (void *) &lxb_tag_res_data_default[45], 2, 0}, {"mark", (void *) &lxb_tag_res_data_default[121], 4, 0},
+    {"femorphology", (void *) &lxb_tag_res_data_default[75], 12, 0}, {"colgroup", (void *) &lxb_tag_res_data_default[42], 8, 0},
+    {"noscript", (void *) &lxb_tag_res_data_default[140], 8, 0}, {"feturbulence", (void *) &lxb_tag_res_data_default[81], 12, 0},
+    {"xmp", (void *) &lxb_tag_res_data_default[198], 3, 0}, {"iframe", (void *) &lxb_tag_res_data_default[104], 6, 0},
+    {"source", (void *) &lxb_tag_res_data_default[169], 6, 0}, {"option", (void *) &lxb_tag_res_data_default[144], 6, 0},
+    {"header", (void *) &lxb_tag_res_data_default[99], 6, 0}, {"section", (void *) &lxb_tag_res_data_default[164], 7, 0},
+    {"form", (void *) &lxb_tag_res_data_default[88], 4, 0}, {"#text", (void *) &lxb_tag_res_data_default[2], 5, 0},
+    {"svg", (void *) &lxb_tag_res_data_default[178], 3, 0}, {"tbody", (void *) &lxb_tag_res_data_default[180], 5, 0},
+    {"plaintext", (void *) &lxb_tag_res_data_default[150], 9, 0}, {"animatetransform", (void *) &lxb_tag_res_data_default[16], 16, 0},
+    {"fefunca", (void *) &lxb_tag_res_data_default[67], 7, 0}, {"samp", (void *) &lxb_tag_res_data_default[161], 4, 0},
+    {"#end-of-file", (void *) &lxb_tag_res_data_default[1], 12, 0}, {"basefont", (void *) &lxb_tag_res_data_default[25], 8, 0},
+    {"abbr", (void *) &lxb_tag_res_data_default[8], 4, 0}, {"fespotlight", (void *) &lxb_tag_res_data_default[79], 11, 0},
+    {"li", (void *) &lxb_tag_res_data_default[114], 2, 0}, {"select", (void *) &lxb_tag_res_data_default[165], 6, 0},
+    {"spacer", (void *) &lxb_tag_res_data_default[170], 6, 0}, {"bgsound", (void *) &lxb_tag_res_data_default[28], 7, 0},
+    {"blockquote", (void *) &lxb_tag_res_data_default[31], 10, 0}, {"base", (void *) &lxb_tag_res_data_default[24], 4, 0},
+    {"foreignobject", (void *) &lxb_tag_res_data_default[87], 13, 0}, {"feimage", (void *) &lxb_tag_res_data_default[72], 7, 0},
+    {"i", (void *) &lxb_tag_res_data_default[103], 1, 0}, {"td", (void *) &lxb_tag_res_data_default[181], 2, 0},
+    {"fieldset", (void *) &lxb_tag_res_data_default[82], 8, 0}, {"caption", (void *) &lxb_tag_res_data_default[36], 7, 0},
+    {"clippath", (void *) &lxb_tag_res_data_default[39], 8, 0}, {"noframes", (void *) &lxb_tag_res_data_default[139], 8, 0},
+    {"#document", (void *) &lxb_tag_res_data_default[3], 9, 0}, {"style", (void *) &lxb_tag_res_data_default[174], 5, 0},
+    {"h3", (void *) &lxb_tag_res_data_default[94], 2, 0}, {"br", (void *) &lxb_tag_res_data_default[33], 2, 0},
+    {"dfn", (void *) &lxb_tag_res_data_default[49], 3, 0}, {"param", (void *) &lxb_tag_res_data_default[147], 5, 0},
+    {"animatemotion", (void *) &lxb_tag_res_data_default[15], 13, 0}, {"label", (void *) &lxb_tag_res_data_default[112], 5, 0},
+    {"figure", (void *) &lxb_tag_res_data_default[84], 6, 0}, {"th", (void *) &lxb_tag_res_data_default[186], 2, 0},
+    {"keygen", (void *) &lxb_tag_res_data_default[111], 6, 0}, {"tr", (void *) &lxb_tag_res_data_default[190], 2, 0},
+    {"kbd", (void *) &lxb_tag_res_data_default[110], 3, 0}, {"dir", (void *) &lxb_tag_res_data_default[51], 3, 0},
+    {"ruby", (void *) &lxb_tag_res_data_default[159], 4, 0}, {"fecolormatrix", (void *) &lxb_tag_res_data_default[58], 13, 0},
+    {"animatecolor", (void *) &lxb_tag_res_data_default[14], 12, 0}, {"mtext", (void *) &lxb_tag_res_data_default[133], 5, 0},
+    {"dt", (void *) &lxb_tag_res_data_default[54], 2, 0}, {"main", (void *) &lxb_tag_res_data_default[118], 4, 0},
+    {"wbr", (void *) &lxb_tag_res_data_default[197], 3, 0}, {"strong", (void *) &lxb_tag_res_data_default[173], 6, 0},
+    {"track", (void *) &lxb_tag_res_data_default[191], 5, 0}
+};
+
+static const uint16_t lxb_tag_res_phs_default_displace[64] =
+{
+    0x0007, 0x0000, 0x0020, 0x0019, 0x0005, 0x0005, 0x0006, 0x0003,
+    0x0001, 0x000f, 0x0022, 0x000b, 0x0000, 0x0026, 0x005e, 0x0076,
+    0x0001, 0x0015, 0x0020, 0x0005, 0x0004, 0x000b, 0x0072, 0x0018,
+    0x00a0, 0x003e, 0x0001, 0x0008, 0x0001, 0x0039, 0x0008, 0x0093,
+    0x003f, 0x0011, 0x0000, 0x0007, 0x001b, 0x0003, 0x0047, 0x0000,
+    0x0018, 0x0018, 0x0004, 0x004c, 0x0058, 0x0030, 0x00e5, 0x0005,
+    0x0008, 0x0000, 0x000f, 0x006a, 0x0040, 0x0002, 0x0012, 0x019f,
+    0x0002, 0x0014, 0x0012, 0x000a, 0x0009, 0x0002, 0x0093, 0x0062
+};
+
+static const lexbor_shs_perfect_t lxb_tag_res_phs_default =
+{
+    lxb_tag_res_phs_default_entries, lxb_tag_res_phs_default_displace,
+    199, 26, 22
+};
+
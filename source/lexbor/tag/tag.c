@@ -43,8 +43,8 @@ lxb_tag_append_lower(lexbor_hash_t *hash, const lxb_char_t *name, size_t length)
     lxb_tag_data_t *data;
     const lexbor_shs_entry_t *entry;
 
-    entry = lexbor_shs_entry_get_lower_static(lxb_tag_res_shs_data_default,
-                                              name, length);
+    entry = lexbor_shs_perfect_get_lower_static(&lxb_tag_res_phs_default,
+                                                name, length);
     if (entry != NULL) {
         return entry->value;
     }
@@ -82,8 +82,8 @@ lxb_tag_data_by_name(lexbor_hash_t *hash, const lxb_char_t *name, size_t len)
         return NULL;
     }
 
-    entry = lexbor_shs_entry_get_lower_static(lxb_tag_res_shs_data_default,
-                                              name, len);
+    entry = lexbor_shs_perfect_get_lower_static(&lxb_tag_res_phs_default,
+                                                name, len);
     if (entry != NULL) {
         return (const lxb_tag_data_t *) entry->value;
     }
@@ -11,7 +11,7 @@
 #include "lexbor/core/conv.h"
 #include "lexbor/core/utils.h"
 #include "lexbor/core/serialize.h"
-#include "lexbor/core/swar.h"
+#include "lexbor/core/simd.h"
 #include "lexbor/unicode/idna.h"
 
 #ifndef LEXBOR_DISABLE_INTERNAL_EXTERN
@@ -3070,22 +3070,13 @@ lxb_url_remove_tab_newline(lxb_url_parser_t *parser,
 
     /* Fast path. */
 
-    p = lexbor_swar_seek3(p, end, '\n', '\r', '\t');
+    p = lexbor_simd_seek3(p, end, '\n', '\r', '\t');
 
-    while (p < end) {
-        c = *p;
-
-        if (c == '\n' || c == '\r' || c == '\t') {
-            /* Slow path. */
-            goto oh_my;
-        }
-
-        p += 1;
+    if (p == end) {
+        return data;
     }
 
-    return data;
-
-oh_my:
+    /* Slow path. */
 
     status = lxb_url_log_append(parser, p,
                                 LXB_URL_ERROR_TYPE_INVALID_URL_UNIT);
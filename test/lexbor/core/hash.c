@@ -153,6 +153,125 @@ TEST_BEGIN(insert_search_case)
 }
 TEST_END
 
+TEST_BEGIN(rebuild_remove)
+{
+    size_t i, len;
+    char key[64];
+    lexbor_hash_t hash = {0};
+    hash_entry_t *entry, *entries[4096];
+
+    lxb_status_t status = lexbor_hash_init(&hash, 32, sizeof(hash_entry_t));
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; i < 4096; i++) {
+        len = sprintf(key, "custom-element-with-long-name-%zu", i);
+
+        entry = lexbor_hash_insert(&hash, lexbor_hash_insert_lower,
+                                   (lxb_char_t *) key, len);
+        test_ne(entry, NULL);
+
+        entry->value = i;
+        entries[i] = entry;
+    }
+
+    test_eq(lexbor_hash_count(&hash), 4096);
+    test_gt(hash.table_size, 4096);
+
+    /* Entries do not move when the table is rebuilt. */
+    for (i = 0; i < 4096; i++) {
+        len = sprintf(key, "CUSTOM-ELEMENT-WITH-LONG-NAME-%zu", i);
+
+        entry = lexbor_hash_search(&hash, lexbor_hash_search_lower,
+                                   (lxb_char_t *) key, len);
+        test_eq(entry, entries[i]);
+        test_eq(entry->value, i);
+    }
+
+    for (i = 0; i < 4096; i += 2) {
+        len = sprintf(key, "custom-element-with-long-name-%zu", i);
+
+        lexbor_hash_remove(&hash, lexbor_hash_search_raw,
+                           (lxb_char_t *) key, len);
+    }
+
+    test_eq(lexbor_hash_count(&hash), 2048);
+
+    for (i = 0; i < 4096; i++) {
+        len = sprintf(key, "custom-element-with-long-name-%zu", i);
+
+        entry = lexbor_hash_search(&hash, lexbor_hash_search_raw,
+                                   (lxb_char_t *) key, len);
+        if (i % 2 == 0) {
+            test_eq(entry, NULL);
+        }
+        else {
+            test_eq(entry, entries[i]);
+        }
+    }
+
+    lexbor_hash_clean(&hash);
+    test_eq(lexbor_hash_count(&hash), 0);
+
+    entry = lexbor_hash_search(&hash, lexbor_hash_search_raw,
+                               (lxb_char_t *) key, len);
+    test_eq(entry, NULL);
+
+    lexbor_hash_destroy(&hash, false);
+}
+TEST_END
+
+TEST_BEGIN(clean_rewind_shrink)
+{
+    char key[64];
+    size_t i, len, size, retained;
+    lexbor_hash_t hash = {0};
+    hash_entry_t *entry;
+
+    lxb_status_t status = lexbor_hash_init(&hash, 32, sizeof(hash_entry_t));
+    test_eq(status, LXB_STATUS_OK);
+
+    size = hash.table_size;
+
+    for (i = 0; i < 1024; i++) {
+        len = sprintf(key, "name-%zu", i);
+
+        entry = lexbor_hash_insert(&hash, lexbor_hash_insert_raw,
+                                   (lxb_char_t *) key, len);
+        test_ne(entry, NULL);
+    }
+
+    test_gt(hash.table_size, size);
+
+    lexbor_hash_clean(&hash);
+    test_eq(hash.table_size, size);
+
+    for (i = 0; i < 1024; i++) {
+        len = sprintf(key, "name-%zu", i);
+
+        entry = lexbor_hash_insert(&hash, lexbor_hash_insert_raw,
+                                   (lxb_char_t *) key, len);
+        test_ne(entry, NULL);
+    }
+
+    /* The grown table fits, it is kept and counted. */
+    retained = lexbor_hash_rewind(&hash, 1024 * 1024);
+    test_gt(hash.table_size, size);
+    test_eq(lexbor_hash_count(&hash), 0);
+    test_gt(retained, hash.table_size * sizeof(lexbor_hash_slot_t));
+
+    /* Nothing to retain: the table of the initial size is kept. */
+    retained = lexbor_hash_rewind(&hash, 0);
+    test_eq(hash.table_size, size);
+    test_gt(retained, size * sizeof(lexbor_hash_slot_t));
+
+    entry = lexbor_hash_search(&hash, lexbor_hash_search_raw,
+                               (lxb_char_t *) key, len);
+    test_eq(entry, NULL);
+
+    lexbor_hash_destroy(&hash, false);
+}
+TEST_END
+
 int
 main(int argc, const char * argv[])
 {
@@ -165,6 +284,8 @@ main(int argc, const char * argv[])
     TEST_ADD(destroy);
     TEST_ADD(destroy_stack);
     TEST_ADD(insert_search_case);
+    TEST_ADD(rebuild_remove);
+    TEST_ADD(clean_rewind_shrink);
 
     TEST_RUN("lexbor/core/hash");
     TEST_RELEASE();
@@ -167,6 +167,102 @@ TEST_BEGIN(clean)
 }
 TEST_END
 
+TEST_BEGIN(mem_rewind)
+{
+    size_t i, retained;
+    void *data;
+    lexbor_mem_t mem;
+    lexbor_mem_chunk_t *second;
+
+    lexbor_mem_init(&mem, 128);
+
+    for (i = 0; i < 32; i++) {
+        test_ne(lexbor_mem_alloc(&mem, 64), NULL);
+    }
+
+    test_eq_size(mem.chunk_length, 16UL);
+
+    second = mem.chunk_first->next;
+
+    /* Keep three chunks. */
+    retained = lexbor_mem_rewind(&mem, mem.chunk_min_size * 3 + 1);
+    test_eq_size(retained, mem.chunk_min_size * 3);
+
+    test_eq_size(mem.chunk_length, 1UL);
+    test_eq(mem.chunk, mem.chunk_first);
+    test_eq_size(mem.chunk->length, 0UL);
+    test_eq(mem.chunk->next, second);
+    test_eq(second->next->next, NULL);
+
+    /* Kept chunks are reused in order. */
+    for (i = 0; i < 3; i++) {
+        test_ne(lexbor_mem_alloc(&mem, 64), NULL);
+    }
+
+    test_eq(mem.chunk, second);
+    test_eq_size(mem.chunk_length, 2UL);
+
+    /* Does not fit into a kept chunk, goes before it. */
+    data = lexbor_mem_alloc(&mem, 1024);
+    test_ne(data, NULL);
+
+    test_eq(mem.chunk->prev, second);
+    test_ne(mem.chunk->next, NULL);
+    test_eq(mem.chunk->next->prev, mem.chunk);
+
+    /* Nothing but the first chunk. */
+    retained = lexbor_mem_rewind(&mem, 0);
+    test_eq_size(retained, mem.chunk_min_size);
+    test_eq(mem.chunk_first->next, NULL);
+
+    lexbor_mem_destroy(&mem, false);
+}
+TEST_END
+
+TEST_BEGIN(mem_stat)
+{
+    lexbor_mem_t one, two;
+    lexbor_mem_stat_t total = {0};
+
+    lexbor_mem_init(&one, 128);
+    lexbor_mem_init(&two, 256);
+
+    test_eq_size(one.stat.size, 128UL);
+    test_eq_size(two.stat.size, 256UL);
+
+    lexbor_mem_stat_parent_set(&one.stat, &total);
+    lexbor_mem_stat_parent_set(&two.stat, &total);
+
+    test_eq_size(total.size, 384UL);
+
+    for (size_t i = 0; i < 4; i++) {
+        test_ne(lexbor_mem_alloc(&one, 128), NULL);
+    }
+
+    test_eq_size(one.stat.size, 512UL);
+    test_eq_size(total.size, 768UL);
+
+    lexbor_mem_clean(&one);
+
+    test_eq_size(one.stat.size, 128UL);
+    test_eq_size(one.stat.peak, 512UL);
+    test_eq_size(total.size, 384UL);
+    test_eq_size(total.peak, 768UL);
+
+    lexbor_mem_stat_peak_reset(&total);
+    test_eq_size(total.peak, 384UL);
+
+    lexbor_mem_destroy(&two, false);
+    test_eq_size(total.size, 128UL);
+
+    lexbor_mem_stat_parent_set(&one.stat, NULL);
+    test_eq_size(total.size, 0UL);
+
+    lexbor_mem_destroy(&one, false);
+    test_eq_size(one.stat.size, 0UL);
+}
+TEST_END
+
 TEST_BEGIN(destroy)
 {
     lexbor_mem_t *mem = lexbor_mem_create();
@@ -318,6 +414,8 @@ main(int argc, const char * argv[])
     TEST_ADD(mem_calloc);
     TEST_ADD(mem_calloc_overflow);
     TEST_ADD(clean);
+    TEST_ADD(mem_rewind);
+    TEST_ADD(mem_stat);
     TEST_ADD(destroy);
     TEST_ADD(destroy_stack);
 
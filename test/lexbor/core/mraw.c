@@ -9,6 +9,30 @@
 #include <lexbor/core/mraw.h>
 
 
+/*
+ * Checks that a block of exactly the given size is in the cache.
+ * The cache is left as it was.
+ */
+static bool
+cached(lexbor_mraw_t *mraw, size_t size)
+{
+    void *data;
+    bool found;
+    size_t length = lexbor_mraw_cache_length(mraw);
+
+    data = lexbor_mraw_alloc(mraw, size);
+    if (data == NULL) {
+        return false;
+    }
+
+    found = lexbor_mraw_cache_length(mraw) == length - 1
+            && lexbor_mraw_data_size(data) == size;
+
+    lexbor_mraw_free(mraw, data);
+
+    return found;
+}
+
 TEST_BEGIN(init)
 {
     lexbor_mraw_t *mraw = lexbor_mraw_create();
@@ -67,7 +91,7 @@ TEST_BEGIN(mraw_alloc)
     test_eq_size(mraw.mem->chunk->size,
                  lexbor_mem_align(1024) + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
 
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
@@ -89,7 +113,7 @@ TEST_BEGIN(mraw_alloc_eq)
     test_eq_size(mraw.mem->chunk->length, 1024UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
 
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
@@ -115,7 +139,7 @@ TEST_BEGIN(mraw_alloc_overflow_if_len_0)
                  lexbor_mem_align(1025) + lexbor_mem_align(1024)
                  + (2 * lexbor_mraw_meta_size()));
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -146,13 +170,14 @@ TEST_BEGIN(mraw_alloc_overflow_if_len_not_0)
                  lexbor_mem_align(1025) + lexbor_mem_align(1024)
                  + (2 * lexbor_mraw_meta_size()));
 
-    test_eq_size(mraw.cache->tree_length, 1UL);
-    test_eq_size(mraw.cache->root->size,
-                 (lexbor_mem_align(1024) + lexbor_mraw_meta_size())  /* Init size. */
-                 - (lexbor_mem_align(13) + lexbor_mraw_meta_size()) /* First alloc size. */
-                 - lexbor_mraw_meta_size());                        /* Insert meta before
-                                                                     * append to cache.
-                                                                     */
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
+    test_eq(cached(&mraw,
+                   (lexbor_mem_align(1024) + lexbor_mraw_meta_size())  /* Init size. */
+                   - (lexbor_mem_align(13) + lexbor_mraw_meta_size()) /* First alloc size. */
+                   - lexbor_mraw_meta_size()),                        /* Insert meta before
+                                                                       * append to cache.
+                                                                       */
+            true);
     test_ne(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -176,7 +201,7 @@ TEST_BEGIN(mraw_alloc_if_len_not_0)
     test_eq_size(mraw.mem->chunk->length, 1024UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, mraw.mem->chunk->length);
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -202,7 +227,7 @@ TEST_BEGIN(mraw_realloc)
     test_eq_size(mraw.mem->chunk->length, 256UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -228,7 +253,7 @@ TEST_BEGIN(mraw_realloc_eq)
     test_eq_size(mraw.mem->chunk->length, 128UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -251,7 +276,7 @@ TEST_BEGIN(mraw_realloc_tail_0)
     test_eq_size(mraw.mem->chunk->length, 0UL);
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -281,10 +306,10 @@ TEST_BEGIN(mraw_realloc_tail_n)
     test_eq_size(mraw.mem->chunk->length, 1024UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 1UL);
-    test_eq_size(mraw.cache->root->size, (1024 + lexbor_mraw_meta_size())
-                 - (128UL + lexbor_mraw_meta_size())
-                 - lexbor_mraw_meta_size());
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
+    test_eq(cached(&mraw, (1024 + lexbor_mraw_meta_size())
+                   - (128UL + lexbor_mraw_meta_size())
+                   - lexbor_mraw_meta_size()), true);
 
     test_ne(mraw.mem->chunk, mraw.mem->chunk_first);
 
@@ -311,7 +336,7 @@ TEST_BEGIN(mraw_realloc_tail_less)
     test_eq_size(mraw.mem->chunk->length, 16UL + lexbor_mraw_meta_size());
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -337,7 +362,7 @@ TEST_BEGIN(mraw_realloc_tail_great)
     test_eq_size(mraw.mem->chunk->size,
                  lexbor_mem_align(2046) + 1024UL + (2 * lexbor_mraw_meta_size()));
 
-    test_eq_size(mraw.cache->tree_length, 0UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
     lexbor_mraw_destroy(&mraw, false);
@@ -370,11 +395,10 @@ TEST_BEGIN(mraw_realloc_n)
 
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 1UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
-    test_ne(mraw.cache->root, NULL);
-    test_eq_size(mraw.cache->root->size, 128UL);
+    test_eq(cached(&mraw, 128UL), true);
 
     lexbor_mraw_destroy(&mraw, false);
 }
@@ -402,11 +426,10 @@ TEST_BEGIN(mraw_realloc_n_0)
 
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
 
-    test_eq_size(mraw.cache->tree_length, 1UL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
     test_eq(mraw.mem->chunk, mraw.mem->chunk_first);
 
-    test_ne(mraw.cache->root, NULL);
-    test_eq_size(mraw.cache->root->size, 128UL);
+    test_eq(cached(&mraw, 128UL), true);
 
     lexbor_mraw_destroy(&mraw, false);
 }
@@ -431,12 +454,11 @@ TEST_BEGIN(mraw_realloc_n_less)
 
     test_eq(one, three);
 
-    test_eq_size(mraw.cache->tree_length, 1UL);
-    test_ne(mraw.cache->root, NULL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
 
-    test_eq_size(mraw.cache->root->size, (128UL + lexbor_mraw_meta_size())
-                 - (lexbor_mem_align(51) + lexbor_mraw_meta_size())
-                 - lexbor_mraw_meta_size());
+    test_eq(cached(&mraw, (128UL + lexbor_mraw_meta_size())
+                   - (lexbor_mem_align(51) + lexbor_mraw_meta_size())
+                   - lexbor_mraw_meta_size()), true);
 
     test_eq_size(mraw.mem->chunk_length, 1UL);
     test_eq_size(mraw.mem->chunk->size, 1024UL + lexbor_mraw_meta_size());
@@ -452,8 +474,6 @@ TEST_END
 TEST_BEGIN(mraw_realloc_n_great)
 {
     lexbor_mraw_t mraw = {0};
-    lexbor_bst_entry_t *cache_entry;
-
     lexbor_mraw_init(&mraw, 1024);
 
     uint8_t *one = lexbor_mraw_alloc(&mraw, 128);
@@ -470,19 +490,16 @@ TEST_BEGIN(mraw_realloc_n_great)
 
     test_ne(one, three);
 
-    test_eq_size(mraw.cache->tree_length, 2UL);
-    test_ne(mraw.cache->root, NULL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 2UL);
 
-    cache_entry = lexbor_bst_search(mraw.cache, mraw.cache->root, 128UL);
-    test_ne(cache_entry, NULL);
+    test_eq(cached(&mraw, 128UL), true);
 
     size_t size = (1024 + lexbor_mraw_meta_size())
     - (128UL + lexbor_mraw_meta_size())
     - (256UL + lexbor_mraw_meta_size())
     - lexbor_mraw_meta_size();
 
-    cache_entry = lexbor_bst_search(mraw.cache, mraw.cache->root, size);
-    test_ne(cache_entry, NULL);
+    test_eq(cached(&mraw, size), true);
 
     test_eq_size(mraw.mem->chunk_length, 2UL);
     test_eq_size(mraw.mem->chunk_first->size, 1024UL + lexbor_mraw_meta_size());
@@ -503,8 +520,6 @@ TEST_END
 TEST_BEGIN(mraw_free)
 {
     lexbor_mraw_t mraw = {0};
-    lexbor_bst_entry_t *cache_entry;
-
     lexbor_mraw_init(&mraw, 1024);
 
     uint8_t *data = lexbor_mraw_calloc(&mraw, 23);
@@ -512,13 +527,12 @@ TEST_BEGIN(mraw_free)
 
     lexbor_mraw_free(&mraw, data);
 
-    cache_entry = lexbor_bst_search(mraw.cache, mraw.cache->root,
-                                    lexbor_mem_align(23));
-    test_ne(cache_entry, NULL);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 1UL);
+    test_eq(cached(&mraw, lexbor_mem_align(23)), true);
 
-    cache_entry = lexbor_bst_search_close(mraw.cache, mraw.cache->root, 23);
-    test_ne(cache_entry, NULL);
-    test_eq_size(cache_entry->size, lexbor_mem_align(23));
+    /* The same block is given back. */
+    test_eq(lexbor_mraw_alloc(&mraw, 23), data);
+    test_eq_size(lexbor_mraw_cache_length(&mraw), 0UL);
 
     lexbor_mraw_destroy(&mraw, false);
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <unit/test.h>
+
+#include <lexbor/core/simd.h>
+
+
+static const unsigned int simd_opts[] = {
+    LEXBOR_SIMD_NONE, LEXBOR_SIMD_SSE2, LEXBOR_SIMD_SSE2 | LEXBOR_SIMD_SSE42,
+    LEXBOR_SIMD_SSE2 | LEXBOR_SIMD_AVX2, LEXBOR_SIMD_NEON, LEXBOR_SIMD_ALL
+};
+
+static const lxb_char_t simd_set[] = "\t\n\f \r&>\"'<=`";
+
+
+static const lxb_char_t *
+naive_seek(const lxb_char_t *data, const lxb_char_t *end,
+           const lxb_char_t *set, size_t length)
+{
+    size_t i;
+
+    for (; data < end; data++) {
+        for (i = 0; i < length; i++) {
+            if (*data == set[i]) {
+                return data;
+            }
+        }
+    }
+
+    return end;
+}
+
+static void
+fill(lxb_char_t *buf, size_t length, unsigned int seed)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (lxb_char_t) ('a' + ((seed >> 16) % 26));
+    }
+}
+
+
+TEST_BEGIN(loaded)
+{
+    /* Chosen before main(). */
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+    test_eq_u_int(lexbor_simd_active(), lexbor_simd_supported());
+#endif
+}
+TEST_END
+
+TEST_BEGIN(supported)
+{
+    unsigned int opt;
+
+    opt = lexbor_simd_use(LEXBOR_SIMD_ALL);
+    test_eq_u_int(opt, lexbor_simd_supported());
+    test_eq_u_int(lexbor_simd_active(), opt);
+
+    test_eq_u_int(lexbor_simd_use(LEXBOR_SIMD_NONE), LEXBOR_SIMD_NONE);
+    test_eq_u_int(lexbor_simd_active(), LEXBOR_SIMD_NONE);
+
+    lexbor_simd_init();
+    test_eq_u_int(lexbor_simd_active(), lexbor_simd_supported());
+}
+TEST_END
+
+TEST_BEGIN(empty)
+{
+    size_t i;
+    const lxb_char_t *data = (const lxb_char_t *) "";
+
+    for (i = 0; i < sizeof(simd_opts) / sizeof(simd_opts[0]); i++) {
+        lexbor_simd_use(simd_opts[i]);
+
+        test_eq(lexbor_simd_seek3(data, data, 'a', 'b', 'c'), data);
+        test_eq(lexbor_simd_seek4(data, data, 'a', 'b', 'c', 0x00), data);
+        test_eq(lexbor_simd_seek_set(data, data, simd_set, 1), data);
+    }
+
+    lexbor_simd_init();
+}
+TEST_END
+
+TEST_BEGIN(seek)
+{
+    size_t i, len, off, pos, set_len;
+    lxb_char_t buf[200];
+    const lxb_char_t *end, *need, *have;
+
+    for (i = 0; i < sizeof(simd_opts) / sizeof(simd_opts[0]); i++) {
+        lexbor_simd_use(simd_opts[i]);
+
+        for (len = 0; len <= 80; len++) {
+            for (off = 0; off < 8; off++) {
+                end = buf + off + len;
+
+                /* No match at all. */
+                fill(buf, sizeof(buf), (unsigned int) (len * 31 + off));
+
+                test_eq(lexbor_simd_seek3(buf + off, end, '<', 0x0D, 0x00), end);
+                test_eq(lexbor_simd_seek4(buf + off, end, '<', '&', 0x0D, 0x00),
+                        end);
+                test_eq(lexbor_simd_seek_set(buf + off, end, simd_set,
+                                             sizeof(simd_set) - 1), end);
+
+                /* The match past the end must not be found. */
+                buf[off + len] = 0x00;
+
+                test_eq(lexbor_simd_seek4(buf + off, end, '<', '&', 0x0D, 0x00),
+                        end);
+
+                for (pos = 0; pos < len; pos++) {
+                    fill(buf, sizeof(buf), (unsigned int) (pos * 7 + len));
+
+                    buf[off + pos] = 0x00;
+                    buf[off + len - 1] = '<';
+
+                    need = buf + off + pos;
+
+                    have = lexbor_simd_seek3(buf + off, end, '<', 0x0D, 0x00);
+                    test_eq(have, need);
+
+                    have = lexbor_simd_seek4(buf + off, end, '<', '&', 0x0D, 0x00);
+                    test_eq(have, need);
+
+                    buf[off + pos] = simd_set[pos % (sizeof(simd_set) - 1)];
+
+                    for (set_len = 1; set_len < sizeof(simd_set); set_len++) {
+                        need = naive_seek(buf + off, end, simd_set, set_len);
+                        have = lexbor_simd_seek_set(buf + off, end,
+                                                    simd_set, set_len);
+                        test_eq(have, need);
+                    }
+                }
+            }
+        }
+    }
+
+    lexbor_simd_init();
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(loaded);
+    TEST_ADD(supported);
+    TEST_ADD(empty);
+    TEST_ADD(seek);
+
+    TEST_RUN("lexbor/core/simd");
+    TEST_RELEASE();
+}
@@ -180,6 +180,55 @@ TEST_BEGIN(deep_nested)
 }
 TEST_END
 
+TEST_BEGIN(memory_usage)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_css_parser_t *parser;
+    lxb_css_stylesheet_t *sst;
+    lxb_css_memory_usage_t usage, before;
+
+    static const lexbor_str_t rule = lexbor_str(
+        "div.a > p:not(.b), a[href^=\"http\"] { color: red; width: 10px }");
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    sst = lxb_css_stylesheet_create(NULL);
+
+    lxb_css_stylesheet_memory_usage(sst, &before);
+    test_ne(before.total.size, 0);
+    test_eq_size(before.total.size, before.objs.size + before.mraw.size
+                                    + before.tree.size);
+
+    for (i = 0; i < 2048; i++) {
+        status = lxb_css_stylesheet_parse(sst, parser, rule.data,
+                                          rule.length);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    lxb_css_stylesheet_memory_usage(sst, &usage);
+    test_eq(usage.total.size > before.total.size, true);
+    test_eq_size(usage.total.size, usage.objs.size + usage.mraw.size
+                                   + usage.tree.size);
+    test_eq(usage.total.peak >= usage.total.size, true);
+
+    lxb_css_memory_clean(sst->memory);
+
+    lxb_css_memory_usage(sst->memory, &usage);
+    test_eq(usage.total.size < usage.total.peak, true);
+
+    lxb_css_memory_peak_reset(sst->memory);
+
+    lxb_css_memory_usage(sst->memory, &usage);
+    test_eq_size(usage.total.peak, usage.total.size);
+
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_css_memory_destroy(sst->memory, true);
+}
+TEST_END
+
 int
 main(int argc, const char * argv[])
 {
@@ -190,6 +239,7 @@ main(int argc, const char * argv[])
     TEST_ADD(eof_offset);
     TEST_ADD(colon_lookup);
     TEST_ADD(deep_nested);
+    TEST_ADD(memory_usage);
 
     TEST_RUN("lexbor/css/stylesheet");
     TEST_RELEASE();
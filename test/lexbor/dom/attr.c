@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <unit/test.h>
+
+#include <lexbor/dom/dom.h>
+
+
+TEST_BEGIN(by_local_name)
+{
+    size_t i, length;
+    lxb_char_t upper[64];
+    lxb_dom_attr_id_t id;
+    lexbor_hash_t *attrs;
+    const lxb_char_t *name;
+    const lxb_dom_attr_data_t *data, *found;
+
+    attrs = lexbor_hash_create();
+    test_eq(lexbor_hash_init(attrs, 32, sizeof(lxb_dom_attr_data_t)),
+            LXB_STATUS_OK);
+
+    for (id = LXB_DOM_ATTR__UNDEF; id < LXB_DOM_ATTR__LAST_ENTRY; id++) {
+        data = lxb_dom_attr_data_by_id(attrs, id);
+        test_ne(data, NULL);
+
+        name = lexbor_hash_entry_str(&data->entry);
+        length = data->entry.length;
+
+        found = lxb_dom_attr_data_by_local_name(attrs, name, length);
+        test_eq(found, data);
+
+        for (i = 0; i < length; i++) {
+            upper[i] = (name[i] >= 'a' && name[i] <= 'z') ? name[i] - 0x20
+                                                          : name[i];
+        }
+
+        found = lxb_dom_attr_data_by_local_name(attrs, upper, length);
+        test_eq(found, data);
+
+        /* A prefix of a known name is not a known name. */
+        if (length > 1) {
+            found = lxb_dom_attr_data_by_local_name(attrs, name, length - 1);
+            test_ne(found, data);
+        }
+    }
+
+    found = lxb_dom_attr_data_by_local_name(attrs,
+                                            (const lxb_char_t *) "data-x", 6);
+    test_eq(found, NULL);
+
+    found = lxb_dom_attr_data_by_local_name(attrs,
+                                            (const lxb_char_t *) "CLASS", 5);
+    test_eq(found, lxb_dom_attr_data_by_id(attrs, LXB_DOM_ATTR_CLASS));
+
+    lexbor_hash_destroy(attrs, true);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(by_local_name);
+
+    TEST_RUN("lexbor/dom/attr");
+    TEST_RELEASE();
+}
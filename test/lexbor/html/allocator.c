@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+
+#include <unit/test.h>
+
+
+typedef struct {
+    size_t allocs;
+    size_t frees;
+}
+counter_t;
+
+typedef struct {
+    uint8_t *data;
+    size_t  length;
+    size_t  size;
+    size_t  frees;
+}
+arena_t;
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html><head><title>Title</title></head>"
+    "<body><div id=main class=\"a b\">text<p>one<p>two</div>"
+    "<table><tr><td>cell</td></tr></table></body></html>";
+
+
+static void *
+counter_malloc(size_t size, void *ctx)
+{
+    ((counter_t *) ctx)->allocs++;
+
+    return malloc(size);
+}
+
+static void *
+counter_realloc(void *dst, size_t size, void *ctx)
+{
+    if (dst == NULL) {
+        ((counter_t *) ctx)->allocs++;
+    }
+
+    return realloc(dst, size);
+}
+
+static void *
+counter_calloc(size_t num, size_t size, void *ctx)
+{
+    ((counter_t *) ctx)->allocs++;
+
+    return calloc(num, size);
+}
+
+static void
+counter_free(void *dst, void *ctx)
+{
+    ((counter_t *) ctx)->frees++;
+
+    free(dst);
+}
+
+/*
+ * Bump arena: free does nothing, everything goes away with the arena.
+ */
+static void *
+arena_malloc(size_t size, void *ctx)
+{
+    uint8_t *data;
+    arena_t *arena = ctx;
+
+    size = lexbor_mem_align(size + sizeof(size_t));
+
+    if (arena->length + size > arena->size) {
+        return NULL;
+    }
+
+    data = &arena->data[arena->length];
+    arena->length += size;
+
+    memcpy(data, &size, sizeof(size_t));
+
+    return data + sizeof(size_t);
+}
+
+static void *
+arena_realloc(void *dst, size_t size, void *ctx)
+{
+    size_t old;
+    uint8_t *data;
+
+    data = arena_malloc(size, ctx);
+
+    if (data != NULL && dst != NULL) {
+        memcpy(&old, (uint8_t *) dst - sizeof(size_t), sizeof(size_t));
+        memcpy(data, dst, lexbor_min(old - sizeof(size_t), size));
+    }
+
+    return data;
+}
+
+static void *
+arena_calloc(size_t num, size_t size, void *ctx)
+{
+    uint8_t *data = arena_malloc(num * size, ctx);
+
+    if (data != NULL) {
+        memset(data, 0, num * size);
+    }
+
+    return data;
+}
+
+static void
+arena_free(void *dst, void *ctx)
+{
+    ((arena_t *) ctx)->frees++;
+}
+
+static bool
+serialize_eq(lxb_html_document_t *first, lxb_html_document_t *second)
+{
+    bool eq;
+    lexbor_mraw_t *mraw;
+    lexbor_str_t one = {0}, two = {0};
+
+    mraw = lexbor_mraw_create();
+    if (lexbor_mraw_init(mraw, 1024) != LXB_STATUS_OK) {
+        return false;
+    }
+
+    (void) lexbor_str_init(&one, mraw, 256);
+    (void) lexbor_str_init(&two, mraw, 256);
+
+    (void) lxb_html_serialize_tree_str(lxb_dom_interface_node(first), &one);
+    (void) lxb_html_serialize_tree_str(lxb_dom_interface_node(second), &two);
+
+    eq = one.length == two.length && one.length != 0
+         && memcmp(one.data, two.data, one.length) == 0;
+
+    lexbor_mraw_destroy(mraw, true);
+
+    return eq;
+}
+
+
+TEST_BEGIN(document)
+{
+    size_t allocs;
+    lxb_status_t status;
+    counter_t counter = {0};
+    lxb_html_document_t *document, *need;
+
+    lexbor_allocator_t allocator = {
+        counter_malloc, counter_realloc, counter_calloc, counter_free,
+        &counter
+    };
+
+    need = lxb_html_document_create();
+    status = lxb_html_document_parse(need, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_document_create_with_allocator(&allocator);
+    test_ne(document, NULL);
+
+    test_eq(lxb_dom_document_allocator(lxb_dom_interface_document(document)),
+            &allocator);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(serialize_eq(document, need), true);
+
+    /* Document pools, its hashes and the parser's tokenizer. */
+    test_ne(counter.allocs, 0);
+
+    allocs = counter.allocs;
+
+    status = lxb_dom_document_index_set(lxb_dom_interface_document(document),
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+    test_gt(counter.allocs, allocs);
+
+    lxb_html_document_destroy(document);
+    lxb_html_document_destroy(need);
+
+    test_eq_size(counter.allocs, counter.frees);
+}
+TEST_END
+
+TEST_BEGIN(parser)
+{
+    counter_t counter = {0};
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+
+    lexbor_allocator_t allocator = {
+        counter_malloc, counter_realloc, counter_calloc, counter_free,
+        &counter
+    };
+
+    parser = lxb_html_parser_create();
+    lxb_html_parser_allocator_set(parser, &allocator);
+
+    test_eq(lxb_html_parser_init(parser), LXB_STATUS_OK);
+    test_ne(counter.allocs, 0);
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+
+    test_eq(lxb_dom_document_allocator(lxb_dom_interface_document(document)),
+            &allocator);
+
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+
+    test_eq_size(counter.allocs, counter.frees);
+}
+TEST_END
+
+TEST_BEGIN(arena)
+{
+    lxb_status_t status;
+    arena_t arena = {0};
+    lxb_html_document_t *document, *need;
+
+    lexbor_allocator_t allocator = {
+        arena_malloc, arena_realloc, arena_calloc, arena_free, &arena
+    };
+
+    arena.size = 4 * 1024 * 1024;
+    arena.data = malloc(arena.size);
+    test_ne(arena.data, NULL);
+
+    need = lxb_html_document_create();
+    status = lxb_html_document_parse(need, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_document_create_with_allocator(&allocator);
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(serialize_eq(document, need), true);
+    test_ne(arena.length, 0);
+
+    /* The document object is in the arena too. */
+    test_eq((uint8_t *) document >= arena.data
+            && (uint8_t *) document < arena.data + arena.length, true);
+
+    lxb_html_document_destroy(document);
+    lxb_html_document_destroy(need);
+
+    test_ne(arena.frees, 0);
+
+    free(arena.data);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(document);
+    TEST_ADD(parser);
+    TEST_ADD(arena);
+
+    TEST_RUN("lexbor/html/allocator");
+    TEST_RELEASE();
+}
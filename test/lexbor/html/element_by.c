@@ -134,6 +134,95 @@ TEST_BEGIN(by_attr)
 }
 TEST_END
 
+TEST_BEGIN(classes)
+{
+    size_t length;
+    lxb_status_t status;
+    lxb_dom_attr_t *attr;
+    lxb_dom_element_t *first, *seventh;
+    lxb_html_document_t *document;
+    lxb_dom_collection_t *collection;
+    const lxb_dom_element_class_t **classes;
+    const lxb_dom_element_class_t *hidden, *upper;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, data, data_len);
+    test_eq(status, LXB_STATUS_OK);
+
+    collection = lxb_dom_collection_make(&document->dom_document, 16);
+    test_ne(collection, NULL);
+
+    status = lxb_dom_elements_by_tag_name(lxb_dom_interface_element(document),
+                                          collection, (lxb_char_t *) "div", 3);
+    test_eq(status, LXB_STATUS_OK);
+
+    first = lxb_dom_collection_element(collection, 0);
+    seventh = lxb_dom_collection_element(collection, 6);
+
+    /* Split once, interned and without repeats. */
+    hidden = lxb_dom_element_class_by_name(&document->dom_document,
+                                           (lxb_char_t *) "hidden", 6, false);
+    test_ne(hidden, NULL);
+
+    classes = lxb_dom_element_classes(seventh, &length);
+    test_eq_size(length, 2);
+    test_eq(classes[0], hidden);
+    test_eq(lxb_dom_element_has_class(seventh, hidden, false), true);
+    test_eq(lxb_dom_element_has_class(first, hidden, false), false);
+
+    lxb_dom_element_classes(lxb_dom_collection_element(collection, 12),
+                            &length);
+    test_eq_size(length, 0);
+
+    test_eq(lxb_dom_element_class_by_name(&document->dom_document,
+                                          (lxb_char_t *) "with", 4, false),
+            NULL);
+
+    /* Changes of the attribute. */
+    attr = lxb_dom_element_set_attribute(first, (lxb_char_t *) "class", 5,
+                                         (lxb_char_t *) " Hidden x ", 10);
+    test_ne(attr, NULL);
+
+    upper = lxb_dom_element_class_by_name(&document->dom_document,
+                                          (lxb_char_t *) "Hidden", 6, false);
+    test_ne(upper, NULL);
+    test_eq(upper->lower, hidden);
+    test_eq(lxb_dom_element_has_class(first, hidden, false), false);
+    test_eq(lxb_dom_element_has_class(first, hidden, true), true);
+
+    lxb_dom_collection_clean(collection);
+
+    status = lxb_dom_elements_by_class_name(lxb_dom_interface_element(document),
+                                            collection,
+                                            (lxb_char_t *) "with-accordion", 14);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lxb_dom_collection_length(collection), 7);
+
+    status = lxb_dom_element_remove_attribute(seventh,
+                                              (lxb_char_t *) "class", 5);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(lxb_dom_element_classes(seventh, &length), NULL);
+    test_eq_size(length, 0);
+
+    /* Quirks mode compares in lowercase. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    lxb_dom_collection_clean(collection);
+
+    status = lxb_dom_elements_by_class_name(lxb_dom_interface_element(document),
+                                            collection,
+                                            (lxb_char_t *) "HIDDEN", 6);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lxb_dom_collection_length(collection), 5);
+
+    lxb_dom_collection_destroy(collection, true);
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
 int
 main(int argc, const char * argv[])
 {
@@ -141,6 +230,7 @@ main(int argc, const char * argv[])
 
     TEST_ADD(by_class);
     TEST_ADD(by_attr);
+    TEST_ADD(classes);
 
     TEST_RUN("lexbor/html/element_by");
     TEST_RELEASE();
@@ -0,0 +1,485 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/dom/dom.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t html[] =
+    "<div id=a>1</div>"
+    "<div id=b><p id=a>2</p><span id=c>3</span></div>"
+    "<div id=b>4</div>"
+    "<table><tr><td id=c>5</td><b id=d>6</b></tr></table>"
+    "<div id=''>7</div>";
+
+static const char *ids[] = {"a", "b", "c", "d", "e", NULL};
+
+
+static lxb_dom_element_t *
+by_id(lxb_html_document_t *document, const char *id)
+{
+    return lxb_dom_element_by_id(lxb_dom_interface_element(document),
+                                 (const lxb_char_t *) id, strlen(id));
+}
+
+/* The same lookup walking the tree. */
+static lxb_dom_element_t *
+by_id_walk(lxb_html_document_t *document, const char *id)
+{
+    lxb_dom_index_t *index;
+    lxb_dom_element_t *element;
+
+    index = document->dom_document.index;
+    document->dom_document.index = NULL;
+
+    element = by_id(document, id);
+
+    document->dom_document.index = index;
+
+    return element;
+}
+
+static bool
+same_as_walk(lxb_html_document_t *document)
+{
+    const char **id;
+
+    for (id = ids; *id != NULL; id++) {
+        if (by_id(document, *id) != by_id_walk(document, *id)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static const char *names[] = {"div", "p", "span", "td", "b", "x-y", "a",
+                              "A", "c", "", NULL};
+
+/* getElementsByTagName() and getElementsByClassName() as by the walk. */
+static bool
+lists_as_walk(lxb_html_document_t *document, lxb_dom_element_t *root)
+{
+    bool same;
+    size_t i;
+    const char **name;
+    lxb_status_t status;
+    lxb_dom_index_t *index;
+    lxb_dom_collection_t *expect, *result;
+
+    expect = lxb_dom_collection_make(&document->dom_document, 16);
+    result = lxb_dom_collection_make(&document->dom_document, 16);
+
+    index = document->dom_document.index;
+    same = true;
+
+    for (name = names; *name != NULL && same; name++) {
+        for (i = 0; i < 2 && same; i++) {
+            lxb_dom_collection_clean(expect);
+            lxb_dom_collection_clean(result);
+
+            document->dom_document.index = NULL;
+
+            if (i == 0) {
+                status = lxb_dom_elements_by_tag_name(root, expect,
+                                                      (const lxb_char_t *) *name,
+                                                      strlen(*name));
+            }
+            else {
+                status = lxb_dom_elements_by_class_name(root, expect,
+                                                        (const lxb_char_t *) *name,
+                                                        strlen(*name));
+            }
+
+            document->dom_document.index = index;
+
+            if (status != LXB_STATUS_OK) {
+                same = false;
+                break;
+            }
+
+            if (i == 0) {
+                status = lxb_dom_elements_by_tag_name(root, result,
+                                                      (const lxb_char_t *) *name,
+                                                      strlen(*name));
+            }
+            else {
+                status = lxb_dom_elements_by_class_name(root, result,
+                                                        (const lxb_char_t *) *name,
+                                                        strlen(*name));
+            }
+
+            same = status == LXB_STATUS_OK
+                   && lxb_dom_collection_length(expect)
+                      == lxb_dom_collection_length(result)
+                   && memcmp(expect->array.list, result->array.list,
+                             sizeof(void *) * expect->array.length) == 0;
+        }
+    }
+
+    lxb_dom_collection_destroy(expect, true);
+    lxb_dom_collection_destroy(result, true);
+
+    return same;
+}
+
+static const lxb_char_t *
+text(lxb_dom_element_t *element)
+{
+    return lxb_dom_node_text_content(lxb_dom_interface_node(element), NULL);
+}
+
+
+TEST_BEGIN(build)
+{
+    lxb_status_t status;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_ID);
+    test_eq(status, LXB_STATUS_OK);
+    test_ne(lxb_dom_document_index(&document->dom_document), NULL);
+
+    test_eq(same_as_walk(document), true);
+
+    test_eq_str(text(by_id(document, "a")), "1");
+    test_eq_str(text(by_id(document, "b")), "23");
+    test_eq_str(text(by_id(document, "d")), "6");
+    test_eq(by_id(document, "e"), NULL);
+
+    /* Within a subtree. */
+    test_eq_str(text(lxb_dom_element_by_id(by_id(document, "b"),
+                                           (const lxb_char_t *) "a", 1)), "2");
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_UNDEF);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lxb_dom_document_index(&document->dom_document), NULL);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(parse)
+{
+    lxb_status_t status;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_ID);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Kept up to date while parsing, and emptied by the clean. */
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(same_as_walk(document), true);
+    test_eq_str(text(by_id(document, "c")), "3");
+
+    status = lxb_html_document_parse(document, (const lxb_char_t *) "<i id=c>x",
+                                     9);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(same_as_walk(document), true);
+    test_eq_str(text(by_id(document, "c")), "x");
+    test_eq(by_id(document, "a"), NULL);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(lists)
+{
+    lxb_status_t status;
+    lxb_dom_element_t *body, *div;
+    lxb_dom_collection_t *collection;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t data[] =
+        "<!DOCTYPE html>"
+        "<div class='a b'><p class=a>1</p><p class=' c  a a '>2</p></div>"
+        "<x-y class=A><span class=c>3</span><p>4</p></x-y>";
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_document_parse(document, data, sizeof(data) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    body = lxb_dom_interface_element(lxb_html_document_body_element(document));
+    div = lxb_dom_interface_element(lxb_dom_interface_node(body)->first_child);
+
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(document)), true);
+    test_eq(lists_as_walk(document, body), true);
+    test_eq(lists_as_walk(document, div), true);
+
+    collection = lxb_dom_collection_make(&document->dom_document, 4);
+    test_ne(collection, NULL);
+
+    status = lxb_dom_elements_by_class_name(body, collection,
+                                            (const lxb_char_t *) "a", 1);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(lxb_dom_collection_length(collection), 3);
+
+    /* Quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+    test_eq(lists_as_walk(document, body), true);
+
+    lxb_dom_collection_clean(collection);
+
+    status = lxb_dom_elements_by_class_name(body, collection,
+                                            (const lxb_char_t *) "a", 1);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(lxb_dom_collection_length(collection), 4);
+
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    /* Changes of the tree and of classes. */
+    test_ne(lxb_dom_element_set_attribute(div, (const lxb_char_t *) "class", 5,
+                                          (const lxb_char_t *) "c", 1), NULL);
+    test_eq(lists_as_walk(document, body), true);
+
+    status = lxb_dom_element_remove_attribute(div,
+                                              (const lxb_char_t *) "class", 5);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lists_as_walk(document, body), true);
+
+    lxb_dom_node_insert_child(lxb_dom_interface_node(body),
+                              lxb_dom_node_clone(lxb_dom_interface_node(div),
+                                                 true));
+    test_eq(lists_as_walk(document, body), true);
+
+    lxb_dom_node_remove(lxb_dom_interface_node(div));
+    test_eq(lists_as_walk(document, body), true);
+    test_eq(lists_as_walk(document, div), true);
+
+    lxb_dom_node_destroy_deep(lxb_dom_interface_node(div));
+    test_eq(lists_as_walk(document, body), true);
+
+    test_ne(lxb_html_element_inner_html_set(lxb_html_interface_element(body),
+                        (const lxb_char_t *) "<p class=c>y</p><b class=c>", 27),
+            NULL);
+    test_eq(lists_as_walk(document, body), true);
+
+    lxb_dom_collection_destroy(collection, true);
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(stale)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_dom_index_t *index;
+    lxb_dom_node_t *body, *div;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t data[] =
+        "<!DOCTYPE html><div class=a><p class=a>1</p></div>"
+        "<ul><li>1<li class=a>2<li>3<li>4<li>5<li>6</ul>"
+        "<ol><li>7<li>8<li>9<li>10<li>11<li>12</ol>";
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_document_parse(document, data, sizeof(data) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    index = document->dom_document.index;
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = body->first_child;
+
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(document)), true);
+    test_eq(index->stale, false);
+
+    /* Fewer descendants than listed elements: walked, lists not needed. */
+    test_eq(lxb_dom_index_subtree_less(div, 12), true);
+    test_eq(lxb_dom_index_subtree_less(body, 12), false);
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(div)), true);
+
+    /* Stale lists are not built again for a few small subtree queries. */
+    lxb_dom_node_insert_child(div, lxb_dom_node_clone(div->first_child, true));
+    test_eq(index->stale, true);
+
+    for (i = 0; i < 3; i++) {
+        test_eq(lxb_dom_index_ready(index, div), LXB_STATUS_NEXT);
+    }
+
+    test_eq(index->stale, true);
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(div)), true);
+
+    /* But after walking as many nodes as a build visits. */
+    for (i = 0; i < index->nodes; i++) {
+        status = lxb_dom_index_ready(index, body);
+        if (status == LXB_STATUS_OK) {
+            break;
+        }
+
+        test_eq(status, LXB_STATUS_NEXT);
+    }
+
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(index->stale, false);
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(body)), true);
+
+    /* And for the document right away. */
+    lxb_dom_node_remove(div->first_child);
+    test_eq(index->stale, true);
+    test_eq(lxb_dom_index_ready(index, lxb_dom_interface_node(document)),
+            LXB_STATUS_OK);
+    test_eq(index->stale, false);
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(document)), true);
+    test_eq(lists_as_walk(document, lxb_dom_interface_element(body)), true);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(mutation)
+{
+    lxb_status_t status;
+    lxb_dom_attr_t *attr;
+    lxb_dom_node_t *body;
+    lxb_dom_element_t *a, *b, *div;
+    lxb_html_document_t *document;
+
+    static lxb_char_t value[] = "e";
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_ID);
+    test_eq(status, LXB_STATUS_OK);
+
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+    a = by_id(document, "a");
+    b = by_id(document, "b");
+
+    /* Change and remove. */
+    attr = lxb_dom_element_set_attribute(a, (const lxb_char_t *) "id", 2,
+                                         (const lxb_char_t *) "e", 1);
+    test_ne(attr, NULL);
+
+    test_eq(by_id(document, "e"), a);
+    test_eq_str(text(by_id(document, "a")), "2");
+    test_eq(same_as_walk(document), true);
+
+    status = lxb_dom_element_remove_attribute(b, (const lxb_char_t *) "id", 2);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str(text(by_id(document, "b")), "4");
+    test_eq(same_as_walk(document), true);
+
+    /* Duplicates follow the tree order. */
+    lxb_dom_node_remove(lxb_dom_interface_node(a));
+    test_eq(by_id(document, "e"), NULL);
+
+    lxb_dom_node_insert_after(lxb_dom_interface_node(b),
+                              lxb_dom_interface_node(a));
+    test_eq(by_id(document, "e"), a);
+
+    attr = lxb_dom_element_set_attribute(a, (const lxb_char_t *) "id", 2,
+                                         (const lxb_char_t *) "b", 1);
+    test_ne(attr, NULL);
+
+    test_eq(by_id(document, "b"), a);
+    test_eq(same_as_walk(document), true);
+
+    /* Elements created and given an id before the insertion. */
+    div = lxb_dom_document_create_element(&document->dom_document,
+                                          (const lxb_char_t *) "div", 3, NULL);
+    test_ne(div, NULL);
+
+    attr = lxb_dom_element_set_attribute(div, (const lxb_char_t *) "id", 2,
+                                         (const lxb_char_t *) "d", 1);
+    test_ne(attr, NULL);
+
+    test_eq_str(text(by_id(document, "d")), "6");
+
+    status = lxb_dom_node_insert_child_status(body,
+                                              lxb_dom_interface_node(div));
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(same_as_walk(document), true);
+
+    lxb_dom_node_remove(lxb_dom_interface_node(div));
+    lxb_dom_node_insert_before(lxb_dom_interface_node(a),
+                               lxb_dom_interface_node(div));
+    test_eq(by_id(document, "d"), div);
+
+    /* Values set without a copy, and the same value again. */
+    status = lxb_dom_attr_set_value_wo_copy(a->attr_id, value, 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(by_id(document, "e"), a);
+    test_eq_str(text(by_id(document, "b")), "4");
+    test_eq(same_as_walk(document), true);
+
+    status = lxb_dom_attr_set_value(a->attr_id, (const lxb_char_t *) "e", 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(by_id(document, "e"), a);
+
+    /* Destroyed elements are gone from the index. */
+    lxb_dom_node_destroy_deep(lxb_dom_interface_node(b));
+    test_eq(same_as_walk(document), true);
+    test_eq(by_id(document, "a"), NULL);
+
+    lxb_dom_node_destroy(lxb_dom_interface_node(div));
+    test_eq(same_as_walk(document), true);
+
+    /* innerHTML. */
+    test_ne(lxb_html_element_inner_html_set(lxb_html_interface_element(body),
+                                   (const lxb_char_t *) "<p id=a>y</p>", 13),
+            NULL);
+
+    test_eq(same_as_walk(document), true);
+    test_eq_str(text(by_id(document, "a")), "y");
+    test_eq(by_id(document, "b"), NULL);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(build);
+    TEST_ADD(parse);
+    TEST_ADD(lists);
+    TEST_ADD(stale);
+    TEST_ADD(mutation);
+
+    TEST_RUN("lexbor/html/index");
+    TEST_RELEASE();
+}
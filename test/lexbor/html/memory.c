@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t item[] =
+    "<div class=\"item\" data-custom-attr=\"value\"><custom-tag>text"
+    "</custom-tag></div>";
+
+
+static size_t
+pools_size(const lxb_dom_document_memory_usage_t *usage)
+{
+    return usage->mraw.size + usage->text.size + usage->tags.size
+           + usage->attrs.size + usage->classes.size + usage->prefix.size
+           + usage->ns.size;
+}
+
+
+TEST_BEGIN(document)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_dom_document_t *doc;
+    lxb_html_document_t *document;
+    lxb_dom_document_memory_usage_t before, usage;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    doc = lxb_dom_interface_document(document);
+
+    lxb_dom_document_memory_usage(doc, &before);
+    test_ne(before.total.size, 0);
+    test_eq_size(before.total.size, pools_size(&before));
+
+    status = lxb_html_document_parse_chunk_begin(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; i < 4096; i++) {
+        status = lxb_html_document_parse_chunk(document, item,
+                                               sizeof(item) - 1);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    status = lxb_html_document_parse_chunk_end(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_dom_document_memory_usage(doc, &usage);
+
+    test_eq(usage.total.size > before.total.size, true);
+    test_eq(usage.mraw.size > before.mraw.size, true);
+    test_eq(usage.text.size > before.text.size, true);
+    test_eq_size(usage.total.size, pools_size(&usage));
+    test_eq(usage.total.peak >= usage.total.size, true);
+
+    /* The peak stays after clean until reset. */
+    lxb_html_document_clean(document);
+
+    lxb_dom_document_memory_usage(doc, &before);
+    test_eq(before.total.size < usage.total.size, true);
+    test_eq_size(before.total.peak, usage.total.peak);
+
+    lxb_dom_document_memory_peak_reset(doc);
+
+    lxb_dom_document_memory_usage(doc, &usage);
+    test_eq_size(usage.total.peak, usage.total.size);
+    test_eq_size(usage.mraw.peak, usage.mraw.size);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(parser)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+    lxb_html_tokenizer_memory_usage_t usage;
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_memory_usage(parser, &usage);
+    test_ne(usage.total.size, 0);
+    test_eq(usage.total.size > usage.mraw.size + usage.tokens.size
+                               + usage.token_attrs.size, true);
+
+    document = lxb_html_parse_chunk_begin(parser);
+    test_ne(document, NULL);
+
+    for (i = 0; i < 256; i++) {
+        status = lxb_html_parse_chunk_process(parser, item, sizeof(item) - 1);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    status = lxb_html_parse_chunk_end(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_memory_usage(parser, &usage);
+    test_eq(usage.total.peak >= usage.total.size, true);
+
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+}
+TEST_END
+
+TEST_BEGIN(limit_document)
+{
+    size_t i;
+    lxb_status_t status;
+    lexbor_str_t str = {0};
+    size_t limit;
+    lxb_dom_document_t *doc;
+    lxb_html_document_t *document;
+    lxb_dom_document_memory_usage_t usage;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    doc = lxb_dom_interface_document(document);
+
+    lxb_dom_document_memory_usage(doc, &usage);
+
+    limit = usage.total.size + 64 * 1024;
+    lxb_dom_document_memory_limit_set(doc, limit);
+
+    status = lxb_html_document_parse_chunk_begin(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; i < 4096; i++) {
+        status = lxb_html_document_parse_chunk(document, item,
+                                               sizeof(item) - 1);
+        if (status != LXB_STATUS_OK) {
+            break;
+        }
+    }
+
+    test_eq(status, LXB_STATUS_ERROR_MEMORY_LIMIT);
+    test_eq(lxb_dom_document_memory_exceeded(doc), true);
+
+    status = lxb_html_document_parse_chunk_end(document);
+    test_eq(status, LXB_STATUS_ERROR_MEMORY_LIMIT);
+
+    /* The partial tree is still a valid document. */
+    test_ne(lxb_html_document_body_element(document), NULL);
+
+    status = lxb_html_serialize_tree_str(lxb_dom_interface_node(document),
+                                         &str);
+    test_eq(status, LXB_STATUS_OK);
+    test_ne(str.length, 0);
+
+    lxb_dom_document_memory_usage(doc, &usage);
+    test_eq(usage.total.peak <= limit, true);
+
+    /* Clean resets the flag, no limit parses everything. */
+    lxb_html_document_clean(document);
+    lxb_dom_document_memory_limit_set(doc, 0);
+
+    test_eq(lxb_dom_document_memory_exceeded(doc), false);
+
+    status = lxb_html_document_parse(document, item, sizeof(item) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(limit_parser)
+{
+    size_t i, size;
+    lxb_status_t status;
+    lxb_char_t *html, *p;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+
+    size = (sizeof(item) - 1) * 4096;
+
+    html = lexbor_malloc(size);
+    test_ne(html, NULL);
+
+    for (i = 0, p = html; i < 4096; i++, p += sizeof(item) - 1) {
+        memcpy(p, item, sizeof(item) - 1);
+    }
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_memory_limit_set(parser, 256 * 1024);
+
+    document = lxb_html_parse(parser, html, size);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_ERROR_MEMORY_LIMIT);
+    test_ne(lxb_html_document_body_element(document), NULL);
+
+    lxb_html_document_destroy(document);
+
+    /* Sweep the limit to hit the failure at many allocation sites. */
+    for (i = 1024; i < 256 * 1024; i += 1024 + i / 4) {
+        lxb_html_parser_memory_limit_set(parser, i);
+
+        document = lxb_html_parse(parser, html, size);
+        if (document == NULL) {
+            test_eq(lxb_html_parser_status(parser),
+                    LXB_STATUS_ERROR_MEMORY_ALLOCATION);
+            continue;
+        }
+
+        test_eq(lxb_html_parser_status(parser), LXB_STATUS_ERROR_MEMORY_LIMIT);
+
+        lxb_html_document_destroy(document);
+    }
+
+    lxb_html_parser_memory_limit_set(parser, 0);
+
+    document = lxb_html_parse(parser, html, size);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+
+    lexbor_free(html);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(document);
+    TEST_ADD(parser);
+    TEST_ADD(limit_document);
+    TEST_ADD(limit_parser);
+
+    TEST_RUN("lexbor/html/memory");
+    TEST_RELEASE();
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/dom/interfaces/text.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html><head><title>Title</title></head>"
+    "<body><div id=main class=\"a b\" title='x &amp; y'>Plain text"
+    "<p>One &lt; two</p><pre>\nkeep</pre><table>t<tr><td>cell</td></tr>"
+    "</table><svg><text>svg text</text></svg>\r\nend</div></body></html>";
+
+
+static void
+release(const lxb_char_t *data, size_t length, void *ctx)
+{
+    (*(size_t *) ctx)++;
+}
+
+static bool
+in_input(const lxb_char_t *data)
+{
+    return data >= html && data < html + sizeof(html);
+}
+
+static lxb_status_t
+serialize(lxb_html_document_t *document, lxb_char_t **out, size_t *length)
+{
+    lxb_status_t status;
+    lexbor_str_t str = {0};
+
+    status = lxb_html_serialize_tree_str(lxb_dom_interface_node(document),
+                                         &str);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    *out = lexbor_malloc(str.length + 1);
+    if (*out == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    memcpy(*out, str.data, str.length + 1);
+    *length = str.length;
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_dom_element_t *
+element_by_id(lxb_html_document_t *document)
+{
+    lxb_dom_collection_t *col;
+    lxb_dom_element_t *element;
+
+    col = lxb_dom_collection_make(lxb_dom_interface_document(document), 4);
+    if (col == NULL) {
+        return NULL;
+    }
+
+    (void) lxb_dom_elements_by_attr(lxb_dom_interface_element(document->body),
+                                    col, (const lxb_char_t *) "id", 2,
+                                    (const lxb_char_t *) "main", 4, false);
+
+    element = lxb_dom_collection_element(col, 0);
+
+    lxb_dom_collection_destroy(col, true);
+
+    return element;
+}
+
+
+TEST_BEGIN(parse)
+{
+    size_t len, need_len, have_len, released = 0;
+    lxb_status_t status;
+    lxb_char_t *need, *have;
+    lxb_dom_attr_t *attr;
+    lxb_dom_node_t *text;
+    lxb_dom_element_t *div;
+    const lxb_char_t *value;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(document, &need, &need_len);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse_input(document, html, sizeof(html) - 1,
+                                           release, &released);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(document, &have, &have_len);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str_n(have, have_len, need, need_len);
+
+    div = element_by_id(document);
+    test_ne(div, NULL);
+
+    /* Not rewritten values point into the input. */
+    attr = lxb_dom_element_attr_by_name(div, (const lxb_char_t *) "class", 5);
+    test_ne(attr, NULL);
+    test_eq(in_input(attr->value->data), true);
+
+    attr = lxb_dom_element_attr_by_name(div, (const lxb_char_t *) "title", 5);
+    test_ne(attr, NULL);
+    test_eq(in_input(attr->value->data), false);
+
+    text = lxb_dom_node_first_child(lxb_dom_interface_node(div));
+    test_eq(text->local_name, LXB_TAG__TEXT);
+    test_eq(in_input(lxb_dom_interface_text(text)->char_data.data.data), true);
+
+    /* Changes must not touch the input. */
+    status = lxb_dom_node_text_content_set(text, (const lxb_char_t *) "new", 3);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(in_input(lxb_dom_interface_text(text)->char_data.data.data), false);
+
+    attr = lxb_dom_element_set_attribute(div, (const lxb_char_t *) "class", 5,
+                                         (const lxb_char_t *) "c", 1);
+    test_ne(attr, NULL);
+
+    value = lxb_dom_element_get_attribute(div, (const lxb_char_t *) "class", 5,
+                                          &len);
+    test_ne(value, NULL);
+    test_eq_str_n(value, len, "c", 1);
+
+    lxb_dom_node_destroy_deep(lxb_dom_interface_node(div));
+
+    test_eq_size(released, 0);
+
+    lxb_html_document_destroy(document);
+
+    test_eq_size(released, 1);
+
+    lexbor_free(need);
+    lexbor_free(have);
+}
+TEST_END
+
+TEST_BEGIN(chunks)
+{
+    size_t chunk, len, need_len, have_len;
+    lxb_status_t status;
+    lxb_char_t *need, *have;
+    const lxb_char_t *data, *end;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(document, &need, &need_len);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+
+    for (chunk = 1; chunk < sizeof(html); chunk++) {
+        document = lxb_html_document_create();
+        test_ne(document, NULL);
+
+        lxb_dom_document_opt_set(lxb_dom_interface_document(document),
+                                 LXB_DOM_DOCUMENT_OPT_BORROW_INPUT);
+
+        status = lxb_dom_document_input_set(lxb_dom_interface_document(document),
+                                            html, sizeof(html) - 1, NULL, NULL);
+        test_eq(status, LXB_STATUS_OK);
+
+        status = lxb_html_document_parse_chunk_begin(document);
+        test_eq(status, LXB_STATUS_OK);
+
+        data = html;
+        end = html + sizeof(html) - 1;
+
+        while (data < end) {
+            len = lexbor_min(chunk, (size_t) (end - data));
+
+            status = lxb_html_document_parse_chunk(document, data, len);
+            test_eq(status, LXB_STATUS_OK);
+
+            data += len;
+        }
+
+        status = lxb_html_document_parse_chunk_end(document);
+        test_eq(status, LXB_STATUS_OK);
+
+        status = serialize(document, &have, &have_len);
+        test_eq(status, LXB_STATUS_OK);
+
+        test_eq_str_n(have, have_len, need, need_len);
+
+        lexbor_free(have);
+        lxb_html_document_destroy(document);
+    }
+
+    lexbor_free(need);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(parse);
+    TEST_ADD(chunks);
+
+    TEST_RUN("lexbor/html/parse_input");
+    TEST_RELEASE();
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+
+#include <unit/test.h>
+
+
+typedef struct {
+    size_t allocs;
+    size_t frees;
+}
+counter_t;
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html><head><title>Title</title></head>"
+    "<body><div id=main class=\"a b\">text<p>one<p>two</div>"
+    "<custom-tag data-x=1>custom</custom-tag></body></html>";
+
+static const lxb_char_t quirks[] = "<p>no doctype";
+
+
+static void *
+counter_malloc(size_t size, void *ctx)
+{
+    ((counter_t *) ctx)->allocs++;
+
+    return malloc(size);
+}
+
+static void *
+counter_realloc(void *dst, size_t size, void *ctx)
+{
+    if (dst == NULL) {
+        ((counter_t *) ctx)->allocs++;
+    }
+
+    return realloc(dst, size);
+}
+
+static void *
+counter_calloc(size_t num, size_t size, void *ctx)
+{
+    ((counter_t *) ctx)->allocs++;
+
+    return calloc(num, size);
+}
+
+static void
+counter_free(void *dst, void *ctx)
+{
+    ((counter_t *) ctx)->frees++;
+
+    free(dst);
+}
+
+static lxb_status_t
+serialize(lxb_html_document_t *document, lexbor_str_t *str,
+          lexbor_mraw_t *mraw)
+{
+    str->data = NULL;
+    str->length = 0;
+
+    if (lexbor_str_init(str, mraw, 256) == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    return lxb_html_serialize_tree_str(lxb_dom_interface_node(document), str);
+}
+
+static lxb_char_t *
+big_html(size_t count, size_t *length)
+{
+    size_t i;
+    lxb_char_t *data, *p;
+
+    static const char item[] = "<div class=\"item\"><span>text</span></div>";
+
+    data = lexbor_malloc((sizeof(item) - 1) * count);
+    if (data == NULL) {
+        return NULL;
+    }
+
+    p = data;
+
+    for (i = 0; i < count; i++) {
+        memcpy(p, item, sizeof(item) - 1);
+        p += sizeof(item) - 1;
+    }
+
+    *length = p - data;
+
+    return data;
+}
+
+/*
+ * Allocations made by the second parse in a pooled document.
+ */
+static lxb_status_t
+parse_allocs(size_t retain, const lxb_char_t *data, size_t length,
+             size_t *allocs)
+{
+    lxb_status_t status;
+    counter_t counter = {0};
+    lxb_html_document_t *document;
+    lxb_html_document_pool_t pool;
+
+    lexbor_allocator_t allocator = {
+        counter_malloc, counter_realloc, counter_calloc, counter_free,
+        &counter
+    };
+
+    status = lxb_html_document_pool_init(&pool, 1, retain, &allocator);
+    if (status != LXB_STATUS_OK) {
+        return status;
+    }
+
+    document = lxb_html_document_pool_acquire(&pool);
+    (void) lxb_html_document_parse(document, data, length);
+    lxb_html_document_pool_release(&pool, document);
+
+    *allocs = counter.allocs;
+
+    document = lxb_html_document_pool_acquire(&pool);
+    (void) lxb_html_document_parse(document, data, length);
+    lxb_html_document_pool_release(&pool, document);
+
+    *allocs = counter.allocs - *allocs;
+
+    lxb_html_document_pool_destroy(&pool, false);
+
+    return (counter.allocs == counter.frees) ? LXB_STATUS_OK
+                                             : LXB_STATUS_ERROR;
+}
+
+
+TEST_BEGIN(reuse)
+{
+    size_t i;
+    lxb_status_t status;
+    lexbor_str_t need, have;
+    lexbor_mraw_t *mraw;
+    lxb_html_document_t *document, *first;
+    lxb_html_document_pool_t *pool;
+
+    mraw = lexbor_mraw_create();
+    test_eq(lexbor_mraw_init(mraw, 1024), LXB_STATUS_OK);
+
+    document = lxb_html_document_create();
+    test_eq(lxb_html_document_parse(document, html, sizeof(html) - 1),
+            LXB_STATUS_OK);
+    test_eq(serialize(document, &need, mraw), LXB_STATUS_OK);
+    lxb_html_document_destroy(document);
+
+    pool = lxb_html_document_pool_create();
+    status = lxb_html_document_pool_init(pool, 4, 64 * 1024, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    first = lxb_html_document_pool_acquire(pool);
+    test_ne(first, NULL);
+
+    lxb_html_document_pool_release(pool, first);
+
+    for (i = 0; i < 8; i++) {
+        document = lxb_html_document_pool_acquire(pool);
+        test_eq(document, first);
+
+        status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+        test_eq(status, LXB_STATUS_OK);
+
+        test_eq(serialize(document, &have, mraw), LXB_STATUS_OK);
+        test_eq_str_n(have.data, have.length, need.data, need.length);
+
+        lxb_dom_interface_document(document)->user = mraw;
+
+        lxb_html_document_pool_release(pool, document);
+        test_eq_size(lxb_html_document_pool_length(pool), 1UL);
+
+        test_eq(lxb_dom_interface_document(document)->user, NULL);
+        test_eq(lxb_dom_interface_node(document)->first_child, NULL);
+    }
+
+    lxb_html_document_pool_destroy(pool, true);
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+TEST_BEGIN(compat_mode)
+{
+    lxb_status_t status;
+    lxb_html_document_t *document;
+    lxb_html_document_pool_t pool;
+
+    status = lxb_html_document_pool_init(&pool, 1, 0, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_document_pool_acquire(&pool);
+
+    status = lxb_html_document_parse(document, quirks, sizeof(quirks) - 1);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lxb_dom_interface_document(document)->compat_mode,
+            LXB_DOM_DOCUMENT_CMODE_QUIRKS);
+
+    lxb_html_document_pool_release(&pool, document);
+
+    document = lxb_html_document_pool_acquire(&pool);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(lxb_dom_interface_document(document)->compat_mode,
+            LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS);
+
+    lxb_html_document_pool_release(&pool, document);
+    lxb_html_document_pool_destroy(&pool, false);
+}
+TEST_END
+
+TEST_BEGIN(full)
+{
+    lxb_status_t status;
+    lxb_html_document_t *one, *two;
+    lxb_html_document_pool_t pool;
+
+    status = lxb_html_document_pool_init(&pool, 1, 0, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    one = lxb_html_document_pool_acquire(&pool);
+    two = lxb_html_document_pool_acquire(&pool);
+    test_ne(one, two);
+
+    lxb_html_document_pool_release(&pool, one);
+    lxb_html_document_pool_release(&pool, two);
+
+    test_eq_size(lxb_html_document_pool_length(&pool), 1UL);
+    test_eq(lxb_html_document_pool_acquire(&pool), one);
+
+    lxb_html_document_pool_release(&pool, one);
+    lxb_html_document_pool_destroy(&pool, false);
+}
+TEST_END
+
+TEST_BEGIN(retain)
+{
+    size_t length, kept, dropped;
+    lxb_char_t *data;
+    lxb_status_t status;
+
+    data = big_html(4096, &length);
+    test_ne(data, NULL);
+
+    status = parse_allocs(64 * 1024 * 1024, data, length, &kept);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = parse_allocs(0, data, length, &dropped);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(dropped > kept, true);
+
+    lexbor_free(data);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(reuse);
+    TEST_ADD(compat_mode);
+    TEST_ADD(full);
+    TEST_ADD(retain);
+
+    TEST_RUN("lexbor/html/pool");
+    TEST_RELEASE();
+}
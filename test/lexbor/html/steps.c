@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html><head><title>Title</title>"
+    "<script>if (a < b) {}</script></head>"
+    "<body><div id=main class=\"a b\">text &amp; more<p>one<p>two</div>"
+    "<table><tr><td>cell</table><!-- comment -->"
+    "<textarea>raw <b> text</textarea>"
+    "<custom-tag data-x=1>custom</custom-tag></body></html>";
+
+
+static lxb_status_t
+serialize(lxb_dom_node_t *node, lexbor_str_t *str)
+{
+    str->data = NULL;
+    str->length = 0;
+
+    return lxb_html_serialize_tree_str(node, str);
+}
+
+static bool
+yield_every_other(lxb_html_tokenizer_t *tkz, void *ctx)
+{
+    size_t *count = ctx;
+
+    return (++(*count) % 2) == 0;
+}
+
+static bool
+yield_never(lxb_html_tokenizer_t *tkz, void *ctx)
+{
+    (*(size_t *) ctx)++;
+
+    return false;
+}
+
+
+TEST_BEGIN(chunk)
+{
+    size_t i, pauses;
+    lxb_status_t status;
+    lexbor_str_t expect, result;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document, *stepped;
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+
+    status = serialize(lxb_dom_interface_node(document), &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_steps_set(parser, 1, NULL, NULL);
+
+    /* Split in two chunks to resume across a chunk boundary too. */
+    stepped = lxb_html_parse_chunk_begin(parser);
+    test_ne(stepped, NULL);
+
+    pauses = 0;
+
+    for (i = 0; i < 2; i++) {
+        if (i == 0) {
+            status = lxb_html_parse_chunk_process(parser, html, 40);
+        }
+        else {
+            status = lxb_html_parse_chunk_process(parser, html + 40,
+                                                  sizeof(html) - 1 - 40);
+        }
+
+        while (status == LXB_STATUS_CONTINUE) {
+            pauses++;
+
+            /* Nothing else is accepted while paused. */
+            test_eq(lxb_html_parse_chunk_process(parser, html, 1),
+                    LXB_STATUS_ERROR_WRONG_STAGE);
+            test_eq(lxb_html_parse_chunk_end(parser),
+                    LXB_STATUS_ERROR_WRONG_STAGE);
+
+            status = lxb_html_parse_chunk_resume(parser);
+        }
+
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    test_eq(pauses > 10, true);
+    test_eq(lxb_html_parse_chunk_resume(parser), LXB_STATUS_ERROR_WRONG_STAGE);
+
+    status = lxb_html_parse_chunk_end(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(lxb_dom_interface_node(stepped), &result);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str(result.data, expect.data);
+
+    lxb_html_document_destroy(stepped);
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+}
+TEST_END
+
+TEST_BEGIN(yield)
+{
+    size_t count, pauses;
+    lxb_status_t status;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* The callback decides; never yielding parses in one call. */
+    count = 0;
+    lxb_html_parser_steps_set(parser, 2, yield_never, &count);
+
+    document = lxb_html_parse_chunk_begin(parser);
+    test_ne(document, NULL);
+
+    status = lxb_html_parse_chunk_process(parser, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(count > 5, true);
+
+    status = lxb_html_parse_chunk_end(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+
+    count = 0;
+    pauses = 0;
+    lxb_html_parser_steps_set(parser, 2, yield_every_other, &count);
+
+    document = lxb_html_parse_chunk_begin(parser);
+    test_ne(document, NULL);
+
+    status = lxb_html_parse_chunk_process(parser, html, sizeof(html) - 1);
+
+    while (status == LXB_STATUS_CONTINUE) {
+        pauses++;
+        status = lxb_html_parse_chunk_resume(parser);
+    }
+
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(pauses, count / 2);
+
+    status = lxb_html_parse_chunk_end(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_document_destroy(document);
+
+    /* Parsing all input at once ignores yield points. */
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_OK);
+    test_ne(lxb_html_document_body_element(document), NULL);
+
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+}
+TEST_END
+
+TEST_BEGIN(fragment)
+{
+    size_t pauses;
+    lxb_status_t status;
+    lexbor_str_t expect, result;
+    lxb_dom_node_t *node;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t frag[] = "<p>one<b>two</b><i>three<p>four";
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    node = lxb_html_parse_fragment_by_tag_id(parser, document, LXB_TAG_DIV,
+                                             LXB_NS_HTML, frag,
+                                             sizeof(frag) - 1);
+    test_ne(node, NULL);
+
+    status = serialize(node, &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_steps_set(parser, 1, NULL, NULL);
+
+    status = lxb_html_parse_fragment_chunk_begin(parser, document, LXB_TAG_DIV,
+                                                 LXB_NS_HTML);
+    test_eq(status, LXB_STATUS_OK);
+
+    pauses = 0;
+    status = lxb_html_parse_fragment_chunk_process(parser, frag,
+                                                   sizeof(frag) - 1);
+
+    while (status == LXB_STATUS_CONTINUE) {
+        pauses++;
+
+        test_eq(lxb_html_parse_fragment_chunk_end(parser), NULL);
+
+        status = lxb_html_parse_chunk_resume(parser);
+    }
+
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(pauses > 3, true);
+
+    node = lxb_html_parse_fragment_chunk_end(parser);
+    test_ne(node, NULL);
+
+    status = serialize(node, &result);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str(result.data, expect.data);
+
+    lxb_html_parser_destroy(parser);
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(document)
+{
+    size_t pauses;
+    lxb_status_t status;
+    lexbor_str_t expect, result;
+    lxb_dom_node_t *node;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document;
+    lxb_html_body_element_t *body;
+
+    static const lxb_char_t frag[] = "<p>one<b>two</b><i>three<p>four";
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(lxb_dom_interface_node(document), &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = document->dom_document.parser;
+    lxb_html_parser_steps_set(parser, 1, NULL, NULL);
+
+    /* Parsing all input at once resumes until done. */
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(lxb_dom_interface_node(document), &result);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_str(result.data, expect.data);
+
+    body = lxb_html_document_body_element(document);
+    test_ne(body, NULL);
+
+    node = lxb_html_document_parse_fragment(document,
+                                            lxb_dom_interface_element(body),
+                                            frag, sizeof(frag) - 1);
+    test_ne(node, NULL);
+    test_ne(node->first_child, NULL);
+
+    /* By chunks the caller resumes. */
+    status = lxb_html_document_parse_chunk_begin(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    pauses = 0;
+    status = lxb_html_document_parse_chunk(document, html, sizeof(html) - 1);
+
+    while (status == LXB_STATUS_CONTINUE) {
+        pauses++;
+        status = lxb_html_document_parse_chunk_resume(document);
+    }
+
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(pauses > 10, true);
+
+    status = lxb_html_document_parse_chunk_end(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(lxb_dom_interface_node(document), &result);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_str(result.data, expect.data);
+
+    lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(tree_build)
+{
+    lxb_status_t status;
+    lexbor_str_t expect, result;
+    lxb_html_parser_t *parser;
+    lxb_html_document_t *document, *built;
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+
+    status = serialize(lxb_dom_interface_node(document), &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_parser_clean(parser);
+    lxb_html_parser_steps_set(parser, 1, NULL, NULL);
+
+    built = lxb_html_document_create();
+    test_ne(built, NULL);
+
+    lxb_html_tokenizer_tags_set(parser->tkz, built->dom_document.tags);
+    lxb_html_tokenizer_attrs_set(parser->tkz, built->dom_document.attrs);
+    lxb_html_tokenizer_attrs_mraw_set(parser->tkz, built->dom_document.text);
+    lxb_html_tokenizer_tree_set(parser->tkz, parser->tree);
+
+    status = lxb_html_tree_build(parser->tree, built, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = serialize(lxb_dom_interface_node(built), &result);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_str(result.data, expect.data);
+
+    lxb_html_document_destroy(built);
+    lxb_html_document_destroy(document);
+    lxb_html_parser_destroy(parser);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(chunk);
+    TEST_ADD(yield);
+    TEST_ADD(fragment);
+    TEST_ADD(document);
+    TEST_ADD(tree_build);
+
+    TEST_RUN("lexbor/html/steps");
+    TEST_RELEASE();
+}
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+
+#include <unit/test.h>
+
+
+typedef struct {
+    lexbor_str_t  str;
+    lexbor_mraw_t *mraw;
+    size_t        events;
+    size_t        input;
+    size_t        copied;
+    size_t        stop_after;
+}
+stream_ctx_t;
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html PUBLIC \"-//W3C//DTD HTML 4.01//EN\">"
+    "<html><head><title>A &amp; B</title>"
+    "<script>if (a < b) { x = \"</p>\"; }</script></head>"
+    "<body><!-- comment -->"
+    "<a href=\"/path?a=1&amp;b=2\" class='link big' id=main data-x>"
+    "text\r\nmore text</a><br/><DIV CLASS=\"x\">last</div></body></html>";
+
+static const char need[] =
+    "DOCTYPE(html) public=\"-//W3C//DTD HTML 4.01//EN\"\n"
+    "START(html)\nSTART(head)\nSTART(title)\nTEXT(A & B)\nEND(title)\n"
+    "START(script)\nTEXT(if (a < b) { x = \"</p>\"; })\nEND(script)\n"
+    "END(head)\nSTART(body)\nCOMMENT( comment )\n"
+    "START(a) href=\"/path?a=1&b=2\" class=\"link big\" id=\"main\" data-x\n"
+    "TEXT(text\nmore text)\nEND(a)\nSTART(br/)\n"
+    "START(div) class=\"x\"\nTEXT(last)\nEND(div)\nEND(body)\nEND(html)\n";
+
+
+static void
+append(stream_ctx_t *ctx, const lxb_char_t *data, size_t length)
+{
+    (void) lexbor_str_append(&ctx->str, ctx->mraw, data, length);
+}
+
+static void
+count(stream_ctx_t *ctx, const lxb_html_stream_str_t *str)
+{
+    if (str->is_input) {
+        ctx->input++;
+    }
+    else {
+        ctx->copied++;
+    }
+}
+
+static lxb_status_t
+callback(lxb_html_stream_t *stream, const lxb_html_stream_event_t *event,
+         void *vctx)
+{
+    size_t i;
+    stream_ctx_t *ctx = vctx;
+    const lxb_html_stream_attr_t *attr;
+
+    static const char *names[] = {
+        "START", "END", "TEXT", "COMMENT", "DOCTYPE", "PI"
+    };
+
+    ctx->events++;
+
+    append(ctx, (const lxb_char_t *) names[event->type],
+           strlen(names[event->type]));
+    append(ctx, (const lxb_char_t *) "(", 1);
+
+    switch (event->type) {
+        case LXB_HTML_STREAM_EVENT_TEXT:
+        case LXB_HTML_STREAM_EVENT_COMMENT:
+            append(ctx, event->data.data, event->data.length);
+            count(ctx, &event->data);
+            break;
+
+        default:
+            append(ctx, event->name.data, event->name.length);
+
+            if (event->self_closing) {
+                append(ctx, (const lxb_char_t *) "/", 1);
+            }
+
+            break;
+    }
+
+    append(ctx, (const lxb_char_t *) ")", 1);
+
+    for (i = 0; i < event->attrs_length; i++) {
+        attr = &event->attrs[i];
+
+        append(ctx, (const lxb_char_t *) " ", 1);
+        append(ctx, attr->name.data, attr->name.length);
+
+        if (attr->value.data != NULL) {
+            append(ctx, (const lxb_char_t *) "=\"", 2);
+            append(ctx, attr->value.data, attr->value.length);
+            append(ctx, (const lxb_char_t *) "\"", 1);
+
+            count(ctx, &attr->value);
+        }
+    }
+
+    append(ctx, (const lxb_char_t *) "\n", 1);
+
+    if (ctx->str.data == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    if (ctx->events == ctx->stop_after) {
+        return LXB_STATUS_STOP;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+run(stream_ctx_t *ctx, size_t chunk)
+{
+    size_t len;
+    lxb_status_t status;
+    const lxb_char_t *data, *end;
+    lxb_html_stream_t *stream;
+
+    stream = lxb_html_stream_create();
+    status = lxb_html_stream_init(stream, callback, ctx);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
+
+    status = lxb_html_stream_begin(stream);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
+
+    data = html;
+    end = html + sizeof(html) - 1;
+
+    while (data < end) {
+        len = lexbor_min(chunk, (size_t) (end - data));
+
+        status = lxb_html_stream_chunk(stream, data, len);
+        if (status != LXB_STATUS_OK) {
+            goto done;
+        }
+
+        data += len;
+    }
+
+    status = lxb_html_stream_end(stream);
+
+done:
+
+    lxb_html_stream_destroy(stream);
+
+    return status;
+}
+
+static void
+ctx_init(stream_ctx_t *ctx, lexbor_mraw_t *mraw)
+{
+    memset(ctx, 0, sizeof(stream_ctx_t));
+
+    ctx->mraw = mraw;
+    (void) lexbor_str_init(&ctx->str, mraw, 1024);
+}
+
+
+TEST_BEGIN(events)
+{
+    lxb_status_t status;
+    stream_ctx_t ctx;
+    lexbor_mraw_t *mraw;
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096);
+    test_eq(status, LXB_STATUS_OK);
+
+    ctx_init(&ctx, mraw);
+
+    status = run(&ctx, sizeof(html));
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str_n(ctx.str.data, ctx.str.length, need, sizeof(need) - 1);
+
+    /*
+     * Rewritten: "A & B", "text\nmore text" and the href value.
+     * Everything else points into the input.
+     */
+    test_eq_size(ctx.copied, 3);
+    test_eq_size(ctx.input, 7);
+
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+TEST_BEGIN(chunks)
+{
+    size_t chunk;
+    lxb_status_t status;
+    stream_ctx_t ctx;
+    lexbor_mraw_t *mraw;
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (chunk = 1; chunk < sizeof(html); chunk++) {
+        lexbor_mraw_clean(mraw);
+        ctx_init(&ctx, mraw);
+
+        status = run(&ctx, chunk);
+        test_eq(status, LXB_STATUS_OK);
+
+        test_eq_str_n(ctx.str.data, ctx.str.length, need, sizeof(need) - 1);
+    }
+
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+TEST_BEGIN(stop)
+{
+    lxb_status_t status;
+    stream_ctx_t ctx;
+    lexbor_mraw_t *mraw;
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096);
+    test_eq(status, LXB_STATUS_OK);
+
+    ctx_init(&ctx, mraw);
+    ctx.stop_after = 3;
+
+    status = run(&ctx, 7);
+    test_eq(status, LXB_STATUS_STOP);
+    test_eq_size(ctx.events, 3);
+
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+static lxb_status_t
+comment_cb(lxb_html_stream_t *stream, const lxb_html_stream_event_t *event,
+           void *vctx)
+{
+    stream_ctx_t *ctx = vctx;
+
+    if (event->type == LXB_HTML_STREAM_EVENT_COMMENT) {
+        append(ctx, event->data.data, event->data.length);
+        append(ctx, (const lxb_char_t *) "|", 1);
+
+        count(ctx, &event->data);
+    }
+
+    return LXB_STATUS_OK;
+}
+
+TEST_BEGIN(comments)
+{
+    lxb_status_t status;
+    stream_ctx_t ctx;
+    lexbor_mraw_t *mraw;
+    lxb_html_stream_t *stream;
+
+    static const lxb_char_t data[] =
+        "<!-- a --><!----><!x y></ z><!-b><![CDATA[c]]><!-- d\r\n-->";
+
+    static const char need[] = " a ||x y| z|-b|[CDATA[c]]| d\n|";
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096);
+    test_eq(status, LXB_STATUS_OK);
+
+    ctx_init(&ctx, mraw);
+
+    stream = lxb_html_stream_create();
+    status = lxb_html_stream_init(stream, comment_cb, &ctx);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_stream_parse(stream, data, sizeof(data) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str_n(ctx.str.data, ctx.str.length, need, sizeof(need) - 1);
+
+    /* Only the last one is rewritten. */
+    test_eq_size(ctx.input, 6);
+    test_eq_size(ctx.copied, 1);
+
+    lxb_html_stream_destroy(stream);
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+TEST_BEGIN(chunk_gone)
+{
+    lxb_status_t status;
+    stream_ctx_t ctx;
+    lexbor_mraw_t *mraw;
+    lxb_html_stream_t *stream;
+    lxb_char_t chunk[32];
+
+    static const char first[] = "<a href=x title='y'";
+    static const char need[] = "START(a) href=\"x\" title=\"y\" id=\"z\"\n";
+
+    mraw = lexbor_mraw_create();
+    status = lexbor_mraw_init(mraw, 4096);
+    test_eq(status, LXB_STATUS_OK);
+
+    ctx_init(&ctx, mraw);
+
+    stream = lxb_html_stream_create();
+    status = lxb_html_stream_init(stream, callback, &ctx);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_stream_begin(stream);
+    test_eq(status, LXB_STATUS_OK);
+
+    memcpy(chunk, first, sizeof(first) - 1);
+
+    status = lxb_html_stream_chunk(stream, chunk, sizeof(first) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* The values taken from the first chunk must not refer to it. */
+    memset(chunk, 'Z', sizeof(chunk));
+
+    status = lxb_html_stream_chunk(stream, (const lxb_char_t *) " id=z>", 6);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_stream_end(stream);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_str_n(ctx.str.data, ctx.str.length, need, sizeof(need) - 1);
+
+    test_eq_size(ctx.copied, 2);
+    test_eq_size(ctx.input, 1);
+
+    lxb_html_stream_destroy(stream);
+    lexbor_mraw_destroy(mraw, true);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(events);
+    TEST_ADD(chunks);
+    TEST_ADD(stop);
+    TEST_ADD(comments);
+    TEST_ADD(chunk_gone);
+
+    TEST_RUN("lexbor/html/stream");
+    TEST_RELEASE();
+}
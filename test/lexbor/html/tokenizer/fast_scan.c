@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/core/simd.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html><head><title>Title title title &amp; title\r\n"
+    "title title title title title title</title>"
+    "<style>body { color: red; } p > a { color: blue; }\r\n\0 div { x: y }"
+    "</style>"
+    "<script>var a = \"<b>\"; if (a < 10 && b > 20) { a--; }\r\n"
+    "<!-- var c = 'script data escaped -- state'; <script> double -->"
+    " escaped </script> --> done();</script></head><body>"
+    "<!-- long comment long comment long comment - long comment \r\n"
+    "long comment <! long comment long comment long comment \0 -->"
+    "<p class='single quoted value with &amp; and \r\n more text here'"
+    " id=unquotedvaluethatisverylongandhasnospacesatall&amp;tail"
+    " title=\"double quoted value double quoted value\r value\">text</p>"
+    "<textarea>rcdata rcdata rcdata rcdata &lt; rcdata rcdata rcdata"
+    "</textarea><? processing instruction processing instruction ?>"
+    "<svg><![CDATA[cdata cdata cdata cdata cdata cdata cdata ] ]] cdata]]>"
+    "</svg></body></html>";
+
+
+static lxb_status_t
+serialize(lexbor_str_t *out, size_t chunk)
+{
+    size_t len;
+    lxb_status_t status;
+    lexbor_str_t str = {0};
+    const lxb_char_t *data, *end;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    if (document == NULL) {
+        return LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+    }
+
+    status = lxb_html_document_parse_chunk_begin(document);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
+
+    data = html;
+    end = html + sizeof(html) - 1;
+
+    while (data < end) {
+        len = lexbor_min(chunk, (size_t) (end - data));
+
+        status = lxb_html_document_parse_chunk(document, data, len);
+        if (status != LXB_STATUS_OK) {
+            goto done;
+        }
+
+        data += len;
+    }
+
+    status = lxb_html_document_parse_chunk_end(document);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
+
+    status = lxb_html_serialize_tree_str(lxb_dom_interface_node(document),
+                                         &str);
+    if (status != LXB_STATUS_OK) {
+        goto done;
+    }
+
+    /* The string lives in the document memory. */
+
+    out->data = lexbor_malloc(str.length + 1);
+    if (out->data == NULL) {
+        status = LXB_STATUS_ERROR_MEMORY_ALLOCATION;
+        goto done;
+    }
+
+    memcpy(out->data, str.data, str.length + 1);
+    out->length = str.length;
+
+done:
+
+    lxb_html_document_destroy(document);
+
+    return status;
+}
+
+
+TEST_BEGIN(compare)
+{
+    size_t chunk;
+    lxb_status_t status;
+    lexbor_str_t need = {0}, have;
+
+    lexbor_simd_use(LEXBOR_SIMD_NONE);
+
+    status = serialize(&need, sizeof(html));
+    test_eq(status, LXB_STATUS_OK);
+
+    lexbor_simd_init();
+
+    for (chunk = 1; chunk <= sizeof(html); chunk++) {
+        have.data = NULL;
+        have.length = 0;
+
+        status = serialize(&have, chunk);
+        test_eq(status, LXB_STATUS_OK);
+
+        test_eq_str_n(have.data, have.length, need.data, need.length);
+
+        lexbor_free(have.data);
+    }
+
+    lexbor_free(need.data);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(compare);
+
+    TEST_RUN("lexbor/html/tokenizer/fast_scan");
+    TEST_RELEASE();
+}
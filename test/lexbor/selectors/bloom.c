@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/selectors.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 512
+
+typedef struct {
+    lxb_dom_node_t *nodes[FOUND_MAX];
+    size_t         length;
+}
+found_t;
+
+
+static const lxb_char_t html[] =
+    "<div id=Main class='a b'><section class=c><p class=x>1"
+    "<span class='B'>2<i>3</i></span></p><p>4<b class=a>5</b></p></section>"
+    "<ul><li class=x>6</li><li id=item><em class=y>7</em></li></ul></div>"
+    "<div class=c><p id=one>8<span>9</span></p><q><s class=x>10</s></q></div>"
+    "<custom-tag class='A z'><p><span class=y>11</span></p></custom-tag>";
+
+static const char *slctrs[] = {
+    "div span", "div > section p", ".a span", ".b .x", "#Main li",
+    "#main li", ".A span", "div .c p span", "section p > span i",
+    "ul > li em", "custom-tag span", "blink span", ".none p", "p ~ p b",
+    "section ~ ul em", "li + li em", ".c q > s", "div p, ul li",
+    "div span, *", "p span, .none i", "#item > .y", ".a.b p.x span",
+    "div :not(.x) > span", "div:has(.y) span", "div *", "* i", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->nodes[found->length++] = node;
+
+    return LXB_STATUS_OK;
+}
+
+/* The nodes below root, as if every one was checked with the list. */
+static lxb_status_t
+match_each(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+           lxb_css_selector_list_t *list, found_t *found)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+
+    found->length = 0;
+    node = root->first_child;
+
+    while (node != NULL) {
+        status = lxb_selectors_match_node(selectors, node, list,
+                                          find_cb, found);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+/*
+ * The ids of the nodes the selector finds below root, separated by spaces.
+ * "(differs)" if matching every node, without the filter, finds others.
+ */
+static const char *
+find_ids(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+         lxb_dom_node_t *root, const char *sel)
+{
+    size_t i, length;
+    lxb_status_t status;
+    const lxb_char_t *id;
+    lxb_css_selector_list_t *list;
+    static found_t expect, result;
+    static char ids[FOUND_MAX * 4];
+
+    list = lxb_css_selectors_parse(parser, (const lxb_char_t *) sel,
+                                   strlen(sel));
+    if (list == NULL) {
+        return "(parse error)";
+    }
+
+    status = match_each(selectors, root, list, &expect);
+    if (status != LXB_STATUS_OK) {
+        return "(match error)";
+    }
+
+    result.length = 0;
+
+    status = lxb_selectors_find(selectors, root, list, find_cb, &result);
+    if (status != LXB_STATUS_OK) {
+        return "(find error)";
+    }
+
+    lxb_css_parser_erase(parser);
+
+    if (expect.length != result.length
+        || memcmp(expect.nodes, result.nodes,
+                  sizeof(lxb_dom_node_t *) * expect.length) != 0)
+    {
+        return "(differs)";
+    }
+
+    ids[0] = '\0';
+
+    for (i = 0; i < result.length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(result.nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+/* Every selector finds the same nodes, in the same order, as matching. */
+static bool
+same_as_match(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+              lxb_dom_node_t *root)
+{
+    bool same;
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    found_t expect, result;
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            return false;
+        }
+
+        status = match_each(selectors, root, list, &expect);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        result.length = 0;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &result);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+
+        same = expect.length == result.length
+               && memcmp(expect.nodes, result.nodes,
+                         sizeof(lxb_dom_node_t *) * expect.length) == 0;
+        if (!same) {
+            TEST_PRINTLN("Differs from matching: %s", *sel);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+TEST_BEGIN(ancestors)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *body, *div, *section;
+    lxb_css_memory_t *memory;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = body->first_child;
+    section = div->first_child;
+
+    /* Ancestors of a subtree root take part too. */
+    test_eq(same_as_match(selectors, parser,
+                          lxb_dom_interface_node(document)), true);
+    test_eq(same_as_match(selectors, parser, div), true);
+    test_eq(same_as_match(selectors, parser, section), true);
+
+    /* Ids and classes are case-insensitive in quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+    test_eq(same_as_match(selectors, parser,
+                          lxb_dom_interface_node(document)), true);
+
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    /* The filter is built for every search. */
+    test_ne(lxb_dom_element_set_attribute(lxb_dom_interface_element(section),
+                                          (const lxb_char_t *) "class", 5,
+                                          (const lxb_char_t *) "none B", 6),
+            NULL);
+    lxb_dom_node_insert_child(body, lxb_dom_node_clone(div, true));
+
+    test_eq(same_as_match(selectors, parser,
+                          lxb_dom_interface_node(document)), true);
+
+    lxb_dom_node_remove(div);
+    test_eq(same_as_match(selectors, parser, div), true);
+
+    lxb_dom_node_destroy_deep(div);
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(expect)
+{
+    size_t i;
+    const char *ids;
+    lxb_status_t status;
+    lxb_dom_node_t *root, *body;
+    lxb_css_memory_t *memory;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t input[] =
+        "<!DOCTYPE html>"
+        "<div id=d1 class=a><section id=s1><p id=p1><span id=n1></span></p>"
+        "</section></div>"
+        "<div id=d2><p id=p2><span id=n2><i id=i1></i></span></p></div>"
+        "<ul id=u1><li id=l1><span id=n3></span></li></ul>";
+
+    static const struct {
+        const char *sel;
+        const char *ids;
+    }
+    expect[] = {
+        {"div span", "n1 n2"},
+        {".a span", "n1"},
+        {"section p > span", "n1"},
+        {"#d2 i", "i1"},
+        {"ul span", "n3"},
+        {"blink span", ""},
+        {"blink span, li", "l1"},
+        {"span", "n1 n2 n3"},
+        {"div span, span", "n1 n1 n2 n2 n3"},
+        {"div :not(.a) span", "n1 n2"}
+    };
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, input, sizeof(input) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+    for (i = 0; i < sizeof(expect) / sizeof(expect[0]); i++) {
+        ids = find_ids(selectors, parser, root, expect[i].sel);
+        test_eq_str(ids, expect[i].ids);
+    }
+
+    /* The ancestors of the root are in the filter. */
+    ids = find_ids(selectors, parser, body->first_child->first_child,
+                   "div span");
+    test_eq_str(ids, "n1");
+
+    ids = find_ids(selectors, parser, body->first_child->next, "div span");
+    test_eq_str(ids, "n2");
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(ancestors);
+    TEST_ADD(expect);
+
+    TEST_RUN("lexbor/selectors/bloom");
+    TEST_RELEASE();
+}
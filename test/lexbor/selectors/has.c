@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/program.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 2048
+
+typedef struct {
+    lxb_dom_node_t *nodes[FOUND_MAX];
+    size_t         length;
+}
+found_t;
+
+
+static const char *slctrs[] = {
+    "div:has(> img)", "div:has(img) span", "div:has(img) div:has(b) span",
+    "p:has(+ p)", "p:has(~ section)", "div:not(:has(img)) > b",
+    ":has(b):has(i) span", "section:has(div > img) i", "div:has(.y, img) b",
+    ":is(div, section):has(i) > span", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->nodes[found->length++] = node;
+
+    return LXB_STATUS_OK;
+}
+
+static const char *
+found_ids(const found_t *found)
+{
+    size_t i, length;
+    const lxb_char_t *id;
+    static char ids[FOUND_MAX * 4];
+
+    ids[0] = '\0';
+
+    for (i = 0; i < found->length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(found->nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+/* Takes the class of the element with id p1 away at the first match. */
+static lxb_status_t
+unclass_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec,
+           void *ctx)
+{
+    lxb_dom_element_t *p1;
+    found_t *found = ctx;
+
+    if (found->length == 0) {
+        p1 = lxb_dom_document_element(node->owner_document);
+        p1 = lxb_dom_element_by_id(p1, (const lxb_char_t *) "p1", 2);
+        if (p1 == NULL) {
+            return LXB_STATUS_ERROR;
+        }
+
+        (void) lxb_dom_element_set_attribute(p1, (const lxb_char_t *) "class",
+                                             5, (const lxb_char_t *) "", 0);
+    }
+
+    return find_cb(node, spec, ctx);
+}
+
+/* Every node below root checked alone, without the cache. */
+static lxb_status_t
+match_each(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+           lxb_css_selector_list_t *list, found_t *found)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+
+    found->length = 0;
+    node = root->first_child;
+
+    while (node != NULL) {
+        status = lxb_selectors_match_node(selectors, node, list,
+                                          find_cb, found);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static bool
+same_found(const found_t *expect, const found_t *result)
+{
+    return expect->length == result->length
+           && memcmp(expect->nodes, result->nodes,
+                     sizeof(lxb_dom_node_t *) * expect->length) == 0;
+}
+
+static bool
+same_as_match(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+              lxb_dom_node_t *root)
+{
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    lxb_selectors_program_t *program;
+    found_t expect, result, compiled;
+
+    program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(program);
+    if (status != LXB_STATUS_OK) {
+        return false;
+    }
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            TEST_PRINTLN("Failed to parse: %s", *sel);
+            return false;
+        }
+
+        status = match_each(selectors, root, list, &expect);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        result.length = 0;
+        compiled.length = 0;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &result);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = lxb_selectors_program_compile(program, list);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = lxb_selectors_program_find(selectors, program, root,
+                                            find_cb, &compiled);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+
+        if (expect.length == 0 || !same_found(&expect, &result)
+            || !same_found(&expect, &compiled))
+        {
+            TEST_PRINTLN("Differs from matching: %s (%zu, %zu, %zu)", *sel,
+                         expect.length, result.length, compiled.length);
+            return false;
+        }
+    }
+
+    (void) lxb_selectors_program_destroy(program, true);
+
+    return true;
+}
+
+static lxb_html_document_t *
+document_make(void)
+{
+    size_t i;
+    lxb_status_t status;
+    lexbor_str_t str;
+    lexbor_mraw_t *mraw;
+    lxb_html_document_t *document;
+
+    static const lexbor_str_t item =
+        lexbor_str("<section><div><div><b>b</b><span>s</span>"
+                   "<div><img><span>s</span></div></div><i>i</i>"
+                   "<span class=y>s</span></div><p>p</p><p>q</p></section>"
+                   "<div><b>b</b><span><i>i</i></span></div><p>r</p>");
+
+    mraw = lexbor_mraw_create();
+    if (lexbor_mraw_init(mraw, 4096) != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    str.data = NULL;
+    str.length = 0;
+
+    if (lexbor_str_init(&str, mraw, 4096) == NULL
+        || lexbor_str_append(&str, mraw,
+                             (const lxb_char_t *) "<!DOCTYPE html>", 15) == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < 100; i++) {
+        if (lexbor_str_append(&str, mraw, item.data, item.length) == NULL) {
+            return NULL;
+        }
+    }
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, str.data, str.length);
+
+    (void) lexbor_mraw_destroy(mraw, true);
+
+    return (status == LXB_STATUS_OK) ? document : NULL;
+}
+
+
+TEST_BEGIN(memo)
+{
+    size_t i;
+    lxb_status_t status;
+    found_t expect, result;
+    lxb_css_selector_list_t *list;
+    lxb_dom_node_t *root, *body;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_html_document_t *document;
+
+    document = document_make();
+    test_ne(document, NULL);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+
+    test_eq(same_as_match(selectors, parser, root), true);
+
+    /* Results of the previous search are not seen by the next one. */
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+    lxb_dom_node_destroy_deep(body->first_child->first_child);
+    lxb_dom_node_insert_child(body, lxb_dom_node_clone(body->first_child,
+                                                       true));
+
+    test_eq(same_as_match(selectors, parser, root), true);
+
+    /* Many searches in one pass. */
+    list = lxb_css_selectors_parse(parser, (const lxb_char_t *) slctrs[1],
+                                   strlen(slctrs[1]));
+    test_ne(list, NULL);
+
+    expect.length = 0;
+
+    status = lxb_selectors_find(selectors, root, list, find_cb, &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_selectors_cache_begin(selectors);
+
+    for (i = 0; i < 3; i++) {
+        result.length = 0;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &result);
+        test_eq(status, LXB_STATUS_OK);
+        test_eq(same_found(&expect, &result), true);
+    }
+
+    lxb_selectors_cache_end(selectors);
+
+    test_eq_size(lxb_selectors_cache_depth(selectors), 0);
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(changes)
+{
+    const char *ids;
+    lxb_status_t status;
+    found_t found;
+    lxb_dom_node_t *root, *img, *d2;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_selector_list_t *has_img, *has_x;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t html[] =
+        "<!DOCTYPE html><div id=d1><img id=i1></div><div id=d2><b id=b1></b>"
+        "</div><div id=d3><p id=p1 class=x><span id=s1></span></p>"
+        "<span id=s2></span></div>";
+
+    static const lxb_char_t sel_img[] = "div:has(img)";
+    static const lxb_char_t sel_x[] = "div:has(.x) span";
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    has_img = lxb_css_selectors_parse(parser, sel_img, sizeof(sel_img) - 1);
+    test_ne(has_img, NULL);
+
+    has_x = lxb_css_selectors_parse(parser, sel_x, sizeof(sel_x) - 1);
+    test_ne(has_x, NULL);
+
+    root = lxb_dom_interface_node(document);
+
+    /* Results kept between cache_begin() and cache_end() follow the tree. */
+    lxb_selectors_cache_begin(selectors);
+
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, root, has_img, find_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "d1");
+
+    img = found.nodes[0]->first_child;
+    d2 = found.nodes[0]->next;
+
+    lxb_dom_node_remove(img);
+    lxb_dom_node_insert_child(d2, img);
+
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, root, has_img, find_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "d2");
+
+    lxb_selectors_cache_end(selectors);
+
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, root, has_x, find_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "s1 s2");
+
+    /* The callback takes the class of p1 away: d3 has no .x for s2. */
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, root, has_x, unclass_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "s1");
+
+    (void) lxb_css_selector_list_destroy_memory(has_x);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(memo);
+    TEST_ADD(changes);
+
+    TEST_RUN("lexbor/selectors/has");
+    TEST_RELEASE();
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/selectors.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 256
+
+typedef struct {
+    lxb_dom_node_t *nodes[FOUND_MAX];
+    size_t         length;
+    size_t         stop;
+}
+found_t;
+
+
+static const lxb_char_t html[] =
+    "<div class='a b'><p class=a>1<span class='B c'>2</span></p>"
+    "<p class='c a a'>3</p><a class=b>4</a></div>"
+    "<div><p>5</p><span class=a>6<p class=b>7</p></span></div>"
+    "<custom-tag class=c><p class='A'>8</p></custom-tag>";
+
+static const char *slctrs[] = {
+    "p", "span", ".a", ".b", ".c", ".A", "p.a", ".a.b", "div p",
+    "div > .a", "span p", ".a ~ a", "p + a", "p, .b", "a, span, .c",
+    "custom-tag p", "custom-tag", "blink", ".none", "p:first-child",
+    "p:not(.a)", "div:has(> .b)", "*", "p, *", ".a, [class]", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->nodes[found->length++] = node;
+
+    if (found->length == found->stop) {
+        return LXB_STATUS_STOP;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+/* Without the index, LXB_SELECTORS_OPT_WALK walks the tree. */
+static lxb_status_t
+find_nodes(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+           lxb_css_selector_list_t *list, found_t *found, bool with_index)
+{
+    lxb_status_t status;
+    lxb_selectors_opt_t opt;
+
+    opt = selectors->options;
+
+    if (!with_index) {
+        lxb_selectors_opt_set(selectors, opt | LXB_SELECTORS_OPT_WALK);
+    }
+
+    found->length = 0;
+
+    status = lxb_selectors_find(selectors, root, list, find_cb, found);
+
+    lxb_selectors_opt_set(selectors, opt);
+
+    return status;
+}
+
+/* The ids of the found elements, separated by spaces. */
+static const char *
+found_ids(const found_t *found)
+{
+    size_t i, length;
+    const lxb_char_t *id;
+    static char ids[FOUND_MAX * 4];
+
+    ids[0] = '\0';
+
+    for (i = 0; i < found->length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(found->nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+static const char *
+find_ids(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+         lxb_dom_node_t *root, const char *sel, bool with_index)
+{
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    static found_t found;
+
+    found.stop = 0;
+
+    list = lxb_css_selectors_parse(parser, (const lxb_char_t *) sel,
+                                   strlen(sel));
+    if (list == NULL) {
+        return "(parse error)";
+    }
+
+    status = find_nodes(selectors, root, list, &found, with_index);
+
+    lxb_css_parser_erase(parser);
+
+    if (status != LXB_STATUS_OK) {
+        return "(find error)";
+    }
+
+    return found_ids(&found);
+}
+
+/* Every selector finds the same nodes, in the same order, as the walk. */
+static bool
+same_as_walk(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+             lxb_dom_node_t *root, size_t stop)
+{
+    bool same;
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    found_t expect, result;
+
+    expect.stop = stop;
+    result.stop = stop;
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            return false;
+        }
+
+        status = find_nodes(selectors, root, list, &expect, false);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = find_nodes(selectors, root, list, &result, true);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+
+        same = expect.length == result.length
+               && memcmp(expect.nodes, result.nodes,
+                         sizeof(lxb_dom_node_t *) * expect.length) == 0;
+        if (!same) {
+            TEST_PRINTLN("Differs from the walk: %s", *sel);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+TEST_BEGIN(find)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *body, *div;
+    lxb_css_memory_t *memory;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = body->first_child;
+
+    /* Document, subtree, root included, first match only. */
+    test_eq(same_as_walk(selectors, parser,
+                         lxb_dom_interface_node(document), 0), true);
+    test_eq(same_as_walk(selectors, parser, div, 0), true);
+    test_eq(same_as_walk(selectors, parser, div, 1), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_MATCH_ROOT
+                                     | LXB_SELECTORS_OPT_MATCH_FIRST);
+
+    test_eq(same_as_walk(selectors, parser, div, 0), true);
+    test_eq(same_as_walk(selectors, parser, body, 0), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_DEFAULT);
+
+    /* Classes are case-insensitive in quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+    test_eq(same_as_walk(selectors, parser,
+                         lxb_dom_interface_node(document), 0), true);
+
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    /* The lists follow the changes of the tree. */
+    lxb_dom_node_insert_child(body, lxb_dom_node_clone(div, true));
+    lxb_dom_node_remove(div->first_child);
+
+    test_ne(lxb_dom_element_set_attribute(lxb_dom_interface_element(div),
+                                          (const lxb_char_t *) "class", 5,
+                                          (const lxb_char_t *) "c", 1), NULL);
+
+    test_eq(same_as_walk(selectors, parser,
+                         lxb_dom_interface_node(document), 0), true);
+
+    /* Detached subtrees are not in the index. */
+    lxb_dom_node_remove(div);
+    test_eq(same_as_walk(selectors, parser, div, 0), true);
+
+    lxb_dom_node_destroy_deep(div);
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(expect)
+{
+    size_t i;
+    const char *ids;
+    lxb_status_t status;
+    lxb_dom_node_t *root, *body;
+    lxb_css_memory_t *memory;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t input[] =
+        "<!DOCTYPE html><div id=d1 class='a b'><p id=p1 class=a></p>"
+        "<span id=s1 class='B c'></span><p id=p2 class='c a'></p>"
+        "<a id=a1 class=b></a></div>"
+        "<div id=d2><p id=p3></p><span id=s2 class=a>"
+        "<p id=p4 class=b></p></span></div>";
+
+    static const struct {
+        const char *sel;
+        const char *ids;
+    }
+    expect[] = {
+        {"p", "p1 p2 p3 p4"},
+        {".a", "d1 p1 p2 s2"},
+        {".b", "d1 a1 p4"},
+        {".B", "s1"},
+        {".c", "s1 p2"},
+        {"p.a", "p1 p2"},
+        {"span p", "p4"},
+        {"div > .a", "p1 p2 s2"},
+        {"p, .b", "d1 p1 p2 a1 p3 p4 p4"},
+        {"a, .none", "a1"},
+        {"blink", ""}
+    };
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, input, sizeof(input) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+    body = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+    for (i = 0; i < sizeof(expect) / sizeof(expect[0]); i++) {
+        ids = find_ids(selectors, parser, root, expect[i].sel, true);
+        test_eq_str(ids, expect[i].ids);
+
+        ids = find_ids(selectors, parser, root, expect[i].sel, false);
+        test_eq_str(ids, expect[i].ids);
+    }
+
+    /* Once for an element found by both selectors. */
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_MATCH_FIRST);
+
+    ids = find_ids(selectors, parser, root, "p, .b", true);
+    test_eq_str(ids, "d1 p1 p2 a1 p3 p4");
+
+    ids = find_ids(selectors, parser, root, "p, .b", false);
+    test_eq_str(ids, "d1 p1 p2 a1 p3 p4");
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_DEFAULT);
+
+    /* Classes are case-insensitive in quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    ids = find_ids(selectors, parser, root, ".B", true);
+    test_eq_str(ids, "d1 s1 a1 p4");
+
+    ids = find_ids(selectors, parser, root, ".B", false);
+    test_eq_str(ids, "d1 s1 a1 p4");
+
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    /* The lists follow the changes of the tree. */
+    lxb_dom_node_remove(body->first_child->first_child);
+
+    ids = find_ids(selectors, parser, root, "p.a", true);
+    test_eq_str(ids, "p2");
+
+    ids = find_ids(selectors, parser, root, "p.a", false);
+    test_eq_str(ids, "p2");
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(find);
+    TEST_ADD(expect);
+
+    TEST_RUN("lexbor/selectors/index");
+    TEST_RELEASE();
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/selectors/lru.h>
+
+#include <unit/test.h>
+
+
+static const lxb_char_t html_first[] =
+    "<!DOCTYPE html><div class=x><p>1<span>2</span></p><p>3</p></div>"
+    "<ul><li class=x>4</li><li>5</li></ul>";
+
+static const lxb_char_t html_second[] =
+    "<!DOCTYPE html><section><p class=x><span>1</span><span>2</span></p>"
+    "</section><div><span class=x>3</span></div>";
+
+
+static lxb_status_t
+count_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    (*(size_t *) ctx)++;
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_selectors_lru_entry_t *
+lru_get(lxb_selectors_lru_t *lru, const char *text)
+{
+    lxb_status_t status;
+    lxb_selectors_lru_entry_t *entry;
+
+    status = lxb_selectors_lru_get(lru, (const lxb_char_t *) text,
+                                   strlen(text), &entry);
+
+    return (status == LXB_STATUS_OK) ? entry : NULL;
+}
+
+static size_t
+count(lxb_selectors_t *selectors, lxb_html_document_t *document,
+      const lxb_css_selector_list_t *list)
+{
+    size_t count = 0;
+
+    if (lxb_selectors_find(selectors, lxb_dom_interface_node(document),
+                           list, count_cb, &count) != LXB_STATUS_OK)
+    {
+        return SIZE_MAX;
+    }
+
+    return count;
+}
+
+
+TEST_BEGIN(get)
+{
+    size_t found;
+    lxb_status_t status;
+    lxb_selectors_t *selectors, *other;
+    lxb_selectors_lru_t *lru;
+    lxb_selectors_lru_entry_t *entry, *again, *held;
+    const lxb_selectors_program_t *program;
+    lxb_html_document_t *first, *second;
+
+    first = lxb_html_document_create();
+    status = lxb_html_document_parse(first, html_first,
+                                     sizeof(html_first) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    second = lxb_html_document_create();
+    status = lxb_html_document_parse(second, html_second,
+                                     sizeof(html_second) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    other = lxb_selectors_create();
+    status = lxb_selectors_init(other);
+    test_eq(status, LXB_STATUS_OK);
+
+    lru = lxb_selectors_lru_create();
+    status = lxb_selectors_lru_init(lru, 2);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Parsed once. */
+
+    entry = lru_get(lru, "p span, .x");
+    test_ne(entry, NULL);
+
+    again = lru_get(lru, "p span, .x");
+    test_eq(again, entry);
+
+    test_eq_size(lru->misses, 1);
+    test_eq_size(lru->hits, 1);
+    test_eq_size(lxb_selectors_lru_length(lru), 1);
+
+    lxb_selectors_lru_release(again);
+
+    /* Any document, any lxb_selectors_t. */
+
+    test_eq_size(count(selectors, first, entry->list), 3);
+    test_eq_size(count(other, second, entry->list), 4);
+    test_eq_size(count(selectors, second, entry->list), 4);
+
+    program = lxb_selectors_lru_program(entry);
+    test_ne(program, NULL);
+    test_eq(lxb_selectors_lru_program(entry), program);
+
+    found = 0;
+
+    status = lxb_selectors_program_find(other, program,
+                                        lxb_dom_interface_node(second),
+                                        count_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(found, 4);
+
+    /* The least recently used goes first. */
+
+    again = lru_get(lru, "li");
+    test_ne(again, NULL);
+    lxb_selectors_lru_release(again);
+
+    again = lru_get(lru, "p span, .x");
+    test_eq(again, entry);
+    lxb_selectors_lru_release(again);
+
+    again = lru_get(lru, "div span");
+    test_ne(again, NULL);
+    lxb_selectors_lru_release(again);
+
+    test_eq_size(lxb_selectors_lru_length(lru), 2);
+    test_eq_size(lru->misses, 3);
+
+    again = lru_get(lru, "p span, .x");
+    test_eq(again, entry);
+    lxb_selectors_lru_release(again);
+
+    test_eq_size(lru->misses, 3);
+
+    again = lru_get(lru, "li");
+    test_ne(again, NULL);
+    lxb_selectors_lru_release(again);
+
+    test_eq_size(lru->misses, 4);
+
+    /* "div span" is dropped, "p span, .x" is dropped but still held. */
+
+    held = lru_get(lru, "section p");
+    test_ne(held, NULL);
+
+    test_eq_size(lxb_selectors_lru_length(lru), 2);
+    test_eq_size(lru->misses, 5);
+
+    test_eq_size(count(selectors, first, entry->list), 3);
+
+    again = lru_get(lru, "p span, .x");
+    test_ne(again, NULL);
+    test_ne(again, entry);
+    lxb_selectors_lru_release(again);
+
+    lxb_selectors_lru_release(entry);
+
+    /* Not a selector list. */
+
+    status = lxb_selectors_lru_get(lru, (const lxb_char_t *) "p >", 3,
+                                   &entry);
+    test_eq(status, LXB_STATUS_ERROR_UNEXPECTED_DATA);
+    test_eq(entry, NULL);
+    test_eq_size(lxb_selectors_lru_length(lru), 2);
+
+    /* Held entries outlive the cache. */
+
+    lxb_selectors_lru_clean(lru);
+    test_eq_size(lxb_selectors_lru_length(lru), 0);
+
+    test_eq_size(count(other, second, held->list), 1);
+
+    (void) lxb_selectors_lru_destroy(lru, true);
+
+    test_eq_size(count(other, second, held->list), 1);
+
+    lxb_selectors_lru_release(held);
+
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_selectors_destroy(other, true);
+    (void) lxb_html_document_destroy(first);
+    (void) lxb_html_document_destroy(second);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(get);
+
+    TEST_RUN("lexbor/selectors/lru");
+    TEST_RELEASE();
+}
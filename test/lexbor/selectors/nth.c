@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/program.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 2048
+
+typedef struct {
+    lxb_dom_node_t *nodes[FOUND_MAX];
+    size_t         length;
+}
+found_t;
+
+
+static const char *slctrs[] = {
+    "li:nth-child(2n+1)", "li:nth-child(4)", "li:nth-last-child(-n+4)",
+    "b:nth-of-type(3n)", "i:nth-last-of-type(2)", "b:first-of-type",
+    "i:last-of-type", "b:only-of-type", "ul > :nth-child(even) b",
+    ":nth-child(odd) > i:nth-of-type(1)", "li:nth-child(2n of .x)", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->nodes[found->length++] = node;
+
+    return LXB_STATUS_OK;
+}
+
+static const char *
+found_ids(const found_t *found)
+{
+    size_t i, length;
+    const lxb_char_t *id;
+    static char ids[FOUND_MAX * 4];
+
+    ids[0] = '\0';
+
+    for (i = 0; i < found->length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(found->nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+/* Takes the first child of the parent out of the tree. */
+static lxb_status_t
+remove_first_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec,
+                void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == 0) {
+        lxb_dom_node_remove(node->parent->first_child);
+    }
+
+    return find_cb(node, spec, ctx);
+}
+
+/* Every node below root checked alone, without the cache. */
+static lxb_status_t
+match_each(lxb_selectors_t *selectors, lxb_dom_node_t *root,
+           lxb_css_selector_list_t *list, found_t *found)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+
+    found->length = 0;
+    node = root->first_child;
+
+    while (node != NULL) {
+        status = lxb_selectors_match_node(selectors, node, list,
+                                          find_cb, found);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (node->first_child != NULL) {
+            node = node->first_child;
+            continue;
+        }
+
+        while (node != root && node->next == NULL) {
+            node = node->parent;
+        }
+
+        if (node == root) {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static bool
+same_as_match(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+              lxb_dom_node_t *root)
+{
+    bool same;
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    lxb_selectors_program_t *program;
+    found_t expect, result, compiled;
+
+    program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(program);
+    if (status != LXB_STATUS_OK) {
+        return false;
+    }
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            return false;
+        }
+
+        status = match_each(selectors, root, list, &expect);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        result.length = 0;
+        compiled.length = 0;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &result);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = lxb_selectors_program_compile(program, list);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = lxb_selectors_program_find(selectors, program, root,
+                                            find_cb, &compiled);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+
+        same = expect.length != 0
+               && expect.length == result.length
+               && memcmp(expect.nodes, result.nodes,
+                         sizeof(lxb_dom_node_t *) * expect.length) == 0
+               && expect.length == compiled.length
+               && memcmp(expect.nodes, compiled.nodes,
+                         sizeof(lxb_dom_node_t *) * expect.length) == 0;
+        if (!same) {
+            TEST_PRINTLN("Differs from matching: %s", *sel);
+            return false;
+        }
+    }
+
+    (void) lxb_selectors_program_destroy(program, true);
+
+    return true;
+}
+
+static lxb_html_document_t *
+document_make(void)
+{
+    size_t i;
+    lxb_status_t status;
+    lexbor_str_t str;
+    lexbor_mraw_t *mraw;
+    lxb_html_document_t *document;
+
+    static const lexbor_str_t item =
+        lexbor_str("<li class=x><b>b</b>t<i>i</i><!-- c --><b>b</b><b>b</b>"
+                   "</li>text<!-- c --><li><i>i</i><i>j</i></li><p><b>p</b></p>");
+
+    mraw = lexbor_mraw_create();
+    if (lexbor_mraw_init(mraw, 4096) != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    str.data = NULL;
+    str.length = 0;
+
+    if (lexbor_str_init(&str, mraw, 4096) == NULL
+        || lexbor_str_append(&str, mraw, (const lxb_char_t *) "<ul>", 4) == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < 150; i++) {
+        if (lexbor_str_append(&str, mraw, item.data, item.length) == NULL) {
+            return NULL;
+        }
+    }
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, str.data, str.length);
+
+    (void) lexbor_mraw_destroy(mraw, true);
+
+    return (status == LXB_STATUS_OK) ? document : NULL;
+}
+
+
+TEST_BEGIN(positions)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *root, *ul;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_html_document_t *document;
+
+    document = document_make();
+    test_ne(document, NULL);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+
+    test_eq(same_as_match(selectors, parser, root), true);
+
+    /* The next search does not see the positions of the previous one. */
+    ul = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    ul = ul->first_child;
+
+    lxb_dom_node_destroy(ul->first_child->next->next->next);
+    lxb_dom_node_insert_child(ul, lxb_dom_node_clone(ul->first_child, true));
+
+    test_eq(same_as_match(selectors, parser, root), true);
+
+    /* Both directions and types from one fill. */
+    lxb_selectors_cache_begin(selectors);
+
+    test_eq_size(lxb_selectors_nth_index(selectors, ul->last_child,
+                                         false, false), 450);
+    test_eq_size(lxb_selectors_nth_index(selectors, ul->last_child,
+                                         false, true), 1);
+    test_eq_size(lxb_selectors_nth_index(selectors, ul->last_child,
+                                         true, false), 300);
+    test_eq_size(lxb_selectors_nth_index(selectors, ul->first_child,
+                                         true, true), 300);
+
+    lxb_selectors_cache_end(selectors);
+
+    test_eq_size(lxb_selectors_cache_depth(selectors), 0);
+    test_eq_size(lxb_selectors_nth_index(selectors, ul->last_child,
+                                         true, false), 300);
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(changes)
+{
+    const char *ids;
+    lxb_status_t status;
+    lxb_dom_node_t *ul, *l1, *l3, *li;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    found_t found;
+
+    static const lxb_char_t html[] =
+        "<!DOCTYPE html><ul id=u><li id=l1>1</li><li id=l2>2</li>"
+        "<li id=l3>3</li><li id=l4>4</li></ul>";
+
+    static const lxb_char_t sel[] = "li:nth-child(2)";
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    ul = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    ul = ul->first_child;
+    l1 = ul->first_child;
+    l3 = l1->next->next;
+
+    /* The positions between cache_begin() and cache_end() follow the tree. */
+    lxb_selectors_cache_begin(selectors);
+
+    test_eq_size(lxb_selectors_nth_index(selectors, l3, false, false), 3);
+    test_eq_size(lxb_selectors_nth_index(selectors, l3, false, true), 2);
+
+    lxb_dom_node_remove(l1);
+
+    test_eq_size(lxb_selectors_nth_index(selectors, l3, false, false), 2);
+    test_eq_size(lxb_selectors_nth_index(selectors, l3, false, true), 2);
+
+    li = lxb_dom_node_clone(l3, false);
+    test_ne(li, NULL);
+
+    lxb_dom_node_insert_after(l3, li);
+
+    test_eq_size(lxb_selectors_nth_index(selectors, l3, false, true), 3);
+    test_eq_size(lxb_selectors_nth_index(selectors, li, false, false), 3);
+
+    lxb_selectors_cache_end(selectors);
+
+    lxb_dom_node_destroy(li);
+    lxb_dom_node_insert_before(ul->first_child, l1);
+
+    list = lxb_css_selectors_parse(parser, sel, sizeof(sel) - 1);
+    test_ne(list, NULL);
+
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, ul, list, find_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "l2");
+
+    /* The callback takes l1 out: l3 is the second child when checked. */
+    found.length = 0;
+
+    status = lxb_selectors_find(selectors, ul, list, remove_first_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    ids = found_ids(&found);
+    test_eq_str(ids, "l2 l3");
+
+    (void) lxb_css_selector_list_destroy_memory(list);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_dom_node_destroy(l1);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(positions);
+    TEST_ADD(changes);
+
+    TEST_RUN("lexbor/selectors/nth");
+    TEST_RELEASE();
+}
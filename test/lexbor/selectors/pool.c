@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/pool.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 4096
+
+typedef struct {
+    lxb_dom_node_t                 *nodes[FOUND_MAX];
+    lxb_css_selector_specificity_t specs[FOUND_MAX];
+    size_t                         length;
+    size_t                         stop;
+}
+found_t;
+
+
+static const char *slctrs[] = {
+    "div span", "section > p", "li:nth-child(2n+1)", "p ~ p b", "li + li",
+    ".x", "#item > .y", "div:has(.y) span", ":not(p) > b", "*",
+    "ul li, p b, div", "section p span i", "blink", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->specs[found->length] = spec;
+    found->nodes[found->length++] = node;
+
+    if (found->length == found->stop) {
+        return LXB_STATUS_STOP;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static bool
+same_found(const found_t *expect, const found_t *result)
+{
+    return expect->length == result->length
+           && memcmp(expect->nodes, result->nodes,
+                     sizeof(lxb_dom_node_t *) * expect->length) == 0
+           && memcmp(expect->specs, result->specs,
+                     sizeof(lxb_css_selector_specificity_t)
+                     * expect->length) == 0;
+}
+
+static const char *
+found_ids(const found_t *found)
+{
+    size_t i, length;
+    const lxb_char_t *id;
+    static char ids[FOUND_MAX * 4];
+
+    ids[0] = '\0';
+
+    for (i = 0; i < found->length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(found->nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+/* The pool finds what lxb_selectors_find() finds, in the same order. */
+static bool
+same_as_find(lxb_selectors_pool_t *pool, lxb_selectors_t *selectors,
+             lxb_css_parser_t *parser, lxb_dom_node_t *root, size_t stop)
+{
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    static found_t expect, result;
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            return false;
+        }
+
+        expect.length = 0;
+        expect.stop = stop;
+        result.length = 0;
+        result.stop = stop;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &expect);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        status = lxb_selectors_pool_find(pool, selectors, root, list,
+                                         find_cb, &result);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+
+        if (!same_found(&expect, &result)) {
+            TEST_PRINTLN("Differs from lxb_selectors_find(): %s (%zu, %zu)",
+                         *sel, expect.length, result.length);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static lxb_html_document_t *
+document_make(void)
+{
+    size_t i;
+    lxb_status_t status;
+    lexbor_str_t str;
+    lexbor_mraw_t *mraw;
+    lxb_html_document_t *document;
+
+    static const lexbor_str_t item =
+        lexbor_str("<div class=x><section><p>1<span>2<i>3</i></span></p>"
+                   "<p>4<b>5</b><b class=x>6</b></p></section><ul><li>7</li>"
+                   "<li id=item><em class=y>8</em></li><li>9</li></ul></div>"
+                   "<p><b>10</b></p>");
+
+    mraw = lexbor_mraw_create();
+    if (lexbor_mraw_init(mraw, 4096) != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    str.data = NULL;
+    str.length = 0;
+
+    if (lexbor_str_init(&str, mraw, 4096) == NULL
+        || lexbor_str_append(&str, mraw,
+                             (const lxb_char_t *) "<!DOCTYPE html>", 15) == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < 100; i++) {
+        if (lexbor_str_append(&str, mraw, item.data, item.length) == NULL) {
+            return NULL;
+        }
+    }
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, str.data, str.length);
+
+    (void) lexbor_mraw_destroy(mraw, true);
+
+    return (status == LXB_STATUS_OK) ? document : NULL;
+}
+
+
+TEST_BEGIN(find)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *root, *div;
+    lxb_selectors_t *selectors;
+    lxb_selectors_pool_t *pool, *single;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_html_document_t *document;
+
+    document = document_make();
+    test_ne(document, NULL);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    pool = lxb_selectors_pool_create();
+    status = lxb_selectors_pool_init(pool, 4);
+    test_eq(status, LXB_STATUS_OK);
+
+    single = lxb_selectors_pool_create();
+    status = lxb_selectors_pool_init(single, 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+    div = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = div->first_child;
+
+    test_eq(same_as_find(pool, selectors, parser, root, 0), true);
+    test_eq(same_as_find(pool, selectors, parser, div, 0), true);
+    test_eq(same_as_find(single, selectors, parser, root, 0), true);
+
+    /* The callback stops the search. */
+    test_eq(same_as_find(pool, selectors, parser, root, 7), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_MATCH_ROOT
+                                     | LXB_SELECTORS_OPT_MATCH_FIRST);
+    test_eq(same_as_find(pool, selectors, parser, div, 0), true);
+    test_eq(selectors->options, LXB_SELECTORS_OPT_MATCH_ROOT
+                                | LXB_SELECTORS_OPT_MATCH_FIRST);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_DEFAULT);
+
+    /* A tree too small to be split. */
+    test_eq(same_as_find(pool, selectors, parser,
+                         div->first_child->first_child, 0), true);
+
+    (void) lxb_selectors_pool_destroy(pool, true);
+    (void) lxb_selectors_pool_destroy(single, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(walk)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *root, *div;
+    lxb_dom_index_t *index;
+    lxb_selectors_t *selectors;
+    lxb_selectors_pool_t *pool;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    static found_t found;
+
+    document = document_make();
+    test_ne(document, NULL);
+
+    status = lxb_dom_document_index_set(&document->dom_document,
+                                        LXB_DOM_INDEX_OPT_TAG
+                                        | LXB_DOM_INDEX_OPT_CLASS);
+    test_eq(status, LXB_STATUS_OK);
+
+    index = document->dom_document.index;
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    pool = lxb_selectors_pool_create();
+    status = lxb_selectors_pool_init(pool, 4);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+    div = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = div->first_child;
+
+    /* The indexed search finds what the walking units find. */
+    test_eq(same_as_find(pool, selectors, parser, root, 0), true);
+    test_eq(same_as_find(pool, selectors, parser, div, 0), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_WALK);
+    test_eq(same_as_find(pool, selectors, parser, root, 0), true);
+
+    /* The units do not build the index again. */
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_DEFAULT);
+    lxb_dom_node_remove(div);
+    test_eq(index->stale, true);
+
+    list = lxb_css_selectors_parse(parser, (const lxb_char_t *) "p b", 3);
+    test_ne(list, NULL);
+
+    found.length = 0;
+    found.stop = 0;
+
+    status = lxb_selectors_pool_find(pool, selectors, root, list,
+                                     find_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(index->stale, true);
+    test_ne_size(found.length, 0);
+
+    test_eq(same_as_find(pool, selectors, parser, root, 0), true);
+
+    (void) lxb_dom_node_destroy_deep(div);
+    (void) lxb_selectors_pool_destroy(pool, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(order)
+{
+    size_t i;
+    const char *ids;
+    lxb_status_t status;
+    lxb_dom_node_t *root;
+    lxb_selectors_t *selectors;
+    lxb_selectors_pool_t *pool;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    static found_t expect, result;
+
+    static const lxb_char_t html[] =
+        "<!DOCTYPE html><div id=a><p id=a1><b id=a2></b></p><p id=a3></p>"
+        "</div><div id=b><p id=b1></p></div><p id=c><b id=c1></b></p>"
+        "<div id=d><div id=d1><p id=d2><b id=d3></b></p></div></div>"
+        "<p id=e></p><div id=f><b id=f1></b><p id=f2></p></div>";
+
+    static const struct {
+        const char *sel;
+        const char *ids;
+    }
+    sels[] = {
+        {"p", "a1 a3 b1 c d2 e f2"},
+        {"div, b", "a a2 b c1 d d1 d3 f f1"},
+        {"div > p", "a1 a3 b1 d2 f2"},
+        {"p b", "a2 c1 d3"},
+        {"div div p b", "d3"},
+        {"blink", ""}
+    };
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    pool = lxb_selectors_pool_create();
+    status = lxb_selectors_pool_init(pool, 4);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+    for (i = 0; i < sizeof(sels) / sizeof(sels[0]); i++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) sels[i].sel,
+                                       strlen(sels[i].sel));
+        test_ne(list, NULL);
+
+        expect.length = 0;
+        expect.stop = 0;
+        result.length = 0;
+        result.stop = 0;
+
+        status = lxb_selectors_find(selectors, root, list, find_cb, &expect);
+        test_eq(status, LXB_STATUS_OK);
+
+        status = lxb_selectors_pool_find(pool, selectors, root, list,
+                                         find_cb, &result);
+        test_eq(status, LXB_STATUS_OK);
+
+        /* The merged results are in document order, as find has them. */
+        ids = found_ids(&result);
+        test_eq_str(ids, sels[i].ids);
+
+        ids = found_ids(&expect);
+        test_eq_str(ids, sels[i].ids);
+
+        lxb_css_parser_erase(parser);
+    }
+
+    (void) lxb_selectors_pool_destroy(pool, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(find);
+    TEST_ADD(walk);
+    TEST_ADD(order);
+
+    TEST_RUN("lexbor/selectors/pool");
+    TEST_RELEASE();
+}
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/program.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 1024
+
+typedef struct {
+    lxb_dom_node_t                 *nodes[FOUND_MAX];
+    lxb_css_selector_specificity_t specs[FOUND_MAX];
+    size_t                         length;
+}
+found_t;
+
+
+static const lxb_char_t html_first[] =
+    "<!DOCTYPE html><div id=Main class='a b' lang=en-US><section class=c>"
+    "<p class=x title='one two'>1<span class='B' data-x=Abc>2<i>3</i></span>"
+    "</p><p>4<b class=a>5</b><!-- c --><b>6</b></p></section>"
+    "<ul><li class=x>7</li><li id=item><em class=y>8</em></li><li>9</li>"
+    "<li align=CENTER>10</li></ul><input type=checkbox checked disabled>"
+    "<a href='http://x.org/a.PDF'>11</a></div><div class=c><p id=one>12"
+    "<span>13</span></p><q><s class=x>14</s></q></div>"
+    "<svg><foreignObject class=a>15</foreignObject></svg><p></p>";
+
+static const lxb_char_t html_second[] =
+    "<p class=X id=main>1<b>2</b><b class='a x'>3</b></p><custom-tag>"
+    "<span class=y>4</span></custom-tag><ul><li>5</li><li>6</li></ul>"
+    "<div lang=en><p title=ONE>7</p></div>";
+
+static const char *slctrs[] = {
+    "div span", "div > section p", ".a span", ".b .x", "#Main li",
+    "#main li", ".A span", ".X b", "section p > span i", "p ~ p b",
+    "section ~ ul em", "li + li", "li ~ li", ".c q > s", "div p, ul li",
+    "*", "div *", "* i", "p.x span", "#item > .y", ".a.b p.x span",
+    "[lang]", "[lang|=en]", "[lang|=EN]", "[title~=two]", "[title~=TWO i]",
+    "[data-x=abc]", "[data-x=abc i]", "[data-x=Abc s]", "[align=center]",
+    "[align=center s]", "[href^=http]", "[href$='.pdf']", "[href$='.pdf' s]",
+    "[href*=x]", "[title='']", "[title^='']", "[nope]", "[title=ONE]",
+    "li:first-child", "li:last-child", "b:first-of-type", "b:last-of-type",
+    "li:nth-child(2n+1)", "li:nth-child(-n+2)", "li:nth-last-child(2)",
+    "b:nth-of-type(2)", "li:nth-last-of-type(odd)", "p:empty", ":root",
+    "input:checked", "input:disabled", "li:only-child", "span:only-of-type",
+    "div :not(.x) > span", "div:has(.y) span", "li:nth-child(odd of .x)",
+    ":is(p, li).x", "foreignObject",
+    "foreignobject.a", "svg > *", "blink", "p, p.x, *",
+    "ul li:nth-child(2) em, section ~ div span", NULL
+};
+
+
+static lxb_status_t
+find_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->specs[found->length] = spec;
+    found->nodes[found->length++] = node;
+
+    return LXB_STATUS_OK;
+}
+
+static bool
+same_found(const found_t *expect, const found_t *result, const char *sel)
+{
+    bool same;
+
+    same = expect->length == result->length
+           && memcmp(expect->nodes, result->nodes,
+                     sizeof(lxb_dom_node_t *) * expect->length) == 0
+           && memcmp(expect->specs, result->specs,
+                     sizeof(lxb_css_selector_specificity_t)
+                     * expect->length) == 0;
+    if (!same) {
+        TEST_PRINTLN("Differs from the interpreter: %s (%zu, %zu)", sel,
+                     expect->length, result->length);
+    }
+
+    return same;
+}
+
+static const char *
+found_ids(const found_t *found)
+{
+    size_t i, length;
+    const lxb_char_t *id;
+    static char ids[FOUND_MAX * 4];
+
+    ids[0] = '\0';
+
+    for (i = 0; i < found->length; i++) {
+        id = lxb_dom_element_id(lxb_dom_interface_element(found->nodes[i]),
+                                &length);
+        if (i != 0) {
+            strcat(ids, " ");
+        }
+
+        strncat(ids, (const char *) id, length);
+    }
+
+    return ids;
+}
+
+/* The ids of the elements the program of the selector finds. */
+static const char *
+program_ids(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+            lxb_selectors_program_t *program, lxb_dom_node_t *root,
+            const char *sel)
+{
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    static found_t found;
+
+    found.length = 0;
+
+    list = lxb_css_selectors_parse(parser, (const lxb_char_t *) sel,
+                                   strlen(sel));
+    if (list == NULL) {
+        return "(parse error)";
+    }
+
+    status = lxb_selectors_program_compile(program, list);
+    if (status == LXB_STATUS_OK) {
+        status = lxb_selectors_program_find(selectors, program, root,
+                                            find_cb, &found);
+    }
+
+    lxb_css_parser_erase(parser);
+
+    if (status != LXB_STATUS_OK) {
+        return "(find error)";
+    }
+
+    return found_ids(&found);
+}
+
+/* The program of every selector finds what lxb_selectors_find() finds. */
+static bool
+same_as_find(lxb_selectors_t *selectors, lxb_css_parser_t *parser,
+             lxb_dom_node_t *root, lxb_dom_node_t *other)
+{
+    const char **sel;
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    lxb_selectors_program_t *program;
+    found_t expect, result;
+
+    program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(program);
+    if (status != LXB_STATUS_OK) {
+        return false;
+    }
+
+    for (sel = slctrs; *sel != NULL; sel++) {
+        list = lxb_css_selectors_parse(parser, (const lxb_char_t *) *sel,
+                                       strlen(*sel));
+        if (list == NULL) {
+            TEST_PRINTLN("Failed to parse: %s", *sel);
+            return false;
+        }
+
+        status = lxb_selectors_program_compile(program, list);
+        if (status != LXB_STATUS_OK) {
+            return false;
+        }
+
+        /* One program for two documents. */
+
+        expect.length = 0;
+        result.length = 0;
+
+        if (lxb_selectors_find(selectors, root, list, find_cb, &expect)
+            != LXB_STATUS_OK
+            || lxb_selectors_program_find(selectors, program, root,
+                                          find_cb, &result) != LXB_STATUS_OK
+            || !same_found(&expect, &result, *sel))
+        {
+            return false;
+        }
+
+        expect.length = 0;
+        result.length = 0;
+
+        if (lxb_selectors_find(selectors, other, list, find_cb, &expect)
+            != LXB_STATUS_OK
+            || lxb_selectors_program_find(selectors, program, other,
+                                          find_cb, &result) != LXB_STATUS_OK
+            || !same_found(&expect, &result, *sel))
+        {
+            return false;
+        }
+
+        lxb_css_parser_erase(parser);
+    }
+
+    (void) lxb_selectors_program_destroy(program, true);
+
+    return true;
+}
+
+
+TEST_BEGIN(compile)
+{
+    lxb_status_t status;
+    lxb_css_selector_list_t *list;
+    lxb_css_parser_t *parser;
+    lxb_selectors_program_t *program;
+
+    static const lxb_char_t sel[] = "div > p.x[title], :not(a), li:nth-child(2n of p)";
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    list = lxb_css_selectors_parse(parser, sel, sizeof(sel) - 1);
+    test_ne(list, NULL);
+
+    program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(program);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_program_compile(program, list);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_size(program->count, 3);
+    test_eq_size(program->fallbacks, 2);
+
+    /* BEGIN, TAG, CLASS, ATTR, CHILD, TAG, END; BEGIN, FALLBACK, END ... */
+    test_eq(program->insts[0].op, LXB_SELECTORS_OP_BEGIN);
+    test_eq_size(program->insts[0].a, 7);
+    test_eq(program->insts[1].op, LXB_SELECTORS_OP_TAG);
+    test_eq(program->insts[2].op, LXB_SELECTORS_OP_CLASS);
+    test_eq(program->insts[3].op, LXB_SELECTORS_OP_ATTR);
+    test_eq(program->insts[4].op, LXB_SELECTORS_OP_CHILD);
+    test_eq(program->insts[5].op, LXB_SELECTORS_OP_TAG);
+    test_eq(program->insts[6].op, LXB_SELECTORS_OP_END);
+    test_eq(program->insts[8].op, LXB_SELECTORS_OP_FALLBACK);
+    test_eq_size(program->length, 13);
+
+    lxb_selectors_program_clean(program);
+    test_eq_size(program->length, 0);
+
+    (void) lxb_selectors_program_destroy(program, true);
+    (void) lxb_css_selector_list_destroy_memory(list);
+    (void) lxb_css_parser_destroy(parser, true);
+}
+TEST_END
+
+TEST_BEGIN(find)
+{
+    lxb_status_t status;
+    lxb_dom_node_t *first, *second, *div;
+    lxb_css_memory_t *memory;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document, *other;
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html_first,
+                                     sizeof(html_first) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    other = lxb_html_document_create();
+    status = lxb_html_document_parse(other, html_second,
+                                     sizeof(html_second) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    first = lxb_dom_interface_node(document);
+    second = lxb_dom_interface_node(other);
+    div = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = div->first_child;
+
+    test_eq(same_as_find(selectors, parser, first, second), true);
+    test_eq(same_as_find(selectors, parser, div, second), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_MATCH_ROOT
+                                     | LXB_SELECTORS_OPT_MATCH_FIRST);
+    test_eq(same_as_find(selectors, parser, div, second), true);
+
+    lxb_selectors_opt_set(selectors, LXB_SELECTORS_OPT_DEFAULT);
+
+    /* Ids and classes are case-insensitive in quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+    test_eq(same_as_find(selectors, parser, first, second), true);
+
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+    (void) lxb_html_document_destroy(other);
+}
+TEST_END
+
+TEST_BEGIN(expect)
+{
+    size_t i;
+    const char *ids;
+    lxb_status_t status;
+    lxb_dom_node_t *root;
+    lxb_dom_element_t *element, *body;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_html_document_t *document;
+    lxb_selectors_program_t *program;
+
+    static const lxb_char_t html[] =
+        "<!DOCTYPE html><div id=d1 class=a><p id=p1 class='x y'>"
+        "<span id=s1>1</span></p><p id=p2><b id=b1 class=y>2</b></p></div>"
+        "<ul id=u1><li id=l1>3</li><li id=l2 class=x>4</li>"
+        "<li id=l3>5</li></ul>";
+
+    static const struct {
+        const char *sel;
+        const char *ids;
+    }
+    expect[] = {
+        {"p", "p1 p2"},
+        {".y", "p1 b1"},
+        {"div .y", "p1 b1"},
+        {"p.x > span", "s1"},
+        {"#P1", ""},
+        {"li:nth-child(odd)", "l1 l3"},
+        {"li.x + li", "l3"},
+        {"div > p ~ p b", "b1"},
+        {"li:not(.x)", "l1 l3"},
+        {"ul, .a", "d1 u1"},
+        {".z", ""}
+    };
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    program = lxb_selectors_program_create();
+    status = lxb_selectors_program_init(program);
+    test_eq(status, LXB_STATUS_OK);
+
+    root = lxb_dom_interface_node(document);
+
+    for (i = 0; i < sizeof(expect) / sizeof(expect[0]); i++) {
+        ids = program_ids(selectors, parser, program, root, expect[i].sel);
+        test_eq_str(ids, expect[i].ids);
+    }
+
+    /* A class new to the document is found by the next search. */
+    body = lxb_dom_interface_element(lxb_html_document_body_element(document));
+    element = lxb_dom_element_by_id(body, (const lxb_char_t *) "l1", 2);
+    test_ne(element, NULL);
+
+    (void) lxb_dom_element_set_attribute(element, (const lxb_char_t *) "class",
+                                         5, (const lxb_char_t *) "z", 1);
+
+    ids = program_ids(selectors, parser, program, root, ".z");
+    test_eq_str(ids, "l1");
+
+    ids = program_ids(selectors, parser, program, root, "li:not(.x)");
+    test_eq_str(ids, "l1 l3");
+
+    (void) lxb_selectors_program_destroy(program, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(compile);
+    TEST_ADD(find);
+    TEST_ADD(expect);
+
+    TEST_RUN("lexbor/selectors/program");
+    TEST_RELEASE();
+}
@@ -915,6 +915,165 @@ TEST_BEGIN(match_first)
 }
 TEST_END
 
+static lxb_status_t
+find_callback_first(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec,
+                    void *ctx)
+{
+    *((lxb_dom_node_t **) ctx) = node;
+
+    return LXB_STATUS_STOP;
+}
+
+TEST_BEGIN(find_limit)
+{
+    size_t count, total;
+    lxb_status_t status;
+    lxb_dom_node_t *node, *first, *found;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *parser;
+    lxb_css_selector_list_t *list, *nested;
+    lxb_html_document_t *document;
+
+    static const lexbor_str_t slctrs = lexbor_str("div p, span");
+    static const lexbor_str_t nested_slctrs =
+    lexbor_str("div:has(span) :not(a) > span:not(#s3)");
+
+    /* Create HTML Document. */
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Create CSS parser. */
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Selectors. */
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    list = lxb_css_selectors_parse(parser, slctrs.data, slctrs.length);
+    test_ne(list, NULL);
+
+    node = lxb_dom_interface_node(document);
+
+    total = 0;
+
+    status = lxb_selectors_find(selectors, node, list,
+                                find_callback_count, &total);
+    test_eq(status, LXB_STATUS_OK);
+    test_ne_size(total, 0);
+
+    /* Cut off. */
+
+    count = 0;
+
+    status = lxb_selectors_find_limit(selectors, node, list, 3,
+                                      find_callback_count, &count);
+    test_eq(status, LXB_STATUS_STOPPED);
+    test_eq_size(count, 3);
+
+    /* Fewer matches than the limit. */
+
+    count = 0;
+
+    status = lxb_selectors_find_limit(selectors, node, list, total + 1,
+                                      find_callback_count, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, total);
+
+    /* No limit. */
+
+    count = 0;
+
+    status = lxb_selectors_find_limit(selectors, node, list, 0,
+                                      find_callback_count, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, total);
+
+    /* The limit does not outlive the call. */
+
+    count = 0;
+
+    status = lxb_selectors_find(selectors, node, list,
+                                find_callback_count, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, total);
+
+    /* The first node, as the callback stopping the search gives. */
+
+    first = NULL;
+
+    status = lxb_selectors_find(selectors, node, list,
+                                find_callback_first, &first);
+    test_eq(status, LXB_STATUS_OK);
+    test_ne(first, NULL);
+
+    status = lxb_selectors_find_first(selectors, node, list, &found);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(found, first);
+
+    /* Stopped by the callback before the limit. */
+
+    first = NULL;
+
+    status = lxb_selectors_find_limit(selectors, node, list, 5,
+                                      find_callback_first, &first);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(first, found);
+
+    /* Nested searches. */
+
+    nested = lxb_css_selectors_parse(parser, nested_slctrs.data,
+                                     nested_slctrs.length);
+    test_ne(nested, NULL);
+
+    total = 0;
+
+    status = lxb_selectors_find(selectors, node, nested,
+                                find_callback_count, &total);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(total > 2, true);
+
+    count = 0;
+
+    status = lxb_selectors_find_limit(selectors, node, nested, 2,
+                                      find_callback_count, &count);
+    test_eq(status, LXB_STATUS_STOPPED);
+    test_eq_size(count, 2);
+
+    first = NULL;
+
+    status = lxb_selectors_find(selectors, node, nested,
+                                find_callback_first, &first);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_find_first(selectors, node, nested, &found);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(found, first);
+
+    /* Nothing found. */
+
+    node = lxb_dom_interface_node(lxb_html_document_head_element(document));
+
+    found = node;
+
+    status = lxb_selectors_find_first(selectors, node, list, &found);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(found, NULL);
+
+    /* Both lists are in the memory of the parser. */
+    (void) lxb_css_selector_list_destroy_memory(list);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
 TEST_BEGIN(match_id_class_case)
 {
     size_t count;
@@ -1284,6 +1443,7 @@ main(int argc, const char * argv[])
     TEST_ADD(match_root);
     TEST_ADD(match_root_document);
     TEST_ADD(match_first);
+    TEST_ADD(find_limit);
     TEST_ADD(match_id_class_case);
     TEST_ADD(match_non_ascii_ident_class);
     TEST_ADD(match_attribute_include_empty);
@@ -0,0 +1,427 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/set.h>
+
+#include <unit/test.h>
+
+
+#define LISTS_MAX 512
+
+typedef struct {
+    lxb_selectors_set_t     *set;
+    lxb_selectors_t         *selectors;
+    lxb_css_selector_list_t *lists[LISTS_MAX];
+    size_t                  elements;
+    bool                    same;
+}
+context_t;
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><div id=Main class='a b' lang=en-US><section class=c>"
+    "<p class=x title='one two'>1<span class='B' data-x=Abc>2<i>3</i></span>"
+    "</p><p>4<b class=a>5</b><!-- c --><b>6</b></p></section>"
+    "<ul><li class=x>7</li><li id=item><em class=y>8</em></li><li>9</li>"
+    "<li align=CENTER>10</li></ul><input type=checkbox checked disabled>"
+    "<a href='http://x.org/a.PDF'>11</a></div><div class=c><p id=one>12"
+    "<span>13</span></p><q><s class=x>14</s></q></div>"
+    "<svg><foreignObject class=a>15</foreignObject></svg><p></p>";
+
+static const char *slctrs[] = {
+    "div span", "div > section p", ".a span", ".b .x", "#Main li",
+    "#main li", ".A span", ".X b", "section p > span i", "p ~ p b",
+    "section ~ ul em", "li + li", "li ~ li", ".c q > s", "div p, ul li",
+    "*", "div *", "* i", "p.x span", "#item > .y", ".a.b p.x span",
+    "[lang]", "[lang|=en]", "[title~=two]", "[data-x=abc i]",
+    "[align=center]", "[href$='.pdf']", "li:first-child", "li:last-child",
+    "b:first-of-type", "li:nth-child(2n+1)", "li:nth-last-child(2)",
+    "p:empty", ":root", "input:checked", "li:only-child",
+    "div :not(.x) > span", "div:has(.y) span", "li:nth-child(odd of .x)",
+    ":is(p, li).x", "foreignObject", "svg > *", "blink", "p, p.x, *",
+    "div > section p span", "div > section p i", "section p, section b",
+    "ul li:nth-child(2) em, section ~ div span", "li", "li, li", NULL
+};
+
+
+static lxb_status_t
+found_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    *((bool *) ctx) = true;
+
+    return LXB_STATUS_OK;
+}
+
+/* The bitmap is the same as matching every list alone. */
+static lxb_status_t
+check_cb(lxb_dom_node_t *node, const uint64_t *bits, void *ctx)
+{
+    bool found;
+    size_t i;
+    lxb_status_t status;
+    context_t *context = ctx;
+
+    context->elements++;
+
+    for (i = 0; i < lxb_selectors_set_length(context->set); i++) {
+        found = false;
+
+        status = lxb_selectors_match_node(context->selectors, node,
+                                          context->lists[i], found_cb, &found);
+        if (status != LXB_STATUS_OK) {
+            return status;
+        }
+
+        if (found != lxb_selectors_set_bit(bits, i)) {
+            TEST_PRINTLN("Differs from matching: list %zu", i);
+
+            context->same = false;
+            return LXB_STATUS_STOP;
+        }
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+count_cb(lxb_dom_node_t *node, const uint64_t *bits, void *ctx)
+{
+    (*(size_t *) ctx)++;
+
+    return LXB_STATUS_OK;
+}
+
+
+TEST_BEGIN(match)
+{
+    char buf[64];
+    size_t i, count, elements;
+    lxb_status_t status;
+    lxb_dom_node_t *root, *node;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    const uint64_t *bits;
+    lxb_html_document_t *document;
+    context_t context;
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, html, sizeof(html) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    context.selectors = lxb_selectors_create();
+    status = lxb_selectors_init(context.selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    context.set = lxb_selectors_set_create();
+    status = lxb_selectors_set_init(context.set);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; slctrs[i] != NULL; i++) {
+        context.lists[i] = lxb_css_selectors_parse(parser,
+                                                   (const lxb_char_t *) slctrs[i],
+                                                   strlen(slctrs[i]));
+        test_ne(context.lists[i], NULL);
+
+        status = lxb_selectors_set_append(context.set, context.lists[i]);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    /* Many lists that share their last compounds. */
+    for (; i < LISTS_MAX; i++) {
+        snprintf(buf, sizeof(buf), (i % 2) ? ".c%zu span" : "p > span.B.c%zu",
+                 i);
+
+        context.lists[i] = lxb_css_selectors_parse(parser,
+                                                   (const lxb_char_t *) buf,
+                                                   strlen(buf));
+        test_ne(context.lists[i], NULL);
+
+        status = lxb_selectors_set_append(context.set, context.lists[i]);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    test_eq_size(lxb_selectors_set_length(context.set), LISTS_MAX);
+    test_eq_size(lxb_selectors_set_words(context.set), LISTS_MAX / 64);
+    test_ne_size(context.set->shared, 0);
+
+    root = lxb_dom_interface_node(document);
+
+    context.elements = 0;
+    context.same = true;
+
+    status = lxb_selectors_set_find(context.set, context.selectors, root,
+                                    check_cb, &context);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(context.same, true);
+    test_ne_size(context.elements, 0);
+
+    elements = context.elements;
+
+    /* Ids and classes are case-insensitive in quirks mode. */
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+
+    context.elements = 0;
+
+    status = lxb_selectors_set_find(context.set, context.selectors, root,
+                                    check_cb, &context);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(context.same, true);
+
+    document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_NO_QUIRKS;
+
+    /* One element. */
+    node = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    node = node->first_child->first_child->first_child->first_child->next;
+
+    status = lxb_selectors_set_bind(context.set, context.selectors,
+                                    &document->dom_document);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_set_match_node(context.set, context.selectors,
+                                          node, &bits);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq(lxb_selectors_set_bit(bits, 0), true);   /* div span */
+    test_eq(lxb_selectors_set_bit(bits, 1), false);  /* div > section p */
+    test_eq(lxb_selectors_set_bit(bits, 6), false);  /* .A span */
+
+    status = check_cb(node, bits, &context);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq(context.same, true);
+
+    /* Every element matches "*". */
+    count = 0;
+
+    status = lxb_selectors_set_find(context.set, context.selectors, root,
+                                    count_cb, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, elements);
+
+    lxb_selectors_set_clean(context.set);
+    test_eq_size(lxb_selectors_set_length(context.set), 0);
+
+    count = 0;
+
+    status = lxb_selectors_set_find(context.set, context.selectors, root,
+                                    count_cb, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, 0);
+
+    (void) lxb_selectors_set_destroy(context.set, true);
+    (void) lxb_selectors_destroy(context.selectors, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(documents)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_dom_node_t *node, *other;
+    lxb_css_parser_t *parser;
+    lxb_css_selector_list_t *x, *y;
+    const uint64_t *bits;
+    lxb_html_document_t *document, *cleaned;
+    lxb_selectors_t *selectors;
+    lxb_selectors_set_t *set;
+
+    static const lxb_char_t px[] = "<p class=x>";
+    static const lxb_char_t py[] = "<p class=y>";
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    x = lxb_css_selectors_parse(parser, (const lxb_char_t *) ".x", 2);
+    test_ne(x, NULL);
+
+    y = lxb_css_selectors_parse(parser, (const lxb_char_t *) ".y", 2);
+    test_ne(y, NULL);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    set = lxb_selectors_set_create();
+    status = lxb_selectors_set_init(set);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_set_append(set, x);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_set_append(set, y);
+    test_eq(status, LXB_STATUS_OK);
+
+    cleaned = lxb_html_document_create();
+    test_ne(cleaned, NULL);
+
+    /*
+     * Documents with as many names as the one before, likely at its
+     * address, and one document cleaned in between: the set is told.
+     */
+    for (i = 0; i < 8; i++) {
+        if (i < 4) {
+            document = lxb_html_document_create();
+            test_ne(document, NULL);
+        }
+        else {
+            document = cleaned;
+            lxb_html_document_clean(document);
+        }
+
+        lxb_selectors_set_unbind(set);
+
+        if (i % 2 == 0) {
+            status = lxb_html_document_parse(document, px, sizeof(px) - 1);
+        }
+        else {
+            status = lxb_html_document_parse(document, py, sizeof(py) - 1);
+        }
+
+        test_eq(status, LXB_STATUS_OK);
+
+        node = lxb_dom_interface_node(lxb_html_document_body_element(document));
+
+        status = lxb_selectors_set_match_node(set, selectors, node->first_child,
+                                              &bits);
+        test_eq(status, LXB_STATUS_OK);
+
+        test_eq(lxb_selectors_set_bit(bits, 0), i % 2 == 0);
+        test_eq(lxb_selectors_set_bit(bits, 1), i % 2 == 1);
+
+        if (i < 4) {
+            (void) lxb_html_document_destroy(document);
+        }
+    }
+
+    /* Two live documents in turns, told apart by their name tables. */
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse(document, px, sizeof(px) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    node = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    other = lxb_dom_interface_node(lxb_html_document_body_element(cleaned));
+
+    for (i = 0; i < 4; i++) {
+        status = lxb_selectors_set_match_node(set, selectors, node->first_child,
+                                              &bits);
+        test_eq(status, LXB_STATUS_OK);
+        test_eq(lxb_selectors_set_bit(bits, 0), true);
+        test_eq(lxb_selectors_set_bit(bits, 1), false);
+
+        status = lxb_selectors_set_match_node(set, selectors,
+                                              other->first_child, &bits);
+        test_eq(status, LXB_STATUS_OK);
+        test_eq(lxb_selectors_set_bit(bits, 0), false);
+        test_eq(lxb_selectors_set_bit(bits, 1), true);
+    }
+
+    (void) lxb_html_document_destroy(document);
+    (void) lxb_html_document_destroy(cleaned);
+    (void) lxb_selectors_set_destroy(set, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_css_selector_list_destroy_memory(x);  /* And y. */
+    (void) lxb_css_parser_destroy(parser, true);
+}
+TEST_END
+
+TEST_BEGIN(turns)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_dom_node_t *node;
+    lxb_css_parser_t *parser;
+    lxb_css_selector_list_t *x, *y;
+    const uint64_t *bits;
+    lxb_html_document_t *document;
+    lxb_selectors_t *selectors;
+    lxb_selectors_set_t *first, *second;
+
+    static const lxb_char_t p[] = "<p class=x>";
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    x = lxb_css_selectors_parse(parser, (const lxb_char_t *) ".x", 2);
+    test_ne(x, NULL);
+
+    y = lxb_css_selectors_parse(parser, (const lxb_char_t *) "p", 1);
+    test_ne(y, NULL);
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    first = lxb_selectors_set_create();
+    status = lxb_selectors_set_init(first);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_set_append(first, x);
+    test_eq(status, LXB_STATUS_OK);
+
+    second = lxb_selectors_set_create();
+    status = lxb_selectors_set_init(second);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_set_append(second, y);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = lxb_html_document_create();
+    test_ne(document, NULL);
+
+    status = lxb_html_document_parse(document, p, sizeof(p) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    node = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    node = node->first_child;
+
+    /* Sets taking turns on one document look the names up once each. */
+    for (i = 0; i < 4; i++) {
+        status = lxb_selectors_set_match_node(first, selectors, node, &bits);
+        test_eq(status, LXB_STATUS_OK);
+        test_eq(lxb_selectors_set_bit(bits, 0), true);
+
+        status = lxb_selectors_set_match_node(second, selectors, node, &bits);
+        test_eq(status, LXB_STATUS_OK);
+        test_eq(lxb_selectors_set_bit(bits, 0), true);
+    }
+
+    (void) lxb_html_document_destroy(document);
+    (void) lxb_selectors_set_destroy(first, true);
+    (void) lxb_selectors_set_destroy(second, true);
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_css_selector_list_destroy_memory(x);  /* And y. */
+    (void) lxb_css_parser_destroy(parser, true);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(match);
+    TEST_ADD(documents);
+    TEST_ADD(turns);
+
+    TEST_RUN("lexbor/selectors/set");
+    TEST_RELEASE();
+}
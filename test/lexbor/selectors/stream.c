@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/html/html.h>
+#include <lexbor/css/css.h>
+#include <lexbor/selectors/stream.h>
+
+#include <unit/test.h>
+
+
+#define FOUND_MAX 256
+
+typedef struct {
+    lxb_dom_node_t *nodes[FOUND_MAX];
+    uint64_t       bits[FOUND_MAX];
+    size_t         length;
+    size_t         stop;    /* Id of the list that stops the parsing. */
+}
+found_t;
+
+
+static const lxb_char_t html[] =
+    "<!DOCTYPE html><html lang=en><head><title>T</title>"
+    "<meta name=description content=d><meta charset=utf-8></head>"
+    "<body><div class=x><p>1<span>2</span></p><p id=two>3</p></div>"
+    "<ul><li>4</li><li class=x>5<span>6</span></li><li>7</li></ul>"
+    "<table><tr><td>8</td></tr></table></body></html>";
+
+static const char *slctrs[] = {
+    "title", "meta[name]", "div > p", "li:nth-child(2)", "p + p",
+    ":not(.x) > span", "html[lang|=en] li ~ li", "td",
+    "li:nth-child(odd of .x, li)", ":is(head, body) > *", NULL
+};
+
+
+static lxb_status_t
+found_cb(lxb_dom_node_t *node, const uint64_t *bits, void *ctx)
+{
+    found_t *found = ctx;
+
+    if (found->length == FOUND_MAX) {
+        return LXB_STATUS_ERROR_OVERFLOW;
+    }
+
+    found->nodes[found->length] = node;
+    found->bits[found->length++] = bits[0];
+
+    if (found->stop != SIZE_MAX && lxb_selectors_set_bit(bits, found->stop)) {
+        return LXB_STATUS_STOP;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_status_t
+count_cb(lxb_dom_node_t *node, lxb_css_selector_specificity_t spec, void *ctx)
+{
+    (*(size_t *) ctx)++;
+
+    return LXB_STATUS_OK;
+}
+
+/* Counts the elements reported with a child or a following sibling. */
+static lxb_status_t
+early_cb(lxb_dom_element_t *element, void *ctx)
+{
+    lxb_dom_node_t *node = lxb_dom_interface_node(element);
+
+    if (node->first_child != NULL
+        || (node->next != NULL && node->next->local_name != LXB_TAG_TABLE))
+    {
+        (*(size_t *) ctx)++;
+    }
+
+    return LXB_STATUS_OK;
+}
+
+static lxb_css_selector_list_t *
+list_parse(lxb_css_parser_t *parser, const char *text)
+{
+    return lxb_css_selectors_parse(parser, (const lxb_char_t *) text,
+                                   strlen(text));
+}
+
+
+TEST_BEGIN(build)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_dom_node_t *root;
+    lxb_html_parser_t *parser;
+    lxb_css_parser_t *css_parser;
+    lxb_css_memory_t *memory;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    lxb_selectors_stream_t *stream;
+    static found_t found, expect;
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    css_parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(css_parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(css_parser, memory);
+
+    stream = lxb_selectors_stream_create();
+    status = lxb_selectors_stream_init(stream, found_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; slctrs[i] != NULL; i++) {
+        list = list_parse(css_parser, slctrs[i]);
+        test_ne(list, NULL);
+
+        status = lxb_selectors_stream_append(stream, list);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_tree_callback_element_set(lxb_html_parser_tree(parser),
+                                       lxb_selectors_stream_element, stream);
+
+    /* Matched while parsing the same as after. */
+
+    found.length = 0;
+    found.stop = SIZE_MAX;
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_OK);
+
+    expect.length = 0;
+    expect.stop = SIZE_MAX;
+
+    root = lxb_dom_interface_node(document);
+
+    status = lxb_selectors_set_find(stream->set, stream->selectors, root,
+                                    found_cb, &expect);
+    test_eq(status, LXB_STATUS_OK);
+
+    test_eq_size(found.length, expect.length);
+    test_eq_size(found.length, 13);
+
+    for (i = 0; i < found.length; i++) {
+        test_eq(found.nodes[i], expect.nodes[i]);
+        test_eq(found.bits[i] == expect.bits[i], true);
+    }
+
+    (void) lxb_html_document_destroy(document);
+
+    /* Stop after the first <meta>: nothing after it is parsed. */
+
+    found.length = 0;
+    found.stop = 1;
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_STOPPED);
+
+    test_eq_size(found.length, 2);
+    test_eq(lxb_html_document_body_element(document), NULL);
+    test_ne(lxb_html_document_head_element(document), NULL);
+
+    (void) lxb_html_document_destroy(document);
+
+    /* The tree callback stays for the next document. */
+
+    found.length = 0;
+    found.stop = SIZE_MAX;
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+    test_eq_size(found.length, expect.length);
+
+    (void) lxb_html_document_destroy(document);
+
+    lxb_html_tree_callback_element_set(lxb_html_parser_tree(parser),
+                                       NULL, NULL);
+
+    found.length = 0;
+
+    document = lxb_html_parse(parser, html, sizeof(html) - 1);
+    test_ne(document, NULL);
+    test_eq_size(found.length, 0);
+
+    (void) lxb_html_document_destroy(document);
+
+    (void) lxb_html_parser_destroy(parser);
+    (void) lxb_selectors_stream_destroy(stream, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(css_parser, true);
+}
+TEST_END
+
+TEST_BEGIN(misnested)
+{
+    size_t count;
+    lxb_status_t status;
+    lxb_selectors_t *selectors;
+    lxb_css_parser_t *css_parser;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    lxb_selectors_stream_t *stream;
+    static found_t found;
+
+    static const lxb_char_t misnested[] =
+        "<!DOCTYPE html><b>1<i>2<p>3</b>4</i>5</p><table><b>6</b><tr>"
+        "<td>7</td></tr></table>";
+
+    css_parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(css_parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    list = list_parse(css_parser, "b, i");
+    test_ne(list, NULL);
+
+    stream = lxb_selectors_stream_create();
+    status = lxb_selectors_stream_init(stream, found_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_selectors_stream_append(stream, list);
+    test_eq(status, LXB_STATUS_OK);
+
+    found.length = 0;
+    found.stop = SIZE_MAX;
+
+    /* The document parser. */
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse_chunk_begin(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_tree_callback_element_set(
+        lxb_html_parser_tree(document->dom_document.parser),
+        lxb_selectors_stream_element, stream);
+
+    status = lxb_html_document_parse_chunk(document, misnested,
+                                           sizeof(misnested) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_document_parse_chunk_end(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Every element made by the parser is reported once. */
+
+    selectors = lxb_selectors_create();
+    status = lxb_selectors_init(selectors);
+    test_eq(status, LXB_STATUS_OK);
+
+    count = 0;
+
+    status = lxb_selectors_find(selectors, lxb_dom_interface_node(document),
+                                list, count_cb, &count);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(count, found.length);
+    test_eq(count > 3, true);
+
+    (void) lxb_selectors_destroy(selectors, true);
+    (void) lxb_html_document_destroy(document);
+    (void) lxb_selectors_stream_destroy(stream, true);
+    (void) lxb_css_selector_list_destroy_memory(list);
+    (void) lxb_css_parser_destroy(css_parser, true);
+}
+TEST_END
+
+TEST_BEGIN(adoption)
+{
+    size_t count;
+    lxb_status_t status;
+    lxb_dom_node_t *div;
+    lxb_html_document_t *document;
+
+    static const lxb_char_t misnested[] =
+        "<!DOCTYPE html><b>1<u>2<i>3<div>4</b>5</div>"
+        "<table><s>6<td>7</s>8</td></table>";
+
+    document = lxb_html_document_create();
+    status = lxb_html_document_parse_chunk_begin(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* The clones of the adoption agency algorithm are reported empty. */
+    count = 0;
+
+    lxb_html_tree_callback_element_set(
+        lxb_html_parser_tree(document->dom_document.parser),
+        early_cb, &count);
+
+    status = lxb_html_document_parse_chunk(document, misnested,
+                                           sizeof(misnested) - 1);
+    test_eq(status, LXB_STATUS_OK);
+
+    status = lxb_html_document_parse_chunk_end(document);
+    test_eq(status, LXB_STATUS_OK);
+
+    /* Only the new <b>, with the "4" of the <div>. */
+    test_eq_size(count, 1);
+
+    /* The <div> went into clones of <u> and <i>. */
+    div = lxb_dom_interface_node(lxb_html_document_body_element(document));
+    div = div->last_child->first_child->first_child;
+
+    test_eq(div->local_name, LXB_TAG_DIV);
+    test_eq(div->parent->local_name, LXB_TAG_I);
+    test_eq(div->parent->parent->local_name, LXB_TAG_U);
+
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+TEST_BEGIN(names)
+{
+    size_t i, length;
+    lxb_status_t status;
+    lxb_html_parser_t *parser;
+    lxb_css_parser_t *css_parser;
+    lxb_css_memory_t *memory;
+    lxb_css_selector_list_t *list;
+    lxb_html_document_t *document;
+    lxb_selectors_stream_t *stream;
+    char text[32];
+    static found_t found;
+    static lxb_char_t page[16384];
+
+    static const char *late[] = {
+        ".late", "x-late", "[data-late]", "p.c7", NULL
+    };
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    css_parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(css_parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(css_parser, memory);
+
+    stream = lxb_selectors_stream_create();
+    status = lxb_selectors_stream_init(stream, found_cb, &found);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; late[i] != NULL; i++) {
+        list = list_parse(css_parser, late[i]);
+        test_ne(list, NULL);
+
+        status = lxb_selectors_stream_append(stream, list);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    /* Names the page never has. */
+    for (i = 0; i < 100; i++) {
+        sprintf(text, ".absent%zu, absent-%zu", i, i);
+
+        list = list_parse(css_parser, text);
+        test_ne(list, NULL);
+
+        status = lxb_selectors_stream_append(stream, list);
+        test_eq(status, LXB_STATUS_OK);
+    }
+
+    /* A new class name for every element, the late names at the end. */
+    length = sprintf((char *) page, "<!DOCTYPE html><body>");
+
+    for (i = 0; i < 300; i++) {
+        length += sprintf((char *) page + length, "<p class=c%zu>", i);
+    }
+
+    length += sprintf((char *) page + length,
+                      "<x-late class=late data-late></x-late>");
+
+    parser = lxb_html_parser_create();
+    status = lxb_html_parser_init(parser);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_html_tree_callback_element_set(lxb_html_parser_tree(parser),
+                                       lxb_selectors_stream_element, stream);
+
+    found.length = 0;
+    found.stop = SIZE_MAX;
+
+    document = lxb_html_parse(parser, page, length);
+    test_ne(document, NULL);
+    test_eq(lxb_html_parser_status(parser), LXB_STATUS_OK);
+
+    /* p.c7 and x-late, by all three of its lists. */
+    test_eq_size(found.length, 2);
+    test_ne(found.nodes[1]->local_name, LXB_TAG_P);
+    test_eq(found.bits[1] & 0x07, 0x07);
+
+    /* Only the names the document never got are left unbound. */
+    test_eq_size(stream->set->unbound_length, 200);
+
+    (void) lxb_html_document_destroy(document);
+
+    /* A new document is looked up in full again. */
+    lxb_selectors_set_unbind(stream->set);
+
+    found.length = 0;
+
+    document = lxb_html_parse(parser, page, length);
+    test_ne(document, NULL);
+    test_eq_size(found.length, 2);
+    test_ne(found.nodes[1]->local_name, LXB_TAG_P);
+    test_eq(found.bits[1] & 0x07, 0x07);
+
+    (void) lxb_html_document_destroy(document);
+
+    (void) lxb_html_parser_destroy(parser);
+    (void) lxb_selectors_stream_destroy(stream, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(css_parser, true);
+}
+TEST_END
+
+TEST_BEGIN(supported)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_css_parser_t *parser;
+    lxb_css_memory_t *memory;
+    lxb_css_selector_list_t *list;
+    lxb_selectors_stream_t *stream;
+
+    static const char *yes[] = {
+        "div p", "a > b + c ~ d", "li:nth-child(2n of .x)", ":first-child",
+        "p:first-of-type", ":not(.x, [y])", ":is(a, b):where(c)", ":root",
+        "html[lang|=en] *", "input:checked", NULL
+    };
+
+    static const char *no[] = {
+        "p:last-child", "li:only-child", ":empty", "div:has(p)",
+        "p:not(:empty)", ":is(a, b:last-of-type)", "li:nth-last-child(2)",
+        "li:nth-child(2 of :only-of-type)", "col || td", "a, b:blank",
+        NULL
+    };
+
+    memory = lxb_css_memory_create();
+    status = lxb_css_memory_init(memory, 128);
+    test_eq(status, LXB_STATUS_OK);
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    lxb_css_parser_memory_set(parser, memory);
+
+    stream = lxb_selectors_stream_create();
+    status = lxb_selectors_stream_init(stream, found_cb, NULL);
+    test_eq(status, LXB_STATUS_OK);
+
+    for (i = 0; yes[i] != NULL; i++) {
+        list = list_parse(parser, yes[i]);
+        test_ne(list, NULL);
+
+        if (!lxb_selectors_stream_supported(list)) {
+            TEST_FAILURE("Must be supported: %s", yes[i]);
+        }
+    }
+
+    for (i = 0; no[i] != NULL; i++) {
+        list = list_parse(parser, no[i]);
+        test_ne(list, NULL);
+
+        if (lxb_selectors_stream_supported(list)) {
+            TEST_FAILURE("Must not be supported: %s", no[i]);
+        }
+
+        status = lxb_selectors_stream_append(stream, list);
+        test_eq(status, LXB_STATUS_ERROR_UNEXPECTED_DATA);
+    }
+
+    test_eq_size(lxb_selectors_set_length(stream->set), 0);
+
+    (void) lxb_selectors_stream_destroy(stream, true);
+    (void) lxb_css_memory_destroy(memory, true);
+    (void) lxb_css_parser_destroy(parser, true);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(build);
+    TEST_ADD(misnested);
+    TEST_ADD(adoption);
+    TEST_ADD(names);
+    TEST_ADD(supported);
+
+    TEST_RUN("lexbor/selectors/stream");
+    TEST_RELEASE();
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Alexander Borisov
+ *
+ * Author: Alexander Borisov <borisov@lexbor.com>
+ */
+
+#include <lexbor/style/style.h>
+#include <unit/test.h>
+
+
+static const lexbor_str_t html = lexbor_str(
+    "<!DOCTYPE html><div id=Main class='a B'><p class=x>one<span class='b A'>two</span></p>"
+    "<p id=second class='x y'>three</p><ul><li>four</li><li class=y>five"
+    "</li></ul></div><section><p>six<i id=main>seven</i></p></section>"
+    "<svg><foreignObject class=a>eight</foreignObject></svg>");
+
+static const lexbor_str_t css = lexbor_str(
+    "p {color: red; width: 1px}"
+    "* {height: 2px}"
+    ".x {color: blue}"
+    "p.x, li {color: green}"
+    "#Main {width: 3px}"
+    "#main {width: 4px}"
+    ".a {height: 5px}"
+    ".A, .b {height: 6px !important}"
+    "div span {width: 7px}"
+    "ul > li.y, section i {color: black}"
+    "foreignObject {width: 8px}"
+    "foreignobject.a {color: white}"
+    "#second.y {height: 9px}"
+    ":not(p) {display: block}"
+    "p {color: gray}"
+    "@media screen {p {color: red}}"
+    "blink {color: red}"
+    "li {width: 10px} li {width: 11px}");
+
+
+static lxb_html_document_t *
+document_make(lxb_css_stylesheet_t **sst)
+{
+    lxb_status_t status;
+    lxb_css_parser_t *parser;
+    lxb_html_document_t *document;
+
+    document = lxb_html_document_create();
+    if (document == NULL) {
+        return NULL;
+    }
+
+    status = lxb_style_init(document);
+    if (status != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    status = lxb_html_document_parse(document, html.data, html.length);
+    if (status != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    parser = lxb_css_parser_create();
+    status = lxb_css_parser_init(parser, NULL);
+    if (status != LXB_STATUS_OK) {
+        return NULL;
+    }
+
+    *sst = lxb_css_stylesheet_create(NULL);
+    if (*sst == NULL) {
+        return NULL;
+    }
+
+    status = lxb_css_stylesheet_parse(*sst, parser, css.data, css.length);
+
+    (void) lxb_css_parser_destroy(parser, true);
+
+    return (status == LXB_STATUS_OK) ? document : NULL;
+}
+
+/* The styles of every element are the same in both documents. */
+static bool
+same_styles(lxb_html_document_t *first, lxb_html_document_t *second)
+{
+    bool same;
+    lxb_status_t status;
+    lexbor_str_t one, two;
+    lxb_dom_node_t *a, *b, *root;
+
+    root = lxb_dom_interface_node(first);
+    a = root->first_child;
+    b = lxb_dom_interface_node(second)->first_child;
+
+    while (a != NULL) {
+        if (a->type == LXB_DOM_NODE_TYPE_ELEMENT) {
+            one.data = NULL;
+            two.data = NULL;
+
+            status = lxb_dom_element_style_serialize_str(lxb_dom_interface_element(a),
+                                                         &one,
+                                                         LXB_DOM_ELEMENT_STYLE_OPT_UNDEF);
+            if (status != LXB_STATUS_OK) {
+                return false;
+            }
+
+            status = lxb_dom_element_style_serialize_str(lxb_dom_interface_element(b),
+                                                         &two,
+                                                         LXB_DOM_ELEMENT_STYLE_OPT_UNDEF);
+            if (status != LXB_STATUS_OK) {
+                return false;
+            }
+
+            same = one.length == two.length
+                   && (one.length == 0
+                       || memcmp(one.data, two.data, one.length) == 0);
+            if (!same) {
+                TEST_PRINTLN("Styles differ: %.*s; %.*s", (int) one.length,
+                             (const char *) one.data, (int) two.length,
+                             (const char *) two.data);
+                return false;
+            }
+        }
+
+        if (a->first_child != NULL) {
+            a = a->first_child;
+            b = b->first_child;
+            continue;
+        }
+
+        while (a != root && a->next == NULL) {
+            a = a->parent;
+            b = b->parent;
+        }
+
+        if (a == root) {
+            break;
+        }
+
+        a = a->next;
+        b = b->next;
+    }
+
+    return true;
+}
+
+
+TEST_BEGIN(apply)
+{
+    size_t i;
+    lxb_status_t status;
+    lxb_css_rule_t *rule;
+    lxb_style_rules_t *rules;
+    lxb_css_stylesheet_t *sst, *sst_each;
+    lxb_html_document_t *document, *each;
+
+    for (i = 0; i < 2; i++) {
+        document = document_make(&sst);
+        test_ne(document, NULL);
+
+        each = document_make(&sst_each);
+        test_ne(each, NULL);
+
+        if (i == 1) {
+            document->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+            each->dom_document.compat_mode = LXB_DOM_DOCUMENT_CMODE_QUIRKS;
+        }
+
+        /* The whole stylesheet in one pass. */
+        status = lxb_html_document_stylesheet_apply(document, sst);
+        test_eq(status, LXB_STATUS_OK);
+
+        /* Rule by rule, a pass for each. */
+        rule = lxb_css_rule_list(sst_each->root)->first;
+
+        for (; rule != NULL; rule = rule->next) {
+            if (rule->type == LXB_CSS_RULE_STYLE) {
+                status = lxb_html_document_style_attach(each,
+                                                        lxb_css_rule_style(rule));
+                test_eq(status, LXB_STATUS_OK);
+            }
+        }
+
+        test_eq(same_styles(document, each), true);
+
+        (void) lxb_css_stylesheet_destroy(sst, true);
+        (void) lxb_css_stylesheet_destroy(sst_each, true);
+        (void) lxb_style_destroy(document);
+        (void) lxb_style_destroy(each);
+        (void) lxb_html_document_destroy(document);
+        (void) lxb_html_document_destroy(each);
+    }
+
+    /* Every selector of a style rule goes to one bucket. */
+    rules = lxb_style_rules_create();
+    status = lxb_style_rules_init(rules);
+    test_eq(status, LXB_STATUS_OK);
+
+    document = document_make(&sst);
+    test_ne(document, NULL);
+
+    status = lxb_style_rules_append_stylesheet(rules, sst);
+    test_eq(status, LXB_STATUS_OK);
+    test_eq_size(lxb_style_rules_length(rules), 21);
+
+    lxb_style_rules_clean(rules);
+    test_eq_size(lxb_style_rules_length(rules), 0);
+
+    (void) lxb_style_rules_destroy(rules, true);
+    (void) lxb_css_stylesheet_destroy(sst, true);
+    (void) lxb_style_destroy(document);
+    (void) lxb_html_document_destroy(document);
+}
+TEST_END
+
+int
+main(int argc, const char * argv[])
+{
+    TEST_INIT();
+
+    TEST_ADD(apply);
+
+    TEST_RUN("lexbor/style/rules");
+    TEST_RELEASE();
+}
@@ -34,6 +34,7 @@ attributes_name.insert(0, "_undef")
 class Attr:
     prefix = "LXB_DOM_ATTR_"
     shs_name = "lxb_dom_attr_res_shs_data"
+    phs_name = "lxb_dom_attr_res_phs_data"
     data_name = "lxb_dom_attr_res_data_default"
 
     def __init__(self):
@@ -83,6 +84,21 @@ class Attr:
 
         return res
 
+    def phs_create(self):
+        attrs = []
+
+        for name in attributes_name:
+            if name == '_undef':
+                var = "#undef"
+            else:
+                var = name
+
+            attrs.append({"key": var,
+                          "value": "(void *) &{}[{}]".format(self.data_name,
+                                                    self.make_enum_name(name))})
+
+        return LXB.PHS(attrs).create(self.phs_name)
+
     def const_create(self):
         frmt_enum = LXB.FormatEnum("{}id_enum_t".format(self.prefix.lower()))
 
@@ -99,11 +115,13 @@ class Attr:
     def shs_save(self, temp_file, save_to):
         res = self.shs_create()
         data = self.data_create()
+        phs = self.phs_create()
 
         lxb_temp = LXB.Temp(temp_file, save_to)
 
         lxb_temp.pattern_append("%%SHS_DATA%%", ''.join(data))
         lxb_temp.pattern_append("%%SHS%%", ''.join(res))
+        lxb_temp.pattern_append("%%PHS%%", ''.join(phs))
 
         lxb_temp.build()
         lxb_temp.save()
@@ -23,5 +23,7 @@
 
 %%SHS%%
 
+%%PHS%%
+
 
 #endif /* LXB_DOM_ATTR_RES_H */
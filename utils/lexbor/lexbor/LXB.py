@@ -446,6 +446,155 @@ class SHS:
         return self.idx
 
 
+class PHS:
+    # Minimal perfect hash (hash and displace) over lowercase keys.
+    # Must be kept in sync with lexbor_shs_perfect_*() in "lexbor/core/shs.c".
+
+    def __init__(self, data, prefix = 'static'):
+        self.data = []
+        self.prefix = prefix
+        self.table = []
+        self.displace = []
+
+        keys = {}
+        signatures = {}
+
+        for entry in data:
+            key = entry["key"].lower()
+
+            if key in keys:
+                continue
+
+            signature = self.signature(key)
+
+            if signature in signatures:
+                raise Exception("Keys \"{}\" and \"{}\" have the same signature"
+                                .format(signatures[signature], key))
+
+            keys[key] = True
+            signatures[signature] = key
+
+            self.data.append({"key": key, "value": entry["value"]})
+
+    def signature(self, key):
+        key = key.encode("utf-8")
+        size = len(key)
+
+        return (key[0], key[1 if size > 1 else 0], key[size >> 1],
+                key[size - 1 - (1 if size > 1 else 0)], key[size - 1], size)
+
+    def hash(self, key):
+        value = 0
+
+        for idx, ch in enumerate(self.signature(key)):
+            value |= ch << (idx * 8)
+
+        return ((value * 0x9e3779b97f4a7c15) & 0xffffffffffffffff) >> 32
+
+    def make(self, rate = 4):
+        size = len(self.data)
+        bits = 1
+
+        # The bucket is taken from the high bits of the hash.
+        while (1 << bits) * rate < size:
+            bits += 1
+
+        while not self.try_make(size, bits):
+            bits += 1
+
+        self.displace_shift = 32 - bits
+
+    def index(self, value, displace, size):
+        return ((((value ^ displace) * 0x85ebca6b) & 0xffffffff) * size) >> 32
+
+    def try_make(self, size, bits):
+        displace_size = 1 << bits
+        buckets = [[] for i in range(0, displace_size)]
+
+        for entry in self.data:
+            entry["hash"] = self.hash(entry["key"])
+            buckets[entry["hash"] >> (32 - bits)].append(entry)
+
+        order = sorted(range(0, displace_size),
+                       key = lambda idx: (-len(buckets[idx]), idx))
+
+        table = [None] * size
+        displace = [0] * displace_size
+
+        for idx in order:
+            bucket = buckets[idx]
+
+            if len(bucket) == 0:
+                break
+
+            for d in range(0, 0x10000):
+                slots = [self.index(entry["hash"], d, size) for entry in bucket]
+
+                if len(set(slots)) != len(slots):
+                    continue
+
+                if any(table[slot] is not None for slot in slots):
+                    continue
+
+                for slot, entry in zip(slots, bucket):
+                    table[slot] = entry
+
+                displace[idx] = d
+                break
+            else:
+                return False
+
+        self.table = table
+        self.displace = displace
+
+        return True
+
+    def create(self, data_name, rate = 2):
+        rate_dn = rate - 1
+        result = []
+
+        self.make()
+
+        prefix = ''
+        if self.prefix != '':
+            prefix = self.prefix + ' '
+
+        entries_name = "{}_entries".format(data_name)
+        displace_name = "{}_displace".format(data_name)
+
+        result.append("{}const lexbor_shs_entry_t {}[{}] =\n{{\n    ".format(prefix, entries_name, len(self.table)))
+
+        for idx, entry in enumerate(self.table):
+            result.append("{{\"{}\", {}, {}, 0}}".format(entry["key"], entry["value"],
+                                                       len(entry["key"])))
+
+            if idx == len(self.table) - 1:
+                result.append("\n};\n\n")
+            elif idx % rate == rate_dn:
+                result.append(",\n    ")
+            else:
+                result.append(", ")
+
+        result.append("{}const uint16_t {}[{}] =\n{{\n    ".format(prefix, displace_name, len(self.displace)))
+
+        for idx, value in enumerate(self.displace):
+            result.append("0x{0:04x}".format(value))
+
+            if idx == len(self.displace) - 1:
+                result.append("\n};\n\n")
+            elif idx % 8 == 7:
+                result.append(",\n    ")
+            else:
+                result.append(", ")
+
+        result.append("{}const lexbor_shs_perfect_t {} =\n{{\n".format(prefix, data_name))
+        result.append("    {}, {},\n".format(entries_name, displace_name))
+        result.append("    {}, {}, {}\n}};".format(len(self.table), self.displace_shift,
+                                                 max(len(entry["key"]) for entry in self.table)))
+
+        return result
+
+
 class FormatEnum:
     def __init__(self, enum_name, value_prefix = ""):
         self.buffer = []
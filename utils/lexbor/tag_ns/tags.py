@@ -486,7 +486,12 @@ class Tags:
 
         return self.shs.create(name)
 
-    def shs_save(self, data, temp_file, save_to):
+    def phs_create(self, name):
+        self.phs = LXB.PHS(self.shs_list)
+
+        return self.phs.create(name)
+
+    def shs_save(self, data, temp_file, save_to, phs_data = None):
         now = datetime.datetime.now()
         res_lower, res_upper = self.tag_data_create_default()
 
@@ -500,6 +505,7 @@ class Tags:
         lxb_temp.pattern_append("%%TAG_DATA%%", res_lower)
         lxb_temp.pattern_append("%%TAG_DATA_UPPER%%", res_upper)
         lxb_temp.pattern_append("%%SHS_DATA%%", ''.join(data))
+        lxb_temp.pattern_append("%%PHS_DATA%%", ''.join(phs_data))
 
         lxb_temp.build()
         lxb_temp.save()
@@ -509,9 +515,10 @@ class Tags:
         print("Save to {}".format(save_to))
         print("Done")
 
-    def shs_create_and_save_default(self, name, temp_file, save_to):
+    def shs_create_and_save_default(self, name, phs_name, temp_file, save_to):
         result = self.shs_create(name)
-        self.shs_save(result, temp_file, save_to)
+        phs = self.phs_create(phs_name)
+        self.shs_save(result, temp_file, save_to, phs)
 
     def shs_create_and_save_html(self, temp_file, save_to,
                                 temp_file_interface, save_to_interface):
@@ -802,7 +809,7 @@ if __name__ == "__main__":
     tags.ns_create_and_save("tmp/ns_const.h", "../../../source/lexbor/ns/const.h")
     tags.ns_shs_create_and_save("lxb_ns_res_shs_data", "lxb_ns_res_shs_link_data", "tmp/ns_res.h", "../../../source/lexbor/ns/res.h")
     tags.enum_create_and_save("tmp/tag_const.h", "../../../source/lexbor/tag/const.h")
-    tags.shs_create_and_save_default("lxb_tag_res_shs_data_default", "tmp/tag_res.h", "../../../source/lexbor/tag/res.h")
+    tags.shs_create_and_save_default("lxb_tag_res_shs_data_default", "lxb_tag_res_phs_default", "tmp/tag_res.h", "../../../source/lexbor/tag/res.h")
     tags.shs_create_and_save_html("tmp/html_tag_res.h", "../../../source/lexbor/html/tag_res.h",
                                   "tmp/html_interface_res.h", "../../../source/lexbor/html/interface_res.h")
 
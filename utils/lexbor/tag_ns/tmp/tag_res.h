@@ -24,3 +24,5 @@
 
 %%SHS_DATA%%
 
+%%PHS_DATA%%
+